@@ -0,0 +1,358 @@
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <chrono>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+#include <linux/if_ether.h>
+
+#include "logger.h"
+#include "macaddress.h"
+#include "fdbnetlink.h"
+
+using namespace std;
+using namespace swss;
+
+#ifndef SOL_NETLINK
+#define SOL_NETLINK 270
+#endif
+
+FdbNetlink::FdbNetlink(size_t batchSize) :
+    m_batchSize(batchSize ? batchSize : FDB_NETLINK_MAX_BATCH_SIZE)
+{
+    open();
+}
+
+FdbNetlink::~FdbNetlink()
+{
+    close();
+}
+
+bool FdbNetlink::open()
+{
+    m_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_fd < 0)
+    {
+        SWSS_LOG_ERROR("Failed to open netlink socket for kernel FDB, errno:%d(%s)", errno, strerror(errno));
+        return false;
+    }
+
+    struct sockaddr_nl local;
+    memset(&local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+
+    if (bind(m_fd, (struct sockaddr *)&local, sizeof(local)) < 0)
+    {
+        SWSS_LOG_ERROR("Failed to bind netlink socket for kernel FDB, errno:%d(%s)", errno, strerror(errno));
+        close();
+        return false;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = FDB_NETLINK_ACK_TIMEOUT_MS / 1000;
+    tv.tv_usec = (FDB_NETLINK_ACK_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+#ifdef NETLINK_CAP_ACK
+    /* Acks only need to carry the request header, not the whole request */
+    int one = 1;
+    setsockopt(m_fd, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+#endif
+
+    return true;
+}
+
+void FdbNetlink::close()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void FdbNetlink::add(const FdbKernelEntry &entry)
+{
+    m_entries.push_back(entry);
+}
+
+double FdbNetlink::getRate() const
+{
+    if (m_elapsedUsec == 0)
+    {
+        return 0;
+    }
+
+    return static_cast<double>(m_programmed) * 1000000 / static_cast<double>(m_elapsedUsec);
+}
+
+string FdbNetlink::toString(const FdbKernelEntry &entry)
+{
+    string str = string(entry.op == FDB_KERNEL_OP_DEL ? "del " : "replace ")
+        + entry.mac + " dev " + entry.ifname;
+
+    if (entry.master)
+    {
+        str += " master";
+    }
+
+    if (!entry.dst.empty())
+    {
+        str += " dst " + entry.dst;
+    }
+
+    return str + " vlan " + to_string(entry.vlan);
+}
+
+static void putAttr(uint8_t *pos, unsigned short type, const void *data, size_t len)
+{
+    struct rtattr *rta = (struct rtattr *)pos;
+
+    rta->rta_type = type;
+    rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+    memcpy(RTA_DATA(rta), data, len);
+}
+
+bool FdbNetlink::encode(const FdbKernelEntry &entry, uint32_t seq, vector<uint8_t> &buf)
+{
+    uint8_t mac[ETH_ALEN];
+    if (!MacAddress::parseMacString(entry.mac, mac))
+    {
+        return false;
+    }
+
+    unsigned int ifindex = if_nametoindex(entry.ifname.c_str());
+    if (ifindex == 0)
+    {
+        return false;
+    }
+
+    /* NDA_DST carries a 4 or 16 byte address, same as "bridge fdb ... dst" */
+    uint8_t dst[sizeof(struct in6_addr)];
+    size_t dstLen = 0;
+    if (!entry.dst.empty())
+    {
+        if (inet_pton(AF_INET, entry.dst.c_str(), dst) == 1)
+        {
+            dstLen = sizeof(struct in_addr);
+        }
+        else if (inet_pton(AF_INET6, entry.dst.c_str(), dst) == 1)
+        {
+            dstLen = sizeof(struct in6_addr);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    size_t len = NLMSG_SPACE(sizeof(struct ndmsg)) + RTA_SPACE(ETH_ALEN) + RTA_SPACE(sizeof(uint16_t));
+    if (dstLen)
+    {
+        len += RTA_SPACE(dstLen);
+    }
+
+    size_t offset = buf.size();
+    buf.resize(offset + len, 0);
+    uint8_t *pos = buf.data() + offset;
+
+    struct nlmsghdr *hdr = (struct nlmsghdr *)pos;
+    hdr->nlmsg_len = static_cast<uint32_t>(len);
+    hdr->nlmsg_seq = seq;
+    if (entry.op == FDB_KERNEL_OP_DEL)
+    {
+        hdr->nlmsg_type = RTM_DELNEIGH;
+        hdr->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+    }
+    else
+    {
+        hdr->nlmsg_type = RTM_NEWNEIGH;
+        hdr->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | NLM_F_CREATE | NLM_F_REPLACE;
+    }
+
+    /* Same state and flags "bridge fdb" derives from its arguments */
+    struct ndmsg *ndm = (struct ndmsg *)NLMSG_DATA(hdr);
+    ndm->ndm_family = AF_BRIDGE;
+    ndm->ndm_ifindex = static_cast<int>(ifindex);
+    ndm->ndm_flags = entry.master ? NTF_MASTER : NTF_SELF;
+    if (entry.state == FDB_KERNEL_STATE_DYNAMIC)
+    {
+        ndm->ndm_state = NUD_REACHABLE;
+        ndm->ndm_flags |= NTF_EXT_LEARNED;
+    }
+    else
+    {
+        ndm->ndm_state = NUD_NOARP;
+        if (entry.state == FDB_KERNEL_STATE_STICKY_STATIC)
+        {
+            ndm->ndm_flags |= NTF_STICKY;
+        }
+    }
+
+    pos += NLMSG_SPACE(sizeof(struct ndmsg));
+    putAttr(pos, NDA_LLADDR, mac, ETH_ALEN);
+    pos += RTA_SPACE(ETH_ALEN);
+    putAttr(pos, NDA_VLAN, &entry.vlan, sizeof(entry.vlan));
+    pos += RTA_SPACE(sizeof(uint16_t));
+    if (dstLen)
+    {
+        putAttr(pos, NDA_DST, dst, dstLen);
+    }
+
+    return true;
+}
+
+void FdbNetlink::sendBatch(vector<FdbKernelEntry>::const_iterator begin,
+                           vector<FdbKernelEntry>::const_iterator end,
+                           vector<FdbKernelEntry> &failed)
+{
+    vector<uint8_t> buf;
+    vector<const FdbKernelEntry *> sent;
+    uint32_t firstSeq = m_seq + 1;
+
+    for (auto it = begin; it != end; ++it)
+    {
+        if (!encode(*it, firstSeq + static_cast<uint32_t>(sent.size()), buf))
+        {
+            SWSS_LOG_INFO("Failed to encode kernel FDB %s", toString(*it).c_str());
+            failed.push_back(*it);
+            continue;
+        }
+        sent.push_back(&(*it));
+    }
+    m_seq += static_cast<uint32_t>(sent.size());
+
+    if (sent.empty())
+    {
+        return;
+    }
+
+    vector<bool> acked(sent.size(), false);
+    size_t remaining = sent.size();
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    if (m_fd < 0 && !open())
+    {
+        remaining = 0;
+    }
+    else if (sendto(m_fd, buf.data(), buf.size(), 0, (struct sockaddr *)&kernel, sizeof(kernel)) < 0)
+    {
+        SWSS_LOG_ERROR("Failed to send %zu kernel FDB requests, errno:%d(%s)", sent.size(), errno, strerror(errno));
+        remaining = 0;
+    }
+
+    /* Every request is acked with an NLMSG_ERROR carrying its sequence number */
+    vector<uint8_t> rbuf(remaining ? 32768 : 0);
+
+    while (remaining > 0)
+    {
+        ssize_t n = recv(m_fd, rbuf.data(), rbuf.size(), 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            SWSS_LOG_ERROR("Failed to receive kernel FDB acks, %zu outstanding, errno:%d(%s)",
+                           remaining, errno, strerror(errno));
+
+            /* Drop the socket, so late acks don't pile up in it */
+            close();
+            break;
+        }
+
+        int len = static_cast<int>(n);
+        for (struct nlmsghdr *hdr = (struct nlmsghdr *)rbuf.data(); NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len))
+        {
+            if (hdr->nlmsg_type != NLMSG_ERROR)
+            {
+                continue;
+            }
+
+            size_t idx = hdr->nlmsg_seq - firstSeq;
+            if (idx >= sent.size() || acked[idx])
+            {
+                /* Late ack of an earlier batch */
+                continue;
+            }
+            acked[idx] = true;
+            remaining--;
+
+            int error = ((struct nlmsgerr *)NLMSG_DATA(hdr))->error;
+            if (error == 0)
+            {
+                continue;
+            }
+
+            if (error == -ENOENT && sent[idx]->op == FDB_KERNEL_OP_DEL)
+            {
+                SWSS_LOG_INFO("Kernel FDB %s not present", toString(*sent[idx]).c_str());
+                continue;
+            }
+
+            SWSS_LOG_WARN("Failed kernel FDB %s, error:%d(%s)", toString(*sent[idx]).c_str(), -error, strerror(-error));
+            failed.push_back(*sent[idx]);
+        }
+    }
+
+    /* Requests that were not sent or not acked may or may not be in the kernel, so they are failed too */
+    for (size_t idx = 0; idx < sent.size(); idx++)
+    {
+        if (!acked[idx])
+        {
+            SWSS_LOG_WARN("No ack for kernel FDB %s", toString(*sent[idx]).c_str());
+            failed.push_back(*sent[idx]);
+        }
+    }
+}
+
+vector<FdbKernelEntry> FdbNetlink::flush()
+{
+    vector<FdbKernelEntry> failed;
+
+    if (m_entries.empty())
+    {
+        return failed;
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); )
+    {
+        auto end = it + static_cast<ptrdiff_t>(min(m_batchSize, static_cast<size_t>(m_entries.cend() - it)));
+        sendBatch(it, end, failed);
+        it = end;
+    }
+
+    uint64_t elapsed = static_cast<uint64_t>(
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+    size_t count = m_entries.size();
+    m_entries.clear();
+
+    m_programmed += count - failed.size();
+    m_failed += failed.size();
+    m_elapsedUsec += elapsed;
+
+    double rate = elapsed ? static_cast<double>(count) * 1000000 / static_cast<double>(elapsed) : 0;
+    if (count >= m_batchSize)
+    {
+        SWSS_LOG_NOTICE("Programmed %zu kernel FDB entries (%zu failed) in %" PRIu64 " us, %.0f MACs/s",
+                        count, failed.size(), elapsed, rate);
+    }
+    else
+    {
+        SWSS_LOG_INFO("Programmed %zu kernel FDB entries (%zu failed) in %" PRIu64 " us, %.0f MACs/s",
+                      count, failed.size(), elapsed, rate);
+    }
+
+    return failed;
+}
@@ -0,0 +1,112 @@
+#ifndef __FDBNETLINK__
+#define __FDBNETLINK__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Max number of FDB requests packed into a single netlink sendmsg
+ */
+#define FDB_NETLINK_MAX_BATCH_SIZE 256
+
+/*
+ * Max time in milliseconds to wait for the kernel to ack a batch
+ */
+#define FDB_NETLINK_ACK_TIMEOUT_MS 1000
+
+namespace swss {
+
+enum FDB_KERNEL_OP_TYPE {
+    FDB_KERNEL_OP_REPLACE = 1,
+    FDB_KERNEL_OP_DEL = 2,
+};
+
+enum FDB_KERNEL_STATE {
+    FDB_KERNEL_STATE_DYNAMIC = 1,       /* dynamic extern_learn */
+    FDB_KERNEL_STATE_STATIC = 2,        /* static */
+    FDB_KERNEL_STATE_STICKY_STATIC = 3, /* sticky static */
+};
+
+/*
+ * One "bridge fdb" request. Entries with master set are programmed into the
+ * bridge (bridge fdb ... master), others into the device itself (self),
+ * which is what the VXLAN remote entries use together with dst.
+ */
+struct FdbKernelEntry
+{
+    short op;
+    std::string mac;
+    std::string ifname;
+    uint16_t vlan;
+    bool master;
+    short state;
+    std::string dst;    /* remote VTEP, empty if none */
+    uint8_t retries = 0;    /* times the caller queued it again after a failure */
+};
+
+/*
+ * Programs bridge FDB entries into the kernel with RTM_NEWNEIGH/RTM_DELNEIGH
+ * requests. Requests are queued and sent many per sendmsg on flush, each one
+ * is acked by the kernel so failures are still reported per MAC.
+ */
+class FdbNetlink
+{
+public:
+    FdbNetlink(size_t batchSize = FDB_NETLINK_MAX_BATCH_SIZE);
+    ~FdbNetlink();
+
+    void add(const FdbKernelEntry &entry);
+
+    /*
+     * Send all queued requests, returns the failed ones for the caller to
+     * retry or drop. A delete of an entry the kernel does not have is not
+     * a failure.
+     */
+    std::vector<FdbKernelEntry> flush();
+
+    size_t pending() const
+    {
+        return m_entries.size();
+    }
+
+    uint64_t getProgrammedCount() const
+    {
+        return m_programmed;
+    }
+
+    uint64_t getFailedCount() const
+    {
+        return m_failed;
+    }
+
+    /* Average programming rate since start, in MACs per second */
+    double getRate() const;
+
+    /* Encode a request, exposed for testing. Returns false if it can not be encoded */
+    static bool encode(const FdbKernelEntry &entry, uint32_t seq, std::vector<uint8_t> &buf);
+
+private:
+    int m_fd = -1;
+    uint32_t m_seq = 0;
+    size_t m_batchSize;
+
+    std::vector<FdbKernelEntry> m_entries;
+
+    uint64_t m_programmed = 0;
+    uint64_t m_failed = 0;
+    uint64_t m_elapsedUsec = 0;
+
+    bool open();
+    void close();
+
+    void sendBatch(std::vector<FdbKernelEntry>::const_iterator begin,
+                   std::vector<FdbKernelEntry>::const_iterator end,
+                   std::vector<FdbKernelEntry> &failed);
+
+    static std::string toString(const FdbKernelEntry &entry);
+};
+
+}
+
+#endif
@@ -11,7 +11,7 @@
 #include "ipaddress.h"
 #include "netmsg.h"
 #include "macaddress.h"
-#include "exec.h"
+#include "converter.h"
 #include "fdbsync.h"
 #include "warm_restart.h"
 #include "errno.h"
@@ -26,7 +26,8 @@ FdbSync::FdbSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector
     m_imetTable(pipelineAppDB, APP_VXLAN_REMOTE_VNI_TABLE_NAME),
     m_fdbStateTable(stateDb, STATE_FDB_TABLE_NAME),
     m_mclagRemoteFdbStateTable(stateDb, STATE_MCLAG_REMOTE_FDB_TABLE_NAME),
-    m_cfgEvpnNvoTable(config_db, CFG_VXLAN_EVPN_NVO_TABLE_NAME)
+    m_cfgEvpnNvoTable(config_db, CFG_VXLAN_EVPN_NVO_TABLE_NAME),
+    m_kernelFdbStatsTable(stateDb, STATE_KERNEL_FDB_STATS_TABLE_NAME)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "fdbsyncd", "swss", DEFAULT_FDBSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -273,30 +274,102 @@ bool FdbSync::macCheckSrcDB(struct m_fdb_info *info)
     return false;
 }
 
-void FdbSync::macDelVxlanEntry(string auxkey, struct m_fdb_info *info)
+/*
+ * Queue a kernel bridge FDB update, the queued updates are sent in batches by flushKernelFdb
+ */
+void FdbSync::programKernelFdb(short op, const std::string &mac, const std::string &ifname,
+                               const std::string &vlan, bool master, short state, const std::string &dst)
 {
-    std::string vtep = m_mac[auxkey].vtep;
+    FdbKernelEntry entry;
+
+    try
+    {
+        entry.vlan = to_uint<uint16_t>(vlan);
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid vlan %s for kernel FDB %s dev %s", vlan.c_str(), mac.c_str(), ifname.c_str());
+        return;
+    }
+
+    entry.op = op;
+    entry.mac = mac;
+    entry.ifname = ifname;
+    entry.master = master;
+    entry.state = state;
+    entry.dst = dst;
+
+    SWSS_LOG_INFO("Kernel FDB %s %s dev %s vlan %s", op == FDB_KERNEL_OP_DEL ? "del" : "replace",
+                  mac.c_str(), ifname.c_str(), vlan.c_str());
+
+    m_kernelFdb.add(entry);
+}
+
+/*
+ * Failed updates are queued again and sent ahead of the updates of the next
+ * event, so a later update of the same MAC still wins. They are dropped after
+ * KERNEL_FDB_MAX_RETRIES attempts.
+ */
+void FdbSync::flushKernelFdb()
+{
+    if (m_kernelFdb.pending() == 0)
+    {
+        return;
+    }
+
+    bool dropped = false;
+
+    for (auto &entry : m_kernelFdb.flush())
+    {
+        if (entry.retries >= KERNEL_FDB_MAX_RETRIES)
+        {
+            SWSS_LOG_ERROR("Dropped kernel FDB %s %s dev %s vlan %u after %u retries",
+                           entry.op == FDB_KERNEL_OP_DEL ? "del" : "replace", entry.mac.c_str(),
+                           entry.ifname.c_str(), entry.vlan, entry.retries);
+            m_kernelFdbDropped++;
+            dropped = true;
+            continue;
+        }
+
+        entry.retries++;
+        m_kernelFdb.add(entry);
+    }
 
-    const std::string cmds = std::string("")
-        + " bridge fdb del " + info->mac + " dev " 
-        + m_mac[auxkey].ifname + " dst " + vtep + " vlan " + info->vid.substr(4);
+    exportKernelFdbStats(dropped);
+}
 
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret != 0)
+void FdbSync::exportKernelFdbStats(bool force)
+{
+    time_t now = time(NULL);
+    if (!force && now - m_kernelFdbStatsExported < KERNEL_FDB_STATS_EXPORT_INTERVAL)
     {
-        SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        return;
     }
+    m_kernelFdbStatsExported = now;
+
+    vector<FieldValueTuple> fvVector;
+    fvVector.emplace_back("programmed", to_string(m_kernelFdb.getProgrammedCount()));
+    fvVector.emplace_back("failed", to_string(m_kernelFdb.getFailedCount()));
+    fvVector.emplace_back("dropped", to_string(m_kernelFdbDropped));
+    fvVector.emplace_back("rate", to_string(static_cast<uint64_t>(m_kernelFdb.getRate())));
+
+    m_kernelFdbStatsTable.set("fdbsyncd", fvVector);
+}
 
-    SWSS_LOG_INFO("Success cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+void FdbSync::macDelVxlanEntry(string auxkey, struct m_fdb_info *info)
+{
+    std::string vtep = m_mac[auxkey].vtep;
+
+    programKernelFdb(FDB_KERNEL_OP_DEL, info->mac, m_mac[auxkey].ifname, info->vid.substr(4),
+                     false, FDB_KERNEL_STATE_STATIC, vtep);
 
     return;
 }
 
 void FdbSync::updateLocalMac (struct m_fdb_info *info)
 {
-    char *op;
-    char *type;
+    short op;
+    short state;
     string port_name = "";
     string key = info->vid + ":" + info->mac;
     short fdb_type;    /*dynamic or static*/
@@ -304,13 +377,13 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
     if (info->op_type == FDB_OPER_ADD)
     {
         macUpdateCache(info);
-        op = "replace";
+        op = FDB_KERNEL_OP_REPLACE;
         port_name = info->port_name;
         fdb_type = info->type;
     }
     else
     {
-        op = "del";
+        op = FDB_KERNEL_OP_DEL;
         port_name = m_fdb_mac[key].port_name;
         fdb_type = m_fdb_mac[key].type;
         m_fdb_mac.erase(key);
@@ -324,21 +397,14 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
 
     if (fdb_type == FDB_TYPE_DYNAMIC)
     {
-        type = "dynamic extern_learn";
+        state = FDB_KERNEL_STATE_DYNAMIC;
     }
     else
     {
-        type = "sticky static";
+        state = FDB_KERNEL_STATE_STICKY_STATIC;
     }
 
-    const std::string cmds = std::string("")
-        + " bridge fdb " + op + " " + info->mac + " dev " 
-        + port_name + " master " + type + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-
-    SWSS_LOG_INFO("cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    programKernelFdb(op, info->mac, port_name, info->vid.substr(4), true, state);
 
     if (info->op_type == FDB_OPER_ADD)
     {
@@ -356,7 +422,7 @@ void FdbSync::updateLocalMac (struct m_fdb_info *info)
 
 void FdbSync::addLocalMac(string key, string op)
 {
-    char *type;
+    short state;
     string port_name = "";
     string mac = "";
     string vlan = "";
@@ -384,33 +450,23 @@ void FdbSync::addLocalMac(string key, string op)
 
         if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
         {
-            type = "dynamic extern_learn";
+            state = FDB_KERNEL_STATE_DYNAMIC;
         }
         else
         {
-            type = "static";
-        }
-
-        const std::string cmds = std::string("")
-                + " bridge fdb " + op + " " + mac + " dev "
-                + port_name + " master " + type  + " vlan " + vlan;
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+            state = FDB_KERNEL_STATE_STATIC;
         }
 
-        SWSS_LOG_INFO("Config triggered cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        programKernelFdb(op == "del" ? FDB_KERNEL_OP_DEL : FDB_KERNEL_OP_REPLACE,
+                         mac, port_name, vlan, true, state);
     }
     return;
 }
 
 void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
 {
-    char *op;
-    char *type;
+    short op;
+    short state;
     string port_name = "";
     string key = info->vid + ":" + info->mac;
     short fdb_type;    /*dynamic or static*/
@@ -418,13 +474,13 @@ void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
     if (info->op_type == FDB_OPER_ADD)
     {
         macUpdateMclagRemoteCache(info);
-        op = "replace";
+        op = FDB_KERNEL_OP_REPLACE;
         port_name = info->port_name;
         fdb_type = info->type;
     }
     else
     {
-        op = "del";
+        op = FDB_KERNEL_OP_DEL;
         port_name = m_mclag_remote_fdb_mac[key].port_name;
         fdb_type = m_mclag_remote_fdb_mac[key].type;
         m_mclag_remote_fdb_mac.erase(key);
@@ -432,21 +488,14 @@ void FdbSync::updateMclagRemoteMac (struct m_fdb_info *info)
 
     if (fdb_type == FDB_TYPE_DYNAMIC)
     {
-        type = "dynamic extern_learn";
+        state = FDB_KERNEL_STATE_DYNAMIC;
     }
     else
     {
-        type = "static";
+        state = FDB_KERNEL_STATE_STATIC;
     }
 
-    const std::string cmds = std::string("")
-        + " bridge fdb " + op + " " + info->mac + " dev "
-        + port_name + " master " + type + " vlan " + info->vid.substr(4);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-
-    SWSS_LOG_INFO("cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+    programKernelFdb(op, info->mac, port_name, info->vid.substr(4), true, state);
 
     return;
 }
@@ -467,19 +516,7 @@ void FdbSync::updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac)
 
         if (type == FDB_TYPE_STATIC)
         {
-            const std::string cmds = std::string("")
-                + " bridge fdb replace" + " " + mac + " dev "
-                + port_name + " master static vlan " + to_string(vlan);
-
-            std::string res;
-            int ret = swss::exec(cmds, res);
-            if (ret != 0)
-            {
-                SWSS_LOG_NOTICE("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
-                return;
-            }
-
-            SWSS_LOG_NOTICE("Update cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+            programKernelFdb(FDB_KERNEL_OP_REPLACE, mac, port_name, to_string(vlan), true, FDB_KERNEL_STATE_STATIC);
         }
     }
     return;
@@ -495,7 +532,7 @@ void FdbSync::updateMclagRemoteMacPort(int ifindex, int vlan, std::string mac)
 void FdbSync::macRefreshStateDB(int vlan, string kmac)
 {
     string key = "Vlan" + to_string(vlan) + ":" + kmac;
-    char *type;
+    short state;
     string port_name = "";
 
     SWSS_LOG_INFO("Refreshing Vlan:%d MAC route MAC:%s Key %s", vlan, kmac.c_str(), key.c_str());
@@ -511,25 +548,14 @@ void FdbSync::macRefreshStateDB(int vlan, string kmac)
 
         if (m_fdb_mac[key].type == FDB_TYPE_DYNAMIC)
         {
-            type = "dynamic extern_learn";
+            state = FDB_KERNEL_STATE_DYNAMIC;
         }
         else
         {
-            type = "static";
-        }
-
-        const std::string cmds = std::string("")
-            + " bridge fdb " + "replace" + " " + kmac + " dev "
-            + port_name + " master " + type  + " vlan " + to_string(vlan);
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret != 0)
-        {
-            SWSS_LOG_INFO("Failed cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+            state = FDB_KERNEL_STATE_STATIC;
         }
 
-        SWSS_LOG_INFO("Refreshing cmd:%s, res=%s, ret=%d", cmds.c_str(), res.c_str(), ret);
+        programKernelFdb(FDB_KERNEL_OP_REPLACE, kmac, port_name, to_string(vlan), true, state);
     }
     return;
 }
@@ -2,12 +2,15 @@
 #define __FDBSYNC__
 
 #include <string>
+#include <time.h>
 #include <arpa/inet.h>
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "subscriberstatetable.h"
+#include "table.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
+#include "fdbnetlink.h"
 
 /*
  * Default timer interval for fdbsyncd reconcillation 
@@ -21,6 +24,23 @@
  */
 #define INTF_RESTORE_MAX_WAIT_TIME 180
 
+/*
+ * Times a failed kernel FDB update is queued again before it is dropped
+ */
+#define KERNEL_FDB_MAX_RETRIES 3
+
+/*
+ * STATE_DB table with the kernel FDB programming counters, under the "fdbsyncd" key:
+ * programmed and failed requests, updates dropped after their retries, and the
+ * average rate in MACs per second
+ */
+#define STATE_KERNEL_FDB_STATS_TABLE_NAME "KERNEL_FDB_STATS"
+
+/*
+ * The kernel FDB counters are written to STATE_DB at most once per interval, in seconds
+ */
+#define KERNEL_FDB_STATS_EXPORT_INTERVAL 1
+
 namespace swss {
 
 enum FDB_OP_TYPE {
@@ -80,6 +100,9 @@ public:
 
     void processCfgEvpnNvo();
 
+    /* Send the kernel FDB updates queued while processing events */
+    void flushKernelFdb();
+
     bool m_reconcileDone = false;
 
     bool m_isEvpnNvoExist = false;
@@ -91,6 +114,10 @@ private:
     SubscriberStateTable m_mclagRemoteFdbStateTable;
     AppRestartAssist  *m_AppRestartAssist;
     SubscriberStateTable m_cfgEvpnNvoTable;
+    FdbNetlink m_kernelFdb;
+    Table m_kernelFdbStatsTable;
+    uint64_t m_kernelFdbDropped = 0;
+    time_t m_kernelFdbStatsExported = 0;
 
     struct m_local_fdb_info
     {
@@ -101,6 +128,11 @@ private:
 
     std::unordered_map<std::string, m_local_fdb_info> m_mclag_remote_fdb_mac;
 
+    void programKernelFdb(short op, const std::string &mac, const std::string &ifname,
+                          const std::string &vlan, bool master, short state, const std::string &dst = "");
+
+    void exportKernelFdbStats(bool force);
+
     void macDelVxlanEntry(std::string auxkey, struct m_fdb_info *info);
 
     void macUpdateCache(struct m_fdb_info *info);
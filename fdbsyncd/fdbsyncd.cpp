@@ -89,6 +89,9 @@ int main(int argc, char **argv)
             s.addSelectable(sync.getCfgEvpnNvoTable());
             while (true)
             {
+                /* Program the kernel FDB updates queued by the previous events in one go */
+                sync.flushKernelFdb();
+
                 s.select(&temps);
 
                 if (temps == (Selectable *)sync.getFdbStateTable())
@@ -120,6 +120,8 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            // Orchagent waits for fpmsyncd to start a new generation after it resets the route ring.
+            SelectableTimer routeRingTimer(timespec{ROUTE_RING_POLL_INTERVAL, 0});
            
             /*
              * Pipeline should be flushed right away to deal with state pending
@@ -140,6 +142,12 @@ int main(int argc, char **argv)
                 s.addSelectable(routeResponseChannel.get());
             }
 
+            if (sync.hasRouteRing())
+            {
+                routeRingTimer.start();
+                s.addSelectable(&routeRingTimer);
+            }
+
             /* If warm-restart feature is enabled, execute 'restoration' logic */
             bool warmStartEnabled = sync.getWarmStartHelper().checkAndStart();
             if (warmStartEnabled)
@@ -295,6 +303,10 @@ int main(int argc, char **argv)
                         } // end for fvs
                     } // end for keyOpFvsQueue
                 }
+                else if (temps == &routeRingTimer)
+                {
+                    sync.pollRouteRing();
+                }
                 else if (routeResponseChannel && (temps == routeResponseChannel.get()))
                 {
                     std::deque<KeyOpFieldsValuesTuple> notifications;
@@ -5,4 +5,7 @@
 // redispipeline has a maximum capacity of 50000 entries
 #define ROUTE_SYNC_PPL_SIZE 50000
 
+// seconds between checks for a reset of the route ring while no route is written
+#define ROUTE_RING_POLL_INTERVAL 1
+
 #endif
\ No newline at end of file
@@ -7,6 +7,9 @@
 #include "ipprefix.h"
 #include "dbconnector.h"
 #include "lib/orch_zmq_config.h"
+#include "lib/shm_route_ring.h"
+#include "lib/route_nexthop_codec.h"
+#include "lib/route_latency.h"
 #include "producerstatetable.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
@@ -150,10 +153,28 @@ static decltype(auto) makeNlAddr(const T& ip)
 }
 
 
+static shared_ptr<ProducerStateTable> createRouteTable(RedisPipeline *pipeline, shared_ptr<ZmqClient> zmqClient)
+{
+    // When the feature ORCH_NORTHBOND_ROUTE_SHM_ENABLED is enabled, routes are sent to orchagent through the shared memory route ring.
+    if (get_feature_status(ORCH_NORTHBOND_ROUTE_SHM_ENABLED, false))
+    {
+        auto ring = ShmRouteRing::attach(SHM_ROUTE_RING_NAME);
+        if (ring)
+        {
+            SWSS_LOG_NOTICE("Create ShmRouteProducerStateTable : %s", APP_ROUTE_TABLE_NAME);
+            return make_shared<ShmRouteProducerStateTable>(pipeline, APP_ROUTE_TABLE_NAME, ring);
+        }
+
+        SWSS_LOG_WARN("Route ring is not available, falling back to the default route channel");
+    }
+
+    return createProducerStateTable(pipeline, APP_ROUTE_TABLE_NAME, true, zmqClient);
+}
+
 RouteSync::RouteSync(RedisPipeline *pipeline) :
     // When the feature ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED is enabled, route events must be sent to orchagent via the ZMQ channel.
     m_zmqClient(create_local_zmq_client(ORCH_NORTHBOND_ROUTE_ZMQ_ENABLED, false)),
-    m_routeTable(createProducerStateTable(pipeline, APP_ROUTE_TABLE_NAME, true, m_zmqClient)),
+    m_routeTable(createRouteTable(pipeline, m_zmqClient)),
     m_nexthop_groupTable(pipeline, APP_NEXTHOP_GROUP_TABLE_NAME, true),
     m_label_routeTable(createProducerStateTable(pipeline, APP_LABEL_ROUTE_TABLE_NAME, true, m_zmqClient)),
     m_pic_context_groupTable(pipeline, APP_PIC_CONTEXT_TABLE_NAME, true),
@@ -167,20 +188,53 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
     rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+
+    // The packed next hop field is only sent on the ZMQ channel, routes written through Redis keep the string fields.
+    m_packedNextHops = dynamic_pointer_cast<ZmqProducerStateTable>(m_routeTable) != nullptr &&
+                       get_feature_status(ORCH_NORTHBOND_ROUTE_ZMQ_PACKED_ENABLED, false);
+    if (m_packedNextHops)
+    {
+        SWSS_LOG_NOTICE("Send packed next hops in %s", APP_ROUTE_TABLE_NAME);
+    }
+
+    // The receive time stamp does not describe the route, never let it make a warm restart diff
+    m_warmStartHelper.ignoreField(ROUTE_LATENCY_TS_FIELD);
+
+    m_latencySampling = get_route_latency_sampling();
+    if (m_latencySampling)
+    {
+        m_stateDb = make_shared<DBConnector>("STATE_DB", 0);
+        m_routeLatency = make_unique<RouteLatencyRecorder>(m_stateDb.get());
+    }
 }
 
 void RouteSync::setRouteWithWarmRestart(FieldValueTupleWrapperBase & fvw,
                                         ProducerStateTable & table )
 {
     bool warmRestartInProgress = m_warmStartHelper.inProgress();
+    auto kfvVector = fvw.KeyOpFieldsValuesTupleVector();
+
+    if (&table == m_routeTable.get())
+    {
+        // Not sampled during warm restart, the timestamp would fail the reconciliation of every sampled route
+        if (m_latencySampling && !warmRestartInProgress)
+        {
+            sampleRouteLatency(kfvVector[0]);
+        }
+
+        if (m_packedNextHops)
+        {
+            packRouteNextHops(kfvFieldsValues(kfvVector[0]));
+        }
+    }
 
     if (!warmRestartInProgress)
     {
-        table.set(fvw.KeyOpFieldsValuesTupleVector());
+        table.set(kfvVector);
     }
     else
     {
-        m_warmStartHelper.insertRefreshMap(fvw.KeyOpFieldsValuesTupleVector()[0]);
+        m_warmStartHelper.insertRefreshMap(kfvVector[0]);
     }
 }
 
@@ -998,15 +1052,25 @@ RouteTableFieldValueTupleWrapper::fieldValueTupleVector() {
     vector<FieldValueTuple> fvVector;
     fvVector.push_back(FieldValueTuple("protocol", protocol.c_str()));
     fvVector.push_back(FieldValueTuple("blackhole", blackhole.c_str()));
-    fvVector.push_back(FieldValueTuple("nexthop", nexthop.c_str()));
-    fvVector.push_back(FieldValueTuple("ifname", ifname.c_str()));
+    if (nexthop_packed.empty())
+    {
+        fvVector.push_back(FieldValueTuple("nexthop", nexthop.c_str()));
+        fvVector.push_back(FieldValueTuple("ifname", ifname.c_str()));
+    }
     fvVector.push_back(FieldValueTuple("nexthop_group", nexthop_group.c_str()));
     fvVector.push_back(FieldValueTuple("mpls_nh", mpls_nh.c_str()));
-    fvVector.push_back(FieldValueTuple("weight", weight.c_str()));
-    fvVector.push_back(FieldValueTuple("vni_label", vni_label.c_str()));
-    fvVector.push_back(FieldValueTuple("router_mac", router_mac.c_str()));
+    if (nexthop_packed.empty())
+    {
+        fvVector.push_back(FieldValueTuple("weight", weight.c_str()));
+        fvVector.push_back(FieldValueTuple("vni_label", vni_label.c_str()));
+        fvVector.push_back(FieldValueTuple("router_mac", router_mac.c_str()));
+    }
     fvVector.push_back(FieldValueTuple("segment", segment.c_str()));
     fvVector.push_back(FieldValueTuple("seg_src", seg_src.c_str()));
+    if (!nexthop_packed.empty())
+    {
+        fvVector.push_back(FieldValueTuple(ROUTE_PACKED_NEXTHOP_FIELD, nexthop_packed));
+    }
     // Return value optimization will avoid copy of the following vector
     return fvVector;
 }
@@ -2111,10 +2175,13 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             return;
         }
 
-        /* Get nexthop lists */
-
-        getNextHopList(route_obj, gw_list, mpls_list, intf_list);
-        weights = getNextHopWt(route_obj);
+        /* Get nexthop lists, packed ones skip the comma separated strings */
+        bool packed = m_packedNextHops && getPackedNextHops(route_obj, fvw.nexthop_packed, intf_list);
+        if (!packed)
+        {
+            getNextHopList(route_obj, gw_list, mpls_list, intf_list);
+            weights = getNextHopWt(route_obj);
+        }
 
         vector<string> alsv = tokenize(intf_list, NHG_DELIMITER);
 
@@ -2148,16 +2215,19 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         }
 
 
-        fvw.nexthop = std::move(gw_list);
-        fvw.ifname = std::move(intf_list);
-
-        if (!mpls_list.empty())
+        if (!packed)
         {
-            fvw.mpls_nh = std::move(mpls_list);
-        }
-        if (!weights.empty())
-        {
-            fvw.weight = std::move(weights);
+            fvw.nexthop = std::move(gw_list);
+            fvw.ifname = std::move(intf_list);
+
+            if (!mpls_list.empty())
+            {
+                fvw.mpls_nh = std::move(mpls_list);
+            }
+            if (!weights.empty())
+            {
+                fvw.weight = std::move(weights);
+            }
         }
     }
 
@@ -2166,6 +2236,11 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     {
         SWSS_LOG_INFO("RouteTable set msg with NHG: %s nhg_id:%d", destipprefix, nhg_id);
     }
+    else if (!fvw.nexthop_packed.empty())
+    {
+        SWSS_LOG_INFO("RouteTable set msg: %s packed nexthops:%d",
+                      destipprefix, rtnl_route_get_nnexthops(route_obj));
+    }
     else
     {
         SWSS_LOG_INFO("RouteTable set msg: %s nexthop:%s ifname:%s mpls:%s weight:%s",
@@ -2862,6 +2937,85 @@ void RouteSync::getNextHopList(struct rtnl_route *route_obj, string& gw_list,
     }
 }
 
+/*
+ * getPackedNextHops() - packs the next hops attached to route_obj
+ * @arg route_obj     (input) Netlink route object
+ * @arg packed        (output) value of the packed next hop field
+ * @arg intf_list     (output) interface of a single next hop route
+ *
+ * Same value as packRouteNextHops() on the getNextHopList() and getNextHopWt()
+ * strings, without building and parsing them. MPLS next hops are not packed.
+ *
+ * Return false if the route has to use the string fields
+ */
+bool RouteSync::getPackedNextHops(struct rtnl_route *route_obj, string& packed,
+                                  string& intf_list)
+{
+    int count = rtnl_route_get_nnexthops(route_obj);
+    if (count <= 0)
+    {
+        return false;
+    }
+
+    RouteNextHopPacker packer(true);
+
+    for (int i = 0; i < count; i++)
+    {
+        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
+        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+
+        if (rtnl_route_nh_get_via(nexthop) ||
+            (addr && rtnl_route_nh_get_encap_mpls_dst(nexthop)))
+        {
+            return false;
+        }
+
+        ip_addr_t ip;
+        memset(&ip, 0, sizeof(ip));
+        if (addr)
+        {
+            ip.family = static_cast<uint8_t>(nl_addr_get_family(addr));
+            unsigned int len = nl_addr_get_len(addr);
+            if ((ip.family == AF_INET && len != sizeof(ip.ip_addr.ipv4_addr)) ||
+                (ip.family == AF_INET6 && len != sizeof(ip.ip_addr.ipv6_addr)))
+            {
+                return false;
+            }
+            memcpy(&ip.ip_addr, nl_addr_get_binary_addr(addr), len);
+        }
+        else
+        {
+            ip.family = rtnl_route_get_family(route_obj) == AF_INET6 ? AF_INET6 : AF_INET;
+        }
+
+        unsigned if_index = rtnl_route_nh_get_ifindex(nexthop);
+        char if_name[IFNAMSIZ] = "0";
+        if (!getIfName(if_index, if_name, IFNAMSIZ))
+        {
+            strcpy(if_name, "unknown");
+        }
+
+        uint32_t weight = rtnl_route_nh_get_weight(nexthop);
+        if (weight == 0)
+        {
+            weight = 1; // default weight is 1
+        }
+
+        if (!packer.add(&ip, if_name, strnlen(if_name, IFNAMSIZ), weight))
+        {
+            return false;
+        }
+
+        if (count == 1)
+        {
+            intf_list = if_name;
+        }
+    }
+
+    packed = packer.encode();
+    return true;
+}
+
 /*
  * Get next hop gateway IP addresses
  * @arg route_obj     route object
@@ -3033,6 +3187,55 @@ void RouteSync::setSuppressionEnabled(bool enabled)
     m_isSuppressionEnabled = enabled;
 
     SWSS_LOG_NOTICE("Pending routes suppression is %s", (m_isSuppressionEnabled ? "enabled": "disabled"));
+
+    if (!m_isSuppressionEnabled)
+    {
+        m_pendingLatency.clear();
+    }
+}
+
+void RouteSync::sampleRouteLatency(KeyOpFieldsValuesTuple& kfv)
+{
+    if (++m_latencyCounter % m_latencySampling != 0)
+    {
+        // A newer unsampled update supersedes the pending sample of the same route
+        if (!m_pendingLatency.empty())
+        {
+            m_pendingLatency.erase(kfvKey(kfv));
+        }
+        return;
+    }
+
+    auto ts = RouteLatencyRecorder::now();
+    kfvFieldsValues(kfv).emplace_back(ROUTE_LATENCY_TS_FIELD, to_string(ts));
+
+    // Offload replies are only sent on orchagent responses when suppression is enabled
+    if (!isSuppressionEnabled())
+    {
+        return;
+    }
+
+    if (m_pendingLatency.size() >= ROUTE_LATENCY_MAX_PENDING)
+    {
+        // Routes whose response never came back (e.g. deleted before being programmed)
+        for (auto it = m_pendingLatency.begin(); it != m_pendingLatency.end();)
+        {
+            if (ts - it->second > ROUTE_LATENCY_PENDING_TIMEOUT_US)
+            {
+                it = m_pendingLatency.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Keep the newest stamp, the response is for the latest update of the route
+    if (m_pendingLatency.size() < ROUTE_LATENCY_MAX_PENDING || m_pendingLatency.count(kfvKey(kfv)))
+    {
+        m_pendingLatency[kfvKey(kfv)] = ts;
+    }
 }
 
 void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldValueTuple>& fieldValues)
@@ -3049,6 +3252,17 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
         return;
     }
 
+    uint64_t fpmTs = 0;
+    if (!m_pendingLatency.empty())
+    {
+        auto pending = m_pendingLatency.find(key);
+        if (pending != m_pendingLatency.end())
+        {
+            fpmTs = pending->second;
+            m_pendingLatency.erase(pending);
+        }
+    }
+
     auto colon = key.find(':');
     if (colon != std::string::npos && key.substr(0, colon).find(VRF_PREFIX) != std::string::npos)
     {
@@ -3140,6 +3354,13 @@ void RouteSync::onRouteResponse(const std::string& key, const std::vector<FieldV
 
     SWSS_LOG_INFO("Sent response to zebra for prefix %s(%s)",
         prefix.to_string().c_str(), vrfName.c_str());
+
+    auto offloadTs = RouteLatencyRecorder::now();
+    if (fpmTs && offloadTs - fpmTs <= ROUTE_LATENCY_PENDING_TIMEOUT_US)
+    {
+        m_routeLatency->record("fpm_to_offload", fpmTs, offloadTs);
+        m_routeLatency->flush();
+    }
 }
 
 void RouteSync::sendOffloadReply(DBConnector& db, const std::string& tableName)
@@ -3184,6 +3405,20 @@ void RouteSync::onWarmStartEnd(DBConnector& applStateDb)
     }
 }
 
+bool RouteSync::hasRouteRing() const
+{
+    return dynamic_cast<ShmRouteProducerStateTable *>(m_routeTable.get()) != nullptr;
+}
+
+void RouteSync::pollRouteRing()
+{
+    auto table = dynamic_cast<ShmRouteProducerStateTable *>(m_routeTable.get());
+    if (table)
+    {
+        table->poll();
+    }
+}
+
 /*
  * Get nexthop group key as string
  * @arg id     next hop group id
@@ -9,6 +9,7 @@
 #include "linkcache.h"
 #include "fpminterface.h"
 #include "warmRestartHelper.h"
+#include "route_latency.h"
 #include <string.h>
 #include <bits/stdc++.h>
 #include <linux/version.h>
@@ -22,6 +23,11 @@
 #define RTM_F_OFFLOAD 0x4000 /* route is offloaded */
 #endif
 
+/* Sampled routes waiting for the orchagent response */
+#define ROUTE_LATENCY_MAX_PENDING   4096
+/* Responses arriving later than this are not recorded, older pending samples are evicted */
+#define ROUTE_LATENCY_PENDING_TIMEOUT_US    (60ULL * 1000000)
+
 using namespace std;
 
 /* Parse the Raw netlink msg */
@@ -107,6 +113,8 @@ class RouteTableFieldValueTupleWrapper : public FieldValueTupleWrapperBase {
     string router_mac = string();
     string segment = string();
     string seg_src = string();
+    /* Set instead of nexthop, ifname and weight when the next hops are packed */
+    string nexthop_packed = string();
 };
 
 class LabelRouteTableFieldValueTupleWrapper : public FieldValueTupleWrapperBase {
@@ -242,11 +250,19 @@ public:
         return m_warmStartHelper;
     }
 
+    /* True if routes are sent to orchagent through the shared memory route ring */
+    bool hasRouteRing() const;
+
+    /* Starts a new route ring generation if orchagent reset the ring while routes were idle */
+    void pollRouteRing();
+
 private:
     /* ZMQ client */
     shared_ptr<ZmqClient> m_zmqClient;
     /* regular route table */
     shared_ptr<ProducerStateTable> m_routeTable;
+    /* next hops of regular routes are sent in the packed field */
+    bool m_packedNextHops{false};
     /* label route table */
     shared_ptr<ProducerStateTable> m_label_routeTable;
     /* vnet route table */
@@ -271,6 +287,17 @@ private:
     bool                m_isSuppressionEnabled{false};
     FpmInterface*       m_fpmInterface {nullptr};
 
+    /* 1 of m_latencySampling route updates carry the receive time, 0 disables it */
+    uint32_t            m_latencySampling{0};
+    uint64_t            m_latencyCounter{0};
+    shared_ptr<DBConnector> m_stateDb;
+    unique_ptr<RouteLatencyRecorder> m_routeLatency;
+    /* Receive time of sampled routes waiting for the orchagent response */
+    unordered_map<string, uint64_t> m_pendingLatency;
+
+    /* Stamps 1 of m_latencySampling route updates with the receive time */
+    void sampleRouteLatency(KeyOpFieldsValuesTuple& kfv);
+
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
@@ -339,6 +366,10 @@ private:
     void getNextHopList(struct rtnl_route *route_obj, string& gw_list,
                         string& mpls_list, string& intf_list);
 
+    /* Get packed next hops, false if the route needs the string fields */
+    bool getPackedNextHops(struct rtnl_route *route_obj, string& packed,
+                           string& intf_list);
+
     /* Get next hop gateway IP addresses */
     string getNextHopGw(struct rtnl_route *route_obj);
 
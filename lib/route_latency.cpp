@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <stdlib.h>
+#include <time.h>
+
+#include "logger.h"
+#include "route_latency.h"
+
+using namespace std;
+using namespace swss;
+
+const size_t LatencyHistogram::SUB_BUCKET_BITS;
+const size_t LatencyHistogram::SUB_BUCKETS;
+const size_t LatencyHistogram::BUCKETS;
+
+size_t LatencyHistogram::bucketIndex(uint64_t us)
+{
+    if (us < SUB_BUCKETS)
+    {
+        return static_cast<size_t>(us);
+    }
+
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(us));
+    size_t shift = exponent - SUB_BUCKET_BITS;
+    size_t sub = static_cast<size_t>(us >> shift) & (SUB_BUCKETS - 1);
+
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index + 1;
+    }
+
+    size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t upper = SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS + 1;
+    if (upper << shift >> shift != upper)
+    {
+        return UINT64_MAX;
+    }
+
+    return upper << shift;
+}
+
+void LatencyHistogram::record(uint64_t us)
+{
+    m_buckets[bucketIndex(us)]++;
+    m_count++;
+    m_sum += us;
+    m_max = std::max(m_max, us);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(p / 100 * static_cast<double>(m_count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        seen += m_buckets[i];
+        if (seen > rank || seen == m_count)
+        {
+            return std::min(bucketUpperBound(i), m_max + 1);
+        }
+    }
+
+    return m_max + 1;
+}
+
+vector<FieldValueTuple> LatencyHistogram::fieldValues() const
+{
+    vector<FieldValueTuple> fvs = {
+        { "count", to_string(m_count) },
+        { "sum_us", to_string(m_sum) },
+        { "max_us", to_string(m_max) },
+        { "p50_us", to_string(percentile(50)) },
+        { "p90_us", to_string(percentile(90)) },
+        { "p99_us", to_string(percentile(99)) },
+    };
+
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        if (m_buckets[i])
+        {
+            fvs.emplace_back("lt_" + to_string(bucketUpperBound(i)), to_string(m_buckets[i]));
+        }
+    }
+
+    return fvs;
+}
+
+RouteLatencyRecorder::RouteLatencyRecorder(DBConnector *stateDb) :
+    m_table(stateDb, STATE_ROUTE_LATENCY_TABLE_NAME)
+{
+}
+
+uint64_t RouteLatencyRecorder::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+void RouteLatencyRecorder::record(const string &stage, uint64_t start, uint64_t end)
+{
+    if (end < start)
+    {
+        return;
+    }
+
+    m_histograms[stage].record(end - start);
+    m_updated.insert(stage);
+}
+
+void RouteLatencyRecorder::flush(bool force)
+{
+    if (m_updated.empty())
+    {
+        return;
+    }
+
+    auto ts = now();
+    if (!force && ts - m_lastExport < ROUTE_LATENCY_EXPORT_INTERVAL_US)
+    {
+        return;
+    }
+
+    for (const auto &stage : m_updated)
+    {
+        m_table.set(stage, m_histograms[stage].fieldValues());
+    }
+    m_updated.clear();
+    m_lastExport = ts;
+}
+
+const LatencyHistogram *RouteLatencyRecorder::getHistogram(const string &stage) const
+{
+    auto it = m_histograms.find(stage);
+    return it == m_histograms.end() ? nullptr : &it->second;
+}
+
+uint32_t swss::get_route_latency_sampling()
+{
+    shared_ptr<string> sampling;
+
+    try
+    {
+        DBConnector config_db("CONFIG_DB", 0);
+        sampling = config_db.hget("DEVICE_METADATA|localhost", ROUTE_LATENCY_SAMPLING);
+    }
+    catch (const std::runtime_error &e)
+    {
+        SWSS_LOG_ERROR("Failed to read %s: %s", ROUTE_LATENCY_SAMPLING, e.what());
+        return 0;
+    }
+
+    if (!sampling)
+    {
+        return 0;
+    }
+
+    char *end = nullptr;
+    auto value = strtoul(sampling->c_str(), &end, 10);
+    if (end == sampling->c_str() || *end != '\0' || value > UINT32_MAX)
+    {
+        SWSS_LOG_WARN("Invalid %s: %s", ROUTE_LATENCY_SAMPLING, sampling->c_str());
+        return 0;
+    }
+
+    if (value)
+    {
+        SWSS_LOG_NOTICE("Route latency sampling: 1 of %lu route updates", value);
+    }
+    return static_cast<uint32_t>(value);
+}
@@ -0,0 +1,94 @@
+#ifndef SWSS_ROUTE_LATENCY_H
+#define SWSS_ROUTE_LATENCY_H
+
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "table.h"
+
+/*
+ * DEVICE_METADATA field, fpmsyncd stamps 1 of every N route updates with its
+ * receive time. 0 or absent disables the sampling.
+ */
+#define ROUTE_LATENCY_SAMPLING              "route_latency_sampling"
+
+/* ROUTE_TABLE field carrying the fpmsyncd receive time, in microseconds since the epoch */
+#define ROUTE_LATENCY_TS_FIELD              "fpm_ts_us"
+
+/* STATE_DB table with one histogram per route programming stage */
+#define STATE_ROUTE_LATENCY_TABLE_NAME      "ROUTE_LATENCY_HISTOGRAM"
+
+/* Samples older than this, e.g. replayed from APPL_DB after a restart, are not counted */
+#define ROUTE_LATENCY_MAX_AGE_US            (600ULL * 1000000)
+
+/* Histograms are written to STATE_DB at most once per interval */
+#define ROUTE_LATENCY_EXPORT_INTERVAL_US    (1000000ULL)
+
+namespace swss {
+
+/*
+ * Log-linear histogram of latencies in microseconds: every power of two range
+ * is split into 4 linear buckets, so a bucket is at most 25% wide.
+ */
+class LatencyHistogram
+{
+public:
+    static const size_t SUB_BUCKET_BITS = 2;
+    static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const size_t BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    static size_t bucketIndex(uint64_t us);
+    /* Exclusive upper bound of the bucket, saturated at UINT64_MAX */
+    static uint64_t bucketUpperBound(size_t index);
+
+    void record(uint64_t us);
+
+    uint64_t count() const { return m_count; }
+    uint64_t max() const { return m_max; }
+    /* Upper bound of the bucket holding the given percentile */
+    uint64_t percentile(double p) const;
+
+    /* count, sum_us, max_us, p50_us, p90_us, p99_us and lt_<bound> per non empty bucket */
+    std::vector<FieldValueTuple> fieldValues() const;
+
+private:
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_max = 0;
+};
+
+/* Route programming stage histograms, exported to STATE_DB ROUTE_LATENCY_HISTOGRAM|<stage> */
+class RouteLatencyRecorder
+{
+public:
+    RouteLatencyRecorder(DBConnector *stateDb);
+
+    /* Microseconds since the epoch, comparable between fpmsyncd and orchagent */
+    static uint64_t now();
+
+    /* Ignored if end is before start */
+    void record(const std::string &stage, uint64_t start, uint64_t end);
+
+    /* Writes the histograms updated since the last export, rate limited unless forced */
+    void flush(bool force = false);
+
+    const LatencyHistogram *getHistogram(const std::string &stage) const;
+
+private:
+    Table m_table;
+    std::map<std::string, LatencyHistogram> m_histograms;
+    std::set<std::string> m_updated;
+    uint64_t m_lastExport = 0;
+};
+
+/* Reads ROUTE_LATENCY_SAMPLING from CONFIG_DB, 0 if it is absent or invalid */
+uint32_t get_route_latency_sampling();
+
+}
+
+#endif /* SWSS_ROUTE_LATENCY_H */
@@ -0,0 +1,406 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger.h"
+#include "tokenize.h"
+#include "route_nexthop_codec.h"
+#include "route_latency.h"
+
+#define ROUTE_PACKED_NEXTHOP_VERSION    1
+
+#define ROUTE_PACKED_FLAG_WEIGHT        0x01
+#define ROUTE_PACKED_FLAG_OVERLAY       0x02
+
+#define ROUTE_PACKED_FAMILY_NONE        0
+#define ROUTE_PACKED_FAMILY_V4          4
+#define ROUTE_PACKED_FAMILY_V6          6
+
+#define ROUTE_PACKED_MAC_LEN            6
+
+using namespace std;
+using namespace swss;
+
+/*
+ * The field is stored as base64 of the layout below. The ZMQ producer also
+ * persists it to APPL_DB, where redis-cli, show and Python tooling expect
+ * text.
+ *
+ * Layout, in host byte order as both ends run on the same switch:
+ *   u8 version, u8 flags, u16 count
+ *   count times:
+ *     u8 family, 0/4/16 address bytes, u8 ifname length, ifname
+ *     u32 weight                   if ROUTE_PACKED_FLAG_WEIGHT
+ *     u32 vni, 6 router MAC bytes  if ROUTE_PACKED_FLAG_OVERLAY
+ */
+
+template<typename T>
+static void append(string &out, const T &value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template<typename T>
+static bool extract(const string &in, size_t &pos, T &value)
+{
+    if (in.size() - pos < sizeof(value))
+    {
+        return false;
+    }
+    memcpy(&value, in.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static string base64Encode(const string &in)
+{
+    string out;
+    out.reserve((in.size() + 2) / 3 * 4);
+
+    for (size_t i = 0; i < in.size(); i += 3)
+    {
+        size_t n = min<size_t>(3, in.size() - i);
+        uint32_t bits = static_cast<uint8_t>(in[i]) << 16;
+        if (n > 1)
+            bits |= static_cast<uint8_t>(in[i + 1]) << 8;
+        if (n > 2)
+            bits |= static_cast<uint8_t>(in[i + 2]);
+
+        out.push_back(base64Chars[(bits >> 18) & 0x3f]);
+        out.push_back(base64Chars[(bits >> 12) & 0x3f]);
+        out.push_back(n > 1 ? base64Chars[(bits >> 6) & 0x3f] : '=');
+        out.push_back(n > 2 ? base64Chars[bits & 0x3f] : '=');
+    }
+
+    return out;
+}
+
+static int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+static bool base64Decode(const string &in, string &out)
+{
+    if (in.size() % 4)
+    {
+        return false;
+    }
+
+    out.clear();
+    out.reserve(in.size() / 4 * 3);
+
+    for (size_t i = 0; i < in.size(); i += 4)
+    {
+        /* Padding is only allowed at the end of the last group */
+        bool last = i + 4 == in.size();
+        size_t pad = last ? (in[i + 3] == '=') + (in[i + 2] == '=' && in[i + 3] == '=') : 0;
+
+        uint32_t bits = 0;
+        for (size_t j = 0; j < 4; j++)
+        {
+            int value = j < 4 - pad ? base64Value(in[i + j]) : 0;
+            if (value < 0)
+            {
+                return false;
+            }
+            bits = (bits << 6) | static_cast<uint32_t>(value);
+        }
+
+        out.push_back(static_cast<char>((bits >> 16) & 0xff));
+        if (pad < 2)
+            out.push_back(static_cast<char>((bits >> 8) & 0xff));
+        if (pad < 1)
+            out.push_back(static_cast<char>(bits & 0xff));
+    }
+
+    return true;
+}
+
+static bool parseUint32(const string &str, uint32_t &value)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+
+    char *end = nullptr;
+    errno = 0;
+    auto parsed = strtoul(str.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed > UINT32_MAX)
+    {
+        return false;
+    }
+
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+RouteNextHopPacker::RouteNextHopPacker(bool weights, bool overlay)
+{
+    /* Weights are ignored for overlay next hops, like in the string form */
+    if (overlay)
+        m_flags |= ROUTE_PACKED_FLAG_OVERLAY;
+    else if (weights)
+        m_flags |= ROUTE_PACKED_FLAG_WEIGHT;
+}
+
+bool RouteNextHopPacker::add(const ip_addr_t *ip, const char *ifname, size_t ifname_len,
+                             uint32_t weight, uint32_t vni, const uint8_t *router_mac)
+{
+    if (m_count >= UINT16_MAX || ifname_len > UINT8_MAX)
+    {
+        return false;
+    }
+
+    if (!ip)
+    {
+        append(m_nexthops, static_cast<uint8_t>(ROUTE_PACKED_FAMILY_NONE));
+    }
+    else if (ip->family == AF_INET)
+    {
+        append(m_nexthops, static_cast<uint8_t>(ROUTE_PACKED_FAMILY_V4));
+        append(m_nexthops, ip->ip_addr.ipv4_addr);
+    }
+    else if (ip->family == AF_INET6)
+    {
+        append(m_nexthops, static_cast<uint8_t>(ROUTE_PACKED_FAMILY_V6));
+        append(m_nexthops, ip->ip_addr.ipv6_addr);
+    }
+    else
+    {
+        return false;
+    }
+
+    append(m_nexthops, static_cast<uint8_t>(ifname_len));
+    m_nexthops.append(ifname, ifname_len);
+
+    if (m_flags & ROUTE_PACKED_FLAG_WEIGHT)
+    {
+        append(m_nexthops, weight);
+    }
+
+    if (m_flags & ROUTE_PACKED_FLAG_OVERLAY)
+    {
+        if (!router_mac)
+        {
+            return false;
+        }
+        append(m_nexthops, vni);
+        m_nexthops.append(reinterpret_cast<const char *>(router_mac), ROUTE_PACKED_MAC_LEN);
+    }
+
+    m_count++;
+    return true;
+}
+
+string RouteNextHopPacker::encode() const
+{
+    string packed;
+    packed.reserve(4 + m_nexthops.size());
+    append(packed, static_cast<uint8_t>(ROUTE_PACKED_NEXTHOP_VERSION));
+    append(packed, m_flags);
+    append(packed, static_cast<uint16_t>(m_count));
+    packed.append(m_nexthops);
+
+    return base64Encode(packed);
+}
+
+bool swss::packRouteNextHops(vector<FieldValueTuple> &fvs)
+{
+    string nexthops, ifnames, weights, vni_labels, router_macs;
+
+    for (const auto &fv : fvs)
+    {
+        const auto &field = fvField(fv);
+        const auto &value = fvValue(fv);
+
+        if (field == "nexthop")
+            nexthops = value;
+        else if (field == "ifname")
+            ifnames = value;
+        else if (field == "weight")
+            weights = value;
+        else if (field == "vni_label")
+            vni_labels = value;
+        else if (field == "router_mac")
+            router_macs = value;
+        else if (field == "blackhole")
+        {
+            if (value == "true")
+                return false;
+        }
+        else if (field != "protocol" && field != ROUTE_LATENCY_TS_FIELD && !value.empty())
+        {
+            /* MPLS, SRv6 and next hop group routes keep the string form */
+            return false;
+        }
+    }
+
+    auto alsv = tokenize(ifnames, ',');
+    auto ipv = tokenize(nexthops, ',');
+    auto wtv = tokenize(weights, ',');
+    auto vniv = tokenize(vni_labels, ',');
+    auto rmacv = tokenize(router_macs, ',');
+
+    bool overlay = !vni_labels.empty();
+    if (alsv.empty() ||
+        (overlay && (ipv.size() != alsv.size() || vniv.size() != ipv.size() || rmacv.size() != ipv.size())))
+    {
+        /* Let RouteOrch report the route as it does today */
+        return false;
+    }
+
+    RouteNextHopPacker packer(!wtv.empty() && wtv.size() == alsv.size(), overlay);
+
+    try
+    {
+        for (size_t i = 0; i < alsv.size(); i++)
+        {
+            ip_addr_t ip;
+            bool has_ip = i < ipv.size() && !ipv[i].empty();
+            if (has_ip)
+            {
+                ip = IpAddress(ipv[i]).getIp();
+            }
+
+            uint32_t weight = 0;
+            if (!overlay && wtv.size() == alsv.size() && !parseUint32(wtv[i], weight))
+            {
+                return false;
+            }
+
+            uint32_t vni = 0;
+            MacAddress router_mac;
+            if (overlay)
+            {
+                if (!parseUint32(vniv[i], vni))
+                {
+                    return false;
+                }
+                router_mac = MacAddress(rmacv[i]);
+            }
+
+            if (!packer.add(has_ip ? &ip : nullptr, alsv[i].data(), alsv[i].size(), weight, vni, router_mac.getMac()))
+            {
+                return false;
+            }
+        }
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_INFO("Keep string next hops for %s@%s: %s", nexthops.c_str(), ifnames.c_str(), e.what());
+        return false;
+    }
+
+    vector<FieldValueTuple> out;
+    out.reserve(fvs.size());
+    for (auto &fv : fvs)
+    {
+        const auto &field = fvField(fv);
+        if (field != "nexthop" && field != "ifname" && field != "weight" &&
+            field != "vni_label" && field != "router_mac")
+        {
+            out.emplace_back(std::move(fv));
+        }
+    }
+    out.emplace_back(ROUTE_PACKED_NEXTHOP_FIELD, packer.encode());
+    fvs.swap(out);
+
+    return true;
+}
+
+bool swss::unpackRouteNextHops(const string &encoded, bool v4,
+                               vector<PackedRouteNextHop> &nexthops, bool &overlay)
+{
+    string packed;
+    if (!base64Decode(encoded, packed))
+    {
+        return false;
+    }
+
+    size_t pos = 0;
+    uint8_t version, flags;
+    uint16_t count;
+
+    if (!extract(packed, pos, version) || version != ROUTE_PACKED_NEXTHOP_VERSION ||
+        !extract(packed, pos, flags) || !extract(packed, pos, count))
+    {
+        return false;
+    }
+
+    overlay = (flags & ROUTE_PACKED_FLAG_OVERLAY) != 0;
+    nexthops.clear();
+    nexthops.resize(count);
+
+    for (auto &nh : nexthops)
+    {
+        uint8_t family, len;
+        ip_addr_t ip;
+        memset(&ip, 0, sizeof(ip));
+
+        if (!extract(packed, pos, family))
+        {
+            return false;
+        }
+
+        if (family == ROUTE_PACKED_FAMILY_V4)
+        {
+            ip.family = AF_INET;
+            if (!extract(packed, pos, ip.ip_addr.ipv4_addr))
+                return false;
+        }
+        else if (family == ROUTE_PACKED_FAMILY_V6)
+        {
+            ip.family = AF_INET6;
+            if (!extract(packed, pos, ip.ip_addr.ipv6_addr))
+                return false;
+        }
+        else if (family == ROUTE_PACKED_FAMILY_NONE)
+        {
+            ip.family = v4 ? AF_INET : AF_INET6;
+        }
+        else
+        {
+            return false;
+        }
+        nh.ip_address = IpAddress(ip);
+
+        if (!extract(packed, pos, len) || packed.size() - pos < len)
+        {
+            return false;
+        }
+        nh.ifname.assign(packed, pos, len);
+        pos += len;
+
+        if ((flags & ROUTE_PACKED_FLAG_WEIGHT) && !extract(packed, pos, nh.weight))
+        {
+            return false;
+        }
+
+        if (flags & ROUTE_PACKED_FLAG_OVERLAY)
+        {
+            uint8_t mac[ROUTE_PACKED_MAC_LEN];
+            if (!extract(packed, pos, nh.vni) || !extract(packed, pos, mac))
+            {
+                return false;
+            }
+            nh.router_mac = MacAddress(mac);
+        }
+    }
+
+    return pos == packed.size();
+}
@@ -0,0 +1,80 @@
+#ifndef SWSS_ROUTE_NEXTHOP_CODEC_H
+#define SWSS_ROUTE_NEXTHOP_CODEC_H
+
+#include <string>
+#include <vector>
+
+#include "ipaddress.h"
+#include "macaddress.h"
+#include "table.h"
+
+/*
+ * Feature flag to let fpmsyncd send the next hops of ROUTE_TABLE entries in the
+ * packed binary field when routes go to orchagent via the ZMQ channel.
+ */
+#define ORCH_NORTHBOND_ROUTE_ZMQ_PACKED_ENABLED "orch_northbond_route_zmq_packed_enabled"
+
+/*
+ * Replaces the nexthop, ifname, weight, vni_label and router_mac fields, the
+ * value is base64 so that the copy kept in APPL_DB is still text
+ */
+#define ROUTE_PACKED_NEXTHOP_FIELD              "nexthop_packed"
+
+namespace swss {
+
+struct PackedRouteNextHop
+{
+    IpAddress ip_address;
+    std::string ifname;
+    uint32_t weight = 0;
+    uint32_t vni = 0;
+    MacAddress router_mac;
+};
+
+/*
+ * Builds the packed field one next hop at a time, so fpmsyncd can fill it
+ * straight from the netlink next hops instead of the comma separated strings.
+ */
+class RouteNextHopPacker
+{
+public:
+    /* weights and overlay apply to every next hop */
+    RouteNextHopPacker(bool weights, bool overlay = false);
+
+    /*
+     * ip is null for a next hop without an address, router_mac is only read
+     * for overlay next hops. False if the next hop can not be packed.
+     */
+    bool add(const ip_addr_t *ip, const char *ifname, size_t ifname_len,
+             uint32_t weight = 0, uint32_t vni = 0, const uint8_t *router_mac = nullptr);
+
+    size_t size() const { return m_count; }
+
+    /* Value of the packed field */
+    std::string encode() const;
+
+private:
+    uint8_t m_flags = 0;
+    size_t m_count = 0;
+    std::string m_nexthops;
+};
+
+/*
+ * Moves the comma separated next hop fields of a ROUTE_TABLE entry into the
+ * packed field. Entries with MPLS, SRv6 or next hop group fields, and entries
+ * that RouteOrch would reject, are left in the string form and false is
+ * returned.
+ */
+bool packRouteNextHops(std::vector<FieldValueTuple> &fvs);
+
+/*
+ * Decodes the packed field, next hops without an address get the zero address
+ * of the route family. overlay is set if the next hops carry a VNI and router
+ * MAC.
+ */
+bool unpackRouteNextHops(const std::string &packed, bool v4,
+                         std::vector<PackedRouteNextHop> &nexthops, bool &overlay);
+
+}
+
+#endif /* SWSS_ROUTE_NEXTHOP_CODEC_H */
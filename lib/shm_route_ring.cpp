@@ -0,0 +1,962 @@
+#include <arpa/inet.h>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logger.h"
+#include "shm_route_ring.h"
+
+#define SHM_ROUTE_RING_MAGIC        0x52524853  // "SHRR"
+#define SHM_ROUTE_RING_VERSION      1
+#define SHM_ROUTE_RING_DIR          "/dev/shm"
+
+/* Interned field sets kept before the producer starts over with a reset record */
+#define SHM_ROUTE_MAX_INTERNED      (256 * 1024)
+
+/* Time the producer waits for space before it writes routes to Redis instead */
+#define SHM_ROUTE_PUSH_TIMEOUT_MS   5000
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory ring needs lock free 64 bit atomics");
+
+namespace swss {
+
+struct ShmRouteRingHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    std::atomic<uint64_t> generation;
+    /* Written by the producer only */
+    alignas(64) std::atomic<uint64_t> head;
+    /* Generation the producer wants the consumer to reset */
+    std::atomic<uint64_t> resetRequest;
+    /* Written by the consumer only */
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+}
+
+using namespace std;
+using namespace swss;
+
+namespace
+{
+    enum : uint8_t
+    {
+        RECORD_RESET = 1,
+        RECORD_VRF,
+        RECORD_FIELDS,
+        RECORD_SET,
+        RECORD_DEL,
+        RECORD_SET_KEY,
+        RECORD_DEL_KEY,
+        RECORD_SYNC,
+    };
+
+    /* Family byte flag of a host route key written without the prefix length */
+    const uint8_t FAMILY_HOST = 0x80;
+
+    /*
+     * Records are tagged with the generation they were encoded for, so the
+     * consumer skips records a producer wrote while it was resetting the ring
+     */
+    struct RecordHeader
+    {
+        uint32_t len;
+        uint32_t generation;
+    };
+
+    size_t dataOffset()
+    {
+        return (sizeof(ShmRouteRingHeader) + 63) & ~static_cast<size_t>(63);
+    }
+
+    uint64_t recordSize(uint64_t len)
+    {
+        return (sizeof(RecordHeader) + len + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    string fifoPath(const string &name)
+    {
+        return SHM_ROUTE_RING_DIR + name + ".fifo";
+    }
+
+    template<typename T>
+    void put(string &record, T value)
+    {
+        record.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void putString(string &record, const string &value)
+    {
+        put(record, static_cast<uint32_t>(value.size()));
+        record.append(value);
+    }
+
+    template<typename T>
+    bool get(const string &record, size_t &pos, T &value)
+    {
+        if (record.size() - pos < sizeof(value))
+        {
+            return false;
+        }
+        memcpy(&value, record.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    }
+
+    bool getString(const string &record, size_t &pos, string &value)
+    {
+        uint32_t len;
+        if (!get(record, pos, len) || record.size() - pos < len)
+        {
+            return false;
+        }
+        value.assign(record, pos, len);
+        pos += len;
+        return true;
+    }
+
+    bool parsePrefix(const string &str, uint8_t &family, uint8_t &len, unsigned char *addr)
+    {
+        auto slash = str.find('/');
+        string ip = str.substr(0, slash);
+
+        if (inet_pton(AF_INET, ip.c_str(), addr) == 1)
+        {
+            family = 4;
+        }
+        else if (inet_pton(AF_INET6, ip.c_str(), addr) == 1)
+        {
+            family = 6;
+        }
+        else
+        {
+            return false;
+        }
+
+        unsigned long max_len = family == 4 ? 32 : 128;
+        if (slash == string::npos)
+        {
+            len = static_cast<uint8_t>(max_len);
+            family = static_cast<uint8_t>(family | FAMILY_HOST);
+            return true;
+        }
+
+        char *end = nullptr;
+        unsigned long value = strtoul(str.c_str() + slash + 1, &end, 10);
+        if (slash + 1 == str.size() || *end != '\0' || value > max_len)
+        {
+            return false;
+        }
+        len = static_cast<uint8_t>(value);
+        return true;
+    }
+
+    string formatKey(const string &vrf, uint8_t family, uint8_t len, const unsigned char *addr)
+    {
+        char buf[INET6_ADDRSTRLEN];
+        inet_ntop((family & ~FAMILY_HOST) == 4 ? AF_INET : AF_INET6, addr, buf, sizeof(buf));
+
+        string key = vrf.empty() ? string() : vrf + ":";
+        key += buf;
+        if (!(family & FAMILY_HOST))
+        {
+            key += "/" + to_string(len);
+        }
+        return key;
+    }
+
+    /* Only keys the consumer rebuilds to the very same string are sent as binary */
+    bool parseKey(const string &key, string &vrf, uint8_t &family, uint8_t &len, unsigned char *addr)
+    {
+        vrf.clear();
+        if (!parsePrefix(key, family, len, addr))
+        {
+            auto pos = key.find(':');
+            if (pos == string::npos || pos == 0)
+            {
+                return false;
+            }
+            vrf = key.substr(0, pos);
+            if (!parsePrefix(key.substr(pos + 1), family, len, addr))
+            {
+                return false;
+            }
+        }
+
+        return formatKey(vrf, family, len, addr) == key;
+    }
+}
+
+ShmRouteRing::ShmRouteRing(const string &name, bool consumer) :
+    m_name(name),
+    m_consumer(consumer),
+    m_pushTimeoutMs(SHM_ROUTE_PUSH_TIMEOUT_MS)
+{
+}
+
+ShmRouteRing::~ShmRouteRing()
+{
+    if (m_header)
+    {
+        munmap(m_header, m_mapSize);
+    }
+    if (m_shmFd >= 0)
+    {
+        close(m_shmFd);
+    }
+    if (m_fifoFd >= 0)
+    {
+        close(m_fifoFd);
+    }
+}
+
+shared_ptr<ShmRouteRing> ShmRouteRing::create(const string &name, size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    if (size == 0 || (size & (size - 1)))
+    {
+        SWSS_LOG_THROW("Route ring size %zu is not a power of two", size);
+    }
+
+    shared_ptr<ShmRouteRing> ring(new ShmRouteRing(name, true));
+
+    ring->m_shmFd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+    if (ring->m_shmFd < 0)
+    {
+        SWSS_LOG_THROW("Failed to open route ring %s: %s", name.c_str(), strerror(errno));
+    }
+
+    ring->m_mapSize = dataOffset() + size;
+    if (ftruncate(ring->m_shmFd, static_cast<off_t>(ring->m_mapSize)) < 0)
+    {
+        SWSS_LOG_THROW("Failed to size route ring %s: %s", name.c_str(), strerror(errno));
+    }
+
+    void *addr = mmap(nullptr, ring->m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, ring->m_shmFd, 0);
+    if (addr == MAP_FAILED)
+    {
+        SWSS_LOG_THROW("Failed to map route ring %s: %s", name.c_str(), strerror(errno));
+    }
+    ring->m_header = static_cast<ShmRouteRingHeader *>(addr);
+    ring->m_data = static_cast<char *>(addr) + dataOffset();
+
+    /*
+     * Records left by a previous consumer refer to interned ids it has lost,
+     * ShmRouteConsumerStateTable loads the routes they carried from APPL_DB
+     */
+    auto header = ring->m_header;
+    if (header->magic != SHM_ROUTE_RING_MAGIC)
+    {
+        header->generation.store(0);
+    }
+    header->capacity = size;
+    header->resetRequest.store(0);
+    ring->reset();
+    header->version = SHM_ROUTE_RING_VERSION;
+    header->magic = SHM_ROUTE_RING_MAGIC;
+    uint64_t generation = header->generation.load();
+
+    string fifo = fifoPath(name);
+    if (mkfifo(fifo.c_str(), 0666) < 0 && errno != EEXIST)
+    {
+        SWSS_LOG_THROW("Failed to create route ring doorbell %s: %s", fifo.c_str(), strerror(errno));
+    }
+
+    /* Keeping a write end open ourselves, the FIFO never reports end of file */
+    ring->m_fifoFd = open(fifo.c_str(), O_RDWR | O_NONBLOCK);
+    if (ring->m_fifoFd < 0)
+    {
+        SWSS_LOG_THROW("Failed to open route ring doorbell %s: %s", fifo.c_str(), strerror(errno));
+    }
+
+    SWSS_LOG_NOTICE("Created route ring %s, %zu bytes, generation %" PRIu64, name.c_str(), size, generation);
+
+    return ring;
+}
+
+shared_ptr<ShmRouteRing> ShmRouteRing::attach(const string &name)
+{
+    SWSS_LOG_ENTER();
+
+    shared_ptr<ShmRouteRing> ring(new ShmRouteRing(name, false));
+
+    ring->m_shmFd = shm_open(name.c_str(), O_RDWR, 0);
+    if (ring->m_shmFd < 0)
+    {
+        SWSS_LOG_WARN("Route ring %s is not available: %s", name.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(ring->m_shmFd, &st) < 0 || static_cast<size_t>(st.st_size) <= dataOffset())
+    {
+        SWSS_LOG_WARN("Route ring %s is not initialized", name.c_str());
+        return nullptr;
+    }
+
+    ring->m_mapSize = static_cast<size_t>(st.st_size);
+    void *addr = mmap(nullptr, ring->m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, ring->m_shmFd, 0);
+    if (addr == MAP_FAILED)
+    {
+        SWSS_LOG_WARN("Failed to map route ring %s: %s", name.c_str(), strerror(errno));
+        return nullptr;
+    }
+    ring->m_header = static_cast<ShmRouteRingHeader *>(addr);
+    ring->m_data = static_cast<char *>(addr) + dataOffset();
+
+    if (ring->m_header->magic != SHM_ROUTE_RING_MAGIC || ring->m_header->version != SHM_ROUTE_RING_VERSION
+            || dataOffset() + ring->m_header->capacity != ring->m_mapSize)
+    {
+        SWSS_LOG_WARN("Route ring %s has an unknown layout", name.c_str());
+        return nullptr;
+    }
+
+    string fifo = fifoPath(name);
+    ring->m_fifoFd = open(fifo.c_str(), O_WRONLY | O_NONBLOCK);
+    if (ring->m_fifoFd < 0)
+    {
+        SWSS_LOG_WARN("Route ring doorbell %s is not available: %s", fifo.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    SWSS_LOG_NOTICE("Attached to route ring %s", name.c_str());
+
+    return ring;
+}
+
+void ShmRouteRing::write(uint64_t pos, const void *data, size_t len)
+{
+    size_t offset = static_cast<size_t>(pos & (m_header->capacity - 1));
+    size_t first = min(len, static_cast<size_t>(m_header->capacity) - offset);
+
+    memcpy(m_data + offset, data, first);
+    memcpy(m_data, static_cast<const char *>(data) + first, len - first);
+}
+
+void ShmRouteRing::read(uint64_t pos, void *data, size_t len) const
+{
+    size_t offset = static_cast<size_t>(pos & (m_header->capacity - 1));
+    size_t first = min(len, static_cast<size_t>(m_header->capacity) - offset);
+
+    memcpy(data, m_data + offset, first);
+    memcpy(static_cast<char *>(data) + first, m_data, len - first);
+}
+
+ShmRouteRing::PushResult ShmRouteRing::push(const string &record, uint64_t generation)
+{
+    uint64_t need = recordSize(record.size());
+    if (m_consumer || need > m_header->capacity)
+    {
+        SWSS_LOG_ERROR("Route ring record of %zu bytes can not be written", record.size());
+        return PUSH_TOO_LARGE;
+    }
+
+    if (m_header->generation.load() != generation)
+    {
+        return PUSH_RESET;
+    }
+
+    uint64_t head = m_header->head.load(memory_order_relaxed);
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(m_pushTimeoutMs);
+    bool waited = false;
+    while (m_header->capacity - (head - m_header->tail.load(memory_order_acquire)) < need)
+    {
+        /* A reset empties the ring, the head read above is not valid anymore */
+        if (m_header->generation.load() != generation)
+        {
+            return PUSH_RESET;
+        }
+
+        if (chrono::steady_clock::now() >= deadline)
+        {
+            SWSS_LOG_WARN("Route ring %s stayed full for %u ms", m_name.c_str(), m_pushTimeoutMs);
+            return PUSH_TIMEOUT;
+        }
+
+        if (!waited)
+        {
+            SWSS_LOG_NOTICE("Route ring %s is full, waiting for the consumer", m_name.c_str());
+            waited = true;
+        }
+        usleep(100);
+    }
+
+    RecordHeader hdr = { static_cast<uint32_t>(record.size()), static_cast<uint32_t>(generation) };
+    write(head, &hdr, sizeof(hdr));
+    write(head + sizeof(hdr), record.data(), record.size());
+
+    /*
+     * The consumer only moves the head when it resets the ring. If it did so
+     * while the record was written, the head is left alone, and a record that
+     * made it into the new ring anyway is skipped by its generation tag.
+     */
+    if (!m_header->head.compare_exchange_strong(head, head + need) ||
+        m_header->generation.load() != generation)
+    {
+        return PUSH_RESET;
+    }
+
+    /*
+     * Ring the doorbell only if the consumer had drained the ring, it checks
+     * the head again after moving the tail, so one of the two sees the other.
+     */
+    if (m_header->tail.load() == head)
+    {
+        char bell = 0;
+        if (::write(m_fifoFd, &bell, 1) < 0 && errno != EAGAIN)
+        {
+            SWSS_LOG_WARN("Failed to ring route ring doorbell: %s", strerror(errno));
+        }
+    }
+
+    return PUSH_OK;
+}
+
+bool ShmRouteRing::pop(string &record)
+{
+    auto generation = static_cast<uint32_t>(m_header->generation.load());
+
+    while (true)
+    {
+        uint64_t tail = m_header->tail.load(memory_order_relaxed);
+        uint64_t used = m_header->head.load(memory_order_acquire) - tail;
+        if (used == 0)
+        {
+            return false;
+        }
+
+        RecordHeader hdr;
+        if (used > m_header->capacity || used < sizeof(hdr))
+        {
+            SWSS_LOG_ERROR("Route ring %s has %" PRIu64 " bytes pending, resetting it", m_name.c_str(), used);
+            reset();
+            return false;
+        }
+
+        read(tail, &hdr, sizeof(hdr));
+        if (recordSize(hdr.len) > used)
+        {
+            SWSS_LOG_ERROR("Route ring %s has a record of %u bytes with %" PRIu64 " bytes pending, resetting it",
+                           m_name.c_str(), hdr.len, used);
+            reset();
+            return false;
+        }
+
+        record.resize(hdr.len);
+        read(tail + sizeof(hdr), &record[0], hdr.len);
+        m_header->tail.store(tail + recordSize(hdr.len));
+
+        if (hdr.generation == generation)
+        {
+            return true;
+        }
+    }
+}
+
+bool ShmRouteRing::empty() const
+{
+    return m_header->head.load() == m_header->tail.load();
+}
+
+uint64_t ShmRouteRing::generation() const
+{
+    return m_header->generation.load();
+}
+
+void ShmRouteRing::reset()
+{
+    /* The generation moves first, so a producer storing its head meanwhile notices */
+    m_header->generation.fetch_add(1);
+    m_header->head.store(0);
+    m_header->tail.store(0);
+}
+
+void ShmRouteRing::requestReset(uint64_t generation)
+{
+    m_header->resetRequest.store(generation);
+}
+
+bool ShmRouteRing::resetRequested() const
+{
+    return m_header->resetRequest.load() == m_header->generation.load();
+}
+
+void ShmRouteRing::clearDoorbell()
+{
+    char buf[256];
+    while (::read(m_fifoFd, buf, sizeof(buf)) > 0)
+    {
+    }
+}
+
+ShmRouteProducerStateTable::ShmRouteProducerStateTable(RedisPipeline *pipeline, const string &tableName, shared_ptr<ShmRouteRing> ring) :
+    ProducerStateTable(pipeline, tableName, true),
+    m_pipeline(pipeline),
+    m_ring(ring),
+    m_table(pipeline, tableName, true),
+    m_generation(ring->generation())
+{
+}
+
+bool ShmRouteProducerStateTable::sync()
+{
+    uint64_t generation = m_ring->generation();
+    if (generation != m_generation)
+    {
+        /* The consumer reloads APPL_DB after a reset, so the ring can be used again */
+        SWSS_LOG_NOTICE("Route ring was reset, interning again");
+        m_generation = generation;
+        m_resync = true;
+        m_redisFallback = false;
+        m_vrfIds.clear();
+        m_fieldIds.clear();
+    }
+    else if (m_redisFallback)
+    {
+        return false;
+    }
+
+    if (m_resync)
+    {
+        /*
+         * The consumer loads APPL_DB when the sync record arrives, the routes
+         * of the records it dropped, or written to Redis, must be there by then
+         */
+        m_pipeline->flush();
+        m_record.clear();
+        put(m_record, RECORD_SYNC);
+        auto result = m_ring->push(m_record, m_generation);
+        if (result == ShmRouteRing::PUSH_TIMEOUT)
+        {
+            startRedisFallback();
+            return false;
+        }
+
+        /* After PUSH_RESET the next push fails as well and sync() starts over */
+        m_resync = result != ShmRouteRing::PUSH_OK;
+    }
+    else if (m_fieldIds.size() >= SHM_ROUTE_MAX_INTERNED)
+    {
+        m_record.clear();
+        put(m_record, RECORD_RESET);
+        if (m_ring->push(m_record, m_generation) == ShmRouteRing::PUSH_TIMEOUT)
+        {
+            startRedisFallback();
+            return false;
+        }
+        m_vrfIds.clear();
+        m_fieldIds.clear();
+    }
+
+    return true;
+}
+
+void ShmRouteProducerStateTable::startRedisFallback()
+{
+    /*
+     * Records left in the ring must not be applied after the routes written
+     * to Redis, the consumer drops them and reloads APPL_DB instead
+     */
+    SWSS_LOG_WARN("Route ring is stuck, writing routes to Redis until it is reset");
+    m_ring->requestReset(m_generation);
+    m_redisFallback = true;
+}
+
+bool ShmRouteProducerStateTable::pushRoute(const string &key, const vector<FieldValueTuple> *values)
+{
+    while (sync())
+    {
+        auto result = writeRoute(key, values);
+        if (result == ShmRouteRing::PUSH_OK)
+        {
+            return true;
+        }
+
+        if (result == ShmRouteRing::PUSH_TIMEOUT)
+        {
+            startRedisFallback();
+            return false;
+        }
+
+        if (result == ShmRouteRing::PUSH_TOO_LARGE)
+        {
+            return false;
+        }
+
+        /* PUSH_RESET, sync() starts over in the new generation */
+    }
+
+    return false;
+}
+
+ShmRouteRing::PushResult ShmRouteProducerStateTable::writeRoute(const string &key, const vector<FieldValueTuple> *values)
+{
+    uint32_t fields = 0;
+    if (values)
+    {
+        auto result = internFields(*values, fields);
+        if (result != ShmRouteRing::PUSH_OK)
+        {
+            return result;
+        }
+    }
+
+    m_record.clear();
+    if (values)
+    {
+        put(m_record, fields);
+    }
+
+    auto result = values ? encodeKey(m_record, key, RECORD_SET, RECORD_SET_KEY)
+                         : encodeKey(m_record, key, RECORD_DEL, RECORD_DEL_KEY);
+    if (result != ShmRouteRing::PUSH_OK)
+    {
+        return result;
+    }
+
+    return m_ring->push(m_record, m_generation);
+}
+
+ShmRouteRing::PushResult ShmRouteProducerStateTable::internVrf(const string &vrf, uint32_t &id)
+{
+    if (vrf.empty())
+    {
+        id = 0;
+        return ShmRouteRing::PUSH_OK;
+    }
+
+    auto it = m_vrfIds.find(vrf);
+    if (it != m_vrfIds.end())
+    {
+        id = it->second;
+        return ShmRouteRing::PUSH_OK;
+    }
+
+    id = static_cast<uint32_t>(m_vrfIds.size() + 1);
+    string record;
+    put(record, RECORD_VRF);
+    put(record, id);
+    record.append(vrf);
+
+    /* Only ids the consumer has received are kept */
+    auto result = m_ring->push(record, m_generation);
+    if (result == ShmRouteRing::PUSH_OK)
+    {
+        m_vrfIds.emplace(vrf, id);
+    }
+
+    return result;
+}
+
+ShmRouteRing::PushResult ShmRouteProducerStateTable::internFields(const vector<FieldValueTuple> &values, uint32_t &id)
+{
+    string fields;
+    put(fields, static_cast<uint32_t>(values.size()));
+    for (const auto &fv : values)
+    {
+        putString(fields, fvField(fv));
+        putString(fields, fvValue(fv));
+    }
+
+    auto it = m_fieldIds.find(fields);
+    if (it != m_fieldIds.end())
+    {
+        id = it->second;
+        return ShmRouteRing::PUSH_OK;
+    }
+
+    id = static_cast<uint32_t>(m_fieldIds.size() + 1);
+    string record;
+    put(record, RECORD_FIELDS);
+    put(record, id);
+    record.append(fields);
+
+    auto result = m_ring->push(record, m_generation);
+    if (result == ShmRouteRing::PUSH_OK)
+    {
+        m_fieldIds.emplace(std::move(fields), id);
+    }
+
+    return result;
+}
+
+ShmRouteRing::PushResult ShmRouteProducerStateTable::encodeKey(string &record, const string &key, uint8_t type, uint8_t raw_type)
+{
+    string vrf;
+    uint8_t family, len;
+    unsigned char addr[16] = {};
+
+    if (!parseKey(key, vrf, family, len, addr))
+    {
+        record.insert(0, 1, static_cast<char>(raw_type));
+        record.append(key);
+        return ShmRouteRing::PUSH_OK;
+    }
+
+    uint32_t vrf_id;
+    auto result = internVrf(vrf, vrf_id);
+    if (result != ShmRouteRing::PUSH_OK)
+    {
+        return result;
+    }
+
+    record.insert(0, 1, static_cast<char>(type));
+    put(record, vrf_id);
+    put(record, family);
+    put(record, len);
+    record.append(reinterpret_cast<const char *>(addr), (family & ~FAMILY_HOST) == 4 ? 4 : 16);
+
+    return ShmRouteRing::PUSH_OK;
+}
+
+void ShmRouteProducerStateTable::set(const string &key, const vector<FieldValueTuple> &values,
+                                     const string &op, const string &prefix)
+{
+    if (op == DEL_COMMAND)
+    {
+        del(key);
+        return;
+    }
+
+    if (!pushRoute(key, &values))
+    {
+        ProducerStateTable::set(key, values, op, prefix);
+        return;
+    }
+
+    /* Replace, not merge, the APPL_DB entry as the Redis path does */
+    m_table.del(key);
+    m_table.set(key, values);
+}
+
+void ShmRouteProducerStateTable::del(const string &key, const string &op, const string &prefix)
+{
+    if (!pushRoute(key, nullptr))
+    {
+        ProducerStateTable::del(key, op, prefix);
+        return;
+    }
+
+    m_table.del(key);
+}
+
+void ShmRouteProducerStateTable::set(const vector<KeyOpFieldsValuesTuple> &values)
+{
+    for (const auto &kfv : values)
+    {
+        if (kfvOp(kfv) == DEL_COMMAND)
+        {
+            del(kfvKey(kfv));
+        }
+        else
+        {
+            set(kfvKey(kfv), kfvFieldsValues(kfv));
+        }
+    }
+}
+
+void ShmRouteProducerStateTable::del(const vector<string> &keys)
+{
+    for (const auto &key : keys)
+    {
+        del(key);
+    }
+}
+
+ShmRouteConsumerStateTable::ShmRouteConsumerStateTable(DBConnector *db, const string &tableName,
+                                                       shared_ptr<ShmRouteRing> ring, int popBatchSize, int pri,
+                                                       bool reload) :
+    Selectable(pri),
+    TableBase(tableName, SonicDBConfig::getSeparator(db)),
+    m_db(db),
+    m_ring(ring),
+    m_reload(reload),
+    m_generation(ring->generation()),
+    m_popBatchSize(popBatchSize > 0 ? static_cast<size_t>(popBatchSize) : 1)
+{
+}
+
+uint64_t ShmRouteConsumerStateTable::readData()
+{
+    m_ring->clearDoorbell();
+    return 0;
+}
+
+void ShmRouteConsumerStateTable::reload(deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    SWSS_LOG_ENTER();
+
+    m_reload = false;
+    m_reloaded = true;
+    m_generation = m_ring->generation();
+
+    /*
+     * The producer flushed its APPL_DB writes before the sync record and
+     * writes a route to APPL_DB after pushing its record, so the records
+     * still in the ring are at least as new as what is read here
+     */
+    Table table(m_db, getTableName());
+    vector<string> keys;
+    table.getKeys(keys);
+    size_t loaded = 0;
+    for (const auto &key : keys)
+    {
+        vector<FieldValueTuple> values;
+        if (table.get(key, values))
+        {
+            vkco.emplace_back(key, SET_COMMAND, std::move(values));
+            loaded++;
+        }
+    }
+    m_reloadedRoutes += loaded;
+
+    SWSS_LOG_NOTICE("Loaded %zu routes of %s from APPL_DB for route ring generation %" PRIu64,
+                    loaded, getTableName().c_str(), m_generation);
+}
+
+void ShmRouteConsumerStateTable::pops(deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    SWSS_LOG_ENTER();
+
+    vkco.clear();
+    m_reloaded = false;
+    m_reloadedRoutes = 0;
+
+    while (vkco.size() - m_reloadedRoutes < m_popBatchSize)
+    {
+        /* The producer went to Redis, what is left in the ring is older than that */
+        if (m_ring->resetRequested())
+        {
+            SWSS_LOG_NOTICE("Route ring %s reset on producer request", getTableName().c_str());
+            m_ring->reset();
+            break;
+        }
+
+        if (!m_ring->pop(m_record))
+        {
+            break;
+        }
+
+        if (!decode(m_record, vkco))
+        {
+            SWSS_LOG_ERROR("Dropping invalid route ring record of %zu bytes", m_record.size());
+        }
+    }
+}
+
+bool ShmRouteConsumerStateTable::decode(const string &record, deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    size_t pos = 0;
+    uint8_t type;
+    uint32_t id = 0;
+
+    if (!get(record, pos, type))
+    {
+        return false;
+    }
+
+    switch (type)
+    {
+        case RECORD_RESET:
+            m_vrfs.clear();
+            m_fields.clear();
+            return true;
+
+        case RECORD_SYNC:
+            m_vrfs.clear();
+            m_fields.clear();
+            if (needsReload())
+            {
+                reload(vkco);
+            }
+            return true;
+
+        case RECORD_VRF:
+            if (!get(record, pos, id) || id != m_vrfs.size() + 1)
+            {
+                return false;
+            }
+            m_vrfs.emplace_back(record, pos);
+            return true;
+
+        case RECORD_FIELDS:
+        {
+            uint32_t count;
+            if (!get(record, pos, id) || id != m_fields.size() + 1 || !get(record, pos, count))
+            {
+                return false;
+            }
+
+            vector<FieldValueTuple> values;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                string field, value;
+                if (!getString(record, pos, field) || !getString(record, pos, value))
+                {
+                    return false;
+                }
+                values.emplace_back(std::move(field), std::move(value));
+            }
+            m_fields.push_back(std::move(values));
+            return true;
+        }
+
+        case RECORD_SET:
+        case RECORD_SET_KEY:
+        case RECORD_DEL:
+        case RECORD_DEL_KEY:
+            break;
+
+        default:
+            return false;
+    }
+
+    bool is_set = type == RECORD_SET || type == RECORD_SET_KEY;
+    if (is_set && (!get(record, pos, id) || id == 0 || id > m_fields.size()))
+    {
+        return false;
+    }
+
+    string key;
+    if (type == RECORD_SET_KEY || type == RECORD_DEL_KEY)
+    {
+        key.assign(record, pos, string::npos);
+    }
+    else
+    {
+        uint32_t vrf;
+        uint8_t family, len;
+        unsigned char addr[16] = {};
+        if (!get(record, pos, vrf) || vrf > m_vrfs.size() || !get(record, pos, family) || !get(record, pos, len))
+        {
+            return false;
+        }
+
+        size_t addr_len = (family & ~FAMILY_HOST) == 4 ? 4 : 16;
+        if (record.size() - pos != addr_len)
+        {
+            return false;
+        }
+        memcpy(addr, record.data() + pos, addr_len);
+        key = formatKey(vrf ? m_vrfs[vrf - 1] : string(), family, len, addr);
+    }
+
+    if (is_set)
+    {
+        vkco.emplace_back(std::move(key), SET_COMMAND, m_fields[id - 1]);
+    }
+    else
+    {
+        vkco.emplace_back(std::move(key), DEL_COMMAND, vector<FieldValueTuple>());
+    }
+
+    return true;
+}
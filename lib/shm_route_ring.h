@@ -0,0 +1,203 @@
+#ifndef SWSS_SHM_ROUTE_RING_H
+#define SWSS_SHM_ROUTE_RING_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dbconnector.h"
+#include "producerstatetable.h"
+#include "redispipeline.h"
+#include "selectable.h"
+#include "table.h"
+
+/*
+ * Feature flag to enable the fpmsyncd to send ROUTE events to orchagent through
+ * the shared memory route ring. Both containers must share /dev/shm.
+ */
+#define ORCH_NORTHBOND_ROUTE_SHM_ENABLED    "orch_northbond_route_shm_enabled"
+
+#define SHM_ROUTE_RING_NAME                 "/swss_route_ring"
+#define SHM_ROUTE_RING_SIZE                 (64 * 1024 * 1024)
+
+namespace swss {
+
+struct ShmRouteRingHeader;
+
+/*
+ * Single producer, single consumer ring of length prefixed records in a POSIX
+ * shared memory segment. Orchagent creates the segment and a FIFO next to it,
+ * the FIFO is the doorbell the producer rings when it writes to an empty ring,
+ * so the consumer can wait on it in Select.
+ */
+class ShmRouteRing
+{
+public:
+    enum PushResult
+    {
+        PUSH_OK,
+        /* The consumer reset the ring, the producer must intern again and retry */
+        PUSH_RESET,
+        /* The ring stayed full for the push timeout */
+        PUSH_TIMEOUT,
+        PUSH_TOO_LARGE,
+    };
+
+    /* Consumer side, creates or resets the ring and its doorbell */
+    static std::shared_ptr<ShmRouteRing> create(const std::string &name, size_t size);
+    /* Producer side, returns nullptr if the consumer has not created the ring */
+    static std::shared_ptr<ShmRouteRing> attach(const std::string &name);
+
+    ~ShmRouteRing();
+
+    /*
+     * Writes a record of the given generation, waits for space while the ring
+     * is full, up to the push timeout
+     */
+    PushResult push(const std::string &record, uint64_t generation);
+    /* False if the ring is empty, resets the ring if it holds a corrupt record */
+    bool pop(std::string &record);
+
+    bool empty() const;
+
+    /* Bumped every time the consumer resets the ring */
+    uint64_t generation() const;
+
+    /* Consumer side, drops all records and starts a new generation */
+    void reset();
+
+    /* Producer side, asks the consumer to reset the given generation */
+    void requestReset(uint64_t generation);
+    /* Consumer side, true if the producer asked for a reset of the current generation */
+    bool resetRequested() const;
+
+    void setPushTimeout(uint32_t msecs) { m_pushTimeoutMs = msecs; }
+
+    /* Read end of the doorbell, drained by the consumer */
+    int getFd() const { return m_fifoFd; }
+    void clearDoorbell();
+
+private:
+    ShmRouteRing(const std::string &name, bool consumer);
+
+    void write(uint64_t pos, const void *data, size_t len);
+    void read(uint64_t pos, void *data, size_t len) const;
+
+    std::string m_name;
+    bool m_consumer;
+    int m_shmFd = -1;
+    int m_fifoFd = -1;
+    size_t m_mapSize = 0;
+    uint32_t m_pushTimeoutMs;
+    ShmRouteRingHeader *m_header = nullptr;
+    char *m_data = nullptr;
+};
+
+/*
+ * Writes ROUTE_TABLE entries into the ring as binary records: the VRF name and
+ * the field values of a route are interned, a route is its VRF id, prefix and
+ * field set id. APPL_DB is still updated for visibility, through the buffered
+ * pipeline without the keyspace notification, so it is flushed with the rest
+ * of the pipeline writes. The first record of a generation is a sync record
+ * pushed after flushing the pipeline, the consumer loads APPL_DB on it.
+ *
+ * If the ring stays full for the push timeout, e.g. orchagent is down, the
+ * producer asks the consumer to reset the ring, so the records it holds are
+ * not applied after the newer ones, and routes are written the
+ * ProducerStateTable way until orchagent resets the ring.
+ */
+class ShmRouteProducerStateTable : public ProducerStateTable
+{
+public:
+    ShmRouteProducerStateTable(RedisPipeline *pipeline, const std::string &tableName, std::shared_ptr<ShmRouteRing> ring);
+
+    void set(const std::string &key,
+             const std::vector<FieldValueTuple> &values,
+             const std::string &op = SET_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void del(const std::string &key,
+             const std::string &op = DEL_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void set(const std::vector<KeyOpFieldsValuesTuple> &values) override;
+
+    void del(const std::vector<std::string> &keys) override;
+
+    /* Starts the generation of a reset done while no route is written */
+    void poll() { sync(); }
+
+private:
+    /* False while routes go through Redis */
+    bool sync();
+    void startRedisFallback();
+    /* Writes a SET, or a DEL if values is null, false if the route must go through Redis */
+    bool pushRoute(const std::string &key, const std::vector<FieldValueTuple> *values);
+    ShmRouteRing::PushResult writeRoute(const std::string &key, const std::vector<FieldValueTuple> *values);
+    ShmRouteRing::PushResult internVrf(const std::string &vrf, uint32_t &id);
+    ShmRouteRing::PushResult internFields(const std::vector<FieldValueTuple> &values, uint32_t &id);
+    ShmRouteRing::PushResult encodeKey(std::string &record, const std::string &key, uint8_t type, uint8_t raw_type);
+
+    RedisPipeline *m_pipeline;
+    std::shared_ptr<ShmRouteRing> m_ring;
+    Table m_table;
+    uint64_t m_generation = 0;
+    /* The sync record of the generation is not pushed yet */
+    bool m_resync = true;
+    bool m_redisFallback = false;
+    std::unordered_map<std::string, uint32_t> m_vrfIds;
+    std::unordered_map<std::string, uint32_t> m_fieldIds;
+    std::string m_record;
+};
+
+/*
+ * Decodes the ring records back into ROUTE_TABLE key, op and field values.
+ * Records dropped by a reset of the ring are made up for by loading the table
+ * from APPL_DB when the sync record of the next generation arrives, the
+ * producer has flushed its APPL_DB writes by then.
+ */
+class ShmRouteConsumerStateTable : public Selectable, public TableBase
+{
+public:
+    /* reload loads the routes already in APPL_DB with the first pops */
+    ShmRouteConsumerStateTable(DBConnector *db, const std::string &tableName,
+                               std::shared_ptr<ShmRouteRing> ring, int popBatchSize, int pri = 0,
+                               bool reload = false);
+
+    /* Pops at most popBatchSize routes, plus the whole table when it is reloaded */
+    void pops(std::deque<KeyOpFieldsValuesTuple> &vkco);
+
+    /*
+     * True if the last pops loaded the table, routes it did not return were
+     * removed from APPL_DB while their records were dropped
+     */
+    bool reloaded() const { return m_reloaded; }
+
+    int getFd() override { return m_ring->getFd(); }
+    uint64_t readData() override;
+    bool hasCachedData() override { return !m_ring->empty(); }
+    bool initializedWithData() override { return hasCachedData(); }
+
+private:
+    bool needsReload() const { return m_reload || m_ring->generation() != m_generation; }
+    void reload(std::deque<KeyOpFieldsValuesTuple> &vkco);
+    bool decode(const std::string &record, std::deque<KeyOpFieldsValuesTuple> &vkco);
+
+    DBConnector *m_db;
+    std::shared_ptr<ShmRouteRing> m_ring;
+    bool m_reload;
+    bool m_reloaded = false;
+    size_t m_reloadedRoutes = 0;
+    uint64_t m_generation;
+    size_t m_popBatchSize;
+    std::vector<std::string> m_vrfs;
+    std::vector<std::vector<FieldValueTuple>> m_fields;
+    std::string m_record;
+};
+
+}
+
+#endif /* SWSS_SHM_ROUTE_RING_H */
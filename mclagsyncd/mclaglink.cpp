@@ -61,58 +61,6 @@ void MclagLink::delVlanMbr(std::string vlan, std::string mbr_port)
 }
 
 
-void MclagLink::getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map)
-{
-    auto hash = p_counters_db->hgetall("COUNTERS_PORT_NAME_MAP");
-
-    for (auto it = hash.begin(); it != hash.end(); ++it)
-        port_map.insert(pair<string, string>(it->second, it->first));
-
-    return;
-}
-
-void MclagLink::getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: string> *oid_map)
-{
-    std::string bridge_port_id;
-    size_t pos1 = 0;
-
-    auto keys = p_asic_db->keys("ASIC_STATE:SAI_OBJECT_TYPE_BRIDGE_PORT:*");
-
-    for (auto& key : keys)
-    {
-        pos1 = key.find("oid:", 0);
-        bridge_port_id = key.substr(pos1);
-
-        auto hash = p_asic_db->hgetall(key);
-        auto attr_port_id = hash.find("SAI_BRIDGE_PORT_ATTR_PORT_ID");
-        if (attr_port_id == hash.end())
-        {
-            attr_port_id = hash.find("SAI_BRIDGE_PORT_ATTR_TUNNEL_ID");
-            if (attr_port_id == hash.end())
-                continue;
-        }
-
-        oid_map->insert(pair<string, string>(bridge_port_id, attr_port_id->second));
-    }
-
-    return;
-}
-
-void MclagLink::getVidByBvid(std::string &bvid, std::string &vlanid)
-{
-    std::string pre = "ASIC_STATE:SAI_OBJECT_TYPE_VLAN:";
-    std::string key = pre + bvid;
-
-    auto hash = p_asic_db->hgetall(key.c_str());
-
-    auto attr_vlan_id = hash.find("SAI_VLAN_ATTR_VLAN_ID");
-    if (attr_vlan_id == hash.end())
-        return;
-
-    vlanid = attr_vlan_id->second;
-    return;
-}
-
 void MclagLink::mclagsyncdFetchSystemMacFromConfigdb()
 {
     vector<FieldValueTuple> fvs; 
@@ -530,6 +478,9 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
 
     char *infor_start = m_messageBuffer_send;
 
+    /* Changes to m_fdb_synced, applied only once the message carrying them is written */
+    MclagFdbSyncedUpdates pending;
+
     /* Nothing popped */
     if (entries.empty())
     {
@@ -574,8 +525,6 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
                     SWSS_LOG_ERROR("MCLAGSYNCD STATE FDB updates key=%s, invalid MAC type %s\n", key.c_str(), fvValue(i).c_str());
             }
         }
-        SWSS_LOG_NOTICE("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
-                key.c_str(), op.c_str(), info.type, info.port_name);
 
         if (MCLAG_MAX_SEND_MSG_LEN - infor_len < sizeof(struct mclag_fdb_info))
         {
@@ -588,16 +537,67 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
                     msg_head->msg_len, msg_head->msg_type, count);
             write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
 
-            if (write <= 0)
+            if (write != (ssize_t)msg_head->msg_len)
             {
                 SWSS_LOG_ERROR("mclagsycnd update FDB to ICCPD Buffer full, write to m_connection_socket failed");
             }
+            else
+            {
+                updateFdbSynced(pending);
+            }
 
+            pending.clear();
             infor_len = sizeof(mclag_msg_hdr_t);
             count = 0;
         }
+
+        /* Only stream changes, ICCPd already has what was sent on this connection */
+        bool is_synced;
+        std::pair<std::string, short> synced;
+        auto pending_it = pending.find(key);
+        if (pending_it != pending.end())
+        {
+            is_synced = pending_it->second.first;
+            synced = pending_it->second.second;
+        }
+        else
+        {
+            auto synced_it = m_fdb_synced.find(key);
+            is_synced = synced_it != m_fdb_synced.end();
+            if (is_synced)
+            {
+                synced = synced_it->second;
+            }
+        }
+
+        if (info.op_type == MCLAG_FDB_OPER_ADD)
+        {
+            if (is_synced && synced.first == info.port_name && synced.second == info.type)
+            {
+                SWSS_LOG_DEBUG("MCLAGSYNCD STATE FDB key=%s unchanged, skipped", key.c_str());
+                continue;
+            }
+        }
+        else if (!is_synced)
+        {
+            SWSS_LOG_DEBUG("MCLAGSYNCD STATE FDB key=%s not synced, skipped", key.c_str());
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("MCLAGSYNCD STATE FDB updates key=%s, operation=%s, type: %d, port: %s \n",
+                key.c_str(), op.c_str(), info.type, info.port_name);
+
         memcpy((char*)(infor_start + infor_len), (char*)&info, sizeof(struct mclag_fdb_info));
         infor_len = infor_len +  sizeof(struct mclag_fdb_info);
+
+        if (info.op_type == MCLAG_FDB_OPER_ADD)
+        {
+            pending[key] = std::make_pair(true, std::make_pair(std::string(info.port_name), info.type));
+        }
+        else
+        {
+            pending[key] = std::make_pair(false, std::make_pair(std::string(), info.type));
+        }
     }
 
 
@@ -614,14 +614,32 @@ void MclagLink::mclagsyncdSendFdbEntries(std::deque<KeyOpFieldsValuesTuple> &ent
             msg_head->msg_len, msg_head->msg_type, count);
     write = ::write(m_connection_socket, infor_start, msg_head->msg_len);
 
-    if (write <= 0)
+    if (write != (ssize_t)msg_head->msg_len)
     {
         SWSS_LOG_ERROR("mclagsycnd update FDB to ICCPD, write to m_connection_socket failed");
+        return;
     }
 
+    updateFdbSynced(pending);
+
     return;
 }
 
+void MclagLink::updateFdbSynced(const MclagFdbSyncedUpdates &updates)
+{
+    for (auto &update: updates)
+    {
+        if (update.second.first)
+        {
+            m_fdb_synced[update.first] = update.second.second;
+        }
+        else
+        {
+            m_fdb_synced.erase(update.first);
+        }
+    }
+}
+
 
 void MclagLink::processMclagDomainCfg(std::deque<KeyOpFieldsValuesTuple> &entries)
 {
@@ -909,6 +927,8 @@ void MclagLink::processMclagDomainCfg(std::deque<KeyOpFieldsValuesTuple> &entrie
 
 void MclagLink::addDomainCfgDependentSelectables()
 {
+    /* The new subscription replays every FDB entry to ICCPd */
+    m_fdb_synced.clear();
     p_state_fdb_tbl = new SubscriberStateTable(p_state_db.get(), STATE_FDB_TABLE_NAME);
     SWSS_LOG_INFO(" MCLAGSYNCD create state fdb table");
 
@@ -1794,8 +1814,6 @@ MclagLink::MclagLink(Select *select, int port) :
     p_state_db    = unique_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     p_appl_db     = unique_ptr<DBConnector>(new DBConnector("APPL_DB", 0));
     p_config_db   = unique_ptr<DBConnector>(new DBConnector("CONFIG_DB", 0));
-    p_asic_db     = unique_ptr<DBConnector>(new DBConnector("ASIC_DB", 0));
-    p_counters_db = unique_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     p_notificationsDb = unique_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
 
     p_device_metadata_tbl          = unique_ptr<Table>(new Table(p_config_db.get(), CFG_DEVICE_METADATA_TABLE_NAME));
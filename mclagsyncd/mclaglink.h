@@ -33,6 +33,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <memory>
 #include <net/ethernet.h>
 
@@ -218,8 +219,6 @@ namespace swss {
             unique_ptr<DBConnector> p_state_db;
             unique_ptr<DBConnector> p_appl_db;
             unique_ptr<DBConnector> p_config_db;
-            unique_ptr<DBConnector> p_asic_db;
-            unique_ptr<DBConnector> p_counters_db;
             unique_ptr<DBConnector> p_notificationsDb;
 
             unique_ptr<Table> p_mclag_tbl;
@@ -245,6 +244,13 @@ namespace swss {
 
             std::map<mclagDomainEntry, mclagDomainData> m_mclag_domains;
 
+            /* Port and type of each FDB entry sent to ICCPd, keyed by Vlan<vid>:<mac> */
+            std::unordered_map<std::string, std::pair<std::string, short>> m_fdb_synced;
+
+            /* Added (true) or removed (false) FDB entries, with their port and type, keyed like m_fdb_synced */
+            typedef std::unordered_map<std::string, std::pair<bool, std::pair<std::string, short>>> MclagFdbSyncedUpdates;
+            void updateFdbSynced(const MclagFdbSyncedUpdates &updates);
+
 
             int getFd() override;
             char* getSendMsgBuffer();
@@ -269,10 +275,6 @@ namespace swss {
 
             void delDomainCfgDependentSelectables();
 
-            void getOidToPortNameMap(std::unordered_map<std::string, std:: string> & port_map);
-            void getBridgePortIdToAttrPortIdMap(std::map<std::string, std:: string> *oid_map);
-            void getVidByBvid(std::string &bvid, std::string &vlanid);
-            void getFdbSet(std::set<mclag_fdb> *fdb_set);
             void setLocalIfPortIsolate(std::string mclag_if, bool is_enable);
             void deleteLocalIfPortIsolate(std::string mclag_if);
             void setPortIsolate(char *msg);
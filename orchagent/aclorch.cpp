@@ -18,6 +18,8 @@ using namespace std;
 using namespace swss;
 
 map<acl_range_properties_t, AclRange*> AclRange::m_ranges;
+// Maximum number of ACL entries a rule may be expanded into to avoid range checkers, 0 disables the expansion
+uint32_t gAclRangeExpansionLimit = 0;
 sai_uint32_t AclRule::m_minPriority = 0;
 sai_uint32_t AclRule::m_maxPriority = 0;
 
@@ -1291,7 +1293,7 @@ bool AclRule::createRule()
     attr.value.booldata = true;
     rule_attrs.push_back(attr);
 
-    // add reference to the counter
+    // add reference to the counter, entries of an expanded rule all count into this one counter
     if (m_createCounter)
     {
         attr.id = SAI_ACL_ENTRY_ATTR_ACTION_COUNTER;
@@ -1300,9 +1302,13 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    if (!m_rangeConfig.empty())
+    vector<AclRangeConfig> hwRanges;
+    vector<AclRangeConfig> expandedRanges;
+    compileRanges(hwRanges, expandedRanges);
+
+    if (!hwRanges.empty())
     {
-        for (const auto& rangeConfig: m_rangeConfig)
+        for (const auto& rangeConfig: hwRanges)
         {
             SWSS_LOG_INFO("Creating range object %u..%u", rangeConfig.min, rangeConfig.max);
 
@@ -1310,7 +1316,7 @@ bool AclRule::createRule()
             if (!range)
             {
                 // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
+                removeRanges();
                 return false;
             }
 
@@ -1338,26 +1344,246 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    // Cross product of the L4 port prefixes of the expanded ranges, one ACL entry per combination
+    vector<vector<sai_attribute_t>> expandedMatches(1);
+    for (const auto& rangeConfig: expandedRanges)
+    {
+        vector<vector<sai_attribute_t>> combinations;
+
+        attr.id = (rangeConfig.rangeType == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ?
+            SAI_ACL_ENTRY_ATTR_FIELD_L4_SRC_PORT : SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT;
+        attr.value.aclfield = {};
+        attr.value.aclfield.enable = true;
+
+        for (const auto& prefix: AclRange::toPrefixes(rangeConfig.min, rangeConfig.max))
+        {
+            attr.value.aclfield.data.u16 = prefix.value;
+            attr.value.aclfield.mask.u16 = prefix.mask;
+
+            for (const auto& matches: expandedMatches)
+            {
+                combinations.push_back(matches);
+                combinations.back().push_back(attr);
+            }
+        }
+
+        expandedMatches.swap(combinations);
+    }
+
+    status = SAI_STATUS_SUCCESS;
+    for (const auto& matches: expandedMatches)
+    {
+        vector<sai_attribute_t> entry_attrs(rule_attrs);
+        entry_attrs.insert(entry_attrs.end(), matches.begin(), matches.end());
+
+        sai_object_id_t entryOid = SAI_NULL_OBJECT_ID;
+        status = sai_acl_api->create_acl_entry(&entryOid, gSwitchId, (uint32_t)entry_attrs.size(), entry_attrs.data());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            break;
+        }
+
+        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+
+        if (m_ruleOid == SAI_NULL_OBJECT_ID)
+        {
+            m_ruleOid = entryOid;
+        }
+        else
+        {
+            m_expandedRuleOids.push_back(entryOid);
+        }
+    }
+
     if (status != SAI_STATUS_SUCCESS)
     {
-        if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+        if (status == SAI_STATUS_ITEM_ALREADY_EXISTS && m_ruleOid == SAI_NULL_OBJECT_ID)
         {
             SWSS_LOG_NOTICE("ACL rule %s already exists", m_id.c_str());
             return true;
         }
         SWSS_LOG_ERROR("Failed to create ACL rule %s, rv:%d",
                 m_id.c_str(), status);
-        AclRange::remove(range_objects, range_object_list.count);
+        removeExpandedEntries();
+        removeRanges();
         decreaseNextHopRefCount();
+        return false;
     }
 
-    if (status == SAI_STATUS_SUCCESS)
+    if (!expandedRanges.empty())
     {
-        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+        SWSS_LOG_INFO("ACL rule %s programmed as %zu entries, %zu range(s) expanded into L4 port prefixes",
+                m_id.c_str(), expandedMatches.size(), expandedRanges.size());
+    }
+
+    return true;
+}
+
+void AclRule::compileRanges(vector<AclRangeConfig>& hwRanges, vector<AclRangeConfig>& expandedRanges) const
+{
+    SWSS_LOG_ENTER();
+
+    hwRanges.clear();
+    expandedRanges.clear();
+
+    if (gAclRangeExpansionLimit == 0)
+    {
+        hwRanges = m_rangeConfig;
+        return;
+    }
+
+    const auto& tableMatches = m_pTable->type.getMatches();
+    size_t entries = 1;
+
+    for (const auto& rangeConfig: m_rangeConfig)
+    {
+        auto portMatch = (rangeConfig.rangeType == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ?
+            SAI_ACL_ENTRY_ATTR_FIELD_L4_SRC_PORT : SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT;
+
+        // Expansion needs the L4 port match on the table and must not clash with an explicit port match
+        if (tableMatches.find(AclEntryFieldToAclTableField(portMatch)) == tableMatches.end() ||
+            m_matches.find(portMatch) != m_matches.end())
+        {
+            hwRanges.push_back(rangeConfig);
+            continue;
+        }
+
+        auto prefixCount = AclRange::toPrefixes(rangeConfig.min, rangeConfig.max).size();
+
+        // A single prefix costs one entry, same as a range checker, so it is always the cheaper encoding.
+        // Otherwise keep sharing an allocated range checker, or allocate a new one while they are available,
+        // and only fall back to the expansion when they are exhausted.
+        bool expand = (prefixCount == 1) ||
+            (!AclRange::exists(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max) &&
+             AclRange::getAvailableCount(rangeConfig.rangeType) == 0);
+
+        if (!expand || entries * prefixCount > gAclRangeExpansionLimit)
+        {
+            hwRanges.push_back(rangeConfig);
+            continue;
+        }
+
+        entries *= prefixCount;
+        expandedRanges.push_back(rangeConfig);
+    }
+
+    if (entries > 1)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY;
+
+        if (sai_acl_api->get_acl_table_attribute(m_pTable->getOid(), 1, &attr) == SAI_STATUS_SUCCESS &&
+            attr.value.u32 < entries)
+        {
+            SWSS_LOG_WARN("Not enough ACL entries left in table %s to expand ranges of rule %s, need %zu, available %u",
+                    m_pTable->getId().c_str(), m_id.c_str(), entries, attr.value.u32);
+            hwRanges = m_rangeConfig;
+            expandedRanges.clear();
+        }
+    }
+}
+
+// Object list of an ACL field or action attribute, nullptr for the other value types
+static sai_object_list_t *getAclEntryObjectList(sai_attribute_t& attr)
+{
+    auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_ENTRY, attr.id);
+    if (!meta)
+    {
+        return nullptr;
     }
 
-    return (status == SAI_STATUS_SUCCESS);
+    switch (meta->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            return &attr.value.aclfield.data.objlist;
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            return &attr.value.aclaction.parameter.objlist;
+        default:
+            return nullptr;
+    }
+}
+
+sai_status_t AclRule::setEntryAttribute(const sai_attribute_t& attr)
+{
+    if (m_expandedRuleOids.empty())
+    {
+        return sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    }
+
+    // The expanded entries are one rule, keep the current value to undo a partial update
+    sai_attribute_t prevAttr = {};
+    prevAttr.id = attr.id;
+    vector<sai_object_id_t> prevObjects;
+
+    auto prevList = getAclEntryObjectList(prevAttr);
+    auto status = sai_acl_api->get_acl_entry_attribute(m_ruleOid, 1, &prevAttr);
+    if (prevList && status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        prevObjects.resize(prevList->count);
+        prevList->list = prevObjects.data();
+        status = sai_acl_api->get_acl_entry_attribute(m_ruleOid, 1, &prevAttr);
+    }
+    bool canRollback = (status == SAI_STATUS_SUCCESS);
+
+    vector<sai_object_id_t> oids{m_ruleOid};
+    oids.insert(oids.end(), m_expandedRuleOids.begin(), m_expandedRuleOids.end());
+
+    size_t updated = 0;
+    for (; updated < oids.size(); updated++)
+    {
+        status = sai_acl_api->set_acl_entry_attribute(oids[updated], &attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    if (status == SAI_STATUS_SUCCESS || updated == 0)
+    {
+        return status;
+    }
+
+    if (!canRollback)
+    {
+        SWSS_LOG_ERROR("Failed to read attribute %d of ACL rule %s, %zu of its %zu entries keep the new value",
+                attr.id, m_id.c_str(), updated, oids.size());
+        return status;
+    }
+
+    for (size_t i = 0; i < updated; i++)
+    {
+        if (sai_acl_api->set_acl_entry_attribute(oids[i], &prevAttr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to restore attribute %d of ACL entry %s of rule %s",
+                    attr.id, sai_serialize_object_id(oids[i]).c_str(), m_id.c_str());
+        }
+    }
+
+    return status;
+}
+
+void AclRule::removeExpandedEntries()
+{
+    SWSS_LOG_ENTER();
+
+    auto oids = m_expandedRuleOids;
+    if (m_ruleOid != SAI_NULL_OBJECT_ID)
+    {
+        oids.push_back(m_ruleOid);
+    }
+
+    for (auto oid: oids)
+    {
+        if (sai_acl_api->remove_acl_entry(oid) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove ACL entry %s of rule %s", sai_serialize_object_id(oid).c_str(), m_id.c_str());
+            continue;
+        }
+        gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+    }
+
+    m_expandedRuleOids.clear();
+    m_ruleOid = SAI_NULL_OBJECT_ID;
 }
 
 void AclRule::decreaseNextHopRefCount()
@@ -1414,6 +1640,23 @@ bool AclRule::removeRule()
         return true;
     }
 
+    while (!m_expandedRuleOids.empty())
+    {
+        auto status = sai_acl_api->remove_acl_entry(m_expandedRuleOids.back());
+        if (status != SAI_STATUS_SUCCESS && status != SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_ERROR("Failed to delete expanded entry of ACL rule %s, status %s",
+                    m_id.c_str(), sai_serialize_status(status).c_str());
+            return false;
+        }
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+        }
+        m_expandedRuleOids.pop_back();
+    }
+
     auto status = sai_acl_api->remove_acl_entry(m_ruleOid);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1459,7 +1702,7 @@ void AclRule::updateInPorts()
     auto attr = m_matches[SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS].getSaiAttr();
     attr.value.aclfield.enable = true;
 
-    status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    status = setEntryAttribute(attr);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to update ACL rule %s, rv:%d", m_id.c_str(), status);
@@ -1722,7 +1965,7 @@ bool AclRule::setAttribute(sai_attribute_t attr)
     {
         SWSS_LOG_THROW("Failed to get metadata for attribute id %d", attr.id);
     }
-    auto status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    auto status = setEntryAttribute(attr);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to update attribute %s on ACL rule %s in ACL table %s: %s",
@@ -1857,7 +2100,7 @@ bool AclRule::enableCounter()
     attr.value.aclaction.parameter.oid = m_counterOid;
     attr.value.aclaction.enable = true;
 
-    sai_status_t status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    sai_status_t status = setEntryAttribute(attr);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to enable counter for ACL rule %s in ACL table %s", m_id.c_str(), m_pTable->getId().c_str());
@@ -1889,7 +2132,7 @@ bool AclRule::disableCounter()
     attr.value.aclaction.parameter.oid = SAI_NULL_OBJECT_ID;
     attr.value.aclaction.enable = false;
 
-    sai_status_t status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr);
+    sai_status_t status = setEntryAttribute(attr);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to disable counter for ACL rule %s in ACL table %s", m_id.c_str(), m_pTable->getId().c_str());
@@ -1950,14 +2193,16 @@ bool AclRule::removeRanges()
        return true;
     }
 
-    for (const auto& rangeConfig: m_rangeConfig)
+    // Ranges expanded into L4 port prefixes don't hold a range checker. The reference is
+    // dropped even if the SAI removal fails, the pointer may not be used again after that.
+    bool res = true;
+    while (!m_ranges.empty())
     {
-        if (!AclRange::remove(rangeConfig.rangeType, rangeConfig.min, rangeConfig.max))
-        {
-            return false;
-        }
+        auto range = m_ranges.back();
+        m_ranges.pop_back();
+        res &= AclRange::remove(range->getOid());
     }
-    return true;
+    return res;
 }
 
 bool AclRule::removeCounter()
@@ -3438,6 +3683,82 @@ bool AclRange::remove(sai_object_id_t *oids, int oidsCnt)
     return false;
 }
 
+bool AclRange::remove(sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto it : m_ranges)
+    {
+        if (it.second->m_oid == oid)
+        {
+            return it.second->remove();
+        }
+    }
+
+    return false;
+}
+
+bool AclRange::exists(sai_acl_range_type_t type, int min, int max)
+{
+    return m_ranges.find(make_tuple(type, min, max)) != m_ranges.end();
+}
+
+uint64_t AclRange::getAvailableCount(sai_acl_range_type_t type)
+{
+    SWSS_LOG_ENTER();
+
+    char *platform = getenv("platform");
+    if (platform)
+    {
+        if ((strstr(platform, MLNX_PLATFORM_SUBSTRING) && m_ranges.size() >= MLNX_MAX_RANGES_COUNT) ||
+            (strstr(platform, CLX_PLATFORM_SUBSTRING) && m_ranges.size() >= CLNX_MAX_RANGES_COUNT))
+        {
+            return 0;
+        }
+    }
+
+    sai_attribute_t attr;
+    attr.id = SAI_ACL_RANGE_ATTR_TYPE;
+    attr.value.s32 = type;
+
+    uint64_t availCount = 0;
+    auto status = sai_object_type_get_availability(gSwitchId, SAI_OBJECT_TYPE_ACL_RANGE, 1, &attr, &availCount);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        // Availability query is optional, assume the range checker can be allocated as before
+        SWSS_LOG_INFO("Failed to get availability of ACL range type %d, rv:%d", type, status);
+        return UINT64_MAX;
+    }
+
+    return availCount;
+}
+
+vector<AclRangePrefix> AclRange::toPrefixes(uint32_t min, uint32_t max)
+{
+    vector<AclRangePrefix> prefixes;
+
+    if (min > max || max > USHRT_MAX)
+    {
+        return prefixes;
+    }
+
+    // Greedily take the largest aligned block starting at min which doesn't go past max
+    uint32_t start = min;
+    while (start <= max)
+    {
+        uint32_t size = 1;
+        while ((start & ((size << 1) - 1)) == 0 && start + (size << 1) - 1 <= max && (size << 1) <= USHRT_MAX + 1u)
+        {
+            size <<= 1;
+        }
+
+        prefixes.push_back({static_cast<uint16_t>(start), static_cast<uint16_t>(~(size - 1) & USHRT_MAX)});
+        start += size;
+    }
+
+    return prefixes;
+}
+
 bool AclRange::remove()
 {
     SWSS_LOG_ENTER();
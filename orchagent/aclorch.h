@@ -267,12 +267,26 @@ struct AclRangeConfig
     uint32_t max;
 };
 
+// Ternary value/mask pair matching a power-of-two aligned block of L4 ports
+struct AclRangePrefix
+{
+    uint16_t value;
+    uint16_t mask;
+};
+
 class AclRange
 {
 public:
     static AclRange *create(sai_acl_range_type_t type, int min, int max);
     static bool remove(sai_acl_range_type_t type, int min, int max);
     static bool remove(sai_object_id_t *oids, int oidsCnt);
+    static bool remove(sai_object_id_t oid);
+    // Check if a range checker with the given properties is already allocated and can be shared
+    static bool exists(sai_acl_range_type_t type, int min, int max);
+    // Number of range checkers of the given type which can still be allocated
+    static uint64_t getAvailableCount(sai_acl_range_type_t type);
+    // Split [min, max] into the minimal list of value/mask pairs covering exactly that range
+    static vector<AclRangePrefix> toPrefixes(uint32_t min, uint32_t max);
     sai_object_id_t getOid()
     {
         return m_oid;
@@ -367,6 +381,13 @@ protected:
 
     virtual bool setAttribute(sai_attribute_t attr);
 
+    // Split the range configuration into range checkers and ranges to be expanded into L4 port matches
+    void compileRanges(vector<AclRangeConfig>& hwRanges, vector<AclRangeConfig>& expandedRanges) const;
+    // Set attribute on every SAI ACL entry programmed for this rule, entries already updated
+    // are restored to the previous value when one of them fails
+    sai_status_t setEntryAttribute(const sai_attribute_t& attr);
+    void removeExpandedEntries();
+
     void decreaseNextHopRefCount();
 
     bool isActionSupported(sai_acl_entry_attr_t) const;
@@ -387,6 +408,9 @@ protected:
 
     vector<AclRangeConfig> m_rangeConfig;
     vector<AclRange*> m_ranges;
+    // Additional ACL entries created when range matches are expanded into L4 port prefixes,
+    // m_ruleOid holds the first one. They all share m_counterOid, which counts the rule as a whole.
+    vector<sai_object_id_t> m_expandedRuleOids;
 
 private:
     bool m_createCounter;
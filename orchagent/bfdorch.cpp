@@ -8,6 +8,10 @@
 #include "directory.h"
 #include "notifications.h"
 #include "schema.h"
+#include "saioffloadsession.h"
+
+#include <chrono>
+#include <deque>
 
 using namespace std;
 using namespace swss;
@@ -29,6 +33,7 @@ extern PortsOrch*           gPortsOrch;
 extern sai_switch_api_t*    sai_switch_api;
 extern Directory<Orch*>     gDirectory;
 extern string               gMySwitchType;
+extern size_t               gMaxBulkSize;
 
 const map<string, sai_bfd_session_type_t> session_type_map =
 {
@@ -56,7 +61,10 @@ const map<sai_bfd_session_state_t, string> session_state_lookup =
 
 BfdOrch::BfdOrch(DBConnector *db, string tableName, TableConnector stateDbBfdSessionTable):
     Orch(db, tableName),
-    m_stateBfdSessionTable(stateDbBfdSessionTable.first, stateDbBfdSessionTable.second)
+    m_stateBfdSessionTable(stateDbBfdSessionTable.first, stateDbBfdSessionTable.second),
+    m_stateDbPipeline(make_unique<RedisPipeline>(stateDbBfdSessionTable.first)),
+    m_stateBfdSessionBatchTable(make_unique<Table>(m_stateDbPipeline.get(), stateDbBfdSessionTable.second, true)),
+    m_stateNotificationStatsTable(make_unique<Table>(m_stateDbPipeline.get(), STATE_OFFLOAD_SESSION_NOTIFICATION_TABLE_NAME, true))
 {
     SWSS_LOG_ENTER();
 
@@ -119,6 +127,27 @@ void BfdOrch::doTask(Consumer &consumer)
         tsa_enabled = bgp_global_state_orch->getTsaState();
         use_software_bfd = bgp_global_state_orch->getSoftwareBfd();
     }
+
+    /*
+     * Hardware sessions are created in bulk after the loop, their entries
+     * stay in m_toSync until the create result is known.
+     */
+    deque<BfdPendingSession> pending;
+    vector<SyncMap::iterator> pending_entries;
+    auto queue_session = [&](SyncMap::iterator entry, const string& key, const vector<FieldValueTuple>& data)
+    {
+        pending.emplace_back();
+        bool consumed = create_bfd_session(key, data, &pending.back());
+        if (pending.back().key.empty())
+        {
+            pending.pop_back();
+            return consumed;
+        }
+
+        pending_entries.push_back(entry);
+        return false;
+    };
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -157,7 +186,7 @@ void BfdOrch::doTask(Consumer &consumer)
                 bfd_session_cache[key] = data;
                 if (!tsa_enabled)
                 {
-                    if (!create_bfd_session(key, data))
+                    if (!queue_session(it, key, data))
                     {
                         it++;
                         continue;
@@ -170,7 +199,7 @@ void BfdOrch::doTask(Consumer &consumer)
             }
             else
             {
-                if (!create_bfd_session(key, data))
+                if (!queue_session(it, key, data))
                 {
                     it++;
                     continue;
@@ -215,6 +244,27 @@ void BfdOrch::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    SaiOffloadSessionBulker<sai_bfd_api_t> bulker(sai_bfd_api->create_bfd_session,
+            sai_bfd_api->remove_bfd_session, gMaxBulkSize);
+    for (auto& session : pending)
+    {
+        bulker.create_entry(&session.id, &session.status, &session.attrs);
+    }
+    bulker.flush();
+
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        if (complete_bfd_session(pending[i]))
+        {
+            consumer.m_toSync.erase(pending_entries[i]);
+        }
+    }
 }
 
 void BfdOrch::doTask(NotificationConsumer &consumer)
@@ -232,39 +282,96 @@ void BfdOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
+    /*
+     * Notifications already queued behind this one are handled in the same
+     * batch, a session that changed several times gets one STATE_DB write
+     * with its final state. Observers still get every transition, so a
+     * session that went DOWN and back UP in the batch isn't missed.
+     */
+    auto received = chrono::steady_clock::now();
+
+    std::deque<KeyOpFieldsValuesTuple> queued;
+    consumer.pops(queued);
+
+    BfdStateBatch batch;
     if (op == "bfd_session_state_change")
     {
-        uint32_t count;
-        sai_bfd_session_state_notification_t *bfdSessionState = nullptr;
+        handle_bfd_state_change(data, batch);
+    }
+    for (const auto& notification : queued)
+    {
+        if (kfvOp(notification) == "bfd_session_state_change")
+        {
+            handle_bfd_state_change(kfvKey(notification), batch);
+        }
+    }
 
-        sai_deserialize_bfd_session_state_ntf(data, count, &bfdSessionState);
+    if (!batch.notifications)
+    {
+        return;
+    }
 
-        for (uint32_t i = 0; i < count; i++)
+    size_t changes = 0;
+    uint64_t coalesced = 0;
+    for (const auto& it : batch.states)
+    {
+        auto lookup = bfd_session_lookup.find(it.first);
+        if (lookup == bfd_session_lookup.end())
         {
-            sai_object_id_t id = bfdSessionState[i].bfd_session_id;
-            sai_bfd_session_state_t state = bfdSessionState[i].session_state;
+            continue;
+        }
 
-            SWSS_LOG_INFO("Get BFD session state change notification id:%" PRIx64 " state: %s", id, session_state_lookup.at(state).c_str());
+        auto transitions = BfdStateBatch::transitions(lookup->second.state, it.second);
+        if (transitions.empty())
+        {
+            continue;
+        }
 
-            if (state != bfd_session_lookup[id].state)
-            {
-                auto key = bfd_session_lookup[id].peer;
-                m_stateBfdSessionTable.hset(key, "state", session_state_lookup.at(state));
+        auto key = lookup->second.peer;
+        m_stateBfdSessionBatchTable->hset(key, "state", session_state_lookup.at(transitions.back()));
 
-                SWSS_LOG_NOTICE("BFD session state for %s changed from %s to %s", key.c_str(),
-                            session_state_lookup.at(bfd_session_lookup[id].state).c_str(), session_state_lookup.at(state).c_str());
+        for (auto state : transitions)
+        {
+            SWSS_LOG_NOTICE("BFD session state for %s changed from %s to %s", key.c_str(),
+                        session_state_lookup.at(lookup->second.state).c_str(), session_state_lookup.at(state).c_str());
 
-                BfdUpdate update;
-                update.peer = key;
-                update.state = state;
-                notify(SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE, static_cast<void *>(&update));
+            BfdUpdate update;
+            update.peer = key;
+            update.state = state;
+            notify(SUBJECT_TYPE_BFD_SESSION_STATE_CHANGE, static_cast<void *>(&update));
 
-                bfd_session_lookup[id].state = state;
-            }
+            lookup->second.state = state;
         }
 
-        sai_deserialize_free_bfd_session_state_ntf(count, bfdSessionState);
+        coalesced += transitions.size() - 1;
+        changes++;
     }
+
+    auto process_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - received).count();
+    publish_notification_batch(*m_stateNotificationStatsTable, "BFD", batch.notifications, changes, coalesced,
+            static_cast<uint64_t>(process_us), m_max_notification_process_us);
+    m_stateDbPipeline->flush();
+}
+
+void BfdOrch::handle_bfd_state_change(const string& data, BfdStateBatch& batch)
+{
+    uint32_t count;
+    sai_bfd_session_state_notification_t *bfdSessionState = nullptr;
+
+    sai_deserialize_bfd_session_state_ntf(data, count, &bfdSessionState);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        sai_object_id_t id = bfdSessionState[i].bfd_session_id;
+        sai_bfd_session_state_t state = bfdSessionState[i].session_state;
+
+        SWSS_LOG_INFO("Get BFD session state change notification id:%" PRIx64 " state: %s", id, session_state_lookup.at(state).c_str());
+
+        batch.add(id, state);
+    }
+    batch.notifications++;
+
+    sai_deserialize_free_bfd_session_state_ntf(count, bfdSessionState);
 }
 
 bool BfdOrch::register_bfd_state_change_notification(void)
@@ -302,7 +409,7 @@ bool BfdOrch::register_bfd_state_change_notification(void)
     return true;
 }
 
-bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple>& data)
+bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple>& data, BfdPendingSession *pending)
 {
     if (!register_state_change_notif)
     {
@@ -543,12 +650,32 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
 
     fvVector.emplace_back("state", session_state_lookup.at(SAI_BFD_SESSION_STATE_DOWN));
 
-    sai_object_id_t bfd_session_id = SAI_NULL_OBJECT_ID;
-    sai_status_t status = sai_bfd_api->create_bfd_session(&bfd_session_id, gSwitchId, (uint32_t)attrs.size(), attrs.data());
+    BfdPendingSession session;
+    session.key = key;
+    session.state_db_key = get_state_db_key(vrf_name, alias, peer_address);
+    session.attrs = attrs;
+    session.fvs = fvVector;
+
+    // The caller creates the queued session and completes it
+    if (pending)
+    {
+        *pending = std::move(session);
+        return true;
+    }
+
+    session.status = sai_bfd_api->create_bfd_session(&session.id, gSwitchId, (uint32_t)session.attrs.size(), session.attrs.data());
+
+    return complete_bfd_session(session);
+}
+
+bool BfdOrch::complete_bfd_session(BfdPendingSession& session)
+{
+    const string& key = session.key;
+    sai_status_t status = session.status;
 
     if (status != SAI_STATUS_SUCCESS)
     {
-        status = retry_create_bfd_session(bfd_session_id, attrs);
+        status = retry_create_bfd_session(session.id, session.attrs);
     }
 
     if (status != SAI_STATUS_SUCCESS)
@@ -561,10 +688,10 @@ bool BfdOrch::create_bfd_session(const string& key, const vector<FieldValueTuple
         }
     }
 
-    const string state_db_key = get_state_db_key(vrf_name, alias, peer_address);
-    m_stateBfdSessionTable.set(state_db_key, fvVector);
-    bfd_session_map[key] = bfd_session_id;
-    bfd_session_lookup[bfd_session_id] = {state_db_key, SAI_BFD_SESSION_STATE_DOWN};
+    const string& state_db_key = session.state_db_key;
+    m_stateBfdSessionTable.set(state_db_key, session.fvs);
+    bfd_session_map[key] = session.id;
+    bfd_session_lookup[session.id] = {state_db_key, SAI_BFD_SESSION_STATE_DOWN};
 
     BfdUpdate update;
     update.peer = state_db_key;
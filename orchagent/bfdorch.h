@@ -3,6 +3,7 @@
 
 #include "orch.h"
 #include "observer.h"
+#include "redispipeline.h"
 
 struct BfdUpdate
 {
@@ -10,6 +11,21 @@ struct BfdUpdate
     sai_bfd_session_state_t state;
 };
 
+template <typename S>
+struct SaiOffloadSessionStateBatch;
+using BfdStateBatch = SaiOffloadSessionStateBatch<sai_bfd_session_state_t>;
+
+// A hardware session whose create is queued, key is empty when nothing was queued
+struct BfdPendingSession
+{
+    std::string key;
+    std::string state_db_key;
+    std::vector<sai_attribute_t> attrs;
+    std::vector<swss::FieldValueTuple> fvs;
+    sai_object_id_t id = SAI_NULL_OBJECT_ID;
+    sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+};
+
 class BfdOrch: public Orch, public Subject
 {
 public:
@@ -28,7 +44,10 @@ public:
     virtual void removeAllSoftwareBfdSessions();
 
 private:
-    bool create_bfd_session(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
+    bool create_bfd_session(const std::string& key, const std::vector<swss::FieldValueTuple>& data,
+                            BfdPendingSession *pending = nullptr);
+    bool complete_bfd_session(BfdPendingSession& session);
+    void handle_bfd_state_change(const std::string& data, BfdStateBatch& batch);
     bool remove_bfd_session(const std::string& key);
     std::string get_state_db_key(const std::string& vrf_name, const std::string& alias, const swss::IpAddress& peer_address);
 
@@ -45,6 +64,11 @@ private:
     std::map<sai_object_id_t, BfdUpdate> bfd_session_lookup;
 
     swss::Table m_stateBfdSessionTable;
+    // Session state changes of a notification batch are written in one pipeline flush
+    std::unique_ptr<swss::RedisPipeline> m_stateDbPipeline;
+    std::unique_ptr<swss::Table> m_stateBfdSessionBatchTable;
+    std::unique_ptr<swss::Table> m_stateNotificationStatsTable;
+    uint64_t m_max_notification_process_us = 0;
 
     std::unique_ptr<swss::DBConnector> m_stateDbConnector;
     std::unique_ptr<swss::Table> m_stateSoftBfdSessionTable;
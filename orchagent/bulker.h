@@ -423,6 +423,20 @@ struct SaiBulkerTraits<sai_dash_meter_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_dash_acl_api_t>
+{
+    // Only ACL rules are bulked, ACL groups are created one at a time
+    using entry_t = sai_object_id_t;
+    using api_t = sai_dash_acl_api_t;
+    using create_entry_fn = sai_create_dash_acl_rule_fn;
+    using remove_entry_fn = sai_remove_dash_acl_rule_fn;
+    using set_entry_attribute_fn = sai_set_dash_acl_rule_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_dash_vnet_api_t>
 {
@@ -1052,6 +1066,21 @@ public:
         return SAI_STATUS_NOT_EXECUTED;
     }
 
+    // Same as above, object_status receives the entry's status on flush
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+
+        *object_status = create_entry(object_id, attr_count, attr_list);
+        creating_statuses[object_id] = object_status;
+        return *object_status;
+    }
+
     sai_status_t remove_entry(
         _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id)
@@ -1076,23 +1105,28 @@ public:
         _In_ sai_object_id_t object_id,
         _In_ const sai_attribute_t *attr)
     {
-        auto found_setting = setting_entries.find(object_id);
-        if (found_setting != setting_entries.end())
-        {
-            // For simplicity, just insert new attribute at the vector end, no merging
-            found_setting->second.emplace_back(*attr);
-        }
-        else
-        {
-            // Create a new key if not exists in the map
-            auto& attrs = setting_entries.emplace(std::piecewise_construct,
-                std::forward_as_tuple(object_id),
-                std::forward_as_tuple()).first->second;
+        set_entry_attribute(nullptr, object_id, attr);
+        return SAI_STATUS_SUCCESS;
+    }
 
-            attrs.emplace_back(*attr);
-        }
+    void set_entry_attribute(
+        _Out_ sai_status_t *object_status,
+        _In_ sai_object_id_t object_id,
+        _In_ const sai_attribute_t *attr)
+    {
+        assert(attr);
+        if (!attr) throw std::invalid_argument("attr is null");
 
-        return SAI_STATUS_SUCCESS;
+        // Insert or find the key, for simplicity the attribute is appended without merging
+        auto& attrs = setting_entries.emplace(std::piecewise_construct,
+            std::forward_as_tuple(object_id),
+            std::forward_as_tuple()).first->second;
+
+        attrs.emplace_back(*attr, object_status);
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
     }
 
     void flush()
@@ -1147,12 +1181,14 @@ public:
             flush_creating_entries(rs, tss, cs);
 
             creating_entries.clear();
+            creating_statuses.clear();
         }
 
         if (!setting_entries.empty())
         {
             std::vector<sai_object_id_t> rs;
             std::vector<sai_attribute_t> ts;
+            std::vector<sai_status_t*> status_vector;
 
             for (auto const& i: setting_entries)
             {
@@ -1161,15 +1197,16 @@ public:
                 for (auto const& attr: attrs)
                 {
                     rs.push_back(entry);
-                    ts.push_back(attr);
+                    ts.push_back(attr.first);
+                    status_vector.push_back(attr.second);
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_setting_entries(rs, ts);
+                        flush_setting_entries(rs, ts, status_vector);
                     }
                 }
             }
-            flush_setting_entries(rs, ts);
+            flush_setting_entries(rs, ts, status_vector);
 
             setting_entries.clear();
         }
@@ -1179,6 +1216,7 @@ public:
     {
         removing_entries.clear();
         creating_entries.clear();
+        creating_statuses.clear();
         setting_entries.clear();
     }
 
@@ -1223,9 +1261,18 @@ private:
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
+                                                            // A map of
+                                                            // object_id pointer -> OUT object_status
+    std::unordered_map<sai_object_id_t *, sai_status_t *>   creating_statuses;
+
     std::unordered_map<                                     // A map of
-            sai_object_id_t,                                // object_id -> attrs
-            std::vector<sai_attribute_t>
+            sai_object_id_t,                                // object_id ->
+            std::vector<                                    //     vector of attribute and status
+                    std::pair<
+                            sai_attribute_t,                //     (attr_value, OUT object_status)
+                            sai_status_t *
+                    >
+            >
     >                                                       setting_entries;
 
                                                             // A map of
@@ -1299,6 +1346,12 @@ private:
             create_statuses.emplace(object_ids[i], statuses[i]);
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+
+            auto status_it = creating_statuses.find(pid);
+            if (status_it != creating_statuses.end())
+            {
+                *status_it->second = statuses[i];
+            }
         }
 
         rs.clear();
@@ -1310,7 +1363,8 @@ private:
 
     sai_status_t flush_setting_entries(
         _Inout_ std::vector<sai_object_id_t> &rs,
-        _Inout_ std::vector<sai_attribute_t> &ts)
+        _Inout_ std::vector<sai_attribute_t> &ts,
+        _Inout_ std::vector<sai_status_t*> &status_vector)
     {
         if (rs.empty())
         {
@@ -1330,8 +1384,17 @@ private:
                             count, sai_serialize_status(status).c_str());
         }
 
+        for (size_t ir = 0; ir < count; ir++)
+        {
+            if (status_vector[ir])
+            {
+                *status_vector[ir] = statuses[ir];
+            }
+        }
+
         rs.clear();
         ts.clear();
+        status_vector.clear();
 
         return status;
     }
@@ -1377,6 +1440,16 @@ inline ObjectBulker<sai_dash_meter_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash
     set_entries_attribute = nullptr;
 }
 
+template <>
+inline ObjectBulker<sai_dash_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_acl_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_dash_acl_rules;
+    remove_entries = api->remove_dash_acl_rules;
+    set_entries_attribute = nullptr;
+}
+
 template <>
 inline ObjectBulker<sai_dash_tunnel_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_tunnel_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size, sai_object_type_extensions_t object_type) :
     switch_id(switch_id),
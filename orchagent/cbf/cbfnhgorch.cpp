@@ -506,46 +506,66 @@ bool CbfNhg::update(const vector<string> &members, const string &selection_map)
     else
     {
         /*
-         * Because the INDEX attribute is CREATE_ONLY, we have to remove all
-         * the existing members and sync the new ones back as the order of the
-         * members can change due to some of them being removed, which would
-         * invalidate all the other members following them, or inserting a new
-         * one somewhere in the front of the existing members which would also
-         * invalidate them.
+         * Because the INDEX attribute is CREATE_ONLY, a member whose position
+         * changed has to be removed and synced back with the new index.  The
+         * members which kept their position are left untouched.
          */
-        set<string> members_set;
+        map<string, uint8_t> new_indices;
+        uint8_t index = 0;
+
+        for (const auto &member : members)
+        {
+            new_indices.emplace(member, index++);
+        }
+
+        if ((unsigned int)gNhgMapOrch->getLargestNhIndex(m_selection_map) >= new_indices.size())
+        {
+            SWSS_LOG_ERROR("FC to NHG map references more NHG members than exist in group %s",
+                           m_key.c_str());
+            return false;
+        }
+
+        set<string> removed_members;
 
         for (const auto &member : m_members)
         {
-            members_set.insert(member.first);
+            auto it = new_indices.find(member.first);
+
+            if ((it == new_indices.end()) || (it->second != member.second.getIndex()))
+            {
+                removed_members.insert(member.first);
+            }
         }
 
-        /* Remove the existing members. */
-        if (!removeMembers(members_set))
+        /* Remove the members that are gone or have moved. */
+        if (!removeMembers(removed_members))
         {
             SWSS_LOG_ERROR("Failed to remove members of CBF next hop group %s",
                             m_key.c_str());
             return false;
         }
-        m_members.clear();
-        m_temp_nhgs.clear();
 
-        /* Add the new members. */
-        uint8_t index = 0;
-        for (const auto &member : members)
+        for (const auto &member : removed_members)
         {
-            m_members.emplace(member, CbfNhgMember(member, index++));
+            m_members.erase(member);
+            m_temp_nhgs.erase(member);
         }
 
-        if ((unsigned int)gNhgMapOrch->getLargestNhIndex(m_selection_map) >= m_members.size())
+        /* Add the new members and sync the ones that aren't synced yet. */
+        set<string> syncing_members;
+
+        for (const auto &member : new_indices)
         {
-            SWSS_LOG_ERROR("FC to NHG map references more NHG members than exist in group %s",
-                           m_key.c_str());
-            return false;
+            auto &nhgm = m_members.emplace(member.first,
+                                           CbfNhgMember(member.first, member.second)).first->second;
+
+            if (!nhgm.isSynced())
+            {
+                syncing_members.insert(member.first);
+            }
         }
 
-        /* Sync the new members. */
-        if (!syncMembers({members.begin(), members.end()}))
+        if (!syncMembers(syncing_members))
         {
             SWSS_LOG_ERROR("Failed to sync members of CBF next hop group %s",
                             m_key.c_str());
@@ -3,7 +3,9 @@
 #include "select.h"
 #include "notifier.h"
 #include "sai_serialize.h"
+#include "counter_hash_reader.h"
 #include <inttypes.h>
+#include <stdlib.h>
 
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC   (5 * 60)
 
@@ -44,113 +46,111 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    mcCounterCheck();
-    pfcFrameCounterCheck();
+    refreshPorts();
+
+    vector<uint64_t> mcCounters;
+    vector<PfcFrameCounters> pfcFrameCounters;
+    if (!readCounters(mcCounters, pfcFrameCounters))
+    {
+        return;
+    }
+
+    mcCounterCheck(mcCounters);
+    pfcFrameCounterCheck(pfcFrameCounters);
 }
 
-void CounterCheckOrch::mcCounterCheck()
+void CounterCheckOrch::refreshPorts()
 {
     SWSS_LOG_ENTER();
 
-    for (auto& i : m_mcCountersMap)
+    /* Queues are created after the port in some flows, pick them up once they exist */
+    for (const auto& checked : m_ports)
     {
-        auto oid = i.first;
-        auto mcCounters = i.second;
-        uint8_t pfcMask = 0;
-
         Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        if (gPortsOrch->getPort(checked.portId, port) && port.m_queue_ids.size() != checked.queueCount)
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
-            continue;
+            m_portsDirty = true;
+            break;
         }
+    }
 
-        auto newMcCounters = getQueueMcCounters(port);
-
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
-        {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
-            continue;
-        }
+    if (!m_portsDirty)
+    {
+        return;
+    }
 
-        for (size_t prio = 0; prio != mcCounters.size(); prio++)
-        {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newMcCounters[prio] == numeric_limits<uint64_t>::max())
-            {
-                SWSS_LOG_WARN("Could not retreive MC counters on queue %zu port %s",
-                        prio,
-                        port.m_alias.c_str());
-            }
-            else if (!isLossy && mcCounters[prio] < newMcCounters[prio])
-            {
-                SWSS_LOG_WARN("Got Multicast %" PRIu64 " frame(s) on lossless queue %zu port %s",
-                        newMcCounters[prio] - mcCounters[prio],
-                        prio,
-                        port.m_alias.c_str());
-            }
-        }
+    /* Keep the last counters of the queues and ports that are still checked */
+    map<sai_object_id_t, uint64_t> lastMcCounters;
+    for (size_t i = 0; i < m_mcQueueIds.size(); i++)
+    {
+        lastMcCounters[m_mcQueueIds[i]] = m_mcCounters[i];
+    }
 
-        i.second= newMcCounters;
+    map<sai_object_id_t, PfcFrameCounters> lastPfcFrameCounters;
+    for (const auto& checked : m_ports)
+    {
+        lastPfcFrameCounters[checked.portId] = checked.pfcFrameCounters;
     }
-}
 
-void CounterCheckOrch::pfcFrameCounterCheck()
-{
-    SWSS_LOG_ENTER();
+    m_ports.clear();
+    m_portHashes.clear();
+    m_mcQueueIds.clear();
+    m_mcQueueHashes.clear();
+    m_mcCounters.clear();
 
-    for (auto& i : m_pfcFrameCountersMap)
+    for (auto portId : m_portIds)
     {
-        auto oid = i.first;
-        auto counters = i.second;
-        auto newCounters = getPfcFrameCounters(oid);
-        uint8_t pfcMask = 0;
-
-        Port port;
-        if (!gPortsOrch->getPort(oid, port))
+        CheckedPort checked;
+        checked.portId = portId;
+        checked.queueCount = 0;
+        checked.mcFirst = m_mcQueueIds.size();
+        checked.mcCount = 0;
+        checked.pfcFrameCounters.fill(numeric_limits<uint64_t>::max());
+
+        auto lastPfc = lastPfcFrameCounters.find(portId);
+        if (lastPfc != lastPfcFrameCounters.end())
         {
-            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, oid);
-            continue;
+            checked.pfcFrameCounters = lastPfc->second;
         }
 
-        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
+        Port port;
+        if (gPortsOrch->getPort(portId, port))
         {
-            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
-            continue;
-        }
+            checked.queueCount = port.m_queue_ids.size();
 
-        for (size_t prio = 0; prio != counters.size(); prio++)
-        {
-            bool isLossy = ((1 << prio) & pfcMask) == 0;
-            if (newCounters[prio] == numeric_limits<uint64_t>::max())
+            /* Queue types are cached by PortsOrch, only queues not seen before cost a SAI query */
+            for (auto queueId : port.m_queue_ids)
             {
-                SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
-                        prio,
-                        port.m_alias.c_str());
-            }
-            else if (isLossy && counters[prio] < newCounters[prio])
-            {
-                SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
-                        newCounters[prio] - counters[prio],
-                        prio,
-                        port.m_alias.c_str());
+                sai_queue_type_t queueType;
+                uint8_t queueIndex;
+                if (!gPortsOrch->getQueueTypeAndIndex(queueId, queueType, queueIndex) ||
+                    queueType != SAI_QUEUE_TYPE_MULTICAST)
+                {
+                    continue;
+                }
+
+                auto last = lastMcCounters.find(queueId);
+                m_mcQueueIds.push_back(queueId);
+                m_mcQueueHashes.push_back(m_countersTable->getKeyName(sai_serialize_object_id(queueId)));
+                m_mcCounters.push_back(last != lastMcCounters.end() ? last->second : numeric_limits<uint64_t>::max());
+                checked.mcCount++;
             }
         }
 
-        i.second = newCounters;
+        m_ports.push_back(checked);
+        m_portHashes.push_back(m_countersTable->getKeyName(sai_serialize_object_id(portId)));
     }
-}
 
+    m_portsDirty = false;
 
-PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
+    SWSS_LOG_INFO("Checking counters of %zu ports and %zu multicast queues", m_ports.size(), m_mcQueueIds.size());
+}
+
+bool CounterCheckOrch::readCounters(vector<uint64_t> &mcCounters, vector<PfcFrameCounters> &pfcFrameCounters)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    PfcFrameCounters counters;
-    counters.fill(numeric_limits<uint64_t>::max());
-
-    static const array<string, PFC_WD_TC_MAX> counterNames =
+    static const vector<string> pfcCounterNames =
     {
         "SAI_PORT_STAT_PFC_0_RX_PKTS",
         "SAI_PORT_STAT_PFC_1_RX_PKTS",
@@ -162,73 +162,135 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
         "SAI_PORT_STAT_PFC_7_RX_PKTS"
     };
 
-    if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
-    {
-        return counters;
-    }
+    PfcFrameCounters unknown;
+    unknown.fill(numeric_limits<uint64_t>::max());
+
+    mcCounters.assign(m_mcQueueIds.size(), numeric_limits<uint64_t>::max());
+    pfcFrameCounters.assign(m_ports.size(), unknown);
+
+    /* All queues and ports in one round trip instead of a get per object */
+    vector<CounterHashRead> reads;
+    reads.push_back({ m_mcQueueHashes, { "SAI_QUEUE_STAT_PACKETS" },
+        [&mcCounters](size_t queue, size_t, const string &value)
+        {
+            mcCounters[queue] = strtoull(value.c_str(), nullptr, 10);
+        } });
+    reads.push_back({ m_portHashes, pfcCounterNames,
+        [&pfcFrameCounters](size_t port, size_t prio, const string &value)
+        {
+            pfcFrameCounters[port][prio] = strtoull(value.c_str(), nullptr, 10);
+        } });
+
+    return readCounterHashes(m_countersDb.get(), reads);
+}
+
+void CounterCheckOrch::mcCounterCheck(const vector<uint64_t> &newMcCounters)
+{
+    SWSS_LOG_ENTER();
 
-    for (const auto& fv : fieldValues)
+    for (const auto& checked : m_ports)
     {
-        const auto field = fvField(fv);
-        const auto value = fvValue(fv);
+        uint8_t pfcMask = 0;
 
+        Port port;
+        if (!gPortsOrch->getPort(checked.portId, port))
+        {
+            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, checked.portId);
+            continue;
+        }
 
-        for (size_t prio = 0; prio != counterNames.size(); prio++)
+        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
         {
-            if (field == counterNames[prio])
+            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
+            continue;
+        }
+
+        for (size_t prio = 0; prio != checked.mcCount; prio++)
+        {
+            bool isLossy = ((1 << prio) & pfcMask) == 0;
+            uint64_t counter = m_mcCounters[checked.mcFirst + prio];
+            uint64_t newCounter = newMcCounters[checked.mcFirst + prio];
+
+            if (newCounter == numeric_limits<uint64_t>::max())
             {
-                counters[prio] = stoul(value);
+                /* Queues without counters in the DB were skipped before, only report a lost counter */
+                if (counter != numeric_limits<uint64_t>::max())
+                {
+                    SWSS_LOG_WARN("Could not retreive MC counters on queue %zu port %s",
+                            prio,
+                            port.m_alias.c_str());
+                }
+            }
+            else if (!isLossy && counter < newCounter)
+            {
+                SWSS_LOG_WARN("Got Multicast %" PRIu64 " frame(s) on lossless queue %zu port %s",
+                        newCounter - counter,
+                        prio,
+                        port.m_alias.c_str());
             }
         }
     }
 
-    return counters;
+    m_mcCounters = newMcCounters;
 }
 
-QueueMcCounters CounterCheckOrch::getQueueMcCounters(
-        const Port& port)
+void CounterCheckOrch::pfcFrameCounterCheck(const vector<PfcFrameCounters> &newCounters)
 {
     SWSS_LOG_ENTER();
 
-    vector<FieldValueTuple> fieldValues;
-    QueueMcCounters counters;
-
-    for (uint8_t prio = 0; prio < port.m_queue_ids.size(); prio++)
+    for (size_t i = 0; i < m_ports.size(); i++)
     {
-        sai_object_id_t queueId = port.m_queue_ids[prio];
-        auto queueIdStr = sai_serialize_object_id(queueId);
-        auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
+        auto& checked = m_ports[i];
+        auto& counters = checked.pfcFrameCounters;
+        const auto& newPortCounters = newCounters[i];
+        uint8_t pfcMask = 0;
 
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+        Port port;
+        if (!gPortsOrch->getPort(checked.portId, port))
         {
+            SWSS_LOG_ERROR("Invalid port oid 0x%" PRIx64, checked.portId);
             continue;
         }
 
-        uint64_t pkts = numeric_limits<uint64_t>::max();
-        for (const auto& fv : fieldValues)
+        if (!gPortsOrch->getPortPfc(port.m_port_id, &pfcMask))
         {
-            const auto field = fvField(fv);
-            const auto value = fvValue(fv);
+            SWSS_LOG_ERROR("Failed to get PFC mask on port %s", port.m_alias.c_str());
+            continue;
+        }
 
-            if (field == "SAI_QUEUE_STAT_PACKETS")
+        for (size_t prio = 0; prio != counters.size(); prio++)
+        {
+            bool isLossy = ((1 << prio) & pfcMask) == 0;
+            if (newPortCounters[prio] == numeric_limits<uint64_t>::max())
             {
-                pkts = stoul(value);
+                SWSS_LOG_WARN("Could not retreive PFC frame count on queue %zu port %s",
+                        prio,
+                        port.m_alias.c_str());
+            }
+            else if (isLossy && counters[prio] < newPortCounters[prio])
+            {
+                SWSS_LOG_WARN("Got PFC %" PRIu64 " frame(s) on lossy queue %zu port %s",
+                        newPortCounters[prio] - counters[prio],
+                        prio,
+                        port.m_alias.c_str());
             }
         }
-        counters.push_back(pkts);
-    }
 
-    return counters;
+        counters = newPortCounters;
+    }
 }
 
 void CounterCheckOrch::addPort(const Port& port)
 {
-    m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
-    m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
+    /* Counters are read on the next check, which also takes the first sample */
+    m_portIds.insert(port.m_port_id);
+    m_portsDirty = true;
 }
 
 void CounterCheckOrch::removePort(const Port& port)
 {
-    m_mcCountersMap.erase(port.m_port_id);
-    m_pfcFrameCountersMap.erase(port.m_port_id);
+    if (m_portIds.erase(port.m_port_id))
+    {
+        m_portsDirty = true;
+    }
 }
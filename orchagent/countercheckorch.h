@@ -5,6 +5,7 @@
 #include "port.h"
 #include "timer.h"
 #include <array>
+#include <set>
 
 #define PFC_WD_TC_MAX 8
 
@@ -12,7 +13,6 @@ extern "C" {
 #include "sai.h"
 }
 
-typedef std::vector<uint64_t> QueueMcCounters;
 typedef std::array<uint64_t, PFC_WD_TC_MAX> PfcFrameCounters;
 
 class CounterCheckOrch: public Orch
@@ -25,15 +25,35 @@ public:
     void removePort(const swss::Port& port);
 
 private:
+    /*
+     * Multicast queues of all checked ports are kept back to back in
+     * m_mcQueueIds/m_mcQueueHashes/m_mcCounters, every port owns the range
+     * starting at mcFirst, so a check walks flat arrays.
+     */
+    struct CheckedPort
+    {
+        sai_object_id_t portId;
+        size_t queueCount;
+        size_t mcFirst;
+        size_t mcCount;
+        PfcFrameCounters pfcFrameCounters;
+    };
+
     CounterCheckOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~CounterCheckOrch(void);
-    QueueMcCounters getQueueMcCounters(const swss::Port& port);
-    PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
-    void mcCounterCheck();
-    void pfcFrameCounterCheck();
-
-    std::map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
-    std::map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
+    void refreshPorts();
+    bool readCounters(std::vector<uint64_t> &mcCounters, std::vector<PfcFrameCounters> &pfcFrameCounters);
+    void mcCounterCheck(const std::vector<uint64_t> &newMcCounters);
+    void pfcFrameCounterCheck(const std::vector<PfcFrameCounters> &newCounters);
+
+    std::set<sai_object_id_t> m_portIds;
+    bool m_portsDirty = false;
+
+    std::vector<CheckedPort> m_ports;
+    std::vector<std::string> m_portHashes;
+    std::vector<sai_object_id_t> m_mcQueueIds;
+    std::vector<std::string> m_mcQueueHashes;
+    std::vector<uint64_t> m_mcCounters;
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
@@ -0,0 +1,405 @@
+#include <inttypes.h>
+#include <stdlib.h>
+#include <set>
+
+#include "counterrateorch.h"
+#include "watermarkorch.h"
+#include "portsorch.h"
+#include "sai_serialize.h"
+#include "schema.h"
+
+using namespace std;
+using namespace swss;
+
+extern PortsOrch *gPortsOrch;
+
+bool gNativeCounterRates = false;
+
+CounterRateOrch::CounterRateOrch(DBConnector *db, const vector<string> &tableNames) :
+    Orch(db, tableNames),
+    m_countersDb(make_shared<DBConnector>("COUNTERS_DB", 0)),
+    m_pipeline(make_unique<RedisPipeline>(m_countersDb.get()))
+{
+    SWSS_LOG_ENTER();
+
+    auto interv = timespec { .tv_sec = COUNTER_RATE_SAMPLE_MSECS / 1000, .tv_nsec = (COUNTER_RATE_SAMPLE_MSECS % 1000) * 1000000 };
+    m_pollTimer = new SelectableTimer(interv);
+    auto executor = new ExecutableTimer(m_pollTimer, this, "COUNTER_RATE_POLL");
+    Orch::addExecutor(executor);
+    m_pollTimer->start();
+
+    SWSS_LOG_NOTICE("Computing counter rates and watermarks natively instead of in the flex counter plugins");
+}
+
+void CounterRateOrch::setWatermarkStatus(uint8_t status)
+{
+    SWSS_LOG_ENTER();
+
+    m_wmStatus = status;
+}
+
+void CounterRateOrch::clearWatermark(const string &table, const string &key, const string &stat)
+{
+    m_engine.clearWatermark(table, key, stat);
+}
+
+void CounterRateOrch::setPollInterval(CounterRateGroup group, uint32_t msecs)
+{
+    SWSS_LOG_ENTER();
+
+    if (msecs == 0)
+    {
+        return;
+    }
+
+    switch (group)
+    {
+        case CounterRateGroup::PORT:
+            m_portPoll.intervalMs = msecs;
+            break;
+        case CounterRateGroup::RIF:
+            m_rifPoll.intervalMs = msecs;
+            break;
+        case CounterRateGroup::QUEUE_WATERMARK:
+            m_queueWmPoll.intervalMs = msecs;
+            break;
+        case CounterRateGroup::PG_WATERMARK:
+            m_pgWmPoll.intervalMs = msecs;
+            break;
+    }
+}
+
+bool CounterRateOrch::isPollDue(const RatePoll &poll, chrono::steady_clock::time_point now) const
+{
+    /* Start looking a bit early, timers of both sides drift */
+    return !poll.polled || now - poll.last >= chrono::milliseconds(poll.intervalMs * 3 / 4);
+}
+
+uint64_t CounterRateOrch::takePoll(RatePoll &poll, CounterRateGroup group, chrono::steady_clock::time_point now)
+{
+    bool landed = m_engine.takeNewPoll(group);
+    uint64_t elapsed = static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(now - poll.last).count());
+
+    /* Counters which did not move for two intervals are idle, not late, rates still have to decay */
+    if (poll.polled && !landed && elapsed < 2ULL * poll.intervalMs)
+    {
+        return 0;
+    }
+
+    /* Same delta the plugin gets, times the polls which landed since the last one taken */
+    uint64_t polls = poll.polled ? max<uint64_t>(1, (elapsed + poll.intervalMs / 2) / poll.intervalMs) : 1;
+    poll.last = now;
+    poll.polled = true;
+
+    return polls * poll.intervalMs;
+}
+
+bool CounterRateOrch::takeWatermarkPoll(RatePoll &poll, CounterRateGroup group, chrono::steady_clock::time_point now)
+{
+    /*
+     * Watermarks are read and cleared by every poll, so each one that lands
+     * is aggregated. A poll read again after WatermarkOrch cleared the
+     * watermark must not bring it back, so only new polls are taken.
+     */
+    bool landed = m_engine.takeNewPoll(group);
+    uint64_t elapsed = static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(now - poll.last).count());
+
+    /* A poll equal to the last one is still a poll, don't keep reading the group until it changes */
+    if (landed || !poll.polled || elapsed >= 2ULL * poll.intervalMs)
+    {
+        poll.last = now;
+        poll.polled = true;
+    }
+
+    return landed;
+}
+
+Table &CounterRateOrch::getTable(const string &name)
+{
+    auto &table = m_tables[name];
+    if (!table)
+    {
+        /* Buffered, so all writes of a poll go out in one pipeline flush */
+        table = make_unique<Table>(m_pipeline.get(), name, true);
+    }
+
+    return *table;
+}
+
+void CounterRateOrch::refreshGroup(CounterRateGroup group, const string &nameMap, bool keyIsField,
+                                   vector<string> &added)
+{
+    SWSS_LOG_ENTER();
+
+    vector<FieldValueTuple> values;
+    Table(m_countersDb.get(), nameMap).get("", values);
+
+    set<string> keys;
+    for (const auto &fv : values)
+    {
+        keys.insert(keyIsField ? fvField(fv) : fvValue(fv));
+    }
+
+    CounterColumnStore &store = m_engine.store(group);
+
+    vector<string> removed;
+    for (size_t row = 0; row < store.rows(); row++)
+    {
+        if (keys.find(store.key(row)) == keys.end())
+        {
+            removed.push_back(store.key(row));
+        }
+    }
+
+    for (const auto &key : removed)
+    {
+        m_engine.removeObject(group, key);
+    }
+
+    for (const auto &key : keys)
+    {
+        size_t row;
+        if (!store.findRow(key, row))
+        {
+            m_engine.addObject(group, key);
+            added.push_back(key);
+        }
+    }
+}
+
+void CounterRateOrch::refreshObjects()
+{
+    SWSS_LOG_ENTER();
+
+    vector<string> ports, rifs, queues, pgs;
+
+    refreshGroup(CounterRateGroup::PORT, COUNTERS_PORT_NAME_MAP, false, ports);
+    refreshGroup(CounterRateGroup::RIF, COUNTERS_RIF_NAME_MAP, false, rifs);
+    refreshGroup(CounterRateGroup::QUEUE_WATERMARK, COUNTERS_QUEUE_TYPE_MAP, true, queues);
+    refreshGroup(CounterRateGroup::PG_WATERMARK, COUNTERS_PG_INDEX_MAP, true, pgs);
+
+    /* Speeds may change at any time, they are read from PortsOrch and not from APPL_DB */
+    map<sai_object_id_t, uint32_t> laneCounts;
+    gPortsOrch->getPortLaneCounts(laneCounts);
+
+    CounterColumnStore &portStore = m_engine.store(CounterRateGroup::PORT);
+    for (size_t row = 0; row < portStore.rows(); row++)
+    {
+        sai_object_id_t id;
+        sai_deserialize_object_id(portStore.key(row), id);
+
+        Port port;
+        if (gPortsOrch->getPort(id, port))
+        {
+            m_engine.setPortSpeed(portStore.key(row), port.m_speed, laneCounts[id]);
+        }
+    }
+
+    if (!ports.empty() || !queues.empty() || !pgs.empty())
+    {
+        seedObjects(ports, queues, pgs);
+    }
+
+    SWSS_LOG_INFO("Added %zu ports, %zu RIFs, %zu queues and %zu PGs to native counter rates",
+                  ports.size(), rifs.size(), queues.size(), pgs.size());
+}
+
+void CounterRateOrch::seedObjects(const vector<string> &ports,
+                                  const vector<string> &queues,
+                                  const vector<string> &pgs)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Max type values outlive orchagent and plugin restarts in the DB, pick
+     * them up so they are never overwritten with a lower value.
+     */
+    vector<CounterHashRead> reads;
+
+    reads.push_back({ getHashNames(RATES_TABLE, ports), { "FEC_PRE_BER_MAX" },
+        [this, &ports](size_t key, size_t, const string &value)
+        {
+            m_engine.seedFecPreBerMax(ports[key], strtod(value.c_str(), nullptr));
+        } });
+
+    for (const auto &table : CounterRateEngine::watermarkTables())
+    {
+        for (auto group : { CounterRateGroup::QUEUE_WATERMARK, CounterRateGroup::PG_WATERMARK })
+        {
+            const auto &keys = group == CounterRateGroup::QUEUE_WATERMARK ? queues : pgs;
+            const auto &stats = m_engine.store(group).counterNames();
+
+            reads.push_back({ getHashNames(table, keys), stats,
+                [this, group, &table, &keys, &stats](size_t key, size_t field, const string &value)
+                {
+                    m_engine.seedWatermark(group, table, keys[key], stats[field], strtoull(value.c_str(), nullptr, 10));
+                } });
+        }
+    }
+
+    readCounterHashes(m_countersDb.get(), reads);
+}
+
+void CounterRateOrch::addCounterRead(CounterRateGroup group, vector<CounterHashRead> &reads)
+{
+    CounterColumnStore &store = m_engine.store(group);
+
+    vector<string> keys;
+    keys.reserve(store.rows());
+    for (size_t row = 0; row < store.rows(); row++)
+    {
+        keys.push_back(store.key(row));
+        for (size_t column = 0; column < store.counterNames().size(); column++)
+        {
+            store.clearCounter(column, row);
+        }
+    }
+
+    reads.push_back({ getHashNames(COUNTERS_TABLE, keys), store.counterNames(),
+        [&store](size_t row, size_t column, const string &value)
+        {
+            char *end = nullptr;
+            uint64_t counter = strtoull(value.c_str(), &end, 10);
+            if (end != value.c_str() && *end == '\0')
+            {
+                store.setCounter(column, row, counter);
+            }
+        } });
+}
+
+vector<string> CounterRateOrch::getHashNames(const string &table, const vector<string> &keys)
+{
+    Table &t = getTable(table);
+
+    vector<string> hashes;
+    hashes.reserve(keys.size());
+    for (const auto &key : keys)
+    {
+        hashes.push_back(t.getKeyName(key));
+    }
+
+    return hashes;
+}
+
+void CounterRateOrch::writeUpdates(const vector<CounterRateUpdate> &updates)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &update : updates)
+    {
+        getTable(update.table).set(update.key, update.values);
+    }
+
+    m_pipeline->flush();
+}
+
+void CounterRateOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!gPortsOrch->allPortsReady())
+    {
+        return;
+    }
+
+    auto now = chrono::steady_clock::now();
+
+    if (!m_refreshed || now - m_lastRefresh >= chrono::seconds(COUNTER_RATE_REFRESH_OBJECTS_SEC))
+    {
+        refreshObjects();
+        m_lastRefresh = now;
+        m_refreshed = true;
+    }
+
+    bool readPorts = isPollDue(m_portPoll, now);
+    bool readRifs = isPollDue(m_rifPoll, now);
+    bool readQueueWms = (m_wmStatus & queue_wm_status_mask) && isPollDue(m_queueWmPoll, now);
+    bool readPgWms = (m_wmStatus & pg_wm_status_mask) && isPollDue(m_pgWmPoll, now);
+    bool computeFlr = !m_flrComputed || now - m_lastFlr >= chrono::seconds(COUNTER_RATE_FLR_INTERVAL_SEC);
+
+    if (!readPorts && !readRifs && !readQueueWms && !readPgWms)
+    {
+        return;
+    }
+
+    bool hasPortAlpha = false, hasRifAlpha = false;
+    double portAlpha = 0, rifAlpha = 0;
+
+    vector<CounterHashRead> reads;
+    reads.push_back({ getHashNames(RATES_TABLE, { "PORT", "RIF" }), { "PORT_ALPHA", "RIF_ALPHA" },
+        [&](size_t key, size_t field, const string &value)
+        {
+            if (key == 0 && field == 0)
+            {
+                hasPortAlpha = true;
+                portAlpha = strtod(value.c_str(), nullptr);
+            }
+            else if (key == 1 && field == 1)
+            {
+                hasRifAlpha = true;
+                rifAlpha = strtod(value.c_str(), nullptr);
+            }
+        } });
+
+    if (readPorts)
+    {
+        addCounterRead(CounterRateGroup::PORT, reads);
+    }
+    if (readRifs)
+    {
+        addCounterRead(CounterRateGroup::RIF, reads);
+    }
+    if (readQueueWms)
+    {
+        addCounterRead(CounterRateGroup::QUEUE_WATERMARK, reads);
+    }
+    if (readPgWms)
+    {
+        addCounterRead(CounterRateGroup::PG_WATERMARK, reads);
+    }
+
+    if (!readCounterHashes(m_countersDb.get(), reads))
+    {
+        return;
+    }
+
+    vector<CounterRateUpdate> updates;
+
+    uint64_t portDeltaMs = readPorts ? takePoll(m_portPoll, CounterRateGroup::PORT, now) : 0;
+    if (portDeltaMs)
+    {
+        m_engine.computePortRates(hasPortAlpha, portAlpha, portDeltaMs, updates);
+
+        if (computeFlr)
+        {
+            m_engine.computePortFlr(updates);
+            m_lastFlr = now;
+            m_flrComputed = true;
+        }
+    }
+
+    uint64_t rifDeltaMs = readRifs ? takePoll(m_rifPoll, CounterRateGroup::RIF, now) : 0;
+    if (rifDeltaMs)
+    {
+        m_engine.computeRifRates(hasRifAlpha, rifAlpha, rifDeltaMs, updates);
+    }
+
+    if (readQueueWms && takeWatermarkPoll(m_queueWmPoll, CounterRateGroup::QUEUE_WATERMARK, now))
+    {
+        m_engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+    }
+    if (readPgWms && takeWatermarkPoll(m_pgWmPoll, CounterRateGroup::PG_WATERMARK, now))
+    {
+        m_engine.computeWatermarks(CounterRateGroup::PG_WATERMARK, updates);
+    }
+
+    if (updates.empty())
+    {
+        return;
+    }
+
+    writeUpdates(updates);
+
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - now).count();
+    SWSS_LOG_DEBUG("Wrote %zu counter rate updates in %" PRId64 " us", updates.size(), static_cast<int64_t>(elapsed));
+}
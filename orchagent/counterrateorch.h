@@ -0,0 +1,96 @@
+#ifndef COUNTERRATE_ORCH_H
+#define COUNTERRATE_ORCH_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include "orch.h"
+#include "timer.h"
+#include "redispipeline.h"
+#include "counter_rate_engine.h"
+#include "counter_hash_reader.h"
+
+/* COUNTERS_DB is checked for a new flex counter poll at this period */
+#define COUNTER_RATE_SAMPLE_MSECS           250
+/* Default PORT and RIF flex counter poll interval, rates are computed once per poll */
+#define COUNTER_RATE_DEFAULT_POLL_MSECS     1000
+/* Default QUEUE/PG_WATERMARK poll interval, each read and clear poll is aggregated */
+#define COUNTER_RATE_DEFAULT_WM_POLL_MSECS  60000
+#define COUNTER_RATE_FLR_INTERVAL_SEC       120
+#define COUNTER_RATE_REFRESH_OBJECTS_SEC    10
+
+/*
+ * Computes the port and RIF rates, FEC BER/FLR and the queue and PG watermarks
+ * in orchagent instead of in the flex counter Lua plugins. Counters are read
+ * from COUNTERS_DB with one pipelined round trip per poll into the engine's
+ * column stores, and the results are written back in one pipelined batch.
+ * Enabled with "-C native", the Lua plugins are used otherwise.
+ */
+class CounterRateOrch : public Orch
+{
+public:
+    CounterRateOrch(swss::DBConnector *db, const std::vector<std::string> &tableNames);
+
+    void doTask(Consumer &consumer) {}
+    void doTask(swss::SelectableTimer &timer);
+
+    /* Same mask WatermarkOrch keeps for the QUEUE/PG_WATERMARK flex counter groups */
+    void setWatermarkStatus(uint8_t status);
+
+    /* Called when WatermarkOrch zeroes a watermark in the DB */
+    void clearWatermark(const std::string &table, const std::string &key, const std::string &stat);
+
+    /*
+     * POLL_INTERVAL of a flex counter group: the delta the Lua plugins get for
+     * PORT and RIF, how often a new read and clear poll lands for watermarks
+     */
+    void setPollInterval(CounterRateGroup group, uint32_t msecs);
+
+private:
+    /* Flex counter polls of a rate group as seen in COUNTERS_DB */
+    struct RatePoll
+    {
+        uint32_t intervalMs;
+        std::chrono::steady_clock::time_point last;
+        bool polled = false;
+
+        RatePoll(uint32_t intervalMs) : intervalMs(intervalMs) {}
+    };
+
+    bool isPollDue(const RatePoll &poll, std::chrono::steady_clock::time_point now) const;
+    uint64_t takePoll(RatePoll &poll, CounterRateGroup group, std::chrono::steady_clock::time_point now);
+    bool takeWatermarkPoll(RatePoll &poll, CounterRateGroup group, std::chrono::steady_clock::time_point now);
+
+    void refreshObjects();
+    void refreshGroup(CounterRateGroup group, const std::string &nameMap, bool keyIsField,
+                      std::vector<std::string> &added);
+    void seedObjects(const std::vector<std::string> &ports,
+                     const std::vector<std::string> &queues,
+                     const std::vector<std::string> &pgs);
+
+    void addCounterRead(CounterRateGroup group, std::vector<CounterHashRead> &reads);
+    std::vector<std::string> getHashNames(const std::string &table, const std::vector<std::string> &keys);
+    void writeUpdates(const std::vector<CounterRateUpdate> &updates);
+    swss::Table &getTable(const std::string &name);
+
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
+    std::map<std::string, std::unique_ptr<swss::Table>> m_tables;
+
+    swss::SelectableTimer *m_pollTimer = nullptr;
+    CounterRateEngine m_engine;
+
+    uint8_t m_wmStatus = 0;
+
+    RatePoll m_portPoll { COUNTER_RATE_DEFAULT_POLL_MSECS };
+    RatePoll m_rifPoll { COUNTER_RATE_DEFAULT_POLL_MSECS };
+    RatePoll m_queueWmPoll { COUNTER_RATE_DEFAULT_WM_POLL_MSECS };
+    RatePoll m_pgWmPoll { COUNTER_RATE_DEFAULT_WM_POLL_MSECS };
+    std::chrono::steady_clock::time_point m_lastRefresh;
+    std::chrono::steady_clock::time_point m_lastFlr;
+    bool m_refreshed = false;
+    bool m_flrComputed = false;
+};
+
+#endif /* COUNTERRATE_ORCH_H */
@@ -14,6 +14,7 @@
 extern sai_dash_acl_api_t* sai_dash_acl_api;
 extern sai_dash_eni_api_t* sai_dash_eni_api;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern CrmOrch *gCrmOrch;
 
 using namespace std;
@@ -127,22 +128,23 @@ sai_attr_id_t getSaiStage(DashAclDirection d, sai_ip_addr_family_t f, DashAclSta
     return stage->second;
 }
 
-DashAclRuleInfo::DashAclRuleInfo(const DashAclRule &rule) :
-    m_src_tags(rule.m_src_tags),
-    m_dst_tags(rule.m_dst_tags)
+DashAclRuleInfo::DashAclRuleInfo(const string &rule_id, const DashAclRule &rule) :
+    m_rule_id(rule_id),
+    m_rule(rule)
 {
     SWSS_LOG_ENTER();
 }
 
 bool DashAclRuleInfo::isTagUsed(const std::string &tag_id) const
 {
-    return (m_src_tags.find(tag_id) != end(m_src_tags)) || (m_dst_tags.find(tag_id) != end(m_dst_tags));
+    return (m_rule.m_src_tags.find(tag_id) != end(m_rule.m_src_tags)) || (m_rule.m_dst_tags.find(tag_id) != end(m_rule.m_dst_tags));
 }
 
 DashAclGroupMgr::DashAclGroupMgr(DBConnector *db, DashOrch *dashorch, DashAclOrch *aclorch) :
     m_dash_orch(dashorch),
     m_dash_acl_orch(aclorch),
-    m_dash_acl_rules_table(new Table(db, APP_DASH_ACL_RULE_TABLE_NAME))
+    m_dash_acl_rules_table(new Table(db, APP_DASH_ACL_RULE_TABLE_NAME)),
+    m_dash_acl_rule_bulker(sai_dash_acl_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 }
@@ -154,7 +156,7 @@ void DashAclGroupMgr::init(DashAclGroup& group)
 
 }
 
-void DashAclGroupMgr::create(DashAclGroup& group)
+bool DashAclGroupMgr::create(DashAclGroup& group)
 {
     SWSS_LOG_ENTER();
 
@@ -174,6 +176,8 @@ void DashAclGroupMgr::create(DashAclGroup& group)
     CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
         CrmResourceType::CRM_DASH_IPV4_ACL_GROUP : CrmResourceType::CRM_DASH_IPV6_ACL_GROUP;
     gCrmOrch->incCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+
+    return status == SAI_STATUS_SUCCESS;
 }
 
 task_process_status DashAclGroupMgr::create(const string& group_id, DashAclGroup& group)
@@ -239,8 +243,21 @@ task_process_status DashAclGroupMgr::remove(const string& group_id)
 
     remove(group);
 
-    m_groups_table.erase(group_id);
+    for (const auto& tag_id : group.m_tags)
+    {
+        auto tag_it = m_tag_rules.find(tag_id);
+        if (tag_it != m_tag_rules.end())
+        {
+            tag_it->second.erase(group_id);
+            if (tag_it->second.empty())
+            {
+                m_tag_rules.erase(tag_it);
+            }
+        }
+    }
+
     detachTags(group_id, group.m_tags);
+    m_groups_table.erase(group_it);
     SWSS_LOG_INFO("Removed ACL group %s", group_id.c_str());
 
     return task_success;
@@ -253,15 +270,22 @@ bool DashAclGroupMgr::exists(const string& group_id) const
     return m_groups_table.find(group_id) != m_groups_table.end();
 }
 
-DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& rule)
+void DashAclGroupMgr::queueRule(const string& group_id, DashAclGroup& group, const DashAclRuleInfo& rule_info)
 {
     SWSS_LOG_ENTER();
 
-    vector<sai_attribute_t> attrs;
-    vector<sai_ip_prefix_t> src_prefixes = {};
-    vector<sai_ip_prefix_t> dst_prefixes = {};
+    m_pending_rules.emplace_back();
+    auto& pending = m_pending_rules.back();
+    pending.m_group_id = group_id;
+    pending.m_info = rule_info;
+    pending.m_info.m_dash_acl_rule_id = SAI_NULL_OBJECT_ID;
 
-    DashAclRuleInfo rule_info = rule;
+    auto& rule = pending.m_info.m_rule;
+    auto& protocols = pending.m_protocols;
+    auto& src_prefixes = pending.m_src_prefixes;
+    auto& dst_prefixes = pending.m_dst_prefixes;
+
+    vector<sai_attribute_t> attrs;
 
     auto any_ip = [] (const auto& g)
     {
@@ -291,7 +315,6 @@ DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& ru
     attrs.emplace_back();
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_PROTOCOL;
 
-    vector<uint8_t> protocols;
     if (rule.m_protocols.size()) {
         protocols = rule.m_protocols;
     } else {
@@ -364,18 +387,130 @@ DashAclRuleInfo DashAclGroupMgr::createRule(DashAclGroup& group, DashAclRule& ru
     attrs.back().id = SAI_DASH_ACL_RULE_ATTR_DASH_ACL_GROUP_ID;
     attrs.back().value.oid = group.m_dash_acl_group_id;
 
-    auto status = sai_dash_acl_api->create_dash_acl_rule(&rule_info.m_dash_acl_rule_id, gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    m_dash_acl_rule_bulker.create_entry(&pending.m_info.m_dash_acl_rule_id, &pending.m_status, static_cast<uint32_t>(attrs.size()), attrs.data());
+}
+
+void DashAclGroupMgr::queueRuleRemoval(const string& group_id, const DashAclGroup& group, sai_object_id_t rule_id)
+{
+    SWSS_LOG_ENTER();
+
+    m_pending_rule_removals.push_back({ group_id, group.m_dash_acl_group_id, rule_id, SAI_STATUS_NOT_EXECUTED });
+
+    auto& removal = m_pending_rule_removals.back();
+    m_dash_acl_rule_bulker.remove_entry(&removal.m_status, removal.m_dash_acl_rule_id);
+}
+
+bool DashAclGroupMgr::flushRules(unordered_map<string, task_process_status> *failed_rules)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pending_rules.empty() && m_pending_rule_removals.empty())
     {
-        SWSS_LOG_ERROR("Failed to create ACL rule: %d, %s", status, sai_serialize_status(status).c_str());
-        handleSaiCreateStatus((sai_api_t)SAI_API_DASH_ACL, status);
+        return true;
     }
 
-    CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
-            CrmResourceType::CRM_DASH_IPV4_ACL_RULE : CrmResourceType::CRM_DASH_IPV6_ACL_RULE;
-    gCrmOrch->incCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+    m_dash_acl_rule_bulker.flush();
+
+    bool success = true;
+
+    for (const auto& removal : m_pending_rule_removals)
+    {
+        if (removal.m_status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove ACL rule: %d, %s", removal.m_status, sai_serialize_status(removal.m_status).c_str());
+            handleSaiRemoveStatus((sai_api_t)SAI_API_DASH_ACL, removal.m_status);
+            success = false;
+            continue;
+        }
+
+        auto group_it = m_groups_table.find(removal.m_group_id);
+        if (group_it == m_groups_table.end())
+        {
+            continue;
+        }
+
+        auto& group = group_it->second;
+        auto rule_it = group.m_dash_acl_rule_table.find(removal.m_dash_acl_rule_id);
+        if (rule_it == group.m_dash_acl_rule_table.end())
+        {
+            continue;
+        }
+
+        for (const auto& tags : { rule_it->second.m_rule.m_src_tags, rule_it->second.m_rule.m_dst_tags })
+        {
+            for (const auto& tag_id : tags)
+            {
+                m_tag_rules[tag_id][removal.m_group_id].erase(removal.m_dash_acl_rule_id);
+            }
+        }
+
+        group.m_dash_acl_rule_table.erase(rule_it);
+        group.m_rule_count--;
+
+        CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
+                CrmResourceType::CRM_DASH_IPV4_ACL_RULE : CrmResourceType::CRM_DASH_IPV6_ACL_RULE;
+        gCrmOrch->decCrmDashAclUsedCounter(crm_rtype, removal.m_dash_acl_group_id);
+    }
+
+    unordered_set<string> updated_groups;
+
+    for (const auto& pending : m_pending_rules)
+    {
+        const auto& rule_info = pending.m_info;
+
+        if (pending.m_status != SAI_STATUS_SUCCESS || rule_info.m_dash_acl_rule_id == SAI_NULL_OBJECT_ID)
+        {
+            auto status = (pending.m_status == SAI_STATUS_SUCCESS) ? SAI_STATUS_FAILURE : pending.m_status;
+            SWSS_LOG_ERROR("Failed to create ACL rule %s:%s: %d, %s", pending.m_group_id.c_str(), rule_info.m_rule_id.c_str(),
+                           status, sai_serialize_status(status).c_str());
+
+            // Rules behind a failed one in the bulk weren't tried at all
+            auto handle_status = (status == SAI_STATUS_NOT_EXECUTED) ?
+                    task_need_retry : handleSaiCreateStatus((sai_api_t)SAI_API_DASH_ACL, status);
+            if (failed_rules)
+            {
+                (*failed_rules)[pending.m_group_id + ":" + rule_info.m_rule_id] = handle_status;
+            }
+            success = false;
+            continue;
+        }
+
+        auto group_it = m_groups_table.find(pending.m_group_id);
+        if (group_it == m_groups_table.end())
+        {
+            continue;
+        }
+
+        auto& group = group_it->second;
 
-    return rule_info;
+        for (const auto& tags : { rule_info.m_rule.m_src_tags, rule_info.m_rule.m_dst_tags })
+        {
+            for (const auto& tag_id : tags)
+            {
+                m_tag_rules[tag_id][pending.m_group_id].insert(rule_info.m_dash_acl_rule_id);
+            }
+        }
+
+        group.m_dash_acl_rule_table.emplace(rule_info.m_dash_acl_rule_id, rule_info);
+        group.m_rule_count++;
+        updated_groups.insert(pending.m_group_id);
+
+        CrmResourceType crm_rtype = (group.m_ip_version == SAI_IP_ADDR_FAMILY_IPV4) ?
+                CrmResourceType::CRM_DASH_IPV4_ACL_RULE : CrmResourceType::CRM_DASH_IPV6_ACL_RULE;
+        gCrmOrch->incCrmDashAclUsedCounter(crm_rtype, group.m_dash_acl_group_id);
+
+        SWSS_LOG_INFO("Created ACL rule %s:%s", pending.m_group_id.c_str(), rule_info.m_rule_id.c_str());
+    }
+
+    for (const auto& group_id : updated_groups)
+    {
+        attachTags(group_id, m_groups_table.at(group_id).m_tags);
+    }
+
+    m_pending_rules.clear();
+    m_pending_rule_removals.clear();
+
+    return success;
 }
 
 task_process_status DashAclGroupMgr::createRule(const string& group_id, const string& rule_id, DashAclRule& rule)
@@ -408,14 +543,159 @@ task_process_status DashAclGroupMgr::createRule(const string& group_id, const st
         }
     }
 
-    auto rule_info = createRule(group, rule);
+    queueRule(group_id, group, DashAclRuleInfo(rule_id, rule));
 
-    group.m_rule_count++;
-    attachTags(group_id, group.m_tags);
+    return task_success;
+}
 
-    SWSS_LOG_INFO("Created ACL rule %s:%s", group_id.c_str(), rule_id.c_str());
+bool DashAclGroupMgr::refreshRules(const string& group_id, DashAclGroup& group, const unordered_set<sai_object_id_t>& rule_ids)
+{
+    SWSS_LOG_ENTER();
 
-    return task_success;
+    // The group isn't bound, so the rules are rebuilt next to the old ones,
+    // an old rule is only removed once its replacement is created
+    for (auto rule_id : rule_ids)
+    {
+        queueRule(group_id, group, group.m_dash_acl_rule_table.at(rule_id));
+    }
+
+    unordered_map<string, task_process_status> failed_rules;
+    bool success = flushRules(&failed_rules);
+
+    for (auto rule_id : rule_ids)
+    {
+        const auto& rule_info = group.m_dash_acl_rule_table.at(rule_id);
+        if (failed_rules.find(group_id + ":" + rule_info.m_rule_id) != failed_rules.end())
+        {
+            SWSS_LOG_WARN("Keeping ACL rule %s:%s with the old prefixes", group_id.c_str(), rule_info.m_rule_id.c_str());
+            continue;
+        }
+
+        queueRuleRemoval(group_id, group, rule_id);
+    }
+
+    return flushRules() && success;
+}
+
+bool DashAclGroupMgr::refreshBoundGroup(const string& group_id, DashAclGroup& group)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * A rule can't be changed or moved to another group, so the group is
+     * rebuilt next to the bound one and the ENIs are moved over to it before
+     * the old one is removed.
+     */
+    DashAclGroup old_group;
+    old_group.m_dash_acl_group_id = group.m_dash_acl_group_id;
+    old_group.m_ip_version = group.m_ip_version;
+
+    vector<sai_object_id_t> old_rules;
+    for (const auto& it : group.m_dash_acl_rule_table)
+    {
+        old_rules.push_back(it.first);
+    }
+
+    if (!create(group))
+    {
+        group.m_dash_acl_group_id = old_group.m_dash_acl_group_id;
+        return false;
+    }
+
+    for (auto rule_id : old_rules)
+    {
+        queueRule(group_id, group, group.m_dash_acl_rule_table.at(rule_id));
+    }
+
+    if (!flushRules())
+    {
+        SWSS_LOG_ERROR("Failed to rebuild ACL group %s, keeping the bound one", group_id.c_str());
+
+        unordered_set<sai_object_id_t> kept(old_rules.begin(), old_rules.end());
+        for (const auto& it : group.m_dash_acl_rule_table)
+        {
+            if (kept.find(it.first) == kept.end())
+            {
+                queueRuleRemoval(group_id, group, it.first);
+            }
+        }
+        flushRules();
+
+        remove(group);
+        group.m_dash_acl_group_id = old_group.m_dash_acl_group_id;
+
+        return false;
+    }
+
+    for (auto direction : { DashAclDirection::IN, DashAclDirection::OUT })
+    {
+        const auto& table = (direction == DashAclDirection::IN) ? group.m_in_tables : group.m_out_tables;
+
+        for (const auto& eni_it : table)
+        {
+            auto eni = m_dash_orch->getEni(eni_it.first);
+            if (!eni)
+            {
+                SWSS_LOG_WARN("eni %s cannot be found", eni_it.first.c_str());
+                continue;
+            }
+
+            for (auto stage : eni_it.second)
+            {
+                bind(group, *eni, direction, stage);
+            }
+        }
+    }
+
+    for (auto rule_id : old_rules)
+    {
+        queueRuleRemoval(group_id, old_group, rule_id);
+    }
+    flushRules();
+
+    remove(old_group);
+
+    SWSS_LOG_INFO("Rebuilt ACL group %s", group_id.c_str());
+
+    return true;
+}
+
+task_process_status DashAclGroupMgr::refreshTag(const string& tag_id)
+{
+    SWSS_LOG_ENTER();
+
+    // Rules queued earlier in this pass have to be in the index first
+    flushRules();
+
+    auto tag_it = m_tag_rules.find(tag_id);
+    if (tag_it == m_tag_rules.end())
+    {
+        return task_success;
+    }
+
+    // Copied, the index changes while the rules are rebuilt
+    auto groups = tag_it->second;
+    bool success = true;
+
+    for (const auto& it : groups)
+    {
+        if (it.second.empty())
+        {
+            continue;
+        }
+
+        auto& group = m_groups_table.at(it.first);
+        if (isBound(group))
+        {
+            success = refreshBoundGroup(it.first, group) && success;
+        }
+        else
+        {
+            success = refreshRules(it.first, group, it.second) && success;
+        }
+    }
+
+    return success ? task_success : task_failed;
 }
 
 void DashAclGroupMgr::bind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage)
@@ -2,6 +2,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <deque>
 
 #include <saitypes.h>
 #include <sai.h>
@@ -10,6 +11,7 @@
 #include "dashorch.h"
 #include "dashtagmgr.h"
 #include "table.h"
+#include "bulker.h"
 
 #include "dash_api/acl_group.pb.h"
 #include "dash_api/acl_rule.pb.h"
@@ -55,15 +57,35 @@ struct DashAclRuleInfo
 {
     sai_object_id_t m_dash_acl_rule_id = SAI_NULL_OBJECT_ID;
 
-    std::unordered_set<std::string> m_src_tags;
-    std::unordered_set<std::string> m_dst_tags;
+    std::string m_rule_id;
+    // Kept to rebuild the rule when a prefix tag it uses changes
+    DashAclRule m_rule;
 
     DashAclRuleInfo() = default;
-    DashAclRuleInfo(const DashAclRule &rule);
+    DashAclRuleInfo(const std::string &rule_id, const DashAclRule &rule);
 
     bool isTagUsed(const std::string &tag_id) const;
 };
 
+// A rule queued on the rule bulker, its SAI attributes point into the lists here
+struct DashAclPendingRule
+{
+    std::string m_group_id;
+    DashAclRuleInfo m_info;
+    std::vector<std::uint8_t> m_protocols;
+    std::vector<sai_ip_prefix_t> m_src_prefixes;
+    std::vector<sai_ip_prefix_t> m_dst_prefixes;
+    sai_status_t m_status;
+};
+
+struct DashAclPendingRuleRemoval
+{
+    std::string m_group_id;
+    sai_object_id_t m_dash_acl_group_id;
+    sai_object_id_t m_dash_acl_rule_id;
+    sai_status_t m_status;
+};
+
 struct DashAclGroup
 {
     using EniTable = std::unordered_map<std::string, std::unordered_set<DashAclStage>>;
@@ -71,6 +93,9 @@ struct DashAclGroup
     std::unordered_set<std::string> m_tags;
     int m_rule_count = 0;
 
+    // Rules by SAI ID, a rule set again is created again
+    std::unordered_map<sai_object_id_t, DashAclRuleInfo> m_dash_acl_rule_table;
+
     sai_ip_addr_family_t m_ip_version;
     
     EniTable m_in_tables;
@@ -99,6 +124,13 @@ class DashAclGroupMgr
     std::unordered_map<std::string, DashAclGroup> m_groups_table;
     std::unique_ptr<swss::Table> m_dash_acl_rules_table;
 
+    // Tag -> group -> SAI IDs of the group's rules that use the tag
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<sai_object_id_t>>> m_tag_rules;
+
+    ObjectBulker<sai_dash_acl_api_t> m_dash_acl_rule_bulker;
+    std::deque<DashAclPendingRule> m_pending_rules;
+    std::deque<DashAclPendingRuleRemoval> m_pending_rule_removals;
+
 public:
     DashAclGroupMgr(swss::DBConnector *db, DashOrch *dashorch, DashAclOrch *aclorch);
 
@@ -107,17 +139,26 @@ public:
     bool exists(const std::string& group_id) const;
     bool isBound(const std::string& group_id);
 
+    // Rules are queued on the rule bulker and programmed by flushRules(),
+    // rules that failed to be created are returned by "group:rule" key
     task_process_status createRule(const std::string& group_id, const std::string& rule_id, DashAclRule& rule);
+    bool flushRules(std::unordered_map<std::string, task_process_status> *failed_rules = nullptr);
+
+    // Rebuilds the rules that use the tag after its prefixes changed
+    task_process_status refreshTag(const std::string& tag_id);
 
     task_process_status bind(const std::string& group_id, const std::string& eni_id, DashAclDirection direction, DashAclStage stage);
     task_process_status unbind(const std::string& group_id, const std::string& eni_id, DashAclDirection direction, DashAclStage stage);
 
 private:
     void init(DashAclGroup& group);
-    void create(DashAclGroup& group);
+    bool create(DashAclGroup& group);
     void remove(DashAclGroup& group);
 
-    DashAclRuleInfo createRule(DashAclGroup& group, DashAclRule& rule);
+    void queueRule(const std::string& group_id, DashAclGroup& group, const DashAclRuleInfo& rule_info);
+    void queueRuleRemoval(const std::string& group_id, const DashAclGroup& group, sai_object_id_t rule_id);
+    bool refreshRules(const std::string& group_id, DashAclGroup& group, const std::unordered_set<sai_object_id_t>& rule_ids);
+    bool refreshBoundGroup(const std::string& group_id, DashAclGroup& group);
 
     void bind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage);
     void unbind(const DashAclGroup& group, const EniEntry& eni, DashAclDirection direction, DashAclStage stage);
@@ -113,6 +113,7 @@ void DashAclOrch::doTask(ConsumerBase &consumer)
      };
 
     const string &table_name = consumer.getTableName();
+    vector<SyncMap::iterator> queued_rules;
     auto itr = consumer.m_toSync.begin();
     while (itr != consumer.m_toSync.end())
     {
@@ -141,6 +142,11 @@ void DashAclOrch::doTask(ConsumerBase &consumer)
                 op.c_str());
             ++itr;
         }
+        else if (task_status == task_success && table_name == APP_DASH_ACL_RULE_TABLE_NAME && op == SET_COMMAND)
+        {
+            // Only queued, the task is kept until the rule is programmed
+            queued_rules.push_back(itr++);
+        }
         else
         {
             if (task_status != task_success)
@@ -160,6 +166,24 @@ void DashAclOrch::doTask(ConsumerBase &consumer)
             itr = consumer.m_toSync.erase(itr);
         }
     }
+
+    // Rules set in this pass are programmed in bulk
+    unordered_map<string, task_process_status> failed_rules;
+    m_group_mgr.flushRules(&failed_rules);
+
+    for (auto rule_itr : queued_rules)
+    {
+        const string &key = kfvKey(rule_itr->second);
+
+        auto failed_it = failed_rules.find(key);
+        if (failed_it != failed_rules.end() && failed_it->second == task_need_retry)
+        {
+            SWSS_LOG_DEBUG("Task %s - %s need retry", table_name.c_str(), key.c_str());
+            continue;
+        }
+
+        consumer.m_toSync.erase(rule_itr);
+    }
 }
 
 task_process_status DashAclOrch::taskUpdateDashAclIn(
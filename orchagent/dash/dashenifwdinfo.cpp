@@ -206,6 +206,18 @@ void EniAclRule::fire(EniInfo& eni)
     setState(INSTALLED);
 }
 
+bool EniAclRule::findPendingEp(IpAddress& ep)
+{
+    /* Only local endpoints are resolved through a neighbor */
+    if (nh_ == nullptr || nh_->getType() != dpu_type_t::LOCAL || nh_->getStatus() == endpoint_status_t::RESOLVED)
+    {
+        return false;
+    }
+
+    ep = nh_->getEp();
+    return true;
+}
+
 string EniAclRule::getMacMatchDirection(EniInfo& eni)
 {
     return MATCH_INNER_DST_MAC;
@@ -311,11 +323,33 @@ bool EniInfo::create(const Request& db_request)
     return true;
 }
 
+std::set<IpAddress> EniInfo::getPendingEps()
+{
+    std::set<IpAddress> eps;
+    for (auto& rule_tuple : rule_container_)
+    {
+        IpAddress ep;
+        if (rule_tuple.second.findPendingEp(ep))
+        {
+            eps.insert(ep);
+        }
+    }
+    return eps;
+}
+
 bool EniInfo::update(const NeighborUpdate& nbr_update)
 {
     if (nbr_update.add)
     {
-        fireAllRules();
+        /* Resolved rules are not affected, only fire the ones waiting on this neighbor */
+        for (auto& rule_tuple : rule_container_)
+        {
+            IpAddress ep;
+            if (rule_tuple.second.findPendingEp(ep) && ep == nbr_update.entry.ip_address)
+            {
+                rule_tuple.second.fire(*this);
+            }
+        }
     }
     else
     {
@@ -1,5 +1,6 @@
 #include <memory>
 #include <numeric>
+#include <algorithm>
 #include "dashenifwdorch.h"
 #include "directory.h"
 
@@ -45,10 +46,18 @@ void DashEniFwdOrch::update(SubjectType type, void *cntx)
     }
 }
 
+void DashEniFwdOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    Orch2::doTask(consumer);
+    ctx->flushAclRules();
+}
+
 void DashEniFwdOrch::handleNeighUpdate(const NeighborUpdate& update)
 {
     /*
-        Refresh ENI's that are hosted on the DPU with the corresponding Neighboo
+        Refresh ENI's with rules waiting on the corresponding Neighbor
     */
     SWSS_LOG_ENTER();
     auto ipaddr = update.entry.ip_address;
@@ -59,20 +68,25 @@ void DashEniFwdOrch::handleNeighUpdate(const NeighborUpdate& update)
     }
     SWSS_LOG_NOTICE("Neighbor Update: %s, add: %d", ipaddr.to_string().c_str(), update.add);
 
-    auto dpu_id = dpu_id_itr->second;
-    auto itr = dpu_eni_map_.lower_bound(dpu_id);
-    auto itr_end = dpu_eni_map_.upper_bound(dpu_id);
+    auto nh_itr = nh_eni_map_.find(ipaddr);
+    if (nh_itr == nh_eni_map_.end())
+    {
+        return ;
+    }
 
-    while (itr != itr_end)    
+    /* Copy, firing the rules re-indexes the ENI's */
+    auto enis = nh_itr->second;
+    for (auto& mac : enis)
     {
-        /* Find the eni_itr */
-        auto eni_itr = eni_container_.find(itr->second);
+        auto eni_itr = eni_container_.find(mac);
         if (eni_itr != eni_container_.end())
         {
             eni_itr->second.update(update);
+            indexEni(eni_itr->second);
         }
-        itr++;
     }
+
+    ctx->flushAclRules();
 }
 
 void DashEniFwdOrch::initLocalEndpoints()
@@ -103,27 +117,30 @@ void DashEniFwdOrch::initLocalEndpoints()
     }
 }
 
-void DashEniFwdOrch::handleEniDpuMapping(const std::string& id, MacAddress mac, bool add)
+void DashEniFwdOrch::indexEni(EniInfo& eni)
 {
-    /* Make sure id is local */
-    dpu_type_t primary_type = CLUSTER;
-    if(ctx->dpu_info.getType(id, primary_type) && primary_type == dpu_type_t::LOCAL)
+    auto mac = eni.getMac();
+    unindexEni(mac);
+    for (auto& ep : eni.getPendingEps())
     {
-        if (add)
+        nh_eni_map_[ep].insert(mac);
+    }
+}
+
+void DashEniFwdOrch::unindexEni(const MacAddress& mac)
+{
+    /* Only a handful of local endpoints, the walk is cheap */
+    auto itr = nh_eni_map_.begin();
+    while (itr != nh_eni_map_.end())
+    {
+        itr->second.erase(mac);
+        if (itr->second.empty())
         {
-            dpu_eni_map_.insert(make_pair(id, mac));
+            itr = nh_eni_map_.erase(itr);
         }
         else
         {
-            auto range = dpu_eni_map_.equal_range(id);
-            for (auto it = range.first; it != range.second; ++it)
-            {
-                if (it->second == mac)
-                {
-                    dpu_eni_map_.erase(it);
-                    break;
-                }
-            }
+            itr++;
         }
     }
 }
@@ -167,17 +184,12 @@ bool DashEniFwdOrch::addOperation(const Request& request)
     if (new_eni)
     {
         eni_itr->second.create(request);
-        std::string local_ep;
-        if (eni_itr->second.findLocalEp(local_ep))
-        {
-            /* Add to the local map if the endpoint is found */
-            handleEniDpuMapping(local_ep, eni_id, true);
-        }
     }
     else
     {
         eni_itr->second.update(request);
     }
+    indexEni(eni_itr->second);
     return true;
 }
 
@@ -195,15 +207,8 @@ bool DashEniFwdOrch::delOperation(const Request& request)
         return true;
     }
 
-    bool result = eni_itr->second.destroy(request);
-    if (result)
-    {
-        std::string local_ep;
-        if (eni_itr->second.findLocalEp(local_ep))
-        {
-            handleEniDpuMapping(local_ep, eni_id, false);
-        }
-    }
+    eni_itr->second.destroy(request);
+    unindexEni(eni_id);
     eni_container_.erase(eni_id);
     return true;
 }
@@ -579,18 +584,20 @@ void EniFwdCtxBase::createAclRule(const std::string& rule, const std::vector<Fie
     }
     acl_rule_count_++;
     SWSS_LOG_INFO("Creating ACL rule: %s, ENI Forwarding rules count: %u", rule.c_str(), acl_rule_count_);
-    rule_table_->set(rule, fv);
+    pending_rules_.emplace_back(rule, SET_COMMAND, fv);
 }
 
 void EniFwdCtxBase::deleteAclRule(const std::string& rule)
 {
-    rule_table_->del(rule);
+    pending_rules_.emplace_back(rule, DEL_COMMAND, vector<FieldValueTuple>());
     if (acl_rule_count_ > 0)
     {
         acl_rule_count_--;
         SWSS_LOG_INFO("Deleted ACL rule: %s, ENI Forwarding rule count: %u", rule.c_str(), acl_rule_count_);
         if (acl_rule_count_ == 0)
         {
+            /* Rules must be gone before the table */
+            flushAclRules();
             deleteAclTable();
         }
     }
@@ -600,6 +607,37 @@ void EniFwdCtxBase::deleteAclRule(const std::string& rule)
     }
 }
 
+void EniFwdCtxBase::flushAclRules()
+{
+    /*
+        Consecutive sets and deletes are written in one batch each,
+        the order between them is kept for rules updated in place
+    */
+    auto itr = pending_rules_.begin();
+    while (itr != pending_rules_.end())
+    {
+        auto op = kfvOp(*itr);
+        auto run_end = std::find_if(itr, pending_rules_.end(),
+                [&op](const KeyOpFieldsValuesTuple& rule) { return kfvOp(rule) != op; });
+
+        if (op == SET_COMMAND)
+        {
+            rule_table_->set(vector<KeyOpFieldsValuesTuple>(itr, run_end));
+        }
+        else
+        {
+            vector<string> keys;
+            for (auto del_itr = itr; del_itr != run_end; del_itr++)
+            {
+                keys.push_back(kfvKey(*del_itr));
+            }
+            rule_table_->del(keys);
+        }
+        itr = run_end;
+    }
+    pending_rules_.clear();
+}
+
 void EniFwdCtxBase::addAclTable()
 {
     vector<string> match_list = {
@@ -104,6 +104,7 @@ public:
     void update(SubjectType, void *) override;
 
 protected:
+    void doTask(Consumer& consumer) override;
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
     EniFwdRequest request_;
@@ -112,10 +113,11 @@ private:
     void lazyInit();
     void initLocalEndpoints();
     void handleNeighUpdate(const NeighborUpdate& update);
-    void handleEniDpuMapping(const std::string& id, MacAddress mac, bool add = true);
+    void indexEni(EniInfo& eni);
+    void unindexEni(const swss::MacAddress& mac);
 
-    /* multimap because Multiple ENIs can be mapped to the same DPU */
-    std::multimap<std::string, swss::MacAddress> dpu_eni_map_;
+    /* Local Endpoint -> ENIs with rules waiting for its neighbor */
+    std::map<swss::IpAddress, std::set<swss::MacAddress>> nh_eni_map_;
     /* Local Endpoint -> DPU mapping */
     std::map<swss::IpAddress, std::string> neigh_dpu_map_;
     std::map<swss::MacAddress, EniInfo> eni_container_;
@@ -268,6 +270,8 @@ public:
     void fire(EniInfo&);
 
     update_type_t processUpdate(EniInfo& eni);
+    /* Local endpoint the rule is waiting on to be resolved */
+    bool findPendingEp(swss::IpAddress& ep);
     std::string getKey() {return name_; }
     string getMacMatchDirection(EniInfo& eni);
     void setState(rule_state_t state);
@@ -297,6 +301,7 @@ public:
     bool findLocalEp(std::string&) const;
     swss::MacAddress getMac() const { return mac_; } // Can only be set during object creation
     std::vector<std::string> getEpList() { return ep_list_; }
+    std::set<swss::IpAddress> getPendingEps();
     std::string getPrimaryId() const { return primary_id_; }
     std::string getVnet() const { return vnet_name_; }
 
@@ -331,8 +336,10 @@ public:
     std::string getNbrAlias(const swss::IpAddress& ip);
     swss::IpPrefix getVip();
 
+    /* Rule updates are queued and written to APPL_DB on flushAclRules */
     void createAclRule(const std::string&, const std::vector<FieldValueTuple>&);
     void deleteAclRule(const std::string&);
+    void flushAclRules();
 
     virtual void initialize() = 0;
     /* API's that call other orchagents */
@@ -351,6 +358,7 @@ protected:
     void deleteAclTable();
     /* Reference counting for ACL rules */
     uint32_t acl_rule_count_ = 0;
+    std::vector<swss::KeyOpFieldsValuesTuple> pending_rules_;
 
     /* Mapping between DPU Nbr and Alias */
     std::map<swss::IpAddress, std::string> nh_alias_map_;
@@ -21,6 +21,7 @@ extern sai_dash_ha_api_t*   sai_dash_ha_api;
 extern sai_dash_eni_api_t*  sai_dash_eni_api;
 extern sai_object_id_t      gSwitchId;
 extern sai_switch_api_t*    sai_switch_api;
+extern size_t               gMaxBulkSize;
 
 static const map<sai_ha_set_event_t, string> sai_ha_set_event_type_name =
 {
@@ -59,20 +60,38 @@ static const map<sai_ha_scope_event_t, string> sai_ha_scope_event_type_name =
     { SAI_HA_SCOPE_EVENT_SPLIT_BRAIN_DETECTED, "split_brain_detected" }
 };
 
+static vector<table_name_with_pri_t> tablesWithDefaultPri(const vector<string> &tables)
+{
+    vector<table_name_with_pri_t> tables_with_pri;
+    for (const auto &table : tables)
+    {
+        tables_with_pri.emplace_back(table, default_orch_pri);
+    }
+
+    return tables_with_pri;
+}
+
 DashHaOrch::DashHaOrch(DBConnector *db, const vector<string> &tables, DashOrch *dash_orch, BfdOrch *bfd_orch, DBConnector *app_state_db, ZmqServer *zmqServer) :
+    DashHaOrch(db, tablesWithDefaultPri(tables), dash_orch, bfd_orch, app_state_db, zmqServer)
+{
+}
+
+DashHaOrch::DashHaOrch(DBConnector *db, const vector<table_name_with_pri_t> &tables, DashOrch *dash_orch, BfdOrch *bfd_orch, DBConnector *app_state_db, ZmqServer *zmqServer) :
     ZmqOrch(db, tables, zmqServer),
     m_dash_orch(dash_orch),
     m_bfd_orch(bfd_orch)
 {
     SWSS_LOG_ENTER();
 
-    dash_ha_set_result_table_ = make_unique<Table>(app_state_db, APP_DASH_HA_SET_TABLE_NAME);
-    dash_ha_scope_result_table_ = make_unique<Table>(app_state_db, APP_DASH_HA_SCOPE_TABLE_NAME);
+    m_appStatePipeline = make_unique<RedisPipeline>(app_state_db);
+    dash_ha_set_result_table_ = make_unique<Table>(m_appStatePipeline.get(), APP_DASH_HA_SET_TABLE_NAME, true);
+    dash_ha_scope_result_table_ = make_unique<Table>(m_appStatePipeline.get(), APP_DASH_HA_SCOPE_TABLE_NAME, true);
 
     m_dpuStateDbConnector = make_unique<DBConnector>("DPU_STATE_DB", 0, true);
+    m_dpuStatePipeline = make_unique<RedisPipeline>(m_dpuStateDbConnector.get());
 
-    m_dpuStateDbHaSetTable = make_unique<Table>(m_dpuStateDbConnector.get(), STATE_DASH_HA_SET_STATE_TABLE_NAME);
-    m_dpuStateDbHaScopeTable = make_unique<Table>(m_dpuStateDbConnector.get(), STATE_DASH_HA_SCOPE_STATE_TABLE_NAME);
+    m_dpuStateDbHaSetTable = make_unique<Table>(m_dpuStatePipeline.get(), STATE_DASH_HA_SET_STATE_TABLE_NAME, true);
+    m_dpuStateDbHaScopeTable = make_unique<Table>(m_dpuStatePipeline.get(), STATE_DASH_HA_SCOPE_STATE_TABLE_NAME, true);
 
     DBConnector *notificationsDb = new DBConnector("ASIC_DB", 0);
     m_haSetNotificationConsumer = new NotificationConsumer(notificationsDb, "NOTIFICATIONS");
@@ -167,30 +186,26 @@ std::string DashHaOrch::getHaSetObjectKey(const sai_object_id_t ha_set_oid)
 {
     SWSS_LOG_ENTER();
 
-    for (auto ha_set_entry : m_ha_set_entries)
+    auto it = m_ha_set_keys.find(ha_set_oid);
+    if (it == m_ha_set_keys.end())
     {
-        if (ha_set_entry.second.ha_set_id == ha_set_oid)
-        {
-            return ha_set_entry.first;
-        }
+        return "";
     }
 
-    return "";
+    return it->second;
 }
 
 std::string DashHaOrch::getHaScopeObjectKey(const sai_object_id_t ha_scope_oid)
 {
     SWSS_LOG_ENTER();
 
-    for (auto ha_scope_entry : m_ha_scope_entries)
+    auto it = m_ha_scope_keys.find(ha_scope_oid);
+    if (it == m_ha_scope_keys.end())
     {
-        if (ha_scope_entry.second.ha_scope_id == ha_scope_oid)
-        {
-            return ha_scope_entry.first;
-        }
+        return "";
     }
 
-    return "";
+    return it->second;
 }
 
 HaScopeEntry DashHaOrch::getHaScopeForEni(const std::string& eni)
@@ -208,28 +223,91 @@ HaScopeEntry DashHaOrch::getHaScopeForEni(const std::string& eni)
     return m_ha_scope_entries.begin()->second;
 }
 
-bool DashHaOrch::updateExistingHaSetEntry(const std::string &key, const dash::ha_set::HaSet &entry, sai_object_id_t sai_ha_set_oid)
+DashHaAttributeBulker::DashHaAttributeBulker(sai_object_type_t object_type, set_attribute_fn set_fn,
+                                             bulk_set_attribute_fn bulk_set_fn, size_t max_bulk_size) :
+    m_object_type(object_type),
+    m_set_fn(set_fn),
+    m_bulk_set_fn(bulk_set_fn),
+    m_max_bulk_size(max_bulk_size ? max_bulk_size : SIZE_MAX)
+{
+}
+
+void DashHaAttributeBulker::set_entry_attribute(sai_status_t *object_status, sai_object_id_t object_id, const sai_attribute_t &attr)
+{
+    *object_status = SAI_STATUS_NOT_EXECUTED;
+    m_setting.push_back({object_id, attr, object_status});
+}
+
+void DashHaAttributeBulker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t first = 0; first < m_setting.size(); first += m_max_bulk_size)
+    {
+        size_t last = std::min(m_setting.size(), first + m_max_bulk_size);
+        uint32_t count = static_cast<uint32_t>(last - first);
+        vector<sai_object_id_t> object_ids;
+        vector<sai_attribute_t> attrs;
+        vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+        for (size_t i = first; i < last; i++)
+        {
+            object_ids.push_back(m_setting[i].object_id);
+            attrs.push_back(m_setting[i].attr);
+        }
+
+        sai_status_t status = m_bulk_set_fn(m_object_type, count, object_ids.data(), attrs.data(),
+                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        bool bulk_not_supported = status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+
+        for (size_t i = first; i < last; i++)
+        {
+            auto& entry = m_setting[i];
+            if (bulk_not_supported)
+            {
+                *entry.object_status = m_set_fn(entry.object_id, &entry.attr);
+            }
+            else
+            {
+                *entry.object_status = statuses[i - first];
+            }
+        }
+    }
+
+    m_setting.clear();
+}
+
+bool DashHaOrch::prepareHaSetUpdate(const std::string &key, const dash::ha_set::HaSet &entry, sai_object_id_t sai_ha_set_oid, HaSetUpdate &update)
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
-    sai_attribute_t ha_set_attr_list[8]={};
     sai_ip_address_t sai_peer_ip;
 
     if (!to_sai(entry.peer_ip(), sai_peer_ip))
     {
         SWSS_LOG_WARN("HA Set entry already exists for %s", key.c_str());
-        return true;
+        return false;
     }
 
-    ha_set_attr_list[0].id = SAI_HA_SET_ATTR_PEER_IP;
-    ha_set_attr_list[0].value.ipaddr = sai_peer_ip;
-    status = sai_dash_ha_api->set_ha_set_attribute(sai_ha_set_oid,
-                                                   &ha_set_attr_list[0]);
-    if (status != SAI_STATUS_SUCCESS)
+    update.key = key;
+    update.entry = entry;
+    update.ha_set_id = sai_ha_set_oid;
+    update.attr.id = SAI_HA_SET_ATTR_PEER_IP;
+    update.attr.value.ipaddr = sai_peer_ip;
+
+    return true;
+}
+
+bool DashHaOrch::completeHaSetUpdate(const HaSetUpdate &update)
+{
+    SWSS_LOG_ENTER();
+
+    const auto& key = update.key;
+
+    if (update.status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to update peer ip for HA Set object in SAI for %s", key.c_str());
-        task_process_status handle_status = handleSaiCreateStatus((sai_api_t) SAI_API_DASH_HA, status);
+        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_HA, update.status);
         if (handle_status != task_success)
         {
             return parseHandleSaiStatusFailure(handle_status);
@@ -238,9 +316,9 @@ bool DashHaOrch::updateExistingHaSetEntry(const std::string &key, const dash::ha
 
     SWSS_LOG_INFO("HA Set entry updated for %s, peer_ip is updated to %s",
                     key.c_str(),
-                    to_string(entry.peer_ip()).c_str());
+                    to_string(update.entry.peer_ip()).c_str());
 
-    *m_ha_set_entries[key].metadata.mutable_peer_ip() = entry.peer_ip();
+    *m_ha_set_entries[key].metadata.mutable_peer_ip() = update.entry.peer_ip();
 
     return true;
 }
@@ -249,15 +327,6 @@ bool DashHaOrch::addHaSetEntry(const std::string &key, const dash::ha_set::HaSet
 {
     SWSS_LOG_ENTER();
 
-    auto it = m_ha_set_entries.find(key);
-
-    if (it != m_ha_set_entries.end())
-    {
-        SWSS_LOG_DEBUG("HA Set entry already exists for %s, updating it", key.c_str());
-
-        return updateExistingHaSetEntry(key, entry, it->second.ha_set_id);
-    }
-
     uint32_t attr_count = 8;
     sai_attribute_t ha_set_attr_list[8]={};
     sai_status_t status;
@@ -315,6 +384,7 @@ bool DashHaOrch::addHaSetEntry(const std::string &key, const dash::ha_set::HaSet
         }
     }
     m_ha_set_entries[key] = HaSetEntry {sai_ha_set_oid, entry};
+    m_ha_set_keys[sai_ha_set_oid] = key;
     SWSS_LOG_NOTICE("Created HA Set object for %s", key.c_str());
 
     return true;
@@ -343,6 +413,7 @@ bool DashHaOrch::removeHaSetEntry(const std::string &key)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
+    m_ha_set_keys.erase(it->second.ha_set_id);
     m_ha_set_entries.erase(it);
     SWSS_LOG_NOTICE("Removed HA Set object for %s", key.c_str());
 
@@ -355,6 +426,9 @@ void DashHaOrch::doTaskHaSetTable(ConsumerBase &consumer)
 
     uint32_t result;
 
+    // Peer IP changes of existing HA Sets are set in bulk after the loop
+    std::deque<HaSetUpdate> updates;
+
     auto it = consumer.m_toSync.begin();
 
     while (it != consumer.m_toSync.end())
@@ -388,13 +462,30 @@ void DashHaOrch::doTaskHaSetTable(ConsumerBase &consumer)
                 continue;
             }
 
-            if (addHaSetEntry(key, entry))
+            auto existing_it = m_ha_set_entries.find(key);
+            if (existing_it != m_ha_set_entries.end())
+            {
+                SWSS_LOG_DEBUG("HA Set entry already exists for %s, updating it", key.c_str());
+
+                updates.emplace_back();
+                if (prepareHaSetUpdate(key, entry, existing_it->second.ha_set_id, updates.back()))
+                {
+                    updates.back().task = it++;
+                    continue;
+                }
+                updates.pop_back();
+            }
+            else if (!addHaSetEntry(key, entry))
+            {
+                result = DASH_RESULT_FAILURE;
+            }
+
+            if (result == DASH_RESULT_SUCCESS)
             {
                 it = consumer.m_toSync.erase(it);
             }
             else
             {
-                result = DASH_RESULT_FAILURE;
                 it++;
             }
             writeResultToDB(dash_ha_set_result_table_, key, result);
@@ -418,54 +509,99 @@ void DashHaOrch::doTaskHaSetTable(ConsumerBase &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
-}
 
-bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::HaScope &entry)
-{
-    SWSS_LOG_ENTER();
+    if (updates.empty())
+    {
+        return;
+    }
 
-    auto ha_scope_it = m_ha_scope_entries.find(key);
-    if (ha_scope_it != m_ha_scope_entries.end())
+    DashHaAttributeBulker bulker(SAI_OBJECT_TYPE_HA_SET, sai_dash_ha_api->set_ha_set_attribute,
+            m_bulk_set_fn, gMaxBulkSize);
+    for (auto& update : updates)
     {
-        bool success = true;
-        bool repeated_message = true;
+        bulker.set_entry_attribute(&update.status, update.ha_set_id, update.attr);
+    }
+    bulker.flush();
 
-        if (ha_scope_it->second.metadata.ha_role() != entry.ha_role())
+    for (const auto& update : updates)
+    {
+        result = DASH_RESULT_SUCCESS;
+        if (completeHaSetUpdate(update))
         {
-            success = success && setHaScopeHaRole(key, entry);
-            repeated_message = false;
+            consumer.m_toSync.erase(update.task);
         }
-
-        if (entry.flow_reconcile_requested() == true)
+        else
         {
-            success = success && setHaScopeFlowReconcileRequest(key);
-            repeated_message = false;
+            result = DASH_RESULT_FAILURE;
         }
+        writeResultToDB(dash_ha_set_result_table_, update.key, result);
+    }
+}
 
-        if (entry.activate_role_requested() == true)
-        {
-            success = success && setHaScopeActivateRoleRequest(key);
-            repeated_message = false;
-        }
+void DashHaOrch::prepareHaScopeUpdate(const std::string &key, const dash::ha_scope::HaScope &entry, HaScopeUpdate &update)
+{
+    SWSS_LOG_ENTER();
 
-        if (ha_scope_it->second.metadata.disabled() != entry.disabled())
-        {
-            success = success && setHaScopeDisabled(key, entry.disabled());
-            repeated_message = false;
-        }
+    const auto& ha_scope = m_ha_scope_entries[key];
 
-        if (repeated_message)
-        {
-            SWSS_LOG_WARN("HA Scope entry already exists for %s", key.c_str());
-        }
-        else
+    update.key = key;
+    update.entry = entry;
+    update.ha_scope_id = ha_scope.ha_scope_id;
+
+    sai_attribute_t ha_scope_attr = {};
+
+    if (ha_scope.metadata.ha_role() != entry.ha_role())
+    {
+        /*
+            Remove bfd passive sessions in planned shutdown (scope == DPU)
+        */
+        if (entry.ha_role() == dash::types::HA_ROLE_DEAD
+            && !m_ha_set_entries.empty())
         {
-            SWSS_LOG_NOTICE("HA Scope entry updated for %s", key.c_str());
+            if (has_dpu_scope())
+            {
+                m_bfd_orch->removeAllSoftwareBfdSessions();
+            }
         }
 
-        return success;
+        ha_scope_attr.id = SAI_HA_SCOPE_ATTR_DASH_HA_ROLE;
+        ha_scope_attr.value.u32 = to_sai(entry.ha_role());
+        update.attrs.push_back(ha_scope_attr);
     }
 
+    if (entry.flow_reconcile_requested() == true)
+    {
+        ha_scope_attr.id = SAI_HA_SCOPE_ATTR_FLOW_RECONCILE_REQUESTED;
+        ha_scope_attr.value.booldata = true;
+        update.attrs.push_back(ha_scope_attr);
+    }
+
+    if (entry.activate_role_requested() == true)
+    {
+        ha_scope_attr.id = SAI_HA_SCOPE_ATTR_ACTIVATE_ROLE;
+        ha_scope_attr.value.booldata = true;
+        update.attrs.push_back(ha_scope_attr);
+    }
+
+    if (ha_scope.metadata.disabled() != entry.disabled())
+    {
+        ha_scope_attr.id = SAI_HA_SCOPE_ATTR_ADMIN_STATE;
+        ha_scope_attr.value.booldata = !entry.disabled();
+        update.attrs.push_back(ha_scope_attr);
+    }
+
+    update.statuses.resize(update.attrs.size(), SAI_STATUS_NOT_EXECUTED);
+
+    if (update.attrs.empty())
+    {
+        SWSS_LOG_WARN("HA Scope entry already exists for %s", key.c_str());
+    }
+}
+
+bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::HaScope &entry, HaScopeCreation &creation)
+{
+    SWSS_LOG_ENTER();
+
     std::map<std::string, HaSetEntry>::iterator ha_set_it;
     if (!entry.ha_set_id().empty())
     {
@@ -583,9 +719,13 @@ bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::H
         }
     }
     m_ha_scope_entries[key] = HaScopeEntry {sai_ha_scope_oid, entry, getNowTime(), SAI_DASH_HA_STATE_DEAD, getNowTime()};
+    m_ha_scope_keys[sai_ha_scope_oid] = key;
     SWSS_LOG_NOTICE("Created HA Scope object for %s", key.c_str());
 
-    // set HA Scope ID to ENI
+    // set HA Scope ID to ENI, in bulk with the other new HA Scopes
+    creation.key = key;
+    creation.ha_scope_id = sai_ha_scope_oid;
+
     if (ha_set_it->second.metadata.scope() == dash::types::HaScope::HA_SCOPE_ENI)
     {
         auto eni_entry = m_dash_orch->getEni(key);
@@ -595,26 +735,14 @@ bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::H
             return false;
         }
 
-        return setEniHaScopeId(eni_entry->eni_id, sai_ha_scope_oid);
+        creation.eni_ids.push_back(eni_entry->eni_id);
 
     } else if (ha_set_it->second.metadata.scope() == dash::types::HaScope::HA_SCOPE_DPU)
     {
         auto eni_table = m_dash_orch->getEniTable();
-        auto it = eni_table->begin();
-        bool success = true;
-        while (it != eni_table->end())
-        {
-            if (!setEniHaScopeId(it->second.eni_id, sai_ha_scope_oid))
-            {
-                SWSS_LOG_ERROR("Failed to set HA Scope ID for ENI %s", it->first.c_str());
-                success = false;
-            }
-            it++;
-        }
-
-        if (!success)
+        for (const auto& eni : *eni_table)
         {
-            return false;
+            creation.eni_ids.push_back(eni.second.eni_id);
         }
     }
     else
@@ -626,33 +754,32 @@ bool DashHaOrch::addHaScopeEntry(const std::string &key, const dash::ha_scope::H
     return true;
 }
 
-bool DashHaOrch::setHaScopeHaRole(const std::string &key, const dash::ha_scope::HaScope &entry)
+bool DashHaOrch::completeHaScopeUpdate(HaScopeUpdate &update, size_t index)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t ha_scope_id = m_ha_scope_entries[key].ha_scope_id;
+    const auto& key = update.key;
+    const auto& attr = update.attrs[index];
+    sai_status_t status = update.statuses[index];
 
-    /*
-        Remove bfd passive sessions in planned shutdown (scope == DPU)
-    */
-    if (entry.ha_role() == dash::types::HA_ROLE_DEAD
-        && !m_ha_set_entries.empty())
+    if (status != SAI_STATUS_SUCCESS)
     {
-        if (has_dpu_scope())
-        {
-            m_bfd_orch->removeAllSoftwareBfdSessions();
+        switch (attr.id)
+        {
+        case SAI_HA_SCOPE_ATTR_DASH_HA_ROLE:
+            SWSS_LOG_ERROR("Failed to set HA Scope role in SAI for %s", key.c_str());
+            break;
+        case SAI_HA_SCOPE_ATTR_FLOW_RECONCILE_REQUESTED:
+            SWSS_LOG_ERROR("Failed to set HA Scope flow reconcile request in SAI for %s", key.c_str());
+            break;
+        case SAI_HA_SCOPE_ATTR_ACTIVATE_ROLE:
+            SWSS_LOG_ERROR("Failed to set HA Scope activate role request in SAI for %s", key.c_str());
+            break;
+        default:
+            SWSS_LOG_ERROR("Failed to set HA Scope admin state to %d in SAI for %s", update.entry.disabled(), key.c_str());
+            break;
         }
-    }
-
-    sai_attribute_t ha_scope_attr;
-    ha_scope_attr.id = SAI_HA_SCOPE_ATTR_DASH_HA_ROLE;
-    ha_scope_attr.value.u32 = to_sai(entry.ha_role());
 
-    sai_status_t status = sai_dash_ha_api->set_ha_scope_attribute(ha_scope_id,
-                                                                &ha_scope_attr);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to set HA Scope role in SAI for %s", key.c_str());
         task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_HA, status);
         if (handle_status != task_success)
         {
@@ -660,120 +787,142 @@ bool DashHaOrch::setHaScopeHaRole(const std::string &key, const dash::ha_scope::
         }
     }
 
-    SWSS_LOG_NOTICE("Set HA Scope role for %s to %s", key.c_str(), (dash::types::HaRole_Name(entry.ha_role())).c_str());
+    switch (attr.id)
+    {
+    case SAI_HA_SCOPE_ATTR_DASH_HA_ROLE:
+    {
+        SWSS_LOG_NOTICE("Set HA Scope role for %s to %s", key.c_str(), (dash::types::HaRole_Name(update.entry.ha_role())).c_str());
+
+        /*
+            Switchover phases, the HA Scope state event that ends it records the completion
+        */
+        m_ha_scope_entries[key].switchover_requested_ms = m_ha_scope_task_start_ms;
+        std::vector<FieldValueTuple> fvs = {
+            {"switchover_requested_time", to_string(m_ha_scope_task_start_ms)},
+            {"switchover_programmed_time", to_string(getNowTimeMs())}
+        };
+        m_dpuStateDbHaScopeTable->set(key, fvs);
+        break;
+    }
+    case SAI_HA_SCOPE_ATTR_FLOW_RECONCILE_REQUESTED:
+    {
+        SWSS_LOG_NOTICE("Set HA Scope flow reconcile request for %s", key.c_str());
+
+        std::vector<FieldValueTuple> fvs = {{"flow_reconcile_pending", "false"}};
+        m_dpuStateDbHaScopeTable->set(key, fvs);
+        break;
+    }
+    case SAI_HA_SCOPE_ATTR_ACTIVATE_ROLE:
+    {
+        SWSS_LOG_NOTICE("Set HA Scope activate role request for %s", key.c_str());
+
+        std::vector<FieldValueTuple> fvs = {
+            {"activate_role_pending", "false"},
+            {"switchover_activated_time", to_string(getNowTimeMs())}
+        };
+        m_dpuStateDbHaScopeTable->set(key, fvs);
+        break;
+    }
+    default:
+        m_ha_scope_entries[key].metadata.set_disabled(update.entry.disabled());
+        SWSS_LOG_NOTICE("Set HA Scope admin state for %s to %d", key.c_str(), !update.entry.disabled());
+        break;
+    }
 
     return true;
 }
 
-bool DashHaOrch::setHaScopeFlowReconcileRequest(const std::string &key)
+void DashHaOrch::setHaScopeUpdates(std::deque<HaScopeUpdate> &updates)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t ha_scope_id = m_ha_scope_entries[key].ha_scope_id;
+    /*
+        One bulk set per attribute position, so an HA Scope appears once per
+        bulk and its attributes keep their order. Like the per attribute sets,
+        an HA Scope stops at its first failed attribute.
+    */
+    for (size_t index = 0; ; index++)
+    {
+        DashHaAttributeBulker bulker(SAI_OBJECT_TYPE_HA_SCOPE, sai_dash_ha_api->set_ha_scope_attribute,
+                m_bulk_set_fn, gMaxBulkSize);
 
-    sai_attribute_t ha_scope_attr;
-    ha_scope_attr.id = SAI_HA_SCOPE_ATTR_FLOW_RECONCILE_REQUESTED;
-    ha_scope_attr.value.booldata = true;
+        for (auto& update : updates)
+        {
+            if (update.success && index < update.attrs.size())
+            {
+                bulker.set_entry_attribute(&update.statuses[index], update.ha_scope_id, update.attrs[index]);
+            }
+        }
 
-    sai_status_t status = sai_dash_ha_api->set_ha_scope_attribute(ha_scope_id,
-                                                                &ha_scope_attr);
+        if (bulker.setting_entries_count() == 0)
+        {
+            break;
+        }
+        bulker.flush();
 
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to set HA Scope flow reconcile request in SAI for %s", key.c_str());
-        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_HA, status);
-        if (handle_status != task_success)
+        for (auto& update : updates)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            if (update.success && index < update.attrs.size())
+            {
+                update.success = completeHaScopeUpdate(update, index);
+            }
         }
     }
-    SWSS_LOG_NOTICE("Set HA Scope flow reconcile request for %s", key.c_str());
-
-    std::vector<FieldValueTuple> fvs = {{"flow_reconcile_pending", "false"}};
-    m_dpuStateDbHaScopeTable->set(key, fvs);
 
-    return true;
-}
-
-bool DashHaOrch::setHaScopeActivateRoleRequest(const std::string &key)
-{
-    SWSS_LOG_ENTER();
-
-    sai_object_id_t ha_scope_id = m_ha_scope_entries[key].ha_scope_id;
-
-    sai_attribute_t ha_scope_attr;
-    ha_scope_attr.id = SAI_HA_SCOPE_ATTR_ACTIVATE_ROLE;
-    ha_scope_attr.value.booldata = true;
-
-    sai_status_t status = sai_dash_ha_api->set_ha_scope_attribute(ha_scope_id,
-                                                                &ha_scope_attr);
-
-    if (status != SAI_STATUS_SUCCESS)
+    for (const auto& update : updates)
     {
-        SWSS_LOG_ERROR("Failed to set HA Scope activate role request in SAI for %s", key.c_str());
-        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_HA, status);
-        if (handle_status != task_success)
+        if (update.success && !update.attrs.empty())
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_NOTICE("HA Scope entry updated for %s", update.key.c_str());
         }
     }
-    SWSS_LOG_NOTICE("Set HA Scope activate role request for %s", key.c_str());
-
-    std::vector<FieldValueTuple> fvs = {{"activate_role_pending", "false"}};
-    m_dpuStateDbHaScopeTable->set(key, fvs);
-
-    return true;
 }
 
-bool DashHaOrch::setHaScopeDisabled(const std::string &key, bool disabled)
+bool DashHaOrch::completeHaScopeCreation(const HaScopeCreation &creation)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t ha_scope_id = m_ha_scope_entries[key].ha_scope_id;
+    bool success = true;
 
-    sai_attribute_t ha_scope_attr;
-    ha_scope_attr.id = SAI_HA_SCOPE_ATTR_ADMIN_STATE;
-    ha_scope_attr.value.booldata = !disabled;
-
-    sai_status_t status = sai_dash_ha_api->set_ha_scope_attribute(ha_scope_id,
-                                                                &ha_scope_attr);
-
-    if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < creation.eni_ids.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to set HA Scope admin state to %d in SAI for %s", disabled, key.c_str());
-        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_HA, status);
-        if (handle_status != task_success)
+        if (creation.statuses[i] == SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            continue;
         }
-    }
 
-    m_ha_scope_entries[key].metadata.set_disabled(disabled);
-    SWSS_LOG_NOTICE("Set HA Scope admin state for %s to %d", key.c_str(), !disabled);
+        SWSS_LOG_ERROR("Failed to set HA Scope ID for ENI %s", std::to_string(creation.eni_ids[i]).c_str());
+        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_ENI, creation.statuses[i]);
+        if (handle_status != task_success && !parseHandleSaiStatusFailure(handle_status))
+        {
+            success = false;
+        }
+    }
 
-    return true;
+    return success;
 }
 
-bool DashHaOrch::setEniHaScopeId(const sai_object_id_t eni_id, const sai_object_id_t ha_scope_id)
+void DashHaOrch::setEniHaScopeIds(std::deque<HaScopeCreation> &creations)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t eni_attr;
-    eni_attr.id = SAI_ENI_ATTR_HA_SCOPE_ID;
-    eni_attr.value.oid = ha_scope_id;
-    sai_status_t status = sai_dash_eni_api->set_eni_attribute(eni_id, &eni_attr);
+    DashHaAttributeBulker bulker(SAI_OBJECT_TYPE_ENI, sai_dash_eni_api->set_eni_attribute,
+            m_bulk_set_fn, gMaxBulkSize);
 
-    if (status != SAI_STATUS_SUCCESS)
+    for (auto& creation : creations)
     {
-        SWSS_LOG_ERROR("Failed to set HA Scope ID for ENI %s", std::to_string(eni_id).c_str());
-        task_process_status handle_status = handleSaiSetStatus((sai_api_t) SAI_API_DASH_ENI, status);
-        if (handle_status != task_success)
+        sai_attribute_t eni_attr = {};
+        eni_attr.id = SAI_ENI_ATTR_HA_SCOPE_ID;
+        eni_attr.value.oid = creation.ha_scope_id;
+
+        creation.statuses.resize(creation.eni_ids.size(), SAI_STATUS_NOT_EXECUTED);
+        for (size_t i = 0; i < creation.eni_ids.size(); i++)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            bulker.set_entry_attribute(&creation.statuses[i], creation.eni_ids[i], eni_attr);
         }
     }
 
-    return true;
+    bulker.flush();
 }
 
 bool DashHaOrch::removeHaScopeEntry(const std::string &key)
@@ -799,6 +948,7 @@ bool DashHaOrch::removeHaScopeEntry(const std::string &key)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
+    m_ha_scope_keys.erase(it->second.ha_scope_id);
     m_ha_scope_entries.erase(it);
     SWSS_LOG_NOTICE("Removed HA Scope object for %s", key.c_str());
 
@@ -810,6 +960,11 @@ void DashHaOrch::doTaskHaScopeTable(ConsumerBase &consumer)
     SWSS_LOG_ENTER();
 
     uint32_t result;
+    m_ha_scope_task_start_ms = getNowTimeMs();
+
+    // Sets of existing HA Scopes and of the ENIs of new ones are done in bulk after the loop
+    std::deque<HaScopeUpdate> updates;
+    std::deque<HaScopeCreation> creations;
 
     auto it = consumer.m_toSync.begin();
 
@@ -851,15 +1006,24 @@ void DashHaOrch::doTaskHaScopeTable(ConsumerBase &consumer)
                 continue;
             }
 
-            if (addHaScopeEntry(key, entry))
+            if (existing_it != m_ha_scope_entries.end())
             {
-                it = consumer.m_toSync.erase(it);
+                updates.emplace_back();
+                prepareHaScopeUpdate(key, entry, updates.back());
+                updates.back().task = it++;
+                continue;
             }
-            else
+
+            creations.emplace_back();
+            if (addHaScopeEntry(key, entry, creations.back()))
             {
-                result = DASH_RESULT_FAILURE;
-                it++;
+                creations.back().task = it++;
+                continue;
             }
+            creations.pop_back();
+
+            result = DASH_RESULT_FAILURE;
+            it++;
             writeResultToDB(dash_ha_scope_result_table_, key, result);
         }
         else if (op == DEL_COMMAND)
@@ -880,6 +1044,44 @@ void DashHaOrch::doTaskHaScopeTable(ConsumerBase &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (!updates.empty())
+    {
+        setHaScopeUpdates(updates);
+    }
+
+    if (!creations.empty())
+    {
+        setEniHaScopeIds(creations);
+    }
+
+    for (const auto& update : updates)
+    {
+        result = DASH_RESULT_SUCCESS;
+        if (update.success)
+        {
+            consumer.m_toSync.erase(update.task);
+        }
+        else
+        {
+            result = DASH_RESULT_FAILURE;
+        }
+        writeResultToDB(dash_ha_scope_result_table_, update.key, result);
+    }
+
+    for (const auto& creation : creations)
+    {
+        result = DASH_RESULT_SUCCESS;
+        if (completeHaScopeCreation(creation))
+        {
+            consumer.m_toSync.erase(creation.task);
+        }
+        else
+        {
+            result = DASH_RESULT_FAILURE;
+        }
+        writeResultToDB(dash_ha_scope_result_table_, creation.key, result);
+    }
 }
 
 void DashHaOrch::doTaskBfdSessionTable(ConsumerBase &consumer)
@@ -964,6 +1166,16 @@ void DashHaOrch::doTask(ConsumerBase &consumer)
     {
         SWSS_LOG_ERROR("Unknown table: %s", consumer.getTableName().c_str());
     }
+
+    flushStateTables();
+}
+
+void DashHaOrch::flushStateTables()
+{
+    SWSS_LOG_ENTER();
+
+    m_appStatePipeline->flush();
+    m_dpuStatePipeline->flush();
 }
 
 void DashHaOrch::doTask(NotificationConsumer &consumer)
@@ -1013,6 +1225,7 @@ void DashHaOrch::doTask(NotificationConsumer &consumer)
         if (op == "ha_scope_event")
         {
             std::time_t now_time = getNowTime();
+            int64_t now_ms = getNowTimeMs();
 
             uint32_t count;
             sai_ha_scope_event_data_t *ha_scope_event = nullptr;
@@ -1082,6 +1295,20 @@ void DashHaOrch::doTask(NotificationConsumer &consumer)
                         m_ha_scope_entries[key].ha_state = ha_scope_event[i].ha_state;
                         m_ha_scope_entries[key].last_state_start_time = now_time;
 
+                        if (m_ha_scope_entries[key].switchover_requested_ms != 0
+                            && in(ha_scope_event[i].ha_state, {SAI_DASH_HA_STATE_ACTIVE,
+                                                              SAI_DASH_HA_STATE_STANDBY,
+                                                              SAI_DASH_HA_STATE_STANDALONE,
+                                                              SAI_DASH_HA_STATE_DEAD}))
+                        {
+                            int64_t duration_ms = now_ms - m_ha_scope_entries[key].switchover_requested_ms;
+                            fvs.push_back({"switchover_completed_time", to_string(now_ms)});
+                            fvs.push_back({"switchover_duration_ms", to_string(duration_ms)});
+                            m_ha_scope_entries[key].switchover_requested_ms = 0;
+                            SWSS_LOG_NOTICE("HA Scope %s switchover to %s took %" PRId64 " ms", key.c_str(),
+                                            sai_ha_state_name.at(ha_scope_event[i].ha_state).c_str(), duration_ms);
+                        }
+
                         if (has_dpu_scope() && in(ha_scope_event[i].ha_state, {SAI_DASH_HA_STATE_ACTIVE,
                                                             SAI_DASH_HA_STATE_STANDBY,
                                                             SAI_DASH_HA_STATE_STANDALONE}))
@@ -1099,6 +1326,8 @@ void DashHaOrch::doTask(NotificationConsumer &consumer)
             sai_deserialize_free_ha_scope_event_ntf(count, ha_scope_event);
         }
     }
+
+    flushStateTables();
 }
 
 bool DashHaOrch::convertKfvToHaSetPb(const std::vector<FieldValueTuple> &kfv, dash::ha_set::HaSet &entry)
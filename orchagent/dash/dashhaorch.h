@@ -1,8 +1,11 @@
 #ifndef DASHHAORCH_H
 #define DASHHAORCH_H
 #include <map>
+#include <deque>
+#include <chrono>
 
 #include "dbconnector.h"
+#include "redispipeline.h"
 #include "dashorch.h"
 #include "bfdorch.h"
 #include "zmqorch.h"
@@ -32,6 +35,80 @@ struct HaScopeEntry
 
     sai_dash_ha_state_t ha_state;
     std::time_t last_state_start_time;
+
+    // When the pending role change was received, 0 when there is none
+    int64_t switchover_requested_ms = 0;
+};
+
+/*
+ * Attribute sets of one DASH object type, programmed with the generic SAI
+ * bulk set and with one call per object when the object type has no bulk
+ * support
+ */
+class DashHaAttributeBulker
+{
+public:
+    using set_attribute_fn = sai_status_t (*)(sai_object_id_t, const sai_attribute_t *);
+    using bulk_set_attribute_fn = sai_status_t (*)(sai_object_type_t, uint32_t, const sai_object_id_t *,
+            const sai_attribute_t *, sai_bulk_op_error_mode_t, sai_status_t *);
+
+    // max_bulk_size 0 sends all queued sets in one call
+    DashHaAttributeBulker(sai_object_type_t object_type, set_attribute_fn set_fn,
+                          bulk_set_attribute_fn bulk_set_fn, size_t max_bulk_size);
+
+    // Queue a set, object_status is written by flush
+    void set_entry_attribute(sai_status_t *object_status, sai_object_id_t object_id, const sai_attribute_t &attr);
+
+    void flush();
+
+    size_t setting_entries_count() const { return m_setting.size(); }
+
+private:
+    struct SettingEntry
+    {
+        sai_object_id_t object_id;
+        sai_attribute_t attr;
+        sai_status_t *object_status;
+    };
+
+    sai_object_type_t m_object_type;
+    set_attribute_fn m_set_fn;
+    bulk_set_attribute_fn m_bulk_set_fn;
+    size_t m_max_bulk_size;
+    std::vector<SettingEntry> m_setting;
+};
+
+// Peer IP change of an existing HA Set, waiting for its bulk set
+struct HaSetUpdate
+{
+    SyncMap::iterator task;
+    std::string key;
+    dash::ha_set::HaSet entry;
+    sai_object_id_t ha_set_id;
+    sai_attribute_t attr;
+    sai_status_t status;
+};
+
+// Changes of an existing HA Scope, each attribute is set once the previous one succeeded
+struct HaScopeUpdate
+{
+    SyncMap::iterator task;
+    std::string key;
+    dash::ha_scope::HaScope entry;
+    sai_object_id_t ha_scope_id;
+    std::vector<sai_attribute_t> attrs;
+    std::vector<sai_status_t> statuses;
+    bool success = true;
+};
+
+// New HA Scope, done once the ENIs it covers point to it
+struct HaScopeCreation
+{
+    SyncMap::iterator task;
+    std::string key;
+    sai_object_id_t ha_scope_id;
+    std::vector<sai_object_id_t> eni_ids;
+    std::vector<sai_status_t> statuses;
 };
 
 typedef std::map<std::string, HaSetEntry> HaSetTable;
@@ -47,10 +124,13 @@ class DashHaOrch : public ZmqOrch
 {
 public:
     DashHaOrch(swss::DBConnector *db, const std::vector<std::string> &tableNames, DashOrch *dash_orch, BfdOrch *bfd_orch, swss::DBConnector *app_state_db, swss::ZmqServer *zmqServer);
+    DashHaOrch(swss::DBConnector *db, const std::vector<table_name_with_pri_t> &tableNames_with_pri, DashOrch *dash_orch, BfdOrch *bfd_orch, swss::DBConnector *app_state_db, swss::ZmqServer *zmqServer);
 
 protected:
     HaSetTable m_ha_set_entries;
     HaScopeTable m_ha_scope_entries;
+    std::map<sai_object_id_t, std::string> m_ha_set_keys;
+    std::map<sai_object_id_t, std::string> m_ha_scope_keys;
     DashBfdSessionTable m_bfd_session_pending_creation;
 
     DashOrch *m_dash_orch;
@@ -65,16 +145,17 @@ protected:
 
     bool addHaSetEntry(const std::string &key, const dash::ha_set::HaSet &entry);
     bool removeHaSetEntry(const std::string &key);
-    bool addHaScopeEntry(const std::string &key, const dash::ha_scope::HaScope &entry);
+    bool addHaScopeEntry(const std::string &key, const dash::ha_scope::HaScope &entry, HaScopeCreation &creation);
     bool removeHaScopeEntry(const std::string &key);
-    bool setHaScopeHaRole(const std::string &key, const dash::ha_scope::HaScope &entry);
-    bool setHaScopeFlowReconcileRequest(const  std::string &key);
-    bool setHaScopeActivateRoleRequest(const std::string &key);
-    bool setHaScopeDisabled(const std::string &key, bool disabled);
-    bool setEniHaScopeId(const sai_object_id_t eni_id, const sai_object_id_t ha_scope_id);
+    void prepareHaScopeUpdate(const std::string &key, const dash::ha_scope::HaScope &entry, HaScopeUpdate &update);
+    bool completeHaScopeUpdate(HaScopeUpdate &update, size_t index);
+    void setHaScopeUpdates(std::deque<HaScopeUpdate> &updates);
+    bool completeHaScopeCreation(const HaScopeCreation &creation);
+    void setEniHaScopeIds(std::deque<HaScopeCreation> &creations);
     bool register_ha_set_notifier();
     bool register_ha_scope_notifier();
-    bool updateExistingHaSetEntry(const std::string &key, const dash::ha_set::HaSet &entry, sai_object_id_t sai_ha_set_oid);
+    bool prepareHaSetUpdate(const std::string &key, const dash::ha_set::HaSet &entry, sai_object_id_t sai_ha_set_oid, HaSetUpdate &update);
+    bool completeHaSetUpdate(const HaSetUpdate &update);
 
     bool has_dpu_scope();
     bool has_eni_scope();
@@ -96,11 +177,25 @@ protected:
     std::time_t getNowTime(){
         return std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     };
+    int64_t getNowTimeMs(){
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    };
+
+    // Time the HA Scope changes being processed were picked up
+    int64_t m_ha_scope_task_start_ms = 0;
+
+    DashHaAttributeBulker::bulk_set_attribute_fn m_bulk_set_fn = sai_bulk_object_set_attribute;
+
+    void flushStateTables();
 
+    // State writes are pipelined and flushed once per task, not once per entry
+    std::unique_ptr<swss::RedisPipeline> m_appStatePipeline;
     std::unique_ptr<swss::Table> dash_ha_set_result_table_;
     std::unique_ptr<swss::Table> dash_ha_scope_result_table_;
 
     std::unique_ptr<swss::DBConnector> m_dpuStateDbConnector;
+    std::unique_ptr<swss::RedisPipeline> m_dpuStatePipeline;
     std::unique_ptr<swss::Table> m_dpuStateDbHaSetTable;
     std::unique_ptr<swss::Table> m_dpuStateDbHaScopeTable;
 
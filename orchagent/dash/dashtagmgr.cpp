@@ -3,9 +3,42 @@
 #include "dashaclorch.h"
 #include "saihelper.h"
 
+#include <string.h>
+
 using namespace std;
 using namespace swss;
 
+static bool samePrefixes(const vector<sai_ip_prefix_t>& a, const vector<sai_ip_prefix_t>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].addr_family != b[i].addr_family)
+        {
+            return false;
+        }
+
+        if (a[i].addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            if (a[i].addr.ip4 != b[i].addr.ip4 || a[i].mask.ip4 != b[i].mask.ip4)
+            {
+                return false;
+            }
+        }
+        else if (memcmp(a[i].addr.ip6, b[i].addr.ip6, sizeof(sai_ip6_t)) ||
+                 memcmp(a[i].mask.ip6, b[i].mask.ip6, sizeof(sai_ip6_t)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool from_pb(const dash::tag::PrefixTag& data, DashTag& tag)
 {
     if (!to_sai(data.ip_version(), tag.m_ip_version))
@@ -64,9 +97,24 @@ task_process_status DashTagMgr::update(const string& tag_id, const DashTag& new_
         return task_failed;
     }
 
-    // Update tag prefixes
+    if (samePrefixes(tag.m_prefixes, new_tag.m_prefixes))
+    {
+        return task_success;
+    }
+
+    // Rules are rebuilt from the tag, so the new prefixes are set while they are
+    auto old_prefixes = std::move(tag.m_prefixes);
     tag.m_prefixes = new_tag.m_prefixes;
 
+    auto status = m_dash_acl_orch->getDashAclGroupMgr().refreshTag(tag_id);
+    if (status != task_success)
+    {
+        // Keep the old prefixes, so the retried update is not taken as a no-op
+        SWSS_LOG_WARN("Failed to rebuild ACL rules of prefix tag %s, retrying", tag_id.c_str());
+        tag.m_prefixes = std::move(old_prefixes);
+        return task_need_retry;
+    }
+
     return task_success;
 }
 
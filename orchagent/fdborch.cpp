@@ -28,8 +28,11 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     TableConnector stateDbFdbConnector, TableConnector stateDbMclagFdbConnector, PortsOrch *port) :
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
+    m_stateDb(stateDbFdbConnector.first),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    m_stateDbPipeline(make_unique<RedisPipeline>(stateDbFdbConnector.first)),
+    m_fdbStateBatchTable(make_unique<Table>(m_stateDbPipeline.get(), stateDbFdbConnector.second, true))
 {
     for(auto it: appFdbTables)
     {
@@ -59,12 +62,94 @@ bool FdbOrch::bake()
         return false;
     }
 
-    size_t refilled = consumer->refillToSync(&m_fdbStateTable);
+    size_t refilled = consumer->refillToSync(m_stateDb, m_fdbStateTable.getTableName());
     SWSS_LOG_NOTICE("Add warm input FDB State: %s, %zd", APP_FDB_TABLE_NAME, refilled);
     return true;
 }
 
 
+void FdbOrch::setFdbState(const string& key, const vector<FieldValueTuple>& fvs)
+{
+    if (!m_fdbStateBatching)
+    {
+        m_fdbStateTable.set(key, fvs);
+        return;
+    }
+
+    auto& write = m_fdbStateWrites[key];
+    write.set = true;
+    write.fvs = fvs;
+}
+
+void FdbOrch::delFdbState(const string& key)
+{
+    if (!m_fdbStateBatching)
+    {
+        m_fdbStateTable.del(key);
+        return;
+    }
+
+    auto& write = m_fdbStateWrites[key];
+    write.set = false;
+    write.fvs.clear();
+}
+
+/*
+ * Records what STATE_DB holds for a key before the first write of the batch
+ * touches it, so a MAC moving back and forth is not written at all.
+ */
+void FdbOrch::setFdbStateBase(const string& key, bool set, const vector<FieldValueTuple>& fvs)
+{
+    if (!m_fdbStateBatching || m_fdbStateWrites.find(key) != m_fdbStateWrites.end())
+    {
+        return;
+    }
+
+    auto& write = m_fdbStateWrites[key];
+    write.baseKnown = true;
+    write.baseSet = set;
+    write.baseFvs = fvs;
+    write.set = set;
+    write.fvs = fvs;
+}
+
+void FdbOrch::beginFdbStateBatch()
+{
+    m_fdbStateBatching = true;
+}
+
+void FdbOrch::flushFdbStateBatch()
+{
+    SWSS_LOG_ENTER();
+
+    m_fdbStateBatching = false;
+
+    size_t written = 0;
+    for (const auto& it : m_fdbStateWrites)
+    {
+        const auto& write = it.second;
+        if (write.baseKnown && write.set == write.baseSet && write.fvs == write.baseFvs)
+        {
+            continue;
+        }
+
+        if (write.set)
+        {
+            m_fdbStateBatchTable->set(it.first, write.fvs);
+        }
+        else
+        {
+            m_fdbStateBatchTable->del(it.first);
+        }
+        written++;
+    }
+
+    m_stateDbPipeline->flush();
+
+    SWSS_LOG_DEBUG("Wrote %zu of %zu FDB state changes", written, m_fdbStateWrites.size());
+    m_fdbStateWrites.clear();
+}
+
 bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
 {
     const FdbEntry& entry = update.entry;
@@ -107,6 +192,15 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
             oldFdbData = it->second;
         }
 
+        if (mac_move && oldFdbData.origin == FDB_ORIGIN_LEARN)
+        {
+            Port oldPort;
+            if (m_portsOrch->getPortByBridgePortId(oldFdbData.bridge_port_id, oldPort))
+            {
+                setFdbStateBase(key, true, { { "port", oldPort.m_alias }, { "type", oldFdbData.type } });
+            }
+        }
+
         fdbdata.bridge_port_id = update.port.m_bridge_port_id;
         fdbdata.type = update.type;
         fdbdata.sai_fdb_type = update.sai_fdb_type;
@@ -132,7 +226,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         std::vector<FieldValueTuple> fvs;
         fvs.push_back(FieldValueTuple("port", portName));
         fvs.push_back(FieldValueTuple("type", update.type));
-        m_fdbStateTable.set(key, fvs);
+        setFdbState(key, fvs);
 
         if (!mac_move)
         {
@@ -146,6 +240,13 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         if(it != m_entries.end())
         {
             oldFdbData = it->second;
+
+            Port oldPort;
+            if (oldFdbData.origin == FDB_ORIGIN_LEARN &&
+                m_portsOrch->getPortByBridgePortId(oldFdbData.bridge_port_id, oldPort))
+            {
+                setFdbStateBase(key, true, { { "port", oldPort.m_alias }, { "type", oldFdbData.type } });
+            }
         }
 
         size_t erased = m_entries.erase(entry);
@@ -167,7 +268,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
                 (oldFdbData.origin == FDB_ORIGIN_PROVISIONED))
         {
             // Remove in StateDb for non advertised mac addresses
-            m_fdbStateTable.del(key);
+            delFdbState(key);
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
@@ -196,7 +297,7 @@ void FdbOrch::clearFdbEntry(const FdbEntry& entry)
 
     /* Remove the FdbEntry from the internal cache, update state DB and CRM counter */
     storeFdbEntryState(update);
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
     SWSS_LOG_INFO("FdbEntry removed from internal cache, MAC: %s , port: %s, BVID: 0x%" PRIx64,
                    update.entry.mac.to_string().c_str(), update.entry.port_name.c_str(), update.entry.bv_id);
@@ -388,7 +489,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     update.add = true;
                     update.type = "dynamic";
                     storeFdbEntryState(update);
-                    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+                    notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
                     return;
                 }
@@ -412,7 +513,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         m_portsOrch->setPort(vlan.m_alias, vlan);
 
         storeFdbEntryState(update);
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
         break;
     }
@@ -541,7 +642,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         }
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
         notifyTunnelOrch(update.port);
         break;
@@ -616,7 +717,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
         notifyTunnelOrch(port_old);
 
@@ -1047,33 +1148,60 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
     }
     else if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
     {
-        uint32_t count;
-        sai_fdb_event_notification_data_t *fdbevent = nullptr;
-        sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
-
-        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+        /*
+         * Events already queued behind this one are handled in the same
+         * batch, so every MAC gets one pipelined STATE_DB write with its
+         * final state. Batch observers get the FDB changes in one call,
+         * the others are still notified per event.
+         */
+        std::deque<KeyOpFieldsValuesTuple> queued;
+        consumer.pops(queued);
 
-        for (uint32_t i = 0; i < count; ++i)
+        beginFdbStateBatch();
+        beginNotifyBatch();
+        handleFdbEventNotification(data);
+        for (const auto& notification : queued)
         {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
-
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+            if (kfvOp(notification) == "fdb_event")
             {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                }
-                else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
-                {
-                    sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
-                }
+                handleFdbEventNotification(kfvKey(notification));
             }
+        }
+        flushFdbStateBatch();
+        endNotifyBatch();
+    }
+}
+
+void FdbOrch::handleFdbEventNotification(const string& data)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count;
+    sai_fdb_event_notification_data_t *fdbevent = nullptr;
+    sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+
+    sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sai_object_id_t oid = SAI_NULL_OBJECT_ID;
 
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
+        for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+        {
+            if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
+            {
+                oid = fdbevent[i].attr[j].value.oid;
+            }
+            else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
+            {
+                sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
+            }
         }
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+        this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
     }
+
+    sai_deserialize_free_fdb_event_ntf(count, fdbevent);
 }
 
 /*
@@ -1580,7 +1708,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
             fvs.push_back(FieldValueTuple("type", "dynamic"));
         else
             fvs.push_back(FieldValueTuple("type", fdbData.type));
-        m_fdbStateTable.set(key, fvs);
+        setFdbState(key, fvs);
     }
 
     else if (macUpdate && (oldOrigin != FDB_ORIGIN_MCLAG_ADVERTIZED) &&
@@ -1590,7 +1718,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
          * so delete from StateDb since we only keep local fdbs
          * in state-db
          */
-        m_fdbStateTable.del(key);
+        delFdbState(key);
     }
 
     if ((fdbData.origin == FDB_ORIGIN_MCLAG_ADVERTIZED) && (fdbData.type != "dynamic_local"))
@@ -1624,7 +1752,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     update.type = fdbData.type;
     update.add = true;
 
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
     return true;
 }
@@ -1723,7 +1851,7 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     // Remove in StateDb
     if ((fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
     {
-        m_fdbStateTable.del(key);
+        delFdbState(key);
     }
 
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
@@ -1734,7 +1862,7 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     update.type = fdbData.type;
     update.add = false;
 
-    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+    notifyBatched<FdbBatchUpdate>(SUBJECT_TYPE_FDB_CHANGE, update);
 
     notifyTunnelOrch(update.port);
 
@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "redispipeline.h"
 
 enum FdbOrigin
 {
@@ -39,6 +40,26 @@ struct FdbUpdate
     sai_fdb_entry_type_t sai_fdb_type;
 };
 
+/*
+ * What batch observers get of a FdbUpdate: the MAC, VLAN and port of the
+ * entry and whether it was added, without a copy of the whole Port.
+ */
+struct FdbBatchUpdate
+{
+    FdbEntry entry;
+    string port_alias;
+    sai_object_id_t port_id;
+    bool add;
+
+    FdbBatchUpdate(const FdbUpdate& update) :
+        entry(update.entry),
+        port_alias(update.port.m_alias),
+        port_id(update.port.m_port_id),
+        add(update.add)
+    {
+    }
+};
+
 struct FdbFlushUpdate
 {
     vector<FdbEntry> entries;
@@ -81,6 +102,18 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+/* Final STATE_DB FDB_TABLE change of one key within a notification batch */
+struct FdbStateWrite
+{
+    bool set = false;
+    vector<FieldValueTuple> fvs;
+
+    /* Content of the key before the batch, when it is known */
+    bool baseKnown = false;
+    bool baseSet = false;
+    vector<FieldValueTuple> baseFvs;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -111,8 +144,13 @@ private:
     map<FdbEntry, FdbData> m_entries;
     fdb_entries_by_port_t saved_fdb_entries;
     vector<Table*> m_appTables;
+    DBConnector *m_stateDb;
     Table m_fdbStateTable;
     Table m_mclagFdbStateTable;
+    unique_ptr<RedisPipeline> m_stateDbPipeline;
+    unique_ptr<Table> m_fdbStateBatchTable;
+    bool m_fdbStateBatching = false;
+    unordered_map<string, FdbStateWrite> m_fdbStateWrites;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
     shared_ptr<DBConnector> m_notificationsDb;
@@ -127,6 +165,12 @@ private:
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
+    void setFdbState(const string& key, const vector<FieldValueTuple>& fvs);
+    void delFdbState(const string& key);
+    void setFdbStateBase(const string& key, bool set, const vector<FieldValueTuple>& fvs);
+    void beginFdbStateBatch();
+    void flushFdbStateBatch();
+    void handleFdbEventNotification(const string& data);
     void notifyTunnelOrch(Port& port);
 
     void clearFdbEntry(const FdbEntry&);
@@ -21,6 +21,7 @@ extern sai_route_api_t*             sai_route_api;
 extern RouteOrch *gRouteOrch;
 extern CrmOrch *gCrmOrch;
 extern PortsOrch *gPortsOrch;
+extern size_t gMaxBulkSize;
 
 FgNhgOrch::FgNhgOrch(DBConnector *db, DBConnector *appDb, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch) :
         Orch(db, tableNames),
@@ -213,44 +214,97 @@ void FgNhgOrch::calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry)
 }
 
 
-void FgNhgOrch::setStateDbRouteEntry(const IpPrefix &ipPrefix, uint32_t index, NextHopKey nextHop)
+void FgNhgOrch::queueHashBucketChange(HashBucketIdx index, sai_object_id_t nh_oid, NextHopKey nextHop)
 {
     SWSS_LOG_ENTER();
 
-    string key = ipPrefix.to_string();
-    string field = std::to_string(index);
-    string value = nextHop.to_string();
-
-    m_stateWarmRestartRouteTable.hset(key, field, value);
-
-    SWSS_LOG_INFO("Set state db entry for ip prefix %s next hop %s with index %d",
-                  key.c_str(), value.c_str(), index);
+    /* A bucket which is moved more than once while the changes are computed
+     * is only programmed with its final next-hop */
+    m_pendingBucketWrites[index] = { nh_oid, nextHop };
 }
 
-bool FgNhgOrch::writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, HashBucketIdx index, sai_object_id_t nh_oid,
-        const IpPrefix &ipPrefix, NextHopKey nextHop)
+
+bool FgNhgOrch::flushHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, const IpPrefix &ipPrefix)
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t nhgm_attr;
-    nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-    nhgm_attr.value.oid = nh_oid;
-    sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
-                                                              syncd_fg_route_entry->nhopgroup_members[index],
-                                                              &nhgm_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    FgHashBucketWrites writes;
+    writes.swap(m_pendingBucketWrites);
+
+    if (writes.empty() || syncd_fg_route_entry->points_to_rif)
     {
-        SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
-            syncd_fg_route_entry->nhopgroup_members[index], nh_oid, status);
-        task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
-        if (handle_status != task_success)
+        /* Nothing to program, or the group was removed while computing the changes */
+        return true;
+    }
+
+    size_t count = writes.size();
+    vector<sai_object_id_t> member_ids;
+    vector<sai_attribute_t> attrs;
+    vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+    member_ids.reserve(count);
+    attrs.reserve(count);
+
+    for (const auto &write : writes)
+    {
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = write.second.nh_oid;
+        member_ids.push_back(syncd_fg_route_entry->nhopgroup_members[write.first]);
+        attrs.push_back(nhgm_attr);
+    }
+
+    size_t bulk_size = gMaxBulkSize ? gMaxBulkSize : count;
+    for (size_t start = 0; start < count; start += bulk_size)
+    {
+        uint32_t chunk = (uint32_t)std::min(bulk_size, count - start);
+        sai_status_t status = sai_next_hop_group_api->set_next_hop_group_members_attribute(
+                chunk, &member_ids[start], &attrs[start], SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, &statuses[start]);
+
+        if (status == SAI_STATUS_NOT_SUPPORTED || status == SAI_STATUS_NOT_IMPLEMENTED)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Bulk set of next hop group members is not supported, setting %u members one by one", chunk);
+            for (size_t i = start; i < start + chunk; i++)
+            {
+                statuses[i] = sai_next_hop_group_api->set_next_hop_group_member_attribute(member_ids[i], &attrs[i]);
+            }
         }
     }
 
-    setStateDbRouteEntry(ipPrefix, index, nextHop);
-    return true;
+    /* Record the buckets which were programmed, even when a later one failed,
+     * so that STATE_DB keeps reflecting what is in the ASIC */
+    vector<FieldValueTuple> fvs;
+    bool success = true;
+    size_t idx = 0;
+    for (const auto &write : writes)
+    {
+        sai_status_t status = statuses[idx++];
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set next hop oid %" PRIx64 " member %" PRIx64 ": %d",
+                write.second.nh_oid, syncd_fg_route_entry->nhopgroup_members[write.first], status);
+            task_process_status handle_status = handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
+            if (handle_status != task_success)
+            {
+                if (!parseHandleSaiStatusFailure(handle_status))
+                {
+                    success = false;
+                }
+                continue;
+            }
+        }
+
+        fvs.emplace_back(std::to_string(write.first), write.second.nextHop.to_string());
+    }
+
+    if (!fvs.empty())
+    {
+        m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
+    }
+
+    SWSS_LOG_INFO("Set %zu of %zu hash buckets for ip prefix %s",
+                  fvs.size(), count, ipPrefix.to_string().c_str());
+
+    return success;
 }
 
 
@@ -593,12 +647,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
         // fill the hash bucket indices with the added NHs
         for (uint32_t i = 0; i < hash_buckets->size(); i++)
         {
-            if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(i),
-                        nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                        ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-            {
-                return false;
-            }
+            queueHashBucketChange(hash_buckets->at(i),
+                    nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                    bank_member_change.nhs_to_add[add_idx]);
         }
 
         (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]] =*hash_buckets;
@@ -681,11 +732,7 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 
                 if (move_bkt)
                 {
-                    if (!writeHashBucketChange(syncd_fg_route_entry, hash_buckets->at(bkt_idx),
-                                               nhopgroup_members_set[*it], ipPrefix, *it))
-                    {
-                        return false;
-                    }
+                    queueHashBucketChange(hash_buckets->at(bkt_idx), nhopgroup_members_set[*it], *it);
                     bank_fgnhg_map->at(*it).push_back(hash_buckets->at(bkt_idx));
                     bkt_idx++;
                 }
@@ -792,12 +839,9 @@ bool FgNhgOrch::setActiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
                 if (move_bkt)
                 {
                     HashBucketIdx last_elem = map_entry->at((*map_entry).size() - 1);
-                    if (!writeHashBucketChange(syncd_fg_route_entry, last_elem,
-                                               nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
-                                               ipPrefix, bank_member_change.nhs_to_add[add_idx]))
-                    {
-                        return false;
-                    }
+                    queueHashBucketChange(last_elem,
+                                          nhopgroup_members_set[bank_member_change.nhs_to_add[add_idx]],
+                                          bank_member_change.nhs_to_add[add_idx]);
 
                     (*bank_fgnhg_map)[bank_member_change.nhs_to_add[add_idx]].push_back(last_elem);
                     (*map_entry).erase((*map_entry).end() - 1);
@@ -847,11 +891,7 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
                 NextHopKey bank_nh_memb = bank_member_changes[new_bank_idx].
                          active_nhs[i % bank_member_changes[new_bank_idx].active_nhs.size()];
 
-                if (!writeHashBucketChange(syncd_fg_route_entry, i,
-                    nhopgroup_members_set[bank_nh_memb],ipPrefix, bank_nh_memb ))
-                {
-                    return false;
-                }
+                queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
                 syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             }
@@ -884,6 +924,9 @@ bool FgNhgOrch::setInactiveBankToNextAvailableActiveBank(FGNextHopGroupEntry *sy
                 return false;
             }
 
+            // buckets queued for this group are moot once it is removed
+            m_pendingBucketWrites.clear();
+
             if (!removeFineGrainedNextHopGroup(syncd_fg_route_entry))
             {
                 SWSS_LOG_ERROR("Failed to delete Fine Grained next hop group");
@@ -935,11 +978,7 @@ bool FgNhgOrch::setInactiveBankHashBucketChanges(FGNextHopGroupEntry *syncd_fg_r
             NextHopKey bank_nh_memb = bank_member_changes[bank].
                 nhs_to_add[i % bank_member_changes[bank].nhs_to_add.size()];
 
-            if (!writeHashBucketChange(syncd_fg_route_entry, i,
-                  nhopgroup_members_set[bank_nh_memb], ipPrefix, bank_nh_memb))
-            {
-                return false;
-            }
+            queueHashBucketChange(i, nhopgroup_members_set[bank_nh_memb], bank_nh_memb);
 
             syncd_fg_route_entry->syncd_fgnhg_map[bank][bank_nh_memb].push_back(i);
             syncd_fg_route_entry->active_nexthops.insert(bank_nh_memb);
@@ -1001,6 +1040,11 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
 {
     SWSS_LOG_ENTER();
 
+    /* The per-bank helpers below only queue the bucket rewrites, they are
+     * programmed in SAI with one bulk call once the whole route is computed */
+    m_pendingBucketWrites.clear();
+
+    bool success = true;
     for (uint32_t bank_idx = 0; bank_idx < bank_member_changes.size(); bank_idx++)
     {
         if (bank_member_changes[bank_idx].active_nhs.size() != 0 ||
@@ -1016,7 +1060,8 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
             if (!setActiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
                         bank_idx, bank_member_changes[bank_idx], nhopgroup_members_set, ipPrefix))
             {
-                return false;
+                success = false;
+                break;
             }
         }
         else
@@ -1024,12 +1069,20 @@ bool FgNhgOrch::computeAndSetHashBucketChanges(FGNextHopGroupEntry *syncd_fg_rou
             if (!setInactiveBankHashBucketChanges(syncd_fg_route_entry, fgNhgEntry,
                         bank_idx, bank_member_changes, nhopgroup_members_set, ipPrefix))
             {
-                return false;
+                success = false;
+                break;
             }
         }
     }
 
-    return true;
+    /* Buckets already moved in the local state are programmed even if a later
+     * bank failed, so that SAI stays in line with syncd_fgnhg_map */
+    if (!flushHashBucketChanges(syncd_fg_route_entry, ipPrefix))
+    {
+        return false;
+    }
+
+    return success;
 }
 
 
@@ -1115,7 +1168,6 @@ bool FgNhgOrch::sprayBankNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, c
         uint32_t bank, BankMemberChanges &bank_member_change,
         std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set)
 {
-    sai_status_t status;
     bool isWarmReboot = false;
     auto nexthopsMap = m_recoveryMap.find(ipPrefix.to_string());
 
@@ -1129,6 +1181,11 @@ bool FgNhgOrch::sprayBankNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, c
 
     SWSS_LOG_INFO("Warm reboot is set to %d, bank %d", isWarmReboot, bank);
 
+    uint32_t count = hash_idx_range.end_index - hash_idx_range.start_index + 1;
+    vector<NextHopKey> nh_memb_keys;
+    vector<std::array<sai_attribute_t, 3>> nhgm_attrs(count);
+    nh_memb_keys.reserve(count);
+
     // fill the hash idx range with the nhs
     for (uint32_t bucket_idx = hash_idx_range.start_index;
             bucket_idx <= hash_idx_range.end_index; bucket_idx++)
@@ -1150,50 +1207,100 @@ bool FgNhgOrch::sprayBankNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, c
                 bank_member_change.nhs_to_add.size()];
         }
 
-        // Create a next hop group member
-        sai_attribute_t nhgm_attr;
-        vector<sai_attribute_t> nhgm_attrs;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = syncd_fg_route_entry.next_hop_group_id;
-        nhgm_attrs.push_back(nhgm_attr);
+        // Next hop group member attributes for this bucket
+        auto &attrs = nhgm_attrs[bucket_idx - hash_idx_range.start_index];
+        attrs[0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        attrs[0].value.oid = syncd_fg_route_entry.next_hop_group_id;
+        attrs[1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        attrs[1].value.oid = nhopgroup_members_set[nh_memb_key];
+        attrs[2].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_INDEX;
+        attrs[2].value.s32 = bucket_idx;
 
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhopgroup_members_set[nh_memb_key];
-        nhgm_attrs.push_back(nhgm_attr);
-
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_INDEX;
-        nhgm_attr.value.s32 = bucket_idx;
-        nhgm_attrs.push_back(nhgm_attr);
-
-        sai_object_id_t next_hop_group_member_id;
-        status = sai_next_hop_group_api->create_next_hop_group_member(
-                                                          &next_hop_group_member_id,
-                                                          gSwitchId,
-                                                          (uint32_t)nhgm_attrs.size(),
-                                                          nhgm_attrs.data());
-        if (status != SAI_STATUS_SUCCESS)
+        nh_memb_keys.push_back(nh_memb_key);
+    }
+
+    // Create the members of the whole bank in bulk
+    vector<uint32_t> attr_counts(count, 3);
+    vector<const sai_attribute_t *> attr_lists(count);
+    vector<sai_object_id_t> member_ids(count, SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        attr_lists[i] = nhgm_attrs[i].data();
+    }
+
+    uint32_t bulk_size = gMaxBulkSize ? (uint32_t)std::min<size_t>(gMaxBulkSize, count) : count;
+    for (uint32_t start = 0; start < count; start += bulk_size)
+    {
+        uint32_t chunk = std::min(bulk_size, count - start);
+        sai_status_t status = sai_next_hop_group_api->create_next_hop_group_members(gSwitchId, chunk,
+                &attr_counts[start], &attr_lists[start], SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                &member_ids[start], &statuses[start]);
+
+        if (status == SAI_STATUS_NOT_SUPPORTED || status == SAI_STATUS_NOT_IMPLEMENTED)
         {
-            SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member %" PRIx64 ": %d",
-               syncd_fg_route_entry.next_hop_group_id, next_hop_group_member_id, status);
+            SWSS_LOG_INFO("Bulk create of next hop group members is not supported, creating %u members one by one", chunk);
+            for (uint32_t i = start; i < start + chunk; i++)
+            {
+                statuses[i] = sai_next_hop_group_api->create_next_hop_group_member(&member_ids[i], gSwitchId,
+                        attr_counts[i], attr_lists[i]);
+                if (statuses[i] != SAI_STATUS_SUCCESS)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (statuses[start + chunk - 1] != SAI_STATUS_SUCCESS)
+        {
+            // stop on the first failure, later buckets are left as not executed
+            break;
+        }
+    }
+
+    vector<FieldValueTuple> fvs;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t bucket_idx = hash_idx_range.start_index + i;
+        const NextHopKey &nh_memb_key = nh_memb_keys[i];
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create next hop group %" PRIx64 " member for bucket %u: %d",
+               syncd_fg_route_entry.next_hop_group_id, bucket_idx, statuses[i]);
+
+            if (!fvs.empty())
+            {
+                m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
+            }
+
             if (!removeFineGrainedNextHopGroup(&syncd_fg_route_entry))
             {
                 SWSS_LOG_ERROR("Failed to clean-up after next-hop member creation failure");
             }
 
-            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
+            if (statuses[i] == SAI_STATUS_NOT_EXECUTED)
+            {
+                return false;
+            }
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
             }
+            return false;
         }
 
-        setStateDbRouteEntry(ipPrefix, bucket_idx, nh_memb_key);
+        fvs.emplace_back(std::to_string(bucket_idx), nh_memb_key.to_string());
         syncd_fg_route_entry.syncd_fgnhg_map[bank][nh_memb_key].push_back(bucket_idx);
         syncd_fg_route_entry.active_nexthops.insert(nh_memb_key);
-        syncd_fg_route_entry.nhopgroup_members[bucket_idx] = next_hop_group_member_id;
+        syncd_fg_route_entry.nhopgroup_members[bucket_idx] = member_ids[i];
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
     }
 
+    m_stateWarmRestartRouteTable.set(ipPrefix.to_string(), fvs);
+
     return true;
 }
 
@@ -98,6 +98,15 @@ typedef struct
     std::vector<NextHopKey> active_nhs;
 } BankMemberChanges;
 
+/* Bucket rewrite queued while the hash bucket changes for a route are computed,
+ * the SAI update for all of them is issued in bulk once the computation is done */
+typedef struct
+{
+    sai_object_id_t nh_oid;
+    NextHopKey nextHop;
+} FgHashBucketWrite;
+typedef std::map<HashBucketIdx, FgHashBucketWrite> FgHashBucketWrites;
+
 typedef std::vector<string> NextHopIndexMap;
 typedef map<string, NextHopIndexMap> WarmBootRecoveryMap;
 
@@ -140,6 +149,9 @@ private:
     // < ip_prefix, < HashBuckets, nh_ip>>
     WarmBootRecoveryMap m_recoveryMap;
 
+    // bucket rewrites pending for the route currently being recomputed
+    FgHashBucketWrites m_pendingBucketWrites;
+
     bool setNewNhgMembers(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     std::vector<BankMemberChanges> &bank_member_changes,
                     std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
@@ -161,9 +173,8 @@ private:
                     uint32_t bank, std::vector<BankMemberChanges> bank_member_changes,
                     std::map<NextHopKey,sai_object_id_t> &nhopgroup_members_set, const IpPrefix&);
     void calculateBankHashBucketStartIndices(FgNhgEntry *fgNhgEntry);
-    void setStateDbRouteEntry(const IpPrefix&, uint32_t index, NextHopKey nextHop);
-    bool writeHashBucketChange(FGNextHopGroupEntry *syncd_fg_route_entry, uint32_t index, sai_object_id_t nh_oid,
-                    const IpPrefix &ipPrefix, NextHopKey nextHop);
+    void queueHashBucketChange(uint32_t index, sai_object_id_t nh_oid, NextHopKey nextHop);
+    bool flushHashBucketChanges(FGNextHopGroupEntry *syncd_fg_route_entry, const IpPrefix &ipPrefix);
     bool modifyRoutesNextHopId(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, sai_object_id_t next_hop_id);
     bool createFineGrainedNextHopGroup(FGNextHopGroupEntry &syncd_fg_route_entry, FgNhgEntry *fgNhgEntry,
                     const NextHopGroupKey &nextHops);
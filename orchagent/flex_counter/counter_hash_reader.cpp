@@ -0,0 +1,88 @@
+#include "counter_hash_reader.h"
+
+#include <memory>
+
+#include <hiredis/hiredis.h>
+
+#include "logger.h"
+#include "rediscommand.h"
+
+using std::string;
+using std::vector;
+
+bool readCounterHashes(swss::DBConnector *db, const vector<CounterHashRead>& reads)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = db->getContext();
+    size_t pending = 0;
+
+    for (const auto& read : reads)
+    {
+        vector<const char *> argv(read.fields.size() + 2);
+        vector<size_t> argvlen(read.fields.size() + 2);
+
+        argv[0] = "HMGET";
+        argvlen[0] = 5;
+        for (size_t i = 0; i < read.fields.size(); i++)
+        {
+            argv[i + 2] = read.fields[i].c_str();
+            argvlen[i + 2] = read.fields[i].size();
+        }
+
+        for (const auto& hash : read.hashes)
+        {
+            argv[1] = hash.c_str();
+            argvlen[1] = hash.size();
+
+            swss::RedisCommand command;
+            command.formatArgv(static_cast<int>(argv.size()), argv.data(), argvlen.data());
+            if (redisAppendFormattedCommand(ctx, command.c_str(), command.length()) != REDIS_OK)
+            {
+                SWSS_LOG_ERROR("Failed to queue read of %s: %s", hash.c_str(), ctx->errstr);
+                return false;
+            }
+            pending++;
+        }
+    }
+
+    bool success = true;
+
+    for (const auto& read : reads)
+    {
+        for (size_t hash = 0; hash < read.hashes.size(); hash++)
+        {
+            void *raw = nullptr;
+            if (redisGetReply(ctx, &raw) != REDIS_OK)
+            {
+                SWSS_LOG_ERROR("Failed to read counters, %zu replies outstanding: %s", pending, ctx->errstr);
+                return false;
+            }
+            pending--;
+
+            std::unique_ptr<redisReply, void (*)(void *)> reply(static_cast<redisReply *>(raw), freeReplyObject);
+            if (reply->type != REDIS_REPLY_ARRAY || reply->elements != read.fields.size())
+            {
+                // Keep draining, so the next read does not get stale replies
+                success = false;
+                continue;
+            }
+
+            for (size_t field = 0; field < reply->elements; field++)
+            {
+                const redisReply *value = reply->element[field];
+                if (value->type == REDIS_REPLY_STRING)
+                {
+                    read.handler(hash, field, string(value->str, value->len));
+                }
+            }
+        }
+    }
+
+    if (!success)
+    {
+        SWSS_LOG_WARN("Unexpected replies reading counters");
+    }
+
+    return success;
+}
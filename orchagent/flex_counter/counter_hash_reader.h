@@ -0,0 +1,24 @@
+#ifndef ORCHAGENT_COUNTER_HASH_READER_H
+#define ORCHAGENT_COUNTER_HASH_READER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+
+// Fields to read from a list of hashes, e.g. COUNTERS:oid:0x... The handler
+// is called with the hash and field index of every field that is set.
+struct CounterHashRead
+{
+    std::vector<std::string> hashes;
+    std::vector<std::string> fields;
+    std::function<void(size_t hash, size_t field, const std::string& value)> handler;
+};
+
+// Reads the fields of many hashes with one HMGET per hash, all of them sent
+// to Redis before the first reply is collected, so the whole read costs a
+// single round trip instead of one per object.
+bool readCounterHashes(swss::DBConnector *db, const std::vector<CounterHashRead>& reads);
+
+#endif // ORCHAGENT_COUNTER_HASH_READER_H
@@ -0,0 +1,808 @@
+#include "counter_rate_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+#include "schema.h"
+#include "logger.h"
+
+using std::string;
+using std::vector;
+using swss::FieldValueTuple;
+
+namespace
+{
+    // Column layout of the port store, counter names follow the order
+    enum PortCounter
+    {
+        PORT_IN_UCAST_PKTS,
+        PORT_IN_NON_UCAST_PKTS,
+        PORT_OUT_UCAST_PKTS,
+        PORT_OUT_NON_UCAST_PKTS,
+        PORT_IN_OCTETS,
+        PORT_OUT_OCTETS,
+        PORT_FEC_CORRECTED_BITS,
+        PORT_FEC_NOT_CORRECTABLE_FRAMES,
+        PORT_FEC_CORRECTABLE_FRAMES,
+        PORT_FEC_CODEWORD_ERRORS_S0,
+        PORT_COUNTERS = PORT_FEC_CODEWORD_ERRORS_S0 + 16
+    };
+
+    enum PortState
+    {
+        PORT_RX_BPS,
+        PORT_RX_PPS,
+        PORT_TX_BPS,
+        PORT_TX_PPS,
+        PORT_INIT,
+        PORT_SPEED,
+        PORT_LANES,
+        PORT_FEC_PRE_BER_MAX,
+        PORT_STATES
+    };
+
+    enum RifCounter
+    {
+        RIF_IN_OCTETS,
+        RIF_IN_PACKETS,
+        RIF_OUT_OCTETS,
+        RIF_OUT_PACKETS,
+        RIF_COUNTERS
+    };
+
+    enum RifState
+    {
+        RIF_RX_BPS,
+        RIF_RX_PPS,
+        RIF_TX_BPS,
+        RIF_TX_PPS,
+        RIF_INIT,
+        RIF_STATES
+    };
+
+    // Same states the Lua scripts keep in INIT_DONE
+    const double RATE_INIT_NONE = 0;
+    const double RATE_INIT_COUNTERS_LAST = 1;
+    const double RATE_INIT_DONE = 2;
+
+    // Watermark states are a value and the value last written per counter and table
+    enum WatermarkLevel
+    {
+        WM_PERIODIC,
+        WM_PERSISTENT,
+        WM_USER,
+        WM_LEVELS
+    };
+
+    const double WM_UNSET = -1;
+
+    size_t wmValueColumn(size_t counter, size_t level)
+    {
+        return (counter * WM_LEVELS + level) * 2;
+    }
+
+    size_t wmWrittenColumn(size_t counter, size_t level)
+    {
+        return wmValueColumn(counter, level) + 1;
+    }
+
+    // HLD review suggest to use the statistical average when calculate the post fec ber
+    const double RS_AVERAGE_FRAME_BER = 1e-8;
+
+    // Predicted FLR parameters, see port_flr.lua
+    const double FLR_BIN_FILTER_VALUE = 10;
+    const size_t FLR_MIN_SIGNIFICANT_BINS = 2;
+    const int FLR_WINDOW_START = 16;
+    const int FLR_WINDOW_END = 20;
+    const double FLR_MFC = 8;
+
+    vector<string> portCounterNames()
+    {
+        vector<string> names = {
+            "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_IN_OCTETS",
+            "SAI_PORT_STAT_IF_OUT_OCTETS",
+            "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS",
+            "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES",
+            "SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES",
+        };
+
+        for (int i = 0; i < 16; i++)
+        {
+            names.push_back("SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S" + std::to_string(i));
+        }
+
+        return names;
+    }
+
+    const vector<string> rifCounterNames = {
+        "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS",
+        "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS",
+    };
+
+    const vector<string> queueWatermarkNames = {
+        "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+    };
+
+    const vector<string> pgWatermarkNames = {
+        "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
+        "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
+    };
+
+    // Numbers are written the way Lua converts them for redis.call
+    string toDbString(double value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.14g", value);
+        return buf;
+    }
+
+    // Counters going backwards were cleared, don't report a negative rate for them
+    double counterDelta(uint64_t current, uint64_t last)
+    {
+        return current >= last ? static_cast<double>(current - last) : 0;
+    }
+
+    // Serdes speed in bits per second of a single lane, 0 if unknown
+    double serdesSpeed(uint32_t speed, uint32_t lanes)
+    {
+        if (lanes == 0 || speed == 0 || speed % lanes != 0)
+        {
+            return 0;
+        }
+
+        switch (speed / lanes)
+        {
+            case 1000:
+                return 1.25e+9;
+            case 10000:
+                return 10.3125e+9;
+            case 25000:
+                return 25.78125e+9;
+            case 50000:
+                return 53.125e+9;
+            case 100000:
+                return 106.25e+9;
+            case 200000:
+                return 212.5e+9;
+            default:
+                return 0;
+        }
+    }
+
+    double interleavingFactor(uint32_t speed, uint32_t lanes)
+    {
+        static const std::map<std::pair<uint32_t, uint32_t>, double> factors = {
+            { { 1600000, 8 }, 4 },
+            { { 800000, 8 }, 4 },
+            { { 400000, 8 }, 2 },
+            { { 400000, 4 }, 2 },
+            { { 200000, 4 }, 2 },
+            { { 200000, 2 }, 2 },
+            { { 100000, 2 }, 2 },
+        };
+
+        auto it = factors.find({ speed, lanes });
+        return it == factors.end() ? 1 : it->second;
+    }
+}
+
+CounterColumnStore::CounterColumnStore(const vector<string>& counter_names, size_t state_columns) :
+    counter_names(counter_names),
+    values(counter_names.size()),
+    present(counter_names.size()),
+    states(state_columns)
+{
+    for (size_t snapshot = 0; snapshot < COUNTER_RATE_SNAPSHOTS; snapshot++)
+    {
+        snapshot_values[snapshot].resize(counter_names.size());
+        snapshot_present[snapshot].resize(counter_names.size());
+    }
+}
+
+size_t CounterColumnStore::addRow(const string& key)
+{
+    size_t row;
+    if (findRow(key, row))
+    {
+        return row;
+    }
+
+    row = keys.size();
+    keys.push_back(key);
+    key_rows[key] = row;
+
+    for (size_t column = 0; column < counter_names.size(); column++)
+    {
+        values[column].push_back(0);
+        present[column].push_back(0);
+        for (size_t snapshot = 0; snapshot < COUNTER_RATE_SNAPSHOTS; snapshot++)
+        {
+            snapshot_values[snapshot][column].push_back(0);
+            snapshot_present[snapshot][column].push_back(0);
+        }
+    }
+
+    for (auto& column : states)
+    {
+        column.push_back(0);
+    }
+
+    return row;
+}
+
+bool CounterColumnStore::removeRow(const string& key)
+{
+    size_t row;
+    if (!findRow(key, row))
+    {
+        return false;
+    }
+
+    size_t last = keys.size() - 1;
+
+    auto swapRemove = [row, last](auto& column)
+    {
+        column[row] = column[last];
+        column.pop_back();
+    };
+
+    for (size_t column = 0; column < counter_names.size(); column++)
+    {
+        swapRemove(values[column]);
+        swapRemove(present[column]);
+        for (size_t snapshot = 0; snapshot < COUNTER_RATE_SNAPSHOTS; snapshot++)
+        {
+            swapRemove(snapshot_values[snapshot][column]);
+            swapRemove(snapshot_present[snapshot][column]);
+        }
+    }
+
+    for (auto& column : states)
+    {
+        swapRemove(column);
+    }
+
+    key_rows.erase(key);
+    if (row != last)
+    {
+        key_rows[keys[last]] = row;
+    }
+    swapRemove(keys);
+
+    return true;
+}
+
+bool CounterColumnStore::findRow(const string& key, size_t& row) const
+{
+    auto it = key_rows.find(key);
+    if (it == key_rows.end())
+    {
+        return false;
+    }
+
+    row = it->second;
+    return true;
+}
+
+void CounterColumnStore::setCounter(size_t column, size_t row, uint64_t value)
+{
+    values[column][row] = value;
+    present[column][row] = 1;
+}
+
+void CounterColumnStore::clearCounter(size_t column, size_t row)
+{
+    present[column][row] = 0;
+}
+
+void CounterColumnStore::takeSnapshot(size_t snapshot, size_t row)
+{
+    for (size_t column = 0; column < counter_names.size(); column++)
+    {
+        snapshot_values[snapshot][column][row] = values[column][row];
+        snapshot_present[snapshot][column][row] = present[column][row];
+    }
+}
+
+bool CounterColumnStore::hasSnapshot(size_t snapshot, size_t column, size_t row) const
+{
+    return snapshot_present[snapshot][column][row] != 0;
+}
+
+uint64_t CounterColumnStore::snapshot(size_t snapshot, size_t column, size_t row) const
+{
+    return snapshot_values[snapshot][column][row];
+}
+
+uint64_t CounterColumnStore::fingerprint() const
+{
+    // FNV-1a over the row count and every counter with its presence
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            hash = (hash ^ ((value >> (i * 8)) & 0xff)) * 1099511628211ULL;
+        }
+    };
+
+    mix(keys.size());
+    for (size_t column = 0; column < counter_names.size(); column++)
+    {
+        for (size_t row = 0; row < keys.size(); row++)
+        {
+            mix(present[column][row] ? values[column][row] : UINT64_MAX);
+        }
+    }
+
+    return hash;
+}
+
+CounterRateEngine::CounterRateEngine() :
+    port_store(portCounterNames(), PORT_STATES),
+    rif_store(rifCounterNames, RIF_STATES),
+    queue_wm_store(queueWatermarkNames, wmValueColumn(queueWatermarkNames.size(), 0)),
+    pg_wm_store(pgWatermarkNames, wmValueColumn(pgWatermarkNames.size(), 0))
+{
+}
+
+const vector<string>& CounterRateEngine::watermarkTables()
+{
+    // Indexed by WatermarkLevel
+    static const vector<string> tables = {
+        PERIODIC_WATERMARKS_TABLE,
+        PERSISTENT_WATERMARKS_TABLE,
+        USER_WATERMARKS_TABLE,
+    };
+
+    return tables;
+}
+
+CounterColumnStore& CounterRateEngine::store(CounterRateGroup group)
+{
+    switch (group)
+    {
+        case CounterRateGroup::PORT:
+            return port_store;
+        case CounterRateGroup::RIF:
+            return rif_store;
+        case CounterRateGroup::QUEUE_WATERMARK:
+            return queue_wm_store;
+        case CounterRateGroup::PG_WATERMARK:
+        default:
+            return pg_wm_store;
+    }
+}
+
+void CounterRateEngine::addObject(CounterRateGroup group, const string& key)
+{
+    CounterColumnStore& s = store(group);
+
+    size_t row;
+    if (s.findRow(key, row))
+    {
+        return;
+    }
+
+    row = s.addRow(key);
+
+    if (group == CounterRateGroup::QUEUE_WATERMARK || group == CounterRateGroup::PG_WATERMARK)
+    {
+        for (size_t counter = 0; counter < s.counterNames().size(); counter++)
+        {
+            for (size_t level = 0; level < WM_LEVELS; level++)
+            {
+                s.state(wmValueColumn(counter, level), row) = WM_UNSET;
+                s.state(wmWrittenColumn(counter, level), row) = WM_UNSET;
+            }
+        }
+    }
+}
+
+void CounterRateEngine::removeObject(CounterRateGroup group, const string& key)
+{
+    store(group).removeRow(key);
+}
+
+void CounterRateEngine::setPortSpeed(const string& key, uint32_t speed, uint32_t lanes)
+{
+    size_t row;
+    if (!port_store.findRow(key, row))
+    {
+        return;
+    }
+
+    port_store.state(PORT_SPEED, row) = speed;
+    port_store.state(PORT_LANES, row) = lanes;
+}
+
+void CounterRateEngine::seedWatermark(CounterRateGroup group, const string& table,
+        const string& key, const string& stat, uint64_t value)
+{
+    CounterColumnStore& s = store(group);
+    const auto& tables = watermarkTables();
+    const auto& names = s.counterNames();
+
+    size_t row;
+    size_t level = static_cast<size_t>(std::find(tables.begin(), tables.end(), table) - tables.begin());
+    size_t counter = static_cast<size_t>(std::find(names.begin(), names.end(), stat) - names.begin());
+    if (level >= WM_LEVELS || counter >= names.size() || !s.findRow(key, row))
+    {
+        return;
+    }
+
+    s.state(wmValueColumn(counter, level), row) = static_cast<double>(value);
+    s.state(wmWrittenColumn(counter, level), row) = static_cast<double>(value);
+}
+
+void CounterRateEngine::seedFecPreBerMax(const string& key, double value)
+{
+    size_t row;
+    if (port_store.findRow(key, row))
+    {
+        port_store.state(PORT_FEC_PRE_BER_MAX, row) = value;
+    }
+}
+
+void CounterRateEngine::clearWatermark(const string& table, const string& key, const string& stat)
+{
+    const auto& tables = watermarkTables();
+    size_t level = static_cast<size_t>(std::find(tables.begin(), tables.end(), table) - tables.begin());
+    if (level >= WM_LEVELS)
+    {
+        return;
+    }
+
+    for (CounterColumnStore *s : { &queue_wm_store, &pg_wm_store })
+    {
+        const auto& names = s->counterNames();
+        size_t counter = static_cast<size_t>(std::find(names.begin(), names.end(), stat) - names.begin());
+
+        size_t row;
+        if (counter < names.size() && s->findRow(key, row))
+        {
+            // The clearing side has already written 0 to the DB
+            s->state(wmValueColumn(counter, level), row) = 0;
+            s->state(wmWrittenColumn(counter, level), row) = 0;
+        }
+    }
+}
+
+bool CounterRateEngine::takeNewPoll(CounterRateGroup group)
+{
+    uint64_t hash = store(group).fingerprint();
+
+    auto it = poll_fingerprints.find(group);
+    if (it != poll_fingerprints.end() && it->second == hash)
+    {
+        return false;
+    }
+
+    poll_fingerprints[group] = hash;
+    return true;
+}
+
+void CounterRateEngine::computePortRates(bool has_alpha, double alpha, uint64_t delta_ms,
+        vector<CounterRateUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    if (delta_ms == 0)
+    {
+        return;
+    }
+
+    CounterColumnStore& s = port_store;
+    const double scale = 1000.0 / static_cast<double>(delta_ms);
+
+    for (size_t row = 0; row < s.rows(); row++)
+    {
+        CounterRateUpdate update = { RATES_TABLE, s.key(row), {} };
+
+        bool has_rate_counters = true;
+        for (size_t column = PORT_IN_UCAST_PKTS; column <= PORT_OUT_OCTETS; column++)
+        {
+            has_rate_counters = has_rate_counters && s.hasCounter(column, row);
+        }
+
+        if (has_alpha && has_rate_counters)
+        {
+            double& init = s.state(PORT_INIT, row);
+            if (init != RATE_INIT_NONE)
+            {
+                auto delta = [&s, row](size_t column)
+                {
+                    return counterDelta(s.counter(column, row), s.snapshot(COUNTER_RATE_SNAPSHOT_RATES, column, row));
+                };
+
+                double rates[] = {
+                    delta(PORT_IN_OCTETS) * scale,
+                    (delta(PORT_IN_UCAST_PKTS) + delta(PORT_IN_NON_UCAST_PKTS)) * scale,
+                    delta(PORT_OUT_OCTETS) * scale,
+                    (delta(PORT_OUT_UCAST_PKTS) + delta(PORT_OUT_NON_UCAST_PKTS)) * scale,
+                };
+                static const char *fields[] = { "RX_BPS", "RX_PPS", "TX_BPS", "TX_PPS" };
+
+                for (size_t i = 0; i < 4; i++)
+                {
+                    double& rate = s.state(PORT_RX_BPS + i, row);
+                    rate = init == RATE_INIT_DONE ? alpha * rates[i] + (1.0 - alpha) * rate : rates[i];
+                    update.values.emplace_back(fields[i], toDbString(rate));
+                }
+
+                init = RATE_INIT_DONE;
+            }
+            else
+            {
+                init = RATE_INIT_COUNTERS_LAST;
+            }
+        }
+
+        computeBer(row, delta_ms, update);
+
+        s.takeSnapshot(COUNTER_RATE_SNAPSHOT_RATES, row);
+
+        if (!update.values.empty())
+        {
+            updates.push_back(std::move(update));
+        }
+    }
+}
+
+void CounterRateEngine::computeBer(size_t row, uint64_t delta_ms, CounterRateUpdate& update)
+{
+    CounterColumnStore& s = port_store;
+
+    if (!s.hasCounter(PORT_FEC_CORRECTED_BITS, row) || !s.hasCounter(PORT_FEC_NOT_CORRECTABLE_FRAMES, row) ||
+        !s.hasSnapshot(COUNTER_RATE_SNAPSHOT_RATES, PORT_FEC_CORRECTED_BITS, row) ||
+        !s.hasSnapshot(COUNTER_RATE_SNAPSHOT_RATES, PORT_FEC_NOT_CORRECTABLE_FRAMES, row))
+    {
+        return;
+    }
+
+    uint32_t speed = static_cast<uint32_t>(s.state(PORT_SPEED, row));
+    uint32_t lanes = static_cast<uint32_t>(s.state(PORT_LANES, row));
+    double serdes_rate_total = lanes * serdesSpeed(speed, lanes) * static_cast<double>(delta_ms) / 1000;
+    if (serdes_rate_total == 0)
+    {
+        return;
+    }
+
+    double pre_ber = counterDelta(s.counter(PORT_FEC_CORRECTED_BITS, row),
+            s.snapshot(COUNTER_RATE_SNAPSHOT_RATES, PORT_FEC_CORRECTED_BITS, row)) / serdes_rate_total;
+    double post_ber = counterDelta(s.counter(PORT_FEC_NOT_CORRECTABLE_FRAMES, row),
+            s.snapshot(COUNTER_RATE_SNAPSHOT_RATES, PORT_FEC_NOT_CORRECTABLE_FRAMES, row)) *
+        RS_AVERAGE_FRAME_BER / serdes_rate_total;
+
+    // Maximum FEC histogram bin with non-zero count
+    int max_t = -1;
+    for (int i = 0; i < 16; i++)
+    {
+        size_t column = PORT_FEC_CODEWORD_ERRORS_S0 + static_cast<size_t>(i);
+        if (s.hasCounter(column, row) && s.counter(column, row) > 0)
+        {
+            max_t = i;
+        }
+    }
+
+    double& pre_ber_max = s.state(PORT_FEC_PRE_BER_MAX, row);
+    if (pre_ber > pre_ber_max)
+    {
+        pre_ber_max = pre_ber;
+        update.values.emplace_back("FEC_PRE_BER_MAX", toDbString(pre_ber));
+    }
+
+    update.values.emplace_back("FEC_PRE_BER", toDbString(pre_ber));
+    update.values.emplace_back("FEC_POST_BER", toDbString(post_ber));
+    update.values.emplace_back("FEC_MAX_T", std::to_string(max_t));
+}
+
+void CounterRateEngine::computePortFlr(vector<CounterRateUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    CounterColumnStore& s = port_store;
+
+    for (size_t row = 0; row < s.rows(); row++)
+    {
+        if (!s.hasCounter(PORT_FEC_CORRECTABLE_FRAMES, row))
+        {
+            continue;
+        }
+
+        // Codewords seen in each symbol error bin since the previous FLR computation
+        double bins[16];
+        for (size_t i = 0; i < 16; i++)
+        {
+            size_t column = PORT_FEC_CODEWORD_ERRORS_S0 + i;
+            bins[i] = counterDelta(s.counter(column, row), s.snapshot(COUNTER_RATE_SNAPSHOT_FLR, column, row));
+        }
+
+        uint32_t speed = static_cast<uint32_t>(s.state(PORT_SPEED, row));
+        uint32_t lanes = static_cast<uint32_t>(s.state(PORT_LANES, row));
+        double interleaving = interleavingFactor(speed, lanes);
+
+        // Observed FLR from the uncorrectable codeword ratio
+        double flr = 0;
+        if (s.hasCounter(PORT_FEC_NOT_CORRECTABLE_FRAMES, row) && s.hasCounter(PORT_FEC_CODEWORD_ERRORS_S0, row))
+        {
+            double uncorr = counterDelta(s.counter(PORT_FEC_NOT_CORRECTABLE_FRAMES, row),
+                    s.snapshot(COUNTER_RATE_SNAPSHOT_FLR, PORT_FEC_NOT_CORRECTABLE_FRAMES, row));
+            double corr = counterDelta(s.counter(PORT_FEC_CORRECTABLE_FRAMES, row),
+                    s.snapshot(COUNTER_RATE_SNAPSHOT_FLR, PORT_FEC_CORRECTABLE_FRAMES, row));
+            double total = uncorr + corr + bins[0];
+            if (total != 0)
+            {
+                flr = interleaving * uncorr / total;
+            }
+        }
+
+        // Predicted FLR from a log-linear regression over the S1-S15 bins
+        double predicted_flr = 0;
+        double r_squared = 0;
+        double total_cws = 0;
+        size_t significant = 0;
+        for (size_t i = 0; i < 16; i++)
+        {
+            total_cws += bins[i];
+            if (i > 0 && bins[i] > FLR_BIN_FILTER_VALUE)
+            {
+                significant++;
+            }
+        }
+
+        if (total_cws != 0 && significant >= FLR_MIN_SIGNIFICANT_BINS)
+        {
+            double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0;
+            for (size_t i = 1; i < 16; i++)
+            {
+                if (bins[i] <= FLR_BIN_FILTER_VALUE)
+                {
+                    continue;
+                }
+
+                double x = static_cast<double>(i);
+                double y = std::log10(bins[i] / total_cws);
+                n += 1;
+                sx += x;
+                sy += y;
+                sxx += x * x;
+                sxy += x * y;
+                syy += y * y;
+            }
+
+            double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+            double intercept = (sy - slope * sx) / n;
+            double r = (n * sxy - sx * sy) / std::sqrt((n * sxx - sx * sx) * (n * syy - sy * sy));
+            r_squared = r * r;
+
+            double cer = 0;
+            for (int x = FLR_WINDOW_START; x <= FLR_WINDOW_END + 1; x++)
+            {
+                cer += std::pow(10, intercept + slope * x);
+            }
+            predicted_flr = cer * (1 + interleaving * FLR_MFC) / FLR_MFC;
+        }
+
+        s.takeSnapshot(COUNTER_RATE_SNAPSHOT_FLR, row);
+
+        updates.push_back({ RATES_TABLE, s.key(row), {
+            { "FEC_FLR", toDbString(flr) },
+            { "FEC_FLR_PREDICTED", toDbString(predicted_flr) },
+            { "FEC_FLR_R_SQUARED", toDbString(r_squared) },
+        } });
+    }
+}
+
+void CounterRateEngine::computeRifRates(bool has_alpha, double alpha, uint64_t delta_ms,
+        vector<CounterRateUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    if (!has_alpha || delta_ms == 0)
+    {
+        return;
+    }
+
+    CounterColumnStore& s = rif_store;
+    const double scale = 1000.0 / static_cast<double>(delta_ms);
+
+    for (size_t row = 0; row < s.rows(); row++)
+    {
+        bool has_counters = true;
+        for (size_t column = 0; column < RIF_COUNTERS; column++)
+        {
+            has_counters = has_counters && s.hasCounter(column, row);
+        }
+
+        if (!has_counters)
+        {
+            continue;
+        }
+
+        double& init = s.state(RIF_INIT, row);
+        if (init != RATE_INIT_NONE)
+        {
+            auto delta = [&s, row](size_t column)
+            {
+                return counterDelta(s.counter(column, row), s.snapshot(COUNTER_RATE_SNAPSHOT_RATES, column, row));
+            };
+
+            double rates[] = {
+                delta(RIF_IN_OCTETS) * scale,
+                delta(RIF_IN_PACKETS) * scale,
+                delta(RIF_OUT_OCTETS) * scale,
+                delta(RIF_OUT_PACKETS) * scale,
+            };
+            static const char *fields[] = { "RX_BPS", "RX_PPS", "TX_BPS", "TX_PPS" };
+
+            CounterRateUpdate update = { RATES_TABLE, s.key(row), {} };
+            for (size_t i = 0; i < 4; i++)
+            {
+                double& rate = s.state(RIF_RX_BPS + i, row);
+                rate = init == RATE_INIT_DONE ? alpha * rates[i] + (1.0 - alpha) * rate : rates[i];
+                update.values.emplace_back(fields[i], toDbString(rate));
+            }
+            updates.push_back(std::move(update));
+
+            init = RATE_INIT_DONE;
+        }
+        else
+        {
+            init = RATE_INIT_COUNTERS_LAST;
+        }
+
+        s.takeSnapshot(COUNTER_RATE_SNAPSHOT_RATES, row);
+    }
+}
+
+void CounterRateEngine::computeWatermarks(CounterRateGroup group, vector<CounterRateUpdate>& updates)
+{
+    SWSS_LOG_ENTER();
+
+    CounterColumnStore& s = store(group);
+    const auto& names = s.counterNames();
+    const auto& tables = watermarkTables();
+
+    for (size_t level = 0; level < WM_LEVELS; level++)
+    {
+        for (size_t row = 0; row < s.rows(); row++)
+        {
+            CounterRateUpdate update = { tables[level], s.key(row), {} };
+
+            for (size_t counter = 0; counter < names.size(); counter++)
+            {
+                if (!s.hasCounter(counter, row))
+                {
+                    continue;
+                }
+
+                double current = static_cast<double>(s.counter(counter, row));
+                double& value = s.state(wmValueColumn(counter, level), row);
+                double& written = s.state(wmWrittenColumn(counter, level), row);
+
+                value = value == WM_UNSET ? current : std::max(value, current);
+
+                // Only changed watermarks are written back
+                if (value != written)
+                {
+                    written = value;
+                    update.values.emplace_back(names[counter], std::to_string(static_cast<uint64_t>(value)));
+                }
+            }
+
+            if (!update.values.empty())
+            {
+                updates.push_back(std::move(update));
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef ORCHAGENT_COUNTER_RATE_ENGINE_H
+#define ORCHAGENT_COUNTER_RATE_ENGINE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include "table.h"
+
+#define RATES_TABLE "RATES"
+
+#define COUNTER_RATE_SNAPSHOT_RATES 0   // counters of the previous rate/BER computation
+#define COUNTER_RATE_SNAPSHOT_FLR   1   // counters of the previous FLR computation
+#define COUNTER_RATE_SNAPSHOTS      2
+
+// CounterColumnStore keeps the counters of one group of objects column by
+// column: every counter is a contiguous array indexed by the object row, so a
+// computation walks arrays instead of looking up hashes per object and field.
+// Rows are swap-removed, so row numbers are only stable until the next removal.
+class CounterColumnStore
+{
+    public:
+        CounterColumnStore(const std::vector<std::string>& counter_names, size_t state_columns);
+
+        size_t addRow(const std::string& key);
+        bool removeRow(const std::string& key);
+        bool findRow(const std::string& key, size_t& row) const;
+
+        size_t rows() const { return keys.size(); }
+        const std::string& key(size_t row) const { return keys[row]; }
+        const std::vector<std::string>& counterNames() const { return counter_names; }
+
+        void setCounter(size_t column, size_t row, uint64_t value);
+        void clearCounter(size_t column, size_t row);
+        bool hasCounter(size_t column, size_t row) const { return present[column][row] != 0; }
+        uint64_t counter(size_t column, size_t row) const { return values[column][row]; }
+
+        // Copy the current counters of a row into one of its snapshots
+        void takeSnapshot(size_t snapshot, size_t row);
+        bool hasSnapshot(size_t snapshot, size_t column, size_t row) const;
+        uint64_t snapshot(size_t snapshot, size_t column, size_t row) const;
+
+        // Hash of all counters, changes when any counter of any row does
+        uint64_t fingerprint() const;
+
+        double& state(size_t column, size_t row) { return states[column][row]; }
+        double state(size_t column, size_t row) const { return states[column][row]; }
+
+    private:
+        std::vector<std::string> counter_names;
+        std::vector<std::string> keys;
+        std::unordered_map<std::string, size_t> key_rows;
+
+        std::vector<std::vector<uint64_t>> values;
+        std::vector<std::vector<uint8_t>> present;
+        std::vector<std::vector<uint64_t>> snapshot_values[COUNTER_RATE_SNAPSHOTS];
+        std::vector<std::vector<uint8_t>> snapshot_present[COUNTER_RATE_SNAPSHOTS];
+        std::vector<std::vector<double>> states;
+};
+
+enum class CounterRateGroup
+{
+    PORT,
+    RIF,
+    QUEUE_WATERMARK,
+    PG_WATERMARK,
+};
+
+// One hash to write back, keyed by table name and object key
+struct CounterRateUpdate
+{
+    std::string table;
+    std::string key;
+    std::vector<swss::FieldValueTuple> values;
+};
+
+// CounterRateEngine does natively what port_rates.lua, port_flr.lua,
+// rif_rates.lua and watermark_{queue,pg}.lua do inside Redis on every poll:
+// smoothed port and RIF rates, FEC BER and FLR, and the periodic, persistent
+// and user watermarks. It only works on its column stores; reading COUNTERS
+// and writing the results back is up to the caller.
+class CounterRateEngine
+{
+    public:
+        CounterRateEngine();
+
+        CounterColumnStore& store(CounterRateGroup group);
+
+        void addObject(CounterRateGroup group, const std::string& key);
+        void removeObject(CounterRateGroup group, const std::string& key);
+
+        // Port speed in Mbps and its lane count, used for BER and FLR
+        void setPortSpeed(const std::string& key, uint32_t speed, uint32_t lanes);
+
+        // Seed a max type value kept across restarts, e.g. a persistent watermark
+        void seedWatermark(CounterRateGroup group, const std::string& table,
+                const std::string& key, const std::string& stat, uint64_t value);
+        void seedFecPreBerMax(const std::string& key, double value);
+
+        // Reset a watermark the way WatermarkOrch clears it in the DB
+        void clearWatermark(const std::string& table, const std::string& key, const std::string& stat);
+
+        // True when the counters just read differ from those of the last poll taken
+        // for the group, i.e. the flex counter poll has landed since then. Reading
+        // the same poll again must not feed it to the computations a second time.
+        bool takeNewPoll(CounterRateGroup group);
+
+        // alpha is the PORT_ALPHA/RIF_ALPHA smoothing factor, rates are skipped if it is not set
+        void computePortRates(bool has_alpha, double alpha, uint64_t delta_ms,
+                std::vector<CounterRateUpdate>& updates);
+        void computePortFlr(std::vector<CounterRateUpdate>& updates);
+        void computeRifRates(bool has_alpha, double alpha, uint64_t delta_ms,
+                std::vector<CounterRateUpdate>& updates);
+        void computeWatermarks(CounterRateGroup group, std::vector<CounterRateUpdate>& updates);
+
+        static const std::vector<std::string>& watermarkTables();
+
+    private:
+        void computeBer(size_t row, uint64_t delta_ms, CounterRateUpdate& update);
+
+        CounterColumnStore port_store;
+        CounterColumnStore rif_store;
+        CounterColumnStore queue_wm_store;
+        CounterColumnStore pg_wm_store;
+
+        std::map<CounterRateGroup, uint64_t> poll_fingerprints;
+};
+
+#endif // ORCHAGENT_COUNTER_RATE_ENGINE_H
@@ -22,6 +22,7 @@
 #include "dash/dashorch.h"
 #include "dash/dashmeterorch.h"
 #include "flex_counter/flowcounterrouteorch.h"
+#include "counterrateorch.h"
 
 #include "flexcounterorch.h"
 
@@ -35,6 +36,7 @@ extern BufferOrch *gBufferOrch;
 extern Directory<Orch*> gDirectory;
 extern CoppOrch *gCoppOrch;
 extern FlowCounterRouteOrch *gFlowCounterRouteOrch;
+extern CounterRateOrch *gCounterRateOrch;
 extern Srv6Orch *gSrv6Orch;
 extern SwitchOrch *gSwitchOrch;
 extern sai_object_id_t gSwitchId;
@@ -193,6 +195,24 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                 {
                     setFlexCounterGroupPollInterval(flexCounterGroupMap[key], value);
 
+                    if (gCounterRateOrch)
+                    {
+                        static const map<string, CounterRateGroup> rateGroups =
+                        {
+                            { PORT_KEY, CounterRateGroup::PORT },
+                            { RIF_KEY, CounterRateGroup::RIF },
+                            { QUEUE_WATERMARK, CounterRateGroup::QUEUE_WATERMARK },
+                            { PG_WATERMARK_KEY, CounterRateGroup::PG_WATERMARK },
+                        };
+
+                        auto rateGroup = rateGroups.find(key);
+                        if (rateGroup != rateGroups.end())
+                        {
+                            gCounterRateOrch->setPollInterval(rateGroup->second,
+                                                              static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 10)));
+                        }
+                    }
+
                     if (gPortsOrch && gPortsOrch->isGearboxEnabled())
                     {
                         if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
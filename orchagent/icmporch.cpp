@@ -14,11 +14,14 @@
 #include "icmporch.h"
 #include "switchorch.h"
 #include <string>
+#include <chrono>
+#include <deque>
 
 using namespace std;
 using namespace swss;
 
 extern SwitchOrch *gSwitchOrch;
+extern size_t gMaxBulkSize;
 
 const uint32_t IcmpOrch::m_max_sessions = 1024;
 
@@ -37,6 +40,9 @@ const std::map<std::string, sai_icmp_echo_session_state_t> IcmpOrch::m_session_s
 IcmpOrch::IcmpOrch(DBConnector *db, string tableName, TableConnector stateDbIcmpSessionTable):
     Orch(db, tableName),
     m_stateIcmpSessionTable(stateDbIcmpSessionTable.first, stateDbIcmpSessionTable.second),
+    m_stateDbPipeline(make_unique<RedisPipeline>(stateDbIcmpSessionTable.first)),
+    m_stateIcmpSessionBatchTable(make_unique<Table>(m_stateDbPipeline.get(), stateDbIcmpSessionTable.second, true)),
+    m_stateNotificationStatsTable(make_unique<Table>(m_stateDbPipeline.get(), STATE_OFFLOAD_SESSION_NOTIFICATION_TABLE_NAME, true)),
     m_register_state_change_notif{false}
 {
     SWSS_LOG_ENTER();
@@ -77,6 +83,14 @@ void IcmpOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    // session creates and removes are sent in bulk after the loop, their
+    // entries stay in m_toSync until the result is known
+    IcmpSessionBulker bulker(sai_icmp_echo_api->create_icmp_echo_session,
+            sai_icmp_echo_api->remove_icmp_echo_session, gMaxBulkSize);
+    vector<pair<SyncMap::iterator, unique_ptr<IcmpSaiSessionHandler>>> creating;
+    vector<pair<SyncMap::iterator, unique_ptr<IcmpSaiSessionHandler>>> removing;
+    unordered_set<string> removing_keys;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -88,6 +102,13 @@ void IcmpOrch::doTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
+            // session set again after its queued remove, handled in the next pass
+            if (removing_keys.find(key) != removing_keys.end())
+            {
+                it++;
+                continue;
+            }
+
             if (m_icmp_session_map.find(key) != m_icmp_session_map.end())
             {
                 if (!update_icmp_session(key, data))
@@ -96,7 +117,15 @@ void IcmpOrch::doTask(Consumer &consumer)
                     continue;
                 }
             } else {
-                if (!create_icmp_session(key, data))
+                unique_ptr<IcmpSaiSessionHandler> handler;
+                bool consumed = queue_create_icmp_session(key, data, bulker, handler);
+                if (handler)
+                {
+                    creating.emplace_back(it++, std::move(handler));
+                    continue;
+                }
+
+                if (!consumed)
                 {
                     it++;
                     continue;
@@ -105,7 +134,16 @@ void IcmpOrch::doTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if (!remove_icmp_session(key))
+            unique_ptr<IcmpSaiSessionHandler> handler;
+            bool consumed = queue_remove_icmp_session(key, bulker, handler);
+            if (handler)
+            {
+                removing_keys.insert(key);
+                removing.emplace_back(it++, std::move(handler));
+                continue;
+            }
+
+            if (!consumed)
             {
                 it++;
                 continue;
@@ -118,6 +156,29 @@ void IcmpOrch::doTask(Consumer &consumer)
 
         it = consumer.m_toSync.erase(it);
     }
+
+    if (creating.empty() && removing.empty())
+    {
+        return;
+    }
+
+    bulker.flush();
+
+    for (auto& entry : removing)
+    {
+        if (complete_remove_icmp_session(*entry.second))
+        {
+            consumer.m_toSync.erase(entry.first);
+        }
+    }
+
+    for (auto& entry : creating)
+    {
+        if (complete_create_icmp_session(*entry.second))
+        {
+            consumer.m_toSync.erase(entry.first);
+        }
+    }
 }
 
 void IcmpOrch::doTask(NotificationConsumer &consumer)
@@ -135,54 +196,102 @@ void IcmpOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
+    // notifications already queued behind this one are handled in the same
+    // batch, each session gets one state db write with its final state
+    auto received = chrono::steady_clock::now();
+
+    std::deque<KeyOpFieldsValuesTuple> queued;
+    consumer.pops(queued);
+
+    IcmpStateBatch batch;
     if (op == "icmp_echo_session_state_change")
     {
-        uint32_t count = 0;
-        sai_icmp_echo_session_state_notification_t *icmpSessionState = nullptr;
+        handle_icmp_state_change(data, batch);
+    }
+    for (const auto& notification : queued)
+    {
+        if (kfvOp(notification) == "icmp_echo_session_state_change")
+        {
+            handle_icmp_state_change(kfvKey(notification), batch);
+        }
+    }
+
+    if (!batch.notifications)
+    {
+        return;
+    }
+
+    size_t changes = 0;
+    uint64_t coalesced = 0;
+    for (const auto& state_it : batch.states)
+    {
+        sai_object_id_t id = state_it.first;
 
-        sai_deserialize_icmp_echo_session_state_ntf(data, count, &icmpSessionState);
+        auto lookup = m_icmp_session_lookup.find(id);
+        if (lookup == m_icmp_session_lookup.end())
+        {
+            SWSS_LOG_NOTICE("ICMP session missing for state change notification id:%" PRIx64 " state: %s", id,
+                        m_session_state_lkup.at(state_it.second.back()).c_str());
+            continue;
+        }
+
+        auto& update = lookup->second;
+        auto transitions = IcmpStateBatch::transitions(update.state, state_it.second);
 
-        for (uint32_t i = 0; i < count; i++)
+        // handle state update
+        if (transitions.empty() && !update.init_state)
         {
-            sai_object_id_t id = icmpSessionState[i].icmp_echo_session_id;
-            sai_icmp_echo_session_state_t state = icmpSessionState[i].session_state;
+            continue;
+        }
 
-            SWSS_LOG_INFO("Got ICMP session state change notification id:%" PRIx64 " state: %s", id, m_session_state_lkup.at(state).c_str());
+        sai_icmp_echo_session_state_t state = state_it.second.back();
+        m_stateIcmpSessionBatchTable->hset(update.db_key, IcmpSaiSessionHandler::m_state_fname, m_session_state_lkup.at(state));
 
-            if (m_icmp_session_lookup.find(id) == m_icmp_session_lookup.end())
-            {
-                SWSS_LOG_NOTICE("ICMP session missing for state change notification id:%" PRIx64 " state: %s", id, m_session_state_lkup.at(state).c_str());
-                continue;
-            }
+        for (auto transition : transitions)
+        {
+            SWSS_LOG_NOTICE("ICMP session state for %s changed from %s to %s", update.db_key.c_str(),
+                        m_session_state_lkup.at(update.state).c_str(), m_session_state_lkup.at(transition).c_str());
+            update.state = transition;
+        }
 
-            // handle state update
-            if (state != m_icmp_session_lookup[id].state || m_icmp_session_lookup[id].init_state)
-            {
-                auto key = m_icmp_session_lookup[id].db_key;
-                vector<FieldValueTuple> fvVector;
-                m_stateIcmpSessionTable.get(key, fvVector);
+        update.init_state = false;
+        coalesced += transitions.empty() ? 0 : transitions.size() - 1;
+        changes++;
+    }
 
-                fvVector.push_back({IcmpSaiSessionHandler::m_state_fname, m_session_state_lkup.at(state)});
+    auto process_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - received).count();
+    publish_notification_batch(*m_stateNotificationStatsTable, "ICMP_ECHO", batch.notifications, changes, coalesced,
+            static_cast<uint64_t>(process_us), m_max_notification_process_us);
+    m_stateDbPipeline->flush();
+}
 
-                m_stateIcmpSessionTable.set(key, fvVector);
+void IcmpOrch::handle_icmp_state_change(const std::string& data, IcmpStateBatch& batch)
+{
+    uint32_t count = 0;
+    sai_icmp_echo_session_state_notification_t *icmpSessionState = nullptr;
 
-                SWSS_LOG_NOTICE("ICMP session state for %s changed from %s to %s", key.c_str(),
-                            m_session_state_lkup.at(m_icmp_session_lookup[id].state).c_str(), m_session_state_lkup.at(state).c_str());
+    sai_deserialize_icmp_echo_session_state_ntf(data, count, &icmpSessionState);
 
-                m_icmp_session_lookup[id].state = state;
-                m_icmp_session_lookup[id].init_state = false;
-            }
-        }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        sai_object_id_t id = icmpSessionState[i].icmp_echo_session_id;
+        sai_icmp_echo_session_state_t state = icmpSessionState[i].session_state;
 
-        sai_deserialize_free_icmp_echo_session_state_ntf(count, icmpSessionState);
+        SWSS_LOG_INFO("Got ICMP session state change notification id:%" PRIx64 " state: %s", id, m_session_state_lkup.at(state).c_str());
+
+        batch.add(id, state);
     }
+    batch.notifications++;
+
+    sai_deserialize_free_icmp_echo_session_state_ntf(count, icmpSessionState);
 }
 
-bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTuple>& data)
+bool IcmpOrch::queue_create_icmp_session(const string& key, const vector<FieldValueTuple>& data,
+        IcmpSessionBulker& bulker, unique_ptr<IcmpSaiSessionHandler>& handler)
 {
-    IcmpSaiSessionHandler sai_session_handler(*this);
+    auto sai_session_handler = make_unique<IcmpSaiSessionHandler>(*this);
 
-    if (m_num_sessions == m_max_sessions)
+    if (m_num_sessions + bulker.creating_entries_count() >= m_max_sessions)
     {
         SWSS_LOG_ERROR("ICMP session creation failed, limit (%u) reached", m_num_sessions);
         // return false to retry
@@ -190,7 +299,7 @@ bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTup
     }
 
     // initialize the sai session handler
-    auto init_status = sai_session_handler.init(sai_icmp_echo_api, key);
+    auto init_status = sai_session_handler->init(sai_icmp_echo_api, key);
     if (init_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
         SWSS_LOG_INFO("ICMP session creation failed key(%s), init_status(%s)", key.c_str(),
@@ -200,7 +309,7 @@ bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTup
 
     if (!m_register_state_change_notif)
     {
-        if (!sai_session_handler.register_state_change_notification())
+        if (!sai_session_handler->register_state_change_notification())
         {
             // return false to retry registration
             return false;
@@ -208,7 +317,25 @@ bool IcmpOrch::create_icmp_session(const string& key, const vector<FieldValueTup
         m_register_state_change_notif = true;
     }
 
-    auto create_status = sai_session_handler.create(data);
+    auto create_status = sai_session_handler->queue_create(bulker, data);
+    if (create_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
+    {
+        SWSS_LOG_INFO("ICMP session creation failed key(%s), create_status(%s)", key.c_str(),
+                SaiOffloadStatusStrMap.at(create_status).c_str());
+        // do not consume the entry for retries
+        bool skip_entry = create_status != SaiOffloadHandlerStatus::RETRY_VALID_ENTRY;
+        return skip_entry;
+    }
+
+    handler = std::move(sai_session_handler);
+    return true;
+}
+
+bool IcmpOrch::complete_create_icmp_session(IcmpSaiSessionHandler& sai_session_handler)
+{
+    auto& key = sai_session_handler.get_key();
+
+    auto create_status = sai_session_handler.complete_create();
     if (create_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
         SWSS_LOG_INFO("ICMP session creation failed key(%s), create_status(%s)", key.c_str(),
@@ -273,7 +400,8 @@ bool IcmpOrch::update_icmp_session(const string& key, const fv_vector_t& data)
     return true;
 }
 
-bool IcmpOrch::remove_icmp_session(const string& key)
+bool IcmpOrch::queue_remove_icmp_session(const string& key, IcmpSessionBulker& bulker,
+        unique_ptr<IcmpSaiSessionHandler>& handler)
 {
     if (m_icmp_session_map.find(key) == m_icmp_session_map.end())
     {
@@ -281,10 +409,10 @@ bool IcmpOrch::remove_icmp_session(const string& key)
         return true;
     }
 
-    IcmpSaiSessionHandler sai_session_handler(*this);
+    auto sai_session_handler = make_unique<IcmpSaiSessionHandler>(*this);
 
     // initialize the sai session handler
-    auto init_status = sai_session_handler.init(sai_icmp_echo_api, key);
+    auto init_status = sai_session_handler->init(sai_icmp_echo_api, key);
     if (init_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
         SWSS_LOG_INFO("ICMP session removal failed key(%s), init_status(%s)", key.c_str(),
@@ -292,8 +420,17 @@ bool IcmpOrch::remove_icmp_session(const string& key)
         return true;
     }
 
-    sai_object_id_t icmp_session_id = m_icmp_session_map[key].session_id;
-    auto remove_status = sai_session_handler.remove(icmp_session_id);
+    sai_session_handler->queue_remove(bulker, m_icmp_session_map[key].session_id);
+
+    handler = std::move(sai_session_handler);
+    return true;
+}
+
+bool IcmpOrch::complete_remove_icmp_session(IcmpSaiSessionHandler& sai_session_handler)
+{
+    auto& key = sai_session_handler.get_key();
+
+    auto remove_status = sai_session_handler.complete_remove();
     if ( remove_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
     {
         // do not consume the entry for retries
@@ -304,6 +441,7 @@ bool IcmpOrch::remove_icmp_session(const string& key)
     }
 
     // delete the session from state db and remove them from local maps
+    sai_object_id_t icmp_session_id = sai_session_handler.get_session_id();
     m_stateIcmpSessionTable.del(m_icmp_session_lookup[icmp_session_id].db_key);
 
     m_icmp_session_map.erase(key);
@@ -10,6 +10,7 @@
 #include "orch.h"
 #include "observer.h"
 #include "saioffloadsession.h"
+#include "redispipeline.h"
 #include <vector>
 #include <tuple>
 
@@ -52,6 +53,9 @@ struct IcmpSessionDataCache
 // forward declaration of icmp sai handler
 struct IcmpSaiSessionHandler;
 
+using IcmpSessionBulker = SaiOffloadSessionBulker<sai_icmp_echo_api_t>;
+using IcmpStateBatch = SaiOffloadSessionStateBatch<sai_icmp_echo_session_state_t>;
+
 /**
  *@class IcmpOrch
  *
@@ -109,9 +113,9 @@ public:
 
 private:
     /**
-     *@method create_icmp_session
+     *@method update_icmp_session
      *
-     *@brief creates icmp echo sessions in hardware
+     *@brief updates icmp echo sessions in hardware
      *
      *@param key(in)  reference to session key
      *@param data(in) vector of session parameters from APP_DB
@@ -120,33 +124,78 @@ private:
      *@return false for retries
      *        true for all other cases where session entry is consumed
      */
-    bool create_icmp_session(const string& key, const vector<FieldValueTuple>& data);
+    bool update_icmp_session(const string& key, const vector<FieldValueTuple>& data);
 
     /**
-     *@method remove_icmp_session
+     *@method queue_create_icmp_session
      *
-     *@brief removes icmp echo sessions from hardware
+     *@brief validates icmp echo session parameters and queues
+     *       the session create on the bulker
      *
-     *@param key(in)  reference to session key
+     *@param key(in)      reference to session key
+     *@param data(in)     vector of session parameters from APP_DB
+     *                    table as field value tuples
+     *@param bulker(in)   bulker the session create is queued on
+     *@param handler(out) sai session handler of the queued session,
+     *                    left empty when nothing was queued
      *
      *@return false for retries
      *        true for all other cases
      */
-    bool remove_icmp_session(const string& key);
+    bool queue_create_icmp_session(const string& key, const vector<FieldValueTuple>& data,
+            IcmpSessionBulker& bulker, std::unique_ptr<IcmpSaiSessionHandler>& handler);
 
     /**
-     *@method update_icmp_session
+     *@method complete_create_icmp_session
      *
-     *@brief updates icmp echo sessions in hardware
+     *@brief updates the session maps and state db once the
+     *       queued session create is flushed
      *
-     *@param key(in)  reference to session key
-     *@param data(in) vector of session parameters from APP_DB
-     *                table as field value tuples
+     *@param handler(in) sai session handler of the queued session
      *
      *@return false for retries
      *        true for all other cases where session entry is consumed
      */
-    bool update_icmp_session(const string& key, const vector<FieldValueTuple>& data);
+    bool complete_create_icmp_session(IcmpSaiSessionHandler& handler);
+
+    /**
+     *@method queue_remove_icmp_session
+     *
+     *@brief queues the icmp echo session remove on the bulker
+     *
+     *@param key(in)      reference to session key
+     *@param bulker(in)   bulker the session remove is queued on
+     *@param handler(out) sai session handler of the queued session,
+     *                    left empty when nothing was queued
+     *
+     *@return false for retries
+     *        true for all other cases
+     */
+    bool queue_remove_icmp_session(const string& key, IcmpSessionBulker& bulker,
+            std::unique_ptr<IcmpSaiSessionHandler>& handler);
+
+    /**
+     *@method complete_remove_icmp_session
+     *
+     *@brief updates the session maps and state db once the
+     *       queued session remove is flushed
+     *
+     *@param handler(in) sai session handler of the queued session
+     *
+     *@return false for retries
+     *        true for all other cases
+     */
+    bool complete_remove_icmp_session(IcmpSaiSessionHandler& handler);
+
+    /**
+     *@method handle_icmp_state_change
+     *
+     *@brief adds the session states in a notification to the batch
+     *
+     *@param data(in)    serialized icmp echo session state notification
+     *@param batch(out)  session states of the notification batch
+     */
+    void handle_icmp_state_change(const std::string& data, IcmpStateBatch& batch);
 
     // map of session key to session data cache
     std::map<std::string, IcmpSessionDataCache> m_icmp_session_map;
@@ -155,6 +204,12 @@ private:
 
     // Icmp session state table produced by IcmpOrch
     swss::Table m_stateIcmpSessionTable;
+    // session state changes of a notification batch are written in one pipeline flush
+    std::unique_ptr<swss::RedisPipeline> m_stateDbPipeline;
+    std::unique_ptr<swss::Table> m_stateIcmpSessionBatchTable;
+    std::unique_ptr<swss::Table> m_stateNotificationStatsTable;
+    // highest notification batch processing time seen
+    uint64_t m_max_notification_process_us = 0;
 
     // ASIC_DB ICMP state notification consumer
     swss::NotificationConsumer* m_icmpStateNotificationConsumer;
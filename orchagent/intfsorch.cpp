@@ -38,6 +38,7 @@ extern NeighOrch *gNeighOrch;
 extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
 extern bool gTraditionalFlexCounter;
+extern bool gNativeCounterRates;
 extern bool isChassisDbInUse();
 
 const int intfsorch_pri = 35;
@@ -59,7 +60,8 @@ static const vector<sai_router_interface_stat_t> rifStatIds =
 };
 
 IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBConnector *chassisAppDb) :
-        Orch(db, tableName, intfsorch_pri), m_vrfOrch(vrf_orch)
+        Orch(db, tableName, intfsorch_pri), m_vrfOrch(vrf_orch),
+        m_ip2meRouteBulker(sai_route_api, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -83,14 +85,18 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     string rifRatePluginName = "rif_rates.lua";
     string rifRateSha;
 
-    try
+    /* Computed by CounterRateOrch instead when native counter rates are enabled */
+    if (!gNativeCounterRates)
     {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
+        try
+        {
+            string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
+            rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
+        }
+        catch (const runtime_error &e)
+        {
+            SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
+        }
     }
 
     setFlexCounterGroupParameter(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP,
@@ -1141,6 +1147,8 @@ void IntfsOrch::doTask(Consumer &consumer)
             }
         }
     }
+
+    flushIp2MeRoutes();
 }
 
 bool IntfsOrch::getSaiLoopbackAction(const string &actionStr, sai_packet_action_t &action)
@@ -1394,28 +1402,8 @@ void IntfsOrch::addIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix)
     attr.value.oid = cpu_port.m_port_id;
     attrs.push_back(attr);
 
-    sai_status_t status = sai_route_api->create_route_entry(&unicast_route_entry, (uint32_t)attrs.size(), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to create IP2me route ip:%s, rv:%d", ip_prefix.getIp().to_string().c_str(), status);
-        if (handleSaiCreateStatus(SAI_API_ROUTE, status) != task_success)
-        {
-            throw runtime_error("Failed to create IP2me route.");
-        }
-    }
-
-    SWSS_LOG_NOTICE("Create IP2me route ip:%s", ip_prefix.getIp().to_string().c_str());
-
-    if (unicast_route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
-
-    gFlowCounterRouteOrch->onAddMiscRouteEntry(vrf_id, IpPrefix(ip_prefix.getIp().to_string()));
+    m_ip2meRouteOps.push_back({ vrf_id, ip_prefix, true, SAI_STATUS_NOT_EXECUTED });
+    m_ip2meRouteBulker.create_entry(&m_ip2meRouteOps.back().status, &unicast_route_entry, (uint32_t)attrs.size(), attrs.data());
 }
 
 void IntfsOrch::removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix)
@@ -1425,28 +1413,66 @@ void IntfsOrch::removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_pref
     unicast_route_entry.vr_id = vrf_id;
     copy(unicast_route_entry.destination, ip_prefix.getIp());
 
-    sai_status_t status = sai_route_api->remove_route_entry(&unicast_route_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_ERROR("Failed to remove IP2me route ip:%s, rv:%d", ip_prefix.getIp().to_string().c_str(), status);
-        if (handleSaiRemoveStatus(SAI_API_ROUTE, status) != task_success)
-        {
-            throw runtime_error("Failed to remove IP2me route.");
-        }
-    }
+    m_ip2meRouteOps.push_back({ vrf_id, ip_prefix, false, SAI_STATUS_NOT_EXECUTED });
+    m_ip2meRouteBulker.remove_entry(&m_ip2meRouteOps.back().status, &unicast_route_entry);
+}
 
-    SWSS_LOG_NOTICE("Remove packet action trap route ip:%s", ip_prefix.getIp().to_string().c_str());
+void IntfsOrch::flushIp2MeRoutes()
+{
+    SWSS_LOG_ENTER();
 
-    if (unicast_route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    if (m_ip2meRouteOps.empty())
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        return;
     }
-    else
+
+    m_ip2meRouteBulker.flush();
+
+    /* Statuses are checked in queueing order, so a route added and removed
+     * within one pass is still accounted for as before */
+    while (!m_ip2meRouteOps.empty())
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
+        auto op = m_ip2meRouteOps.front();
+        m_ip2meRouteOps.pop_front();
+
+        bool v4 = op.ip_prefix.isV4();
+        string ip_str = op.ip_prefix.getIp().to_string();
+
+        if (op.add)
+        {
+            if (op.status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to create IP2me route ip:%s, rv:%d", ip_str.c_str(), op.status);
+                if (handleSaiCreateStatus(SAI_API_ROUTE, op.status) != task_success)
+                {
+                    m_ip2meRouteOps.clear();
+                    throw runtime_error("Failed to create IP2me route.");
+                }
+            }
+
+            SWSS_LOG_NOTICE("Create IP2me route ip:%s", ip_str.c_str());
 
-    gFlowCounterRouteOrch->onRemoveMiscRouteEntry(vrf_id, IpPrefix(ip_prefix.getIp().to_string()));
+            gCrmOrch->incCrmResUsedCounter(v4 ? CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE);
+            gFlowCounterRouteOrch->onAddMiscRouteEntry(op.vrf_id, IpPrefix(ip_str));
+        }
+        else
+        {
+            if (op.status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove IP2me route ip:%s, rv:%d", ip_str.c_str(), op.status);
+                if (handleSaiRemoveStatus(SAI_API_ROUTE, op.status) != task_success)
+                {
+                    m_ip2meRouteOps.clear();
+                    throw runtime_error("Failed to remove IP2me route.");
+                }
+            }
+
+            SWSS_LOG_NOTICE("Remove packet action trap route ip:%s", ip_str.c_str());
+
+            gCrmOrch->decCrmResUsedCounter(v4 ? CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE);
+            gFlowCounterRouteOrch->onRemoveMiscRouteEntry(op.vrf_id, IpPrefix(ip_str));
+        }
+    }
 }
 
 void IntfsOrch::addDirectedBroadcast(const Port &port, const IpPrefix &ip_prefix)
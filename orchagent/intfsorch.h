@@ -5,16 +5,19 @@
 #include "portsorch.h"
 #include "vrforch.h"
 #include "timer.h"
+#include "bulker.h"
 
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "macaddress.h"
 
+#include <deque>
 #include <map>
 #include <set>
 
 extern sai_object_id_t gVirtualRouterId;
 extern MacAddress gMacAddress;
+extern size_t gMaxBulkSize;
 
 #define RIF_STAT_COUNTER_FLEX_COUNTER_GROUP "RIF_STAT_COUNTER"
 #define RIF_RATE_COUNTER_FLEX_COUNTER_GROUP "RIF_RATE_COUNTER"
@@ -30,6 +33,14 @@ struct IntfsEntry
 
 typedef map<string, IntfsEntry> IntfsTable;
 
+struct Ip2MeRouteOp
+{
+    sai_object_id_t     vrf_id;
+    IpPrefix            ip_prefix;
+    bool                add;
+    sai_status_t        status;
+};
+
 class IntfsOrch : public Orch
 {
 public:
@@ -60,8 +71,10 @@ public:
     bool setIntf(const string& alias, sai_object_id_t vrf_id = gVirtualRouterId, const IpPrefix *ip_prefix = nullptr, const bool adminUp = true, const uint32_t mtu = 0, string loopbackAction = "");
     bool removeIntf(const string& alias, sai_object_id_t vrf_id = gVirtualRouterId, const IpPrefix *ip_prefix = nullptr);
 
+    /* IP2me routes are queued and programmed in bulk by flushIp2MeRoutes() */
     void addIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix);
     void removeIp2MeRoute(sai_object_id_t vrf_id, const IpPrefix &ip_prefix);
+    void flushIp2MeRoutes();
 
     const IntfsTable& getSyncdIntfses(void)
     {
@@ -93,6 +106,9 @@ private:
 
     std::set<std::string> m_removingIntfses;
 
+    EntityBulker<sai_route_api_t> m_ip2meRouteBulker;
+    std::deque<Ip2MeRouteOp> m_ip2meRouteOps;
+
     std::string getRifFlexCounterTableKey(std::string s);
 
     bool addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopbackAction);
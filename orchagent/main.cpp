@@ -56,6 +56,7 @@ string gSaiErrorString;
 extern size_t gMaxBulkSize;
 
 #define DEFAULT_BATCH_SIZE  128
+#define DEFAULT_ROUTE_DRAIN_QUOTA 8192
 extern int gBatchSize;
 
 bool gRingMode = false;
@@ -64,6 +65,10 @@ sai_redis_communication_mode_t gRedisCommunicationMode = SAI_REDIS_COMMUNICATION
 string gAsicInstance;
 
 extern bool gIsNatSupported;
+extern uint32_t gAclRangeExpansionLimit;
+extern size_t gRouteDrainQuota;
+extern string gPortCapabilityCacheFile;
+extern bool gNativeCounterRates;
 
 #define SAIREDIS_RECORD_ENABLE 0x1
 #define SWSS_RECORD_ENABLE (0x1 << 1)
@@ -91,7 +96,7 @@ bool isChassisDbInUse()
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R] [-M]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-I heart_beat_interval] [-R] [-M] [-a acl_range_expansion_limit] [-P port_capability_cache_file] [-C counter_rate_mode] [-Q route_drain_quota]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -117,6 +122,10 @@ void usage()
     cout << "    -R enable the ring thread feature" << endl;
     cout << "    -M enable SAI MACSec POST" << endl;
     cout << "    -D Delay in seconds before flex counter processing begins after orchagent startup (default 0)" << endl;
+    cout << "    -a max ACL entries a rule may be expanded into instead of using L4 port range checkers (default 0, disabled)" << endl;
+    cout << "    -P port_capability_cache_file: Persist discovered port capabilities across restarts (default empty, disabled)" << endl;
+    cout << "    -C counter_rate_mode: Compute port/RIF rates and queue/PG watermarks with the flex counter Lua plugins or natively in orchagent (lua|native), default: lua" << endl;
+    cout << "    -Q route_drain_quota: Max routes RouteOrch processes per pass before other tables are serviced (default 8192, 0 disables)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -387,6 +396,7 @@ int main(int argc, char **argv)
     sai_status_t status;
 
     gBatchSize = DEFAULT_BATCH_SIZE;
+    gRouteDrainQuota = DEFAULT_ROUTE_DRAIN_QUOTA;
     string record_location = Recorder::DEFAULT_DIR;
     string swss_rec_filename = Recorder::SWSS_FNAME;
     string sairedis_rec_filename = Recorder::SAIREDIS_FNAME;
@@ -400,7 +410,7 @@ int main(int argc, char **argv)
     // Disable SAI MACSec POST by default. Use option -M to enable it.
     bool macsec_post_enabled = false;
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:I:R:D:M")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:I:R:D:Ma:P:C:Q:")) != -1)
     {
         switch (opt)
         {
@@ -522,6 +532,30 @@ int main(int argc, char **argv)
             macsec_post_enabled = true;
             break;
         case 'D': { gFlexCounterDelaySec = swss::to_int<int>(optarg); } break;
+        case 'a':
+            gAclRangeExpansionLimit = swss::to_uint<uint32_t>(optarg);
+            SWSS_LOG_NOTICE("Setting ACL range expansion limit as %u", gAclRangeExpansionLimit);
+            break;
+        case 'P':
+            gPortCapabilityCacheFile = optarg;
+            SWSS_LOG_NOTICE("Using port capability cache %s", gPortCapabilityCacheFile.c_str());
+            break;
+        case 'C':
+            if (optarg == string("native"))
+            {
+                gNativeCounterRates = true;
+            }
+            else if (optarg != string("lua"))
+            {
+                SWSS_LOG_ERROR("Invalid counter rate mode %s", optarg);
+                exit(EXIT_FAILURE);
+            }
+            SWSS_LOG_NOTICE("Computing counter rates with %s", optarg);
+            break;
+        case 'Q':
+            gRouteDrainQuota = swss::to_uint<uint32_t>(optarg);
+            SWSS_LOG_NOTICE("Setting route drain quota as %zu", gRouteDrainQuota);
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
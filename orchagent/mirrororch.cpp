@@ -54,6 +54,36 @@ extern string           gMySwitchType;
 
 using namespace std::rel_ops;
 
+// Copied, the sessions are indexed again while they are updated
+template <typename K>
+static set<string> getIndexedSessions(const map<K, set<string>>& index, const K& key)
+{
+    auto it = index.find(key);
+    return it == index.end() ? set<string>() : it->second;
+}
+
+template <typename K>
+static void addIndexedSession(map<K, set<string>>& index, const K& key, const string& name)
+{
+    index[key].insert(name);
+}
+
+template <typename K>
+static void removeIndexedSession(map<K, set<string>>& index, const K& key, const string& name)
+{
+    auto it = index.find(key);
+    if (it == index.end())
+    {
+        return;
+    }
+
+    it->second.erase(name);
+    if (it->second.empty())
+    {
+        index.erase(it);
+    }
+}
+
 MirrorEntry::MirrorEntry(const string& platform) :
         status(false),
         dscp(8),
@@ -201,6 +231,82 @@ void MirrorOrch::update(SubjectType type, void *cntx)
     }
 }
 
+bool MirrorOrch::isBatchObserver(SubjectType type) const
+{
+    return type == SUBJECT_TYPE_NEIGH_CHANGE || type == SUBJECT_TYPE_FDB_CHANGE;
+}
+
+void MirrorOrch::updateBatch(SubjectType type, const vector<void *> &cntxs)
+{
+    SWSS_LOG_ENTER();
+
+    switch(type) {
+    case SUBJECT_TYPE_NEIGH_CHANGE:
+    {
+        // Every session is updated once, however many of its neighbors changed
+        set<IpAddress> ips;
+        for (auto cntx : cntxs)
+        {
+            ips.insert(static_cast<NeighborUpdate *>(cntx)->entry.ip_address);
+        }
+
+        set<string> names;
+        for (const auto& ip : ips)
+        {
+            auto dst = getIndexedSessions(m_dstIpSessions, ip);
+            auto nexthop = getIndexedSessions(m_nexthopIpSessions, ip);
+            names.insert(dst.begin(), dst.end());
+            names.insert(nexthop.begin(), nexthop.end());
+        }
+
+        for (const auto& name : names)
+        {
+            auto it = m_syncdMirrors.find(name);
+            if (it == m_syncdMirrors.end())
+            {
+                continue;
+            }
+
+            auto& session = it->second;
+
+            SWSS_LOG_NOTICE("Updating mirror session %s with %zu neighbor updates",
+                    name.c_str(), cntxs.size());
+
+            updateSession(name, session);
+        }
+        break;
+    }
+    case SUBJECT_TYPE_FDB_CHANGE:
+    {
+        // Only the last change of every MAC is applied, a MAC moving back and forth is applied once
+        map<pair<sai_object_id_t, MacAddress>, const FdbBatchUpdate *> updates;
+        for (auto cntx : cntxs)
+        {
+            const FdbBatchUpdate *update = static_cast<FdbBatchUpdate *>(cntx);
+            updates[{ update->entry.bv_id, update->entry.mac }] = update;
+        }
+
+        for (const auto& update : updates)
+        {
+            for (const auto& name : getIndexedSessions(m_fdbSessions, update.first))
+            {
+                auto it = m_syncdMirrors.find(name);
+                if (it == m_syncdMirrors.end())
+                {
+                    continue;
+                }
+
+                updateSessionFdb(name, it->second, *update.second);
+            }
+        }
+        break;
+    }
+    default:
+        Observer::updateBatch(type, cntxs);
+        break;
+    }
+}
+
 bool MirrorOrch::sessionExists(const string& name)
 {
     SWSS_LOG_ENTER();
@@ -504,6 +610,7 @@ task_process_status MirrorOrch::createEntry(const string& key, const vector<Fiel
     }
 
     m_syncdMirrors.emplace(key, entry);
+    indexSession(key, entry);
     setSessionState(key, entry);
 
     if (entry.type == MIRROR_SESSION_SPAN && !entry.dst_port.empty())
@@ -564,6 +671,7 @@ task_process_status MirrorOrch::deleteEntry(const string& name)
 
     removeSessionState(name);
 
+    unindexSession(name);
     m_syncdMirrors.erase(sessionIter);
 
     SWSS_LOG_NOTICE("Removed mirror session %s", name.c_str());
@@ -805,9 +913,86 @@ bool MirrorOrch::updateSession(const string& name, MirrorEntry& session)
         }
     }
 
+    // The next hop and neighbor may have changed
+    indexSession(name, session);
+
     return ret;
 }
 
+void MirrorOrch::indexSession(const string& name, const MirrorEntry& session)
+{
+    SWSS_LOG_ENTER();
+
+    unindexSession(name);
+
+    MirrorSessionKeys keys;
+    keys.dstIp = session.dstIp;
+    keys.nexthopIp = session.nexthopInfo.nexthop.ip_address;
+
+    const auto& port = session.neighborInfo.port;
+    if (port.m_type == Port::LAG || port.m_type == Port::VLAN)
+    {
+        keys.neighborPort = port.m_alias;
+    }
+    if (port.m_type == Port::VLAN)
+    {
+        keys.hasFdb = true;
+        keys.fdb = { port.m_vlan_info.vlan_oid, session.neighborInfo.mac };
+    }
+
+    if (!session.src_port.empty())
+    {
+        keys.srcPorts = tokenize(session.src_port, ',');
+    }
+
+    addIndexedSession(m_dstIpSessions, keys.dstIp, name);
+    if (!keys.nexthopIp.isZero())
+    {
+        addIndexedSession(m_nexthopIpSessions, keys.nexthopIp, name);
+    }
+    if (!keys.neighborPort.empty())
+    {
+        addIndexedSession(m_neighborPortSessions, keys.neighborPort, name);
+    }
+    if (keys.hasFdb)
+    {
+        addIndexedSession(m_fdbSessions, keys.fdb, name);
+    }
+    for (const auto& alias : keys.srcPorts)
+    {
+        addIndexedSession(m_srcPortSessions, alias, name);
+    }
+
+    m_sessionKeys[name] = keys;
+}
+
+void MirrorOrch::unindexSession(const string& name)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_sessionKeys.find(name);
+    if (it == m_sessionKeys.end())
+    {
+        return;
+    }
+
+    const auto& keys = it->second;
+
+    removeIndexedSession(m_dstIpSessions, keys.dstIp, name);
+    removeIndexedSession(m_nexthopIpSessions, keys.nexthopIp, name);
+    removeIndexedSession(m_neighborPortSessions, keys.neighborPort, name);
+    if (keys.hasFdb)
+    {
+        removeIndexedSession(m_fdbSessions, keys.fdb, name);
+    }
+    for (const auto& alias : keys.srcPorts)
+    {
+        removeIndexedSession(m_srcPortSessions, alias, name);
+    }
+
+    m_sessionKeys.erase(it);
+}
+
 bool MirrorOrch::setUnsetPortMirror(Port port,
                                     bool ingress,
                                     bool set,
@@ -1294,9 +1479,14 @@ void MirrorOrch::updateNextHop(const NextHopUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    for (const auto& name : getIndexedSessions(m_dstIpSessions, update.destination))
     {
-        const auto& name = it->first;
+        auto it = m_syncdMirrors.find(name);
+        if (it == m_syncdMirrors.end())
+        {
+            continue;
+        }
+
         auto& session = it->second;
 
         // Check if mirror session's destination IP is the update's destination IP
@@ -1377,9 +1567,18 @@ void MirrorOrch::updateNeighbor(const NeighborUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    auto names = getIndexedSessions(m_dstIpSessions, update.entry.ip_address);
+    auto nexthop_names = getIndexedSessions(m_nexthopIpSessions, update.entry.ip_address);
+    names.insert(nexthop_names.begin(), nexthop_names.end());
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
+        auto it = m_syncdMirrors.find(name);
+        if (it == m_syncdMirrors.end())
+        {
+            continue;
+        }
+
         auto& session = it->second;
 
         // Check if the session's destination IP matches the neighbor's update IP
@@ -1405,9 +1604,14 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    for (const auto& name : getIndexedSessions(m_fdbSessions, make_pair(update.entry.bv_id, update.entry.mac)))
     {
-        const auto& name = it->first;
+        auto it = m_syncdMirrors.find(name);
+        if (it == m_syncdMirrors.end())
+        {
+            continue;
+        }
+
         auto& session = it->second;
 
         // Check the following three conditions:
@@ -1421,34 +1625,45 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
             continue;
         }
 
-        SWSS_LOG_NOTICE("Updating mirror session %s with monitor port %s",
-                name.c_str(), update.port.m_alias.c_str());
+        updateSessionFdb(name, session, FdbBatchUpdate(update));
+    }
+}
 
-        // Get the new monitor port
-        if (update.add)
+void MirrorOrch::updateSessionFdb(const string& name, MirrorEntry& session, const FdbBatchUpdate& update)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("Updating mirror session %s with monitor port %s",
+            name.c_str(), update.port_alias.c_str());
+
+    // Get the new monitor port
+    if (update.add)
+    {
+        if (session.status)
         {
-            if (session.status)
-            {
-                // Update port if changed
-                if (session.neighborInfo.portId != update.port.m_port_id)
-                {
-                    session.neighborInfo.portId = update.port.m_port_id;
-                    updateSessionDstPort(name, session);
-                }
-            }
-            else
+            // Update port if changed
+            if (session.neighborInfo.portId != update.port_id)
             {
-                // Activate session
-                session.neighborInfo.portId = update.port.m_port_id;
-                activateSession(name, session);
+                session.neighborInfo.portId = update.port_id;
+                updateSessionDstPort(name, session);
             }
         }
-        // Remove the monitor port
         else
+        {
+            // Activate session
+            session.neighborInfo.portId = update.port_id;
+            activateSession(name, session);
+        }
+    }
+    // Remove the monitor port
+    else
+    {
+        // A batch may remove a MAC that was learned and never activated the session
+        if (session.status)
         {
             deactivateSession(name, session);
-            session.neighborInfo.portId = SAI_NULL_OBJECT_ID;
         }
+        session.neighborInfo.portId = SAI_NULL_OBJECT_ID;
     }
 }
 
@@ -1456,9 +1671,19 @@ void MirrorOrch::updateLagMember(const LagMemberUpdate& update)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    // Sessions mirroring the LAG and sessions whose neighbor is on the LAG
+    auto names = getIndexedSessions(m_srcPortSessions, update.lag.m_alias);
+    auto neighbor_names = getIndexedSessions(m_neighborPortSessions, update.lag.m_alias);
+    names.insert(neighbor_names.begin(), neighbor_names.end());
+
+    for (const auto& name : names)
     {
-        const auto& name = it->first;
+        auto it = m_syncdMirrors.find(name);
+        if (it == m_syncdMirrors.end())
+        {
+            continue;
+        }
+
         auto& session = it->second;
 
         // Check the following conditions:
@@ -1542,9 +1767,14 @@ void MirrorOrch::updateVlanMember(const VlanMemberUpdate& update)
         return;
     }
 
-    for (auto it = m_syncdMirrors.begin(); it != m_syncdMirrors.end(); it++)
+    for (const auto& name : getIndexedSessions(m_neighborPortSessions, update.vlan.m_alias))
     {
-        const auto& name = it->first;
+        auto it = m_syncdMirrors.find(name);
+        if (it == m_syncdMirrors.end())
+        {
+            continue;
+        }
+
         auto& session = it->second;
 
         // Check the following three conditions:
@@ -16,6 +16,7 @@
 #include "table.h"
 
 #include <map>
+#include <set>
 #include <inttypes.h>
 
 #define MIRROR_RX_DIRECTION      "RX"
@@ -73,6 +74,24 @@ struct MirrorSessionUpdate
 /* MirrorTable: mirror session name, mirror session data */
 typedef map<string, MirrorEntry> MirrorTable;
 
+/* Keys a mirror session is indexed under, as of its last update */
+struct MirrorSessionKeys
+{
+    IpAddress dstIp;
+    IpAddress nexthopIp;
+    // LAG or VLAN the session's neighbor is on
+    string neighborPort;
+    // VLAN and MAC of the neighbor when it is on a VLAN
+    bool hasFdb = false;
+    pair<sai_object_id_t, MacAddress> fdb;
+    vector<string> srcPorts;
+};
+
+/* Session names by the key they depend on */
+typedef map<IpAddress, set<string>> MirrorIpIndex;
+typedef map<string, set<string>> MirrorPortIndex;
+typedef map<pair<sai_object_id_t, MacAddress>, set<string>> MirrorFdbIndex;
+
 class MirrorOrch : public Orch, public Observer, public Subject
 {
 public:
@@ -81,6 +100,8 @@ public:
 
     bool bake() override;
     void update(SubjectType, void *);
+    bool isBatchObserver(SubjectType) const;
+    void updateBatch(SubjectType, const vector<void *> &);
     bool sessionExists(const string&);
     bool getSessionStatus(const string&, bool&);
     bool getSessionOid(const string&, sai_object_id_t&);
@@ -102,6 +123,17 @@ private:
     Table m_mirrorTable;
 
     MirrorTable m_syncdMirrors;
+
+    /*
+     * Secondary indexes of m_syncdMirrors, so that a neighbor, FDB, next hop
+     * or LAG update only visits the sessions depending on it
+     */
+    MirrorIpIndex m_dstIpSessions;
+    MirrorIpIndex m_nexthopIpSessions;
+    MirrorPortIndex m_neighborPortSessions;
+    MirrorPortIndex m_srcPortSessions;
+    MirrorFdbIndex m_fdbSessions;
+    map<string, MirrorSessionKeys> m_sessionKeys;
     // session_name -> VLAN | monitor_port_alias | next_hop_ip
     map<string, string> m_recoverySessionMap;
 
@@ -126,9 +158,13 @@ private:
 
     bool getNeighborInfo(const string&, MirrorEntry&);
 
+    void indexSession(const string&, const MirrorEntry&);
+    void unindexSession(const string&);
+
     void updateNextHop(const NextHopUpdate&);
     void updateNeighbor(const NeighborUpdate&);
     void updateFdb(const FdbUpdate&);
+    void updateSessionFdb(const string&, MirrorEntry&, const FdbBatchUpdate&);
     void updateLagMember(const LagMemberUpdate&);
     void updateVlanMember(const VlanMemberUpdate&);
 
@@ -1456,18 +1456,31 @@ void MuxOrch::updateFdb(const FdbUpdate& update)
         return;
     }
 
+    updateFdb(map<MacAddress, string>{ { update.entry.mac, update.entry.port_name } });
+}
+
+/* Moves the mux neighbors of all given MACs to their learned ports in one pass */
+void MuxOrch::updateFdb(const map<MacAddress, string>& ports)
+{
     NeighborEntry neigh;
     MacAddress mac;
     MuxCable* ptr;
     for (auto nh = mux_nexthop_tb_.begin(); nh != mux_nexthop_tb_.end(); ++nh)
     {
         auto res = neigh_orch_->getNeighborEntry(nh->first, neigh, mac);
-        if (!res || update.entry.mac != mac)
+        if (!res)
         {
             continue;
         }
 
-        if (nh->second != update.entry.port_name)
+        auto port = ports.find(mac);
+        if (port == ports.end())
+        {
+            continue;
+        }
+
+        const string& port_name = port->second;
+        if (nh->second != port_name)
         {
             if (!nh->second.empty() && isMuxExists(nh->second))
             {
@@ -1476,13 +1489,13 @@ void MuxOrch::updateFdb(const FdbUpdate& update)
                 {
                     continue;
                 }
-                nh->second = update.entry.port_name;
+                nh->second = port_name;
                 ptr->updateNeighbor(nh->first, false);
             }
 
-            if (isMuxExists(update.entry.port_name))
+            if (isMuxExists(port_name))
             {
-                ptr = getMuxCable(update.entry.port_name);
+                ptr = getMuxCable(port_name);
                 ptr->updateNeighbor(nh->first, true);
             }
         }
@@ -1704,6 +1717,47 @@ void MuxOrch::update(SubjectType type, void *cntx)
     }
 }
 
+bool MuxOrch::isBatchObserver(SubjectType type) const
+{
+    return type == SUBJECT_TYPE_FDB_CHANGE;
+}
+
+void MuxOrch::updateBatch(SubjectType type, const vector<void *> &cntxs)
+{
+    SWSS_LOG_ENTER();
+
+    if (type != SUBJECT_TYPE_FDB_CHANGE)
+    {
+        Observer::updateBatch(type, cntxs);
+        return;
+    }
+
+    /* Only the last port a MAC was learned on matters, aging and flushes are skipped as in updateFdb() */
+    map<MacAddress, string> ports;
+    for (auto cntx : cntxs)
+    {
+        FdbBatchUpdate *update = static_cast<FdbBatchUpdate *>(cntx);
+        if (update->add)
+        {
+            ports[update->entry.mac] = update->entry.port_name;
+        }
+    }
+
+    if (ports.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        updateFdb(ports);
+    }
+    catch (const std::exception& e)
+    {
+        SWSS_LOG_ERROR("Exception caught while updating FDB. Error: %s", e.what());
+    }
+}
+
 MuxOrch::MuxOrch(DBConnector *db, const std::vector<std::string> &tables,
          TunnelDecapOrch* decapOrch, NeighOrch* neighOrch, FdbOrch* fdbOrch) :
          Orch2(db, tables, request_),
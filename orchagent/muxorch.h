@@ -225,6 +225,8 @@ public:
     MuxCable* findMuxCableInSubnet(IpAddress);
     bool isNeighborActive(const IpAddress&, const MacAddress&, string&);
     void update(SubjectType, void *);
+    bool isBatchObserver(SubjectType) const;
+    void updateBatch(SubjectType, const vector<void *> &);
 
     void addNexthop(NextHopKey, string = "");
     void removeNexthop(NextHopKey);
@@ -261,6 +263,7 @@ private:
 
     void updateNeighbor(const NeighborUpdate&);
     void updateFdb(const FdbUpdate&);
+    void updateFdb(const map<MacAddress, string>&);
 
     /***
      * Methods for managing tunnel routes for neighbor IPs not associated
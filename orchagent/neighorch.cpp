@@ -855,6 +855,9 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    /* Batch observers get the neighbor changes of this pass in one call */
+    beginNotifyBatch();
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -1006,6 +1009,8 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    endNotifyBatch();
 }
 
 /* Gets all neighbor entries tied to a given mux port */
@@ -1230,7 +1235,7 @@ bool NeighOrch::addNeighbor(NeighborContext& ctx)
     m_syncdNeighbors[neighborEntry] = { macAddress, hw_config };
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
-    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    notifyBatched(SUBJECT_TYPE_NEIGH_CHANGE, update);
 
     if(isChassisDbInUse())
     {
@@ -1379,7 +1384,7 @@ bool NeighOrch::removeNeighbor(NeighborContext& ctx, bool disable)
     m_syncdNeighbors.erase(neighborEntry);
 
     NeighborUpdate update = { neighborEntry, MacAddress(), false };
-    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    notifyBatched(SUBJECT_TYPE_NEIGH_CHANGE, update);
 
     if(isChassisDbInUse())
     {
@@ -1493,7 +1498,7 @@ bool NeighOrch::processBulkEnableNeighbor(NeighborContext& ctx)
     m_syncdNeighbors[neighborEntry] = { macAddress, true };
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
-    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    notifyBatched(SUBJECT_TYPE_NEIGH_CHANGE, update);
 
     return true;
 }
@@ -71,6 +71,15 @@ public:
         }
     }
 
+    /* Next hops decoded from the packed ROUTE_TABLE field */
+    NextHopGroupKey(const std::vector<NextHopKey> &nexthops, bool overlay_nh)
+    {
+        m_overlay_nexthops = overlay_nh;
+        m_srv6_nexthops = false;
+        m_srv6_vpn = false;
+        m_nexthops.insert(nexthops.begin(), nexthops.end());
+    }
+
     inline const std::set<NextHopKey> &getNextHops() const
     {
         return m_nexthops;
@@ -321,6 +321,26 @@ protected:
                                                       gMaxBulkSize);
         map<MbrKey, sai_status_t> statuses;
 
+        queueRemoveMembers(bulker, member_keys, statuses);
+
+        /*
+         * Flush the bulker to remove the members.
+         */
+        bulker.flush();
+
+        return completeRemoveMembers(statuses);
+    }
+
+    /*
+     * Add the removal of the given synced members to a bulker, so it can be
+     * flushed together with other member changes of the group.
+     */
+    void queueRemoveMembers(ObjectBulker<sai_next_hop_group_api_t> &bulker,
+                            const set<MbrKey> &member_keys,
+                            map<MbrKey, sai_status_t> &statuses)
+    {
+        SWSS_LOG_ENTER();
+
         for (const auto &key : member_keys)
         {
             const auto &nhgm = m_members.at(key);
@@ -330,11 +350,15 @@ protected:
                 bulker.remove_entry(&statuses[key], nhgm.getId());
             }
         }
+    }
 
-        /*
-         * Flush the bulker to remove the members.
-         */
-        bulker.flush();
+    /*
+     * Remove the members whose removal went through after the bulker was
+     * flushed.
+     */
+    bool completeRemoveMembers(const map<MbrKey, sai_status_t> &statuses)
+    {
+        SWSS_LOG_ENTER();
 
         /*
          * Iterate over the returned statuses and check if the removal was
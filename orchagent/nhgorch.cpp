@@ -589,35 +589,6 @@ sai_object_id_t NextHopGroupMember::getNhId() const
     return nh_id;
 }
 
-/*
- * Purpose:     Update the weight of a member.
- * Description: Set the new member's weight and if the member is synced, update
- *              the SAI attribute as well.
- * Params:      IN  weight - The weight of the next hop group member.
- * Returns:     true, if the operation was successful;
- *              false, otherwise.
- */
-bool NextHopGroupMember::updateWeight(uint32_t weight)
-{
-    SWSS_LOG_ENTER();
-
-    bool success = true;
-
-    m_key.weight = weight;
-
-    if (isSynced())
-    {
-        sai_attribute_t nhgm_attr;
-        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
-        nhgm_attr.value.s32 = m_key.weight;
-
-        sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(m_gm_id, &nhgm_attr);
-        success = status == SAI_STATUS_SUCCESS;
-    }
-
-    return success;
-}
-
 /*
  * Purpose:     Sync the group member with the given group member ID.
  * Description: Set the group member's SAI ID to the the one given and
@@ -911,16 +882,35 @@ bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
     assert(isRecursive() || (m_members.size() > 1));
 
     ObjectBulker<sai_next_hop_group_api_t> nextHopGroupMemberBulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize);
-
-    /*
-     * Iterate over the given next hops.
-     * If the group member is already synced, skip it.
-     * If any next hop is not synced, thus neighOrch doesn't have it, stop
-     * immediately.
-     * If a next hop's interface is down, skip it from being synced.
-     */
     std::map<NextHopKey, sai_object_id_t> syncingMembers;
 
+    bool success = queueSyncMembers(nextHopGroupMemberBulker, nh_keys, syncingMembers);
+
+    /* Flush the bulker to perform the sync. */
+    nextHopGroupMemberBulker.flush();
+
+    return completeSyncMembers(syncingMembers) && success;
+}
+
+/*
+ * Purpose:     Add the creation of the given members to a bulker.
+ * Description: Iterate over the given next hops.  If the group member is
+ *              already synced, skip it.  If any next hop is not synced, thus
+ *              neighOrch doesn't have it, the member is not added and the
+ *              operation fails.  If a next hop's interface is down, skip it
+ *              from being synced.
+ * Params:      IN  bulker          - The bulker to add the members to.
+ *              IN  nh_keys         - The next hop keys of the members to sync.
+ *              OUT syncing_members - The members added to the bulker.
+ * Returns:     true, if all the members could be added;
+ *              false, otherwise.
+ */
+bool NextHopGroup::queueSyncMembers(ObjectBulker<sai_next_hop_group_api_t>& bulker,
+                                    const std::set<NextHopKey>& nh_keys,
+                                    std::map<NextHopKey, sai_object_id_t>& syncing_members)
+{
+    SWSS_LOG_ENTER();
+
     bool success = true;
     for (const auto& nh_key : nh_keys)
     {
@@ -955,19 +945,28 @@ bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
         vector<sai_attribute_t> nhgm_attrs = createNhgmAttrs(nhgm);
 
         /* Add a bulker entry for this member. */
-        nextHopGroupMemberBulker.create_entry(&syncingMembers[nh_key],
-                                               (uint32_t)nhgm_attrs.size(),
-                                               nhgm_attrs.data());
+        bulker.create_entry(&syncing_members[nh_key],
+                            (uint32_t)nhgm_attrs.size(),
+                            nhgm_attrs.data());
     }
 
-    /* Flush the bulker to perform the sync. */
-    nextHopGroupMemberBulker.flush();
+    return success;
+}
 
-    /*
-     * Go through the synced members and increment the Crm ref count for the
-     * successful ones.
-     */
-    for (const auto& mbr : syncingMembers)
+/*
+ * Purpose:     Sync the members created by a flushed bulker.
+ * Description: Go through the created members and sync the successful ones,
+ *              incrementing their ref counts.
+ * Params:      IN  syncing_members - The members added to the bulker.
+ * Returns:     true, if all the members were created;
+ *              false, otherwise.
+ */
+bool NextHopGroup::completeSyncMembers(const std::map<NextHopKey, sai_object_id_t>& syncing_members)
+{
+    SWSS_LOG_ENTER();
+
+    bool success = true;
+    for (const auto& mbr : syncing_members)
     {
         /* Check that the returned member ID is valid. */
         if (mbr.second == SAI_NULL_OBJECT_ID)
@@ -987,11 +986,12 @@ bool NextHopGroup::syncMembers(const std::set<NextHopKey>& nh_keys)
 
 /*
  * Purpose:     Update the next hop group based on a new next hop group key.
- * Description: Update the group's members by removing the members that aren't
- *              in the new next hop group and adding the new members.  We first
- *              remove the missing members to avoid cases where we reached the
- *              ASIC group members limit.  This will not update the group's SAI
- *              ID in any way, unless we are promoting a temporary group.
+ * Description: Diff the group's members against the new key and submit only
+ *              the members to remove, the members to add and the weight
+ *              changes, all through one bulker flush.  The bulker removes
+ *              before it creates, so we don't hit the ASIC group members
+ *              limit.  This will not update the group's SAI ID in any way,
+ *              unless we are promoting a temporary group.
  * Params:      IN  nhg_key - The new next hop group key to update to.
  * Returns:     true, if the operation was successful;
  *              false, otherwise.
@@ -1022,8 +1022,9 @@ bool NextHopGroup::update(const NextHopGroupKey& nhg_key)
 
     std::set<NextHopKey> new_nh_keys = nhg_key.getNextHops();
     std::set<NextHopKey> removed_nh_keys;
+    std::map<NextHopKey, uint32_t> updated_weights;
 
-    /* Mark the members that need to be removed. */
+    /* Mark the members that need to be removed or have their weight updated. */
     for (auto& mbr_it : m_members)
     {
         const NextHopKey& nh_key = mbr_it.first;
@@ -1036,13 +1037,19 @@ bool NextHopGroup::update(const NextHopGroupKey& nhg_key)
         {
             removed_nh_keys.insert(nh_key);
         }
-        /* If the member is updated, update it's weight. */
         else
         {
-            if (new_nh_key_it->weight && mbr_it.second.getWeight() != new_nh_key_it->weight && !mbr_it.second.updateWeight(new_nh_key_it->weight))
+            if (new_nh_key_it->weight && mbr_it.second.getWeight() != new_nh_key_it->weight)
             {
-                SWSS_LOG_WARN("Failed to update member %s weight", nh_key.to_string().c_str());
-                return false;
+                /* A member that isn't synced picks the weight up when it's created. */
+                if (mbr_it.second.isSynced())
+                {
+                    updated_weights[nh_key] = new_nh_key_it->weight;
+                }
+                else
+                {
+                    mbr_it.second.setWeight(new_nh_key_it->weight);
+                }
             }
 
             /*
@@ -1053,37 +1060,72 @@ bool NextHopGroup::update(const NextHopGroupKey& nhg_key)
         }
     }
 
-    /* Remove the removed members. */
-    if (!removeMembers(removed_nh_keys))
+    /* Add any new members to the group. */
+    for (const auto& it : new_nh_keys)
     {
-        SWSS_LOG_WARN("Failed to remove members from group %s", to_string().c_str());
-        return false;
+        m_members.emplace(it, NextHopGroupMember(it));
     }
 
-    /* Remove the removed members. */
-    for (const auto& nh_key : removed_nh_keys)
-    {
-        m_members.erase(nh_key);
-    }
+    ObjectBulker<sai_next_hop_group_api_t> bulker(sai_next_hop_group_api, gSwitchId, gMaxBulkSize);
+    std::map<NextHopKey, sai_status_t> remove_statuses;
+    std::map<NextHopKey, sai_status_t> weight_statuses;
+    std::map<NextHopKey, sai_object_id_t> syncing_members;
 
-    /* Add any new members to the group. */
-    for (const auto& it : new_nh_keys)
+    queueRemoveMembers(bulker, removed_nh_keys, remove_statuses);
+
+    for (const auto& it : updated_weights)
     {
-        m_members.emplace(it, NextHopGroupMember(it));
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+        nhgm_attr.value.s32 = it.second;
+
+        bulker.set_entry_attribute(&weight_statuses[it.first], m_members.at(it.first).getId(), &nhgm_attr);
     }
 
     /*
-     * Sync all the members of the group.  We sync all of them because
+     * Sync all the members of the group.  Synced members are skipped, but
      * there may be previous members that were not successfully synced
      * before the update, so we must make sure we sync those as well.
      */
-    if (!syncMembers(m_key.getNextHops()))
+    bool success = queueSyncMembers(bulker, m_key.getNextHops(), syncing_members);
+
+    bulker.flush();
+
+    if (!completeRemoveMembers(remove_statuses))
+    {
+        SWSS_LOG_WARN("Failed to remove members from group %s", to_string().c_str());
+        success = false;
+    }
+
+    /* Members that failed to be removed stay in the group to be retried. */
+    for (const auto& nh_key : removed_nh_keys)
+    {
+        if (!m_members.at(nh_key).isSynced())
+        {
+            m_members.erase(nh_key);
+        }
+    }
+
+    for (const auto& it : weight_statuses)
+    {
+        if (it.second == SAI_STATUS_SUCCESS)
+        {
+            m_members.at(it.first).setWeight(updated_weights.at(it.first));
+        }
+        else
+        {
+            SWSS_LOG_WARN("Failed to update member %s weight", it.first.to_string().c_str());
+            success = false;
+        }
+    }
+
+    if (!completeSyncMembers(syncing_members))
     {
         SWSS_LOG_WARN("Failed to sync new members for group %s", to_string().c_str());
-        return false;
+        success = false;
     }
 
-    return true;
+    return success;
 }
 
 /*
@@ -23,8 +23,8 @@ public:
     /* Destructor. */
     ~NextHopGroupMember();
 
-    /* Update member's weight and update the SAI attribute as well. */
-    bool updateWeight(uint32_t weight);
+    /* Set the member's weight, the SAI attribute is updated by the group. */
+    inline void setWeight(uint32_t weight) { m_key.weight = weight; }
 
     /* Sync / Remove. */
     void sync(sai_object_id_t gm_id) override;
@@ -105,6 +105,15 @@ private:
     /* Add group's members over the SAI API for the given keys. */
     bool syncMembers(const set<NextHopKey>& nh_keys) override;
 
+    /*
+     * Split phases of syncMembers(), so the member creation can share a
+     * bulker flush with other member changes of the group.
+     */
+    bool queueSyncMembers(ObjectBulker<sai_next_hop_group_api_t>& bulker,
+                          const set<NextHopKey>& nh_keys,
+                          map<NextHopKey, sai_object_id_t>& syncing_members);
+    bool completeSyncMembers(const map<NextHopKey, sai_object_id_t>& syncing_members);
+
     /* Create the attributes vector for a next hop group member. */
     vector<sai_attribute_t> createNhgmAttrs(
                                 const NextHopGroupMember& nhgm) const override;
@@ -2,6 +2,12 @@
 #define SWSS_OBSERVER_H
 
 #include <list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "logger.h"
 
 using namespace std;
 using namespace swss;
@@ -31,6 +37,26 @@ class Observer
 {
 public:
     virtual void update(SubjectType, void *) = 0;
+
+    /*
+     * Observers that return true here get the changes a Subject notifies
+     * within one batch in a single updateBatch() call instead of one
+     * update() per change, and must override updateBatch() for that type.
+     */
+    virtual bool isBatchObserver(SubjectType) const
+    {
+        return false;
+    }
+
+    /*
+     * Batched changes may be of another type than the ones given to
+     * update(), so they are never forwarded there.
+     */
+    virtual void updateBatch(SubjectType type, const vector<void *> &cntxs)
+    {
+        SWSS_LOG_ERROR("Observer does not handle %zu batched changes of type %d", cntxs.size(), type);
+    }
+
     virtual ~Observer() {}
 };
 
@@ -59,6 +85,81 @@ protected:
             iter->update(type, cntx);
         }
     }
+
+    /*
+     * Between beginNotifyBatch() and endNotifyBatch(), changes notified with
+     * notifyBatched() are still delivered to other observers right away,
+     * but batch observers get them all at endNotifyBatch(), consecutive
+     * changes of the same type in one call.
+     */
+    void beginNotifyBatch()
+    {
+        m_notifyBatching = true;
+    }
+
+    void endNotifyBatch()
+    {
+        m_notifyBatching = false;
+
+        auto batch = std::move(m_notifyBatch);
+        m_notifyBatch.clear();
+
+        size_t first = 0;
+        while (first < batch.size())
+        {
+            SubjectType type = batch[first].first;
+            vector<void *> cntxs;
+
+            size_t last = first;
+            while (last < batch.size() && batch[last].first == type)
+            {
+                cntxs.push_back(batch[last].second.get());
+                last++;
+            }
+
+            for (auto iter: m_observers)
+            {
+                if (iter->isBatchObserver(type))
+                {
+                    iter->updateBatch(type, cntxs);
+                }
+            }
+
+            first = last;
+        }
+    }
+
+    /*
+     * Batch observers get a B built from the change, or a copy of it if B
+     * is not given. Changes that carry large objects batch only the keys
+     * their batch observers use.
+     */
+    template <typename B = void, typename T>
+    void notifyBatched(SubjectType type, T &cntx)
+    {
+        using Batched = typename std::conditional<std::is_void<B>::value, T, B>::type;
+        bool batched = false;
+
+        for (auto iter: m_observers)
+        {
+            if (m_notifyBatching && iter->isBatchObserver(type))
+            {
+                batched = true;
+                continue;
+            }
+
+            iter->update(type, static_cast<void *>(&cntx));
+        }
+
+        if (batched)
+        {
+            m_notifyBatch.emplace_back(type, std::make_shared<Batched>(cntx));
+        }
+    }
+
+private:
+    bool m_notifyBatching = false;
+    vector<pair<SubjectType, shared_ptr<void>>> m_notifyBatch;
 };
 
 #endif /* SWSS_OBSERVER_H */
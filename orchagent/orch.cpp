@@ -1,6 +1,8 @@
 #include <inttypes.h>
 #include <stdexcept>
+#include <functional>
 #include <sys/time.h>
+#include <hiredis/hiredis.h>
 #include "timestamp.h"
 #include "orch.h"
 
@@ -12,6 +14,7 @@
 #include "zmqserver.h"
 #include "zmqconsumerstatetable.h"
 #include "sai_serialize.h"
+#include "rediscommand.h"
 
 using namespace swss;
 
@@ -19,6 +22,161 @@ int gBatchSize = 0;
 
 std::shared_ptr<RingBuffer> Orch::gRingBuffer = nullptr;
 std::shared_ptr<RingBuffer> Executor::gRingBuffer = nullptr;
+std::atomic<int> Executor::gThrottledExecutors{0};
+
+static int64_t steadyNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+using RedisReplyPtr = std::unique_ptr<redisReply, void (*)(void *)>;
+
+static bool appendRedisCommand(redisContext *ctx, const vector<string> &args)
+{
+    vector<const char *> argv;
+    vector<size_t> argvlen;
+
+    for (const auto &arg : args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    RedisCommand command;
+    command.formatArgv(static_cast<int>(argv.size()), argv.data(), argvlen.data());
+
+    return redisAppendFormattedCommand(ctx, command.c_str(), command.length()) == REDIS_OK;
+}
+
+static RedisReplyPtr getRedisReply(redisContext *ctx)
+{
+    void *raw = nullptr;
+    if (redisGetReply(ctx, &raw) != REDIS_OK)
+    {
+        raw = nullptr;
+    }
+
+    return RedisReplyPtr(static_cast<redisReply *>(raw), freeReplyObject);
+}
+
+/*
+ * Walks all the entries of a table with a SCAN cursor. The HGETALLs of the
+ * keys a SCAN returned are sent together with the next SCAN, so every batch
+ * costs one round trip. Each batch is passed to the handler as SET entries.
+ */
+static bool scanTable(const DBConnector *db, const string &tableName,
+                      const std::function<void(std::shared_ptr<std::deque<KeyOpFieldsValuesTuple>>)> &handler)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = db->getContext();
+    string prefix = tableName + SonicDBConfig::getSeparator(db);
+    string cursor = "0";
+    vector<string> keys;
+    bool scanned = false;
+
+    while (!scanned || !keys.empty())
+    {
+        for (const auto &key : keys)
+        {
+            if (!appendRedisCommand(ctx, { "HGETALL", key }))
+            {
+                SWSS_LOG_ERROR("Failed to queue read of %s: %s", key.c_str(), ctx->errstr);
+                return false;
+            }
+        }
+
+        if (!scanned && !appendRedisCommand(ctx, { "SCAN", cursor, "MATCH", prefix + "*", "COUNT", std::to_string(REFILL_SCAN_COUNT) }))
+        {
+            SWSS_LOG_ERROR("Failed to queue scan of %s: %s", tableName.c_str(), ctx->errstr);
+            return false;
+        }
+
+        bool success = true;
+        auto entries = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+
+        for (const auto &key : keys)
+        {
+            auto reply = getRedisReply(ctx);
+            if (!reply)
+            {
+                SWSS_LOG_ERROR("Failed to read %s: %s", key.c_str(), ctx->errstr);
+                return false;
+            }
+
+            // Keep draining the batch, so no stale reply is left behind
+            if (reply->type != REDIS_REPLY_ARRAY || reply->elements % 2)
+            {
+                success = false;
+                continue;
+            }
+
+            // The key may have been removed since it was scanned
+            if (reply->elements == 0)
+            {
+                continue;
+            }
+
+            vector<FieldValueTuple> fvs;
+            for (size_t i = 0; i < reply->elements; i += 2)
+            {
+                const redisReply *field = reply->element[i];
+                const redisReply *value = reply->element[i + 1];
+                fvs.emplace_back(string(field->str, field->len), string(value->str, value->len));
+            }
+
+            entries->emplace_back(key.substr(prefix.size()), SET_COMMAND, std::move(fvs));
+        }
+
+        if (!scanned)
+        {
+            auto reply = getRedisReply(ctx);
+            if (!reply)
+            {
+                SWSS_LOG_ERROR("Failed to scan %s: %s", tableName.c_str(), ctx->errstr);
+                return false;
+            }
+
+            // SCAN replies with the next cursor and the keys of this batch
+            if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 ||
+                reply->element[0]->type != REDIS_REPLY_STRING ||
+                reply->element[1]->type != REDIS_REPLY_ARRAY)
+            {
+                success = false;
+            }
+            else
+            {
+                cursor = string(reply->element[0]->str, reply->element[0]->len);
+                scanned = cursor == "0";
+
+                keys.clear();
+                for (size_t i = 0; i < reply->element[1]->elements; i++)
+                {
+                    const redisReply *key = reply->element[1]->element[i];
+                    keys.emplace_back(key->str, key->len);
+                }
+            }
+        }
+        else
+        {
+            keys.clear();
+        }
+
+        if (!success)
+        {
+            SWSS_LOG_WARN("Unexpected replies scanning %s", tableName.c_str());
+            return false;
+        }
+
+        if (!entries->empty())
+        {
+            handler(entries);
+        }
+    }
+
+    return true;
+}
 
 RingBuffer::RingBuffer(int size): buffer(size)
 {
@@ -236,11 +394,24 @@ void Orch::notifyRetry(Orch *retryOrch, const std::string &executorName, const C
     }
 }
 
-size_t ConsumerBase::addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries, bool onRetry) {
-    return addToSync(*entries, onRetry);
+size_t ConsumerBase::addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries, bool onRetry)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& entry: *entries)
+    {
+        addToSync(std::move(entry), onRetry);
+    }
+
+    return entries->size();
 }
 
 void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
+{
+    addToSync(KeyOpFieldsValuesTuple(entry), onRetry);
+}
+
+void ConsumerBase::addToSync(KeyOpFieldsValuesTuple &&entry, bool onRetry)
 {
     SWSS_LOG_ENTER();
 
@@ -289,8 +460,8 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
                 {
                     // move the old SET back to m_toSync for later merge
                     auto old_task = retryCache->evict(key);
-                    m_toSync.emplace(key, *old_task);
                     Recorder::Instance().retry.record(dumpTuple(*old_task).append(DECACHE));
+                    m_toSync.emplace(key, std::move(*old_task));
                 }
             }
             break;
@@ -310,7 +481,7 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
                 // Keep the DEL task, move the old SET back to m_toSync for later merge
                 auto old_task = retryCache->evict(key);
                 Recorder::Instance().retry.record(dumpTuple(*old_task).append(DECACHE));
-                m_toSync.emplace(key, *old_task);
+                m_toSync.emplace(key, std::move(*old_task));
             }
             break;
         }
@@ -319,6 +490,13 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
         }
     }
 
+    mergeToSync(key, std::move(entry));
+}
+
+void ConsumerBase::mergeToSync(const string &key, KeyOpFieldsValuesTuple &&entry)
+{
+    const string &op = kfvOp(entry);
+
     /*
     * m_toSync is a multimap which will allow one key with multiple values,
     * Also, the order of the key-value pairs whose keys compare equivalent
@@ -328,14 +506,14 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
     if (m_toSync.find(key) == m_toSync.end())
     {
-        m_toSync.emplace(key, entry);
+        m_toSync.emplace(key, std::move(entry));
     }
 
     /* if a DEL task comes, we overwrite the old key */
     else if (op == DEL_COMMAND)
     {
         m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
+        m_toSync.emplace(key, std::move(entry));
     }
     else
     {
@@ -360,38 +538,104 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry, bool onRetry)
         }
         if (iter == ret.second)
         {
-            m_toSync.emplace(key, entry);
+            m_toSync.emplace(key, std::move(entry));
         }
         else
         {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
-
+            /* Merge in place, the new values are moved over the old ones */
+            auto& existing_values = kfvFieldsValues(iter->second);
 
-            for (auto it : new_values)
+            for (auto& it : kfvFieldsValues(entry))
             {
-                string field = fvField(it);
-                string value = fvValue(it);
+                const string& field = fvField(it);
 
                 auto iu = existing_values.begin();
                 while (iu != existing_values.end())
                 {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
+                    if (field == fvField(*iu))
                         iu = existing_values.erase(iu);
                     else
                         iu++;
                 }
-                existing_values.push_back(FieldValueTuple(field, value));
+                existing_values.push_back(std::move(it));
             }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
         }
     }
 
 }
 
+void ConsumerBase::drainPending(const AnyTask &task)
+{
+    if (m_toSync.empty())
+    {
+        m_queueDepth = 0;
+        m_pendingSinceMs = 0;
+        setThrottled(false);
+        return;
+    }
+
+    int64_t now = steadyNowMs();
+    if (m_pendingSinceMs == 0)
+    {
+        m_pendingSinceMs = now;
+    }
+
+    size_t quota = m_drainQuota;
+    if (quota)
+    {
+        auto aging = static_cast<size_t>((now - m_pendingSinceMs) / EXECUTOR_AGING_MSECS);
+        quota <<= std::min<size_t>(aging, EXECUTOR_MAX_AGING_SHIFT);
+    }
+
+    if (!quota || m_toSync.size() <= quota)
+    {
+        task();
+        setThrottled(false);
+    }
+    else
+    {
+        SyncMap backlog;
+        backlog.swap(m_toSync);
+
+        /* Whole keys only, so a DEL and the SET after it stay in order */
+        auto it = backlog.upper_bound(m_drainCursor);
+        while (m_toSync.size() < quota)
+        {
+            if (it == backlog.end())
+            {
+                it = backlog.begin();
+            }
+
+            m_drainCursor = it->first;
+            do
+            {
+                m_toSync.emplace(it->first, std::move(it->second));
+                it = backlog.erase(it);
+            } while (it != backlog.end() && it->first == m_drainCursor);
+        }
+
+        size_t sliced = m_toSync.size();
+
+        task();
+
+        /* A slice the orch made no progress on is waiting for retries, not for the quota */
+        setThrottled(m_toSync.size() < sliced);
+
+        /* What the orch left or added is newer than the backlog it did not see */
+        backlog.swap(m_toSync);
+        for (auto &entry : backlog)
+        {
+            mergeToSync(entry.first, std::move(entry.second));
+        }
+    }
+
+    m_queueDepth = m_toSync.size();
+    if (m_toSync.empty())
+    {
+        m_pendingSinceMs = 0;
+    }
+}
+
 size_t ConsumerBase::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries, bool onRetry)
 {
     SWSS_LOG_ENTER();
@@ -427,6 +671,46 @@ size_t ConsumerBase::refillToSync(Table* table)
     return addToSync(entries);
 }
 
+size_t ConsumerBase::refillToSync(const DBConnector *db, const string &tableName)
+{
+    SWSS_LOG_ENTER();
+
+    int64_t start = steadyNowMs();
+    size_t loaded = 0;
+    size_t refilled = 0;
+
+    /*
+     * The scan leaves replies in flight, so it runs on a connection of its
+     * own instead of one its owner keeps using. A failed scan may leave
+     * some unread, its connection is dropped with them.
+     */
+    std::unique_ptr<DBConnector> scanDb(db->newConnector(0));
+    bool success = scanTable(scanDb.get(), tableName, [&](std::shared_ptr<std::deque<KeyOpFieldsValuesTuple>> entries) {
+        loaded += entries->size();
+        refilled += addToSync(entries);
+    });
+    scanDb.reset();
+
+    if (!success)
+    {
+        // Entries already loaded are set again with the same values, which merges into the same task
+        SWSS_LOG_WARN("Failed to scan %s after %zu entries, reading it key by key", tableName.c_str(), loaded);
+
+        auto table = Table(db, tableName);
+        return refillToSync(&table);
+    }
+
+    int64_t elapsed = std::max<int64_t>(steadyNowMs() - start, 1);
+    if (loaded)
+    {
+        SWSS_LOG_NOTICE("Loaded %zu entries of %s in %" PRId64 " ms, %" PRIu64 " entries/s",
+                        loaded, tableName.c_str(), elapsed,
+                        static_cast<uint64_t>(loaded) * 1000 / static_cast<uint64_t>(elapsed));
+    }
+
+    return refilled;
+}
+
 size_t ConsumerBase::refillToSync()
 {
     auto subTable = dynamic_cast<SubscriberStateTable *>(getSelectable());
@@ -448,16 +732,12 @@ size_t ConsumerBase::refillToSync()
     if (consumerTable != NULL)
     {
         // consumerTable is either ConsumerStateTable or ConsumerTable
-        auto db = consumerTable->getDbConnector();
-        auto table = Table(db, tableName);
-        return refillToSync(&table);
+        return refillToSync(consumerTable->getDbConnector(), tableName);
     }
     auto zmqTable = dynamic_cast<ZmqConsumerStateTable *>(getSelectable());
     if (zmqTable != NULL)
     {
-        auto db = zmqTable->getDbConnector();
-        auto table = Table(db, tableName);
-        return refillToSync(&table);
+        return refillToSync(zmqTable->getDbConnector(), tableName);
     }
     return 0;
 }
@@ -517,6 +797,21 @@ void Consumer::execute()
     );
 }
 
+uint64_t Executor::getWaitTimeMs() const
+{
+    int64_t since = m_pendingSinceMs;
+    return since ? static_cast<uint64_t>(steadyNowMs() - since) : 0;
+}
+
+void Executor::setThrottled(bool throttled)
+{
+    if (throttled != m_throttled)
+    {
+        m_throttled = throttled;
+        gThrottledExecutors += throttled ? 1 : -1;
+    }
+}
+
 void Executor::processAnyTask(AnyTask&& task)
 {
     // if either gRingBuffer isn't initialized or the ring thread isn't created
@@ -555,8 +850,7 @@ void Executor::processAnyTask(AnyTask&& task)
 
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
-        ((Orch *)m_orch)->doTask((Consumer&)*this);
+    drainPending([this]() { ((Orch *)m_orch)->doTask((Consumer&)*this); });
 }
 
 size_t Orch::addExistingData(const string& tableName)
@@ -841,10 +1135,42 @@ void Orch::doTask()
 
     size_t count = 0;
 
-    for (auto &it : m_consumerMap)
+    for (auto *executor : m_drainOrder)
+    {
+        count += retryToSync(executor->getName(), threshold - count);
+        executor->drain();
+    }
+}
+
+bool Orch::setDrainQuota(const string &executorName, size_t quota)
+{
+    auto executor = getExecutor(executorName);
+    if (executor == NULL)
+    {
+        return false;
+    }
+
+    executor->setDrainQuota(quota);
+    return true;
+}
+
+void Orch::getExecutorStats(std::map<string, ExecutorStats> &stats)
+{
+    for (auto *executor : m_drainOrder)
     {
-        count += retryToSync(it.first, threshold - count);
-        it.second->drain();
+        ExecutorStats current = { executor->getPri(), executor->getDrainQuota(),
+                                  executor->getQueueDepth(), executor->getWaitTimeMs() };
+
+        /* Executors of different orchs may share a table name */
+        auto inserted = stats.emplace(executor->getName(), current);
+        if (!inserted.second)
+        {
+            auto &existing = inserted.first->second;
+            existing.pri = std::max(existing.pri, current.pri);
+            existing.drainQuota = std::max(existing.drainQuota, current.drainQuota);
+            existing.queueDepth += current.queueDepth;
+            existing.waitTimeMs = std::max(existing.waitTimeMs, current.waitTimeMs);
+        }
     }
 }
 
@@ -1111,6 +1437,15 @@ void Orch::addExecutor(Executor* executor)
         SWSS_LOG_THROW("Duplicated executorName in m_consumerMap: %s", executor->getName().c_str());
     }
 
+    auto pos = m_drainOrder.begin();
+    while (pos != m_drainOrder.end() &&
+           ((*pos)->getPri() > executor->getPri() ||
+            ((*pos)->getPri() == executor->getPri() && (*pos)->getName() < executor->getName())))
+    {
+        pos++;
+    }
+    m_drainOrder.insert(pos, executor);
+
     if (gRingBuffer && executor->getName() == APP_ROUTE_TABLE_NAME) {
         gRingBuffer->addExecutor(executor);
     }
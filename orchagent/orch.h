@@ -7,6 +7,8 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 
 extern "C" {
@@ -56,6 +58,13 @@ const char state_db_key_delimiter  = '|';
 #define RING_SIZE 30
 #define SLEEP_MSECONDS 500
 
+/* The drain quota of a waiting backlog doubles every aging interval, up to 8 times */
+#define EXECUTOR_AGING_MSECS 1000
+#define EXECUTOR_MAX_AGING_SHIFT 3
+
+/* SCAN COUNT hint when preloading a table, each batch is one round trip */
+#define REFILL_SCAN_COUNT 1000
+
 const int default_orch_pri = 0;
 
 typedef enum
@@ -113,7 +122,11 @@ public:
     {
     }
 
-    virtual ~Executor() { delete m_selectable; }
+    virtual ~Executor()
+    {
+        setThrottled(false);
+        delete m_selectable;
+    }
 
     // Decorating Selectable
     int getFd() override { return m_selectable->getFd(); }
@@ -139,6 +152,20 @@ public:
     static std::shared_ptr<RingBuffer> gRingBuffer;
     void processAnyTask(AnyTask&& func);
 
+    // Select priority of the underlying selectable, also the drain order within the orch
+    int getPri() const { return m_selectable->getPri(); }
+
+    // Limits the pending entries one drain pass hands to the orch, 0 hands all of them
+    void setDrainQuota(size_t quota) { m_drainQuota = quota; }
+    size_t getDrainQuota() const { return m_drainQuota; }
+
+    // Entries left pending by the last pass and how long the oldest of them has waited
+    size_t getQueueDepth() const { return m_queueDepth; }
+    uint64_t getWaitTimeMs() const;
+
+    // True while a quota held back part of a backlog the orch is making progress on
+    static bool hasThrottled() { return gThrottledExecutors > 0; }
+
 protected:
     swss::Selectable *m_selectable;
     Orch *m_orch;
@@ -146,12 +173,29 @@ protected:
     // Name for Executor
     std::string m_name;
 
+    size_t m_drainQuota = 0;
+    // Written by the draining thread, which is the ring thread for ring buffer executors
+    std::atomic<size_t> m_queueDepth{0};
+    std::atomic<int64_t> m_pendingSinceMs{0};
+    bool m_throttled = false;
+    static std::atomic<int> gThrottledExecutors;
+
+    void setThrottled(bool throttled);
+
     // Get the underlying selectable
     swss::Selectable *getSelectable() const { return m_selectable; }
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
 
+struct ExecutorStats
+{
+    int pri;
+    size_t drainQuota;
+    size_t queueDepth;
+    uint64_t waitTimeMs;
+};
+
 class ConsumerBase : public Executor {
 public:
     ConsumerBase(swss::Selectable *selectable, Orch *orch, const std::string &name)
@@ -177,10 +221,13 @@ public:
     void recordTuple(const swss::KeyOpFieldsValuesTuple &tuple);
 
     void addToSync(const swss::KeyOpFieldsValuesTuple &entry, bool onRetry=false);
+    // Moves the tuple and its fields into m_toSync instead of copying them
+    void addToSync(swss::KeyOpFieldsValuesTuple &&entry, bool onRetry=false);
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries, bool onRetry=false);
-    size_t addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries, bool onRetry=false); 
+    // The deque is owned by the caller's task, its entries are moved out and left empty
+    size_t addToSync(std::shared_ptr<std::deque<swss::KeyOpFieldsValuesTuple>> entries, bool onRetry=false);
 
     /**
      * @brief Add the failed task and its constraint to the consumer's RetryCache
@@ -191,6 +238,25 @@ public:
 
     size_t refillToSync();
     size_t refillToSync(swss::Table* table);
+    /*
+     * Loads the table with SCAN and pipelined HGETALLs instead of KEYS and
+     * one HGET per key, falls back to the Table read if that fails. Both
+     * run on connections of their own, db only names the database.
+     */
+    size_t refillToSync(const swss::DBConnector *db, const std::string &tableName);
+
+protected:
+    /*
+     * Runs task over the pending entries, at most the drain quota of them per
+     * pass. Each pass starts after the key the previous one stopped at, so a
+     * large backlog is walked round robin, and the rest is merged back after.
+     */
+    void drainPending(const AnyTask &task);
+
+private:
+    void mergeToSync(const std::string &key, swss::KeyOpFieldsValuesTuple &&entry);
+
+    std::string m_drainCursor;
 };
 
 class RingBuffer
@@ -298,7 +364,7 @@ public:
     // otherwise fallback to cold start
     virtual bool bake();
 
-    /* Iterate all consumers in m_consumerMap and run doTask(Consumer) */
+    /* Iterate all consumers in m_consumerMap by priority and run doTask(Consumer) */
     virtual void doTask();
 
     /* Run doTask against a specific executor */
@@ -317,6 +383,9 @@ public:
     virtual void onWarmBootEnd() { }
 
     void dumpPendingTasks(std::vector<std::string> &ts);
+
+    bool setDrainQuota(const std::string &executorName, size_t quota);
+    void getExecutorStats(std::map<std::string, ExecutorStats> &stats);
     
     void createRetryCache(const std::string &executorName);
     RetryCache* getRetryCache(const std::string &executorName);
@@ -355,6 +424,8 @@ public:
 protected:
     ConsumerMap m_consumerMap;
     RetryCacheMap m_retryCaches;
+    // m_consumerMap executors by descending priority, then by name
+    std::vector<Executor *> m_drainOrder;
 
     Orch();
     ref_resolve_status resolveFieldRefValue(type_map&, const std::string&, const std::string&, swss::KeyOpFieldsValuesTuple&, sai_object_id_t&, std::string&);
@@ -8,6 +8,7 @@
 #include "warm_restart.h"
 #include <iostream>
 #include "orch_zmq_config.h"
+#include "shm_route_ring.h"
 
 #define SAI_SWITCH_ATTR_CUSTOM_RANGE_BASE SAI_SWITCH_ATTR_CUSTOM_RANGE_START
 #include "sairedis.h"
@@ -19,22 +20,28 @@ using namespace swss;
 
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
+/* select() timeout while drain quotas hold back part of a backlog */
+#define THROTTLED_SELECT_TIMEOUT 0
 #define PFC_WD_POLL_MSECS 100
 
 #define APP_FABRIC_MONITOR_PORT_TABLE_NAME      "FABRIC_PORT_TABLE"
 #define APP_FABRIC_MONITOR_DATA_TABLE_NAME      "FABRIC_MONITOR_TABLE"
 
+#define STATE_ORCH_EXECUTOR_TABLE_NAME          "ORCH_EXECUTOR_TABLE"
+
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
 extern string                      gMySwitchType;
 extern string                      gMySwitchSubType;
 extern bool                        gOrchUnhealthy;
 extern string                      gSaiErrorString;
+extern bool                        gNativeCounterRates;
 
 extern void syncd_apply_view();
 /*
  * Global orch daemon variables
  */
+size_t gRouteDrainQuota = 0;
 PortsOrch *gPortsOrch;
 FabricPortsOrch *gFabricPortsOrch;
 FdbOrch *gFdbOrch;
@@ -71,6 +78,7 @@ StpOrch *gStpOrch;
 MuxOrch *gMuxOrch;
 IcmpOrch *gIcmpOrch;
 HFTelOrch *gHFTOrch;
+CounterRateOrch *gCounterRateOrch;
 
 bool gIsNatSupported = false;
 event_handle_t g_events_handle;
@@ -314,6 +322,13 @@ bool OrchDaemon::init()
     auto route_zmq_sever = enable_route_zmq ? m_zmqServer : nullptr;
 
     gRouteOrch = new RouteOrch(m_applDb, route_tables, gSwitchOrch, gNeighOrch, gIntfsOrch, vrf_orch, gFgNhgOrch, gSrv6Orch, route_zmq_sever);
+
+    // Enable the fpmsyncd service to send Route events to orchagent through the shared memory route ring.
+    if (get_feature_status(ORCH_NORTHBOND_ROUTE_SHM_ENABLED, false))
+    {
+        gRouteOrch->addShmRouteConsumer(m_applDb, APP_ROUTE_TABLE_NAME, routeorch_pri,
+                                        ShmRouteRing::create(SHM_ROUTE_RING_NAME, SHM_ROUTE_RING_SIZE));
+    }
     gNhgOrch = new NhgOrch(m_applDb, APP_NEXTHOP_GROUP_TABLE_NAME);
     gCbfNhgOrch = new CbfNhgOrch(m_applDb, APP_CLASS_BASED_NEXT_HOP_GROUP_TABLE_NAME);
 
@@ -478,6 +493,12 @@ bool OrchDaemon::init()
      */
     m_orchList = { gSwitchOrch, gCrmOrch, gPortsOrch, gBufferOrch, gFlowCounterRouteOrch, gIntfsOrch, gNeighOrch, gNhgMapOrch, gNhgOrch, gCbfNhgOrch, gFgNhgOrch, gRouteOrch, gCoppOrch, gQosOrch, wm_orch, gPolicerOrch, gTunneldecapOrch, sflow_orch, gDebugCounterOrch, gMacsecOrch, bgp_global_state_orch, gBfdOrch, gIcmpOrch, gSrv6Orch, gMuxOrch, mux_cb_orch, gMonitorOrch, gBfdMonitorOrch, gStpOrch};
 
+    if (gNativeCounterRates)
+    {
+        gCounterRateOrch = new CounterRateOrch(m_configDb, {});
+        m_orchList.push_back(gCounterRateOrch);
+    }
+
     bool initialize_dtel = false;
     if (platform == BFN_PLATFORM_SUBSTRING || platform == VS_PLATFORM_SUBSTRING)
     {
@@ -859,6 +880,41 @@ bool OrchDaemon::init()
     return true;
 }
 
+/* Export the queue depth and wait time of the executors that changed */
+void OrchDaemon::exportExecutorStats()
+{
+    SWSS_LOG_ENTER();
+
+    map<string, ExecutorStats> stats;
+    for (Orch *o : m_orchList)
+    {
+        o->getExecutorStats(stats);
+    }
+
+    for (const auto &it : stats)
+    {
+        const auto &current = it.second;
+        auto last = m_executorStats.find(it.first);
+        if (last != m_executorStats.end() &&
+            last->second.queueDepth == current.queueDepth &&
+            last->second.waitTimeMs == current.waitTimeMs &&
+            last->second.drainQuota == current.drainQuota)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs = {
+            { "priority", to_string(current.pri) },
+            { "drain_quota", to_string(current.drainQuota) },
+            { "queue_depth", to_string(current.queueDepth) },
+            { "wait_time_ms", to_string(current.waitTimeMs) }
+        };
+        m_executorStatsTable->set(it.first, fvs);
+    }
+
+    m_executorStats.swap(stats);
+}
+
 /* Flush redis through sairedis interface */
 void OrchDaemon::flush()
 {
@@ -921,6 +977,19 @@ void OrchDaemon::start(long heartBeatInterval)
         m_select->addSelectables(o->getSelectables());
     }
 
+    /*
+     * Bulk route loads are handed to RouteOrch in slices, so the other tables
+     * are serviced in between. Set only now, warm restore drains everything.
+     */
+    if (gRouteOrch && gRouteDrainQuota)
+    {
+        gRouteOrch->setDrainQuota(APP_ROUTE_TABLE_NAME, gRouteDrainQuota);
+        gRouteOrch->setDrainQuota(APP_LABEL_ROUTE_TABLE_NAME, gRouteDrainQuota);
+        SWSS_LOG_NOTICE("Draining at most %zu routes per pass", gRouteDrainQuota);
+    }
+
+    m_executorStatsTable = make_unique<Table>(m_stateDb, STATE_ORCH_EXECUTOR_TABLE_NAME);
+
     auto tstart = std::chrono::high_resolution_clock::now();
 
     while (true)
@@ -928,7 +997,7 @@ void OrchDaemon::start(long heartBeatInterval)
         Selectable *s;
         int ret;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        ret = m_select->select(&s, Executor::hasThrottled() ? THROTTLED_SELECT_TIMEOUT : SELECT_TIMEOUT);
 
         /*
          * Log an error message periodically if a previous SAI API call failed with
@@ -949,6 +1018,7 @@ void OrchDaemon::start(long heartBeatInterval)
             tstart = std::chrono::high_resolution_clock::now();
 
             flush();
+            exportExecutorStats();
         }
 
         if (ret == Select::ERROR)
@@ -978,6 +1048,12 @@ void OrchDaemon::start(long heartBeatInterval)
                         o->doTask();
                 }
             }
+            else if (Executor::hasThrottled())
+            {
+                /* Nothing else to do, carry on with the backlogs held back by drain quotas */
+                for (Orch *o : m_orchList)
+                    o->doTask();
+            }
 
             continue;
         }
@@ -1311,10 +1387,15 @@ bool DpuOrchDaemon::init()
     DashOrch *dash_orch = new DashOrch(m_dpu_appDb, dash_tables, m_dpu_appstateDb, dash_zmq_server);
     gDirectory.set(dash_orch);
 
-    vector<string> dash_ha_tables = {
-        APP_DASH_HA_SET_TABLE_NAME,
-        APP_DASH_HA_SCOPE_TABLE_NAME,
-        APP_BFD_SESSION_TABLE_NAME
+    /*
+     * HA tables drive switchover, select hands them out ahead of the bulk
+     * DASH config tables, which all use the default priority.
+     */
+    const int dashhaorch_pri = 10;
+    vector<table_name_with_pri_t> dash_ha_tables = {
+        { APP_DASH_HA_SET_TABLE_NAME,   dashhaorch_pri },
+        { APP_DASH_HA_SCOPE_TABLE_NAME, dashhaorch_pri },
+        { APP_BFD_SESSION_TABLE_NAME,   dashhaorch_pri }
     };
 
     DashHaOrch *dash_ha_orch = new DashHaOrch(m_dpu_appDb, dash_ha_tables, dash_orch, gBfdOrch, m_dpu_appstateDb, dash_zmq_server);
@@ -33,6 +33,7 @@
 #include "countercheckorch.h"
 #include "flexcounterorch.h"
 #include "watermarkorch.h"
+#include "counterrateorch.h"
 #include "policerorch.h"
 #include "sfloworch.h"
 #include "debugcounterorch.h"
@@ -124,7 +125,11 @@ protected:
     Select *m_select;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_lastHeartBeat;
 
+    std::unique_ptr<Table> m_executorStatsTable;
+    std::map<std::string, ExecutorStats> m_executorStats;
+
     void flush();
+    void exportExecutorStats();
 
     void heartBeat(std::chrono::time_point<std::chrono::high_resolution_clock> tcurrent, long interval);
 
@@ -1105,7 +1105,7 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::bake()
         return false;
     }
 
-    size_t refilled = consumer->refillToSync(m_applTable.get());
+    size_t refilled = consumer->refillToSync(m_applDb.get(), m_applTable->getTableName());
     SWSS_LOG_NOTICE("Add warm input PFC watchdog State: %s, %zd", APP_PFC_WD_TABLE_NAME, refilled);
 
     return true;
@@ -0,0 +1,247 @@
+// includes -----------------------------------------------------------------------------------------------------------
+
+#include <cstdio>
+
+#include <fstream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include <stringutility.h>
+#include <logger.h>
+
+#include "port_capability_cache.h"
+
+using namespace swss;
+
+// constants ----------------------------------------------------------------------------------------------------------
+
+// Bump whenever the file layout or the meaning of a cached value changes
+static const std::uint32_t cacheVersion = 2;
+
+// Port capability cache ----------------------------------------------------------------------------------------------
+
+void PortCapabilityCache::init(const std::string &path, const std::string &platform, const std::string &hwsku, const std::string &swVersion)
+{
+    SWSS_LOG_ENTER();
+
+    this->path = path;
+    this->platform = platform;
+    this->hwsku = hwsku;
+    this->swVersion = swVersion;
+
+    this->entries.clear();
+    this->dirty = false;
+
+    if (!this->isEnabled())
+    {
+        return;
+    }
+
+    if (!this->load())
+    {
+        SWSS_LOG_NOTICE("Port capability cache %s is not usable, ports will be queried from SAI", path.c_str());
+        this->entries.clear();
+        return;
+    }
+
+    SWSS_LOG_NOTICE("Loaded %zu ports from port capability cache %s", this->entries.size(), path.c_str());
+}
+
+bool PortCapabilityCache::isEnabled() const
+{
+    return !this->path.empty();
+}
+
+std::string PortCapabilityCache::toKey(const std::set<std::uint32_t> &lanes)
+{
+    return join(',', lanes.cbegin(), lanes.cend());
+}
+
+bool PortCapabilityCache::getSupportedSpeeds(const std::set<std::uint32_t> &lanes, std::vector<std::uint32_t> &speeds) const
+{
+    const auto &cit = this->entries.find(toKey(lanes));
+    if ((cit == this->entries.cend()) || !cit->second.hasSpeeds)
+    {
+        return false;
+    }
+
+    speeds = cit->second.speeds;
+
+    return true;
+}
+
+void PortCapabilityCache::setSupportedSpeeds(const std::set<std::uint32_t> &lanes, const std::vector<std::uint32_t> &speeds)
+{
+    if (!this->isEnabled())
+    {
+        return;
+    }
+
+    auto &entry = this->entries[toKey(lanes)];
+    if (entry.hasSpeeds && (entry.speeds == speeds))
+    {
+        return;
+    }
+
+    entry.hasSpeeds = true;
+    entry.speeds = speeds;
+    this->dirty = true;
+}
+
+bool PortCapabilityCache::getSupportedFecModes(const std::set<std::uint32_t> &lanes, std::set<sai_port_fec_mode_t> &fecModes) const
+{
+    const auto &cit = this->entries.find(toKey(lanes));
+    if ((cit == this->entries.cend()) || !cit->second.hasFecModes)
+    {
+        return false;
+    }
+
+    fecModes = cit->second.fecModes;
+
+    return true;
+}
+
+void PortCapabilityCache::setSupportedFecModes(const std::set<std::uint32_t> &lanes, const std::set<sai_port_fec_mode_t> &fecModes)
+{
+    if (!this->isEnabled())
+    {
+        return;
+    }
+
+    auto &entry = this->entries[toKey(lanes)];
+    if (entry.hasFecModes && (entry.fecModes == fecModes))
+    {
+        return;
+    }
+
+    entry.hasFecModes = true;
+    entry.fecModes = fecModes;
+    this->dirty = true;
+}
+
+bool PortCapabilityCache::load()
+{
+    SWSS_LOG_ENTER();
+
+    std::ifstream file(this->path);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    try
+    {
+        nlohmann::json root;
+        file >> root;
+
+        if ((root.at("version").get<std::uint32_t>() != cacheVersion) ||
+            (root.at("platform").get<std::string>() != this->platform) ||
+            (root.at("hwsku").get<std::string>() != this->hwsku) ||
+            (root.at("sw_version").get<std::string>() != this->swVersion))
+        {
+            SWSS_LOG_NOTICE("Port capability cache %s was built for another platform, HWSKU or version", this->path.c_str());
+            return false;
+        }
+
+        for (const auto &it : root.at("ports").items())
+        {
+            Entry entry;
+            const auto &port = it.value();
+
+            if (port.contains("speeds"))
+            {
+                entry.hasSpeeds = true;
+                entry.speeds = port.at("speeds").get<std::vector<std::uint32_t>>();
+            }
+
+            if (port.contains("fec_modes"))
+            {
+                entry.hasFecModes = true;
+                for (const auto &fec : port.at("fec_modes"))
+                {
+                    entry.fecModes.insert(static_cast<sai_port_fec_mode_t>(fec.get<std::int32_t>()));
+                }
+            }
+
+            this->entries[it.key()] = entry;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_WARN("Failed to parse port capability cache %s: %s", this->path.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool PortCapabilityCache::flush()
+{
+    SWSS_LOG_ENTER();
+
+    if (!this->isEnabled() || !this->dirty)
+    {
+        return true;
+    }
+
+    nlohmann::json root;
+    root["version"] = cacheVersion;
+    root["platform"] = this->platform;
+    root["hwsku"] = this->hwsku;
+    root["sw_version"] = this->swVersion;
+    root["ports"] = nlohmann::json::object();
+
+    for (const auto &cit : this->entries)
+    {
+        nlohmann::json port = nlohmann::json::object();
+
+        if (cit.second.hasSpeeds)
+        {
+            port["speeds"] = cit.second.speeds;
+        }
+
+        if (cit.second.hasFecModes)
+        {
+            auto fecModes = nlohmann::json::array();
+            for (const auto &fec : cit.second.fecModes)
+            {
+                fecModes.push_back(static_cast<std::int32_t>(fec));
+            }
+            port["fec_modes"] = fecModes;
+        }
+
+        root["ports"][cit.first] = port;
+    }
+
+    // Write to a temporary file first, so a crash never leaves a truncated cache behind
+    const auto tmpPath = this->path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            SWSS_LOG_WARN("Failed to open port capability cache %s for writing", tmpPath.c_str());
+            return false;
+        }
+
+        file << root.dump();
+        if (!file.good())
+        {
+            SWSS_LOG_WARN("Failed to write port capability cache %s", tmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), this->path.c_str()) != 0)
+    {
+        SWSS_LOG_WARN("Failed to replace port capability cache %s", this->path.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    this->dirty = false;
+
+    SWSS_LOG_NOTICE("Saved %zu ports to port capability cache %s", this->entries.size(), this->path.c_str());
+
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+extern "C" {
+#include <saitypes.h>
+#include <saiport.h>
+}
+
+#include <cstdint>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Per-port discovery results persisted across orchagent restarts.
+// Entries are keyed by the port hardware lanes, so they stay valid across
+// cold boots where SAI object ids change. The whole file is discarded when
+// the format version, platform, HWSKU or software version does not match the
+// running system, as a SAI or firmware upgrade may change what ports support.
+class PortCapabilityCache final
+{
+public:
+    PortCapabilityCache() = default;
+    ~PortCapabilityCache() = default;
+
+    void init(const std::string &path, const std::string &platform, const std::string &hwsku, const std::string &swVersion);
+    bool isEnabled() const;
+
+    bool getSupportedSpeeds(const std::set<std::uint32_t> &lanes, std::vector<std::uint32_t> &speeds) const;
+    void setSupportedSpeeds(const std::set<std::uint32_t> &lanes, const std::vector<std::uint32_t> &speeds);
+
+    bool getSupportedFecModes(const std::set<std::uint32_t> &lanes, std::set<sai_port_fec_mode_t> &fecModes) const;
+    void setSupportedFecModes(const std::set<std::uint32_t> &lanes, const std::set<sai_port_fec_mode_t> &fecModes);
+
+    // Write the cache back if anything was learned since it was loaded
+    bool flush();
+
+private:
+    struct Entry
+    {
+        bool hasSpeeds = false;
+        std::vector<std::uint32_t> speeds;
+        bool hasFecModes = false;
+        std::set<sai_port_fec_mode_t> fecModes;
+    };
+
+    static std::string toKey(const std::set<std::uint32_t> &lanes);
+
+    bool load();
+
+    std::string path;
+    std::string platform;
+    std::string hwsku;
+    std::string swVersion;
+
+    std::map<std::string, Entry> entries;
+    bool dirty = false;
+};
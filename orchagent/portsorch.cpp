@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <cstring>
+#include <cctype>
 #include <algorithm>
 
 #include "portsorch.h"
@@ -71,6 +72,10 @@ extern string gMyAsicName;
 extern event_handle_t g_events_handle;
 extern bool isChassisDbInUse();
 extern bool gMultiAsicVoq;
+extern bool gNativeCounterRates;
+
+// Path of the port capability cache, empty disables the cache
+string gPortCapabilityCacheFile;
 
 // defines ------------------------------------------------------------------------------------------------------------
 
@@ -81,6 +86,7 @@ extern bool gMultiAsicVoq;
 #define DEFAULT_HOSTIF_TX_QUEUE 7
 
 #define PORT_SPEED_LIST_DEFAULT_SIZE                     16
+#define PORT_SUPPORTED_SPEED_LIST_DEFAULT_SIZE           25
 #define PORT_STATE_POLLING_SEC                            5
 #define PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS     1000
 #define PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS     60000
@@ -89,6 +95,9 @@ extern bool gMultiAsicVoq;
 #define PG_WATERMARK_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS   60000
 #define PG_DROP_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS   10000
 
+#define SONIC_VERSION_FILE          "/etc/sonic/sonic_version.yml"
+#define SONIC_BUILD_VERSION_KEY     "build_version:"
+
 // types --------------------------------------------------------------------------------------------------------------
 
 struct PortAttrValue
@@ -686,6 +695,99 @@ static bool isMlnxPlatform()
     return true;
 }
 
+// The SONiC image pins the vendor SAI, SDK and firmware, and the SAI API version
+// is the one orchagent was built with. Empty if the image version is unknown.
+static std::string getPortCapabilitySwVersion()
+{
+    std::ifstream file(SONIC_VERSION_FILE);
+    std::string line;
+    std::string buildVersion;
+
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, strlen(SONIC_BUILD_VERSION_KEY), SONIC_BUILD_VERSION_KEY) != 0)
+        {
+            continue;
+        }
+
+        // build_version: 'master.123-abcdef'
+        buildVersion = line.substr(strlen(SONIC_BUILD_VERSION_KEY));
+        buildVersion.erase(std::remove_if(buildVersion.begin(), buildVersion.end(),
+            [](char c) { return std::isspace(static_cast<unsigned char>(c)) || c == '\'' || c == '"'; }),
+            buildVersion.end());
+        break;
+    }
+
+    if (buildVersion.empty())
+    {
+        return "";
+    }
+
+    sai_api_version_t saiVersion = 0;
+    if (sai_query_api_version(&saiVersion) != SAI_STATUS_SUCCESS)
+    {
+        return "";
+    }
+
+    return buildVersion + "/sai-" + std::to_string(saiVersion);
+}
+
+static std::map<sai_object_id_t, std::set<std::uint32_t>> getPortLaneSets(const std::map<std::set<std::uint32_t>, sai_object_id_t> &portListLaneMap)
+{
+    std::map<sai_object_id_t, std::set<std::uint32_t>> portLaneSets;
+
+    for (const auto &cit : portListLaneMap)
+    {
+        portLaneSets[cit.second] = cit.first;
+    }
+
+    return portLaneSets;
+}
+
+static void logPortSupportedSpeedsError(const std::string &alias, sai_object_id_t port_id, sai_status_t status)
+{
+    if (status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        // something went wrong in SAI implementation
+        SWSS_LOG_ERROR("Failed to get supported speed list for port %s id=%" PRIx64 ". Not enough container size",
+                       alias.c_str(), port_id);
+    }
+    else if (SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+             SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status) ||
+             status == SAI_STATUS_NOT_IMPLEMENTED)
+    {
+        // unable to validate speed if attribute is not supported on platform
+        // assuming input value is correct
+        SWSS_LOG_WARN("Unable to validate speed for port %s id=%" PRIx64 ". Not supported by platform",
+                      alias.c_str(), port_id);
+    }
+    else
+    {
+        SWSS_LOG_ERROR("Failed to get a list of supported speeds for port %s id=%" PRIx64 ". Error=%d",
+                       alias.c_str(), port_id, status);
+    }
+}
+
+static void logPortSupportedFecModesError(sai_object_id_t port_id, sai_status_t status)
+{
+    if (SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+        SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status) ||
+        (status == SAI_STATUS_NOT_SUPPORTED) ||
+        (status == SAI_STATUS_NOT_IMPLEMENTED))
+    {
+        // unable to validate FEC mode if attribute is not supported on platform
+        SWSS_LOG_NOTICE(
+            "Unable to validate FEC mode for port id=%" PRIx64 " due to unsupported by platform", port_id
+        );
+    }
+    else
+    {
+        SWSS_LOG_ERROR(
+            "Failed to get a list of supported FEC modes for port id=%" PRIx64 ". Error=%d", port_id, status
+        );
+    }
+}
+
 // Port OA ------------------------------------------------------------------------------------------------------------
 
 /*
@@ -817,6 +919,15 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         SWSS_LOG_ERROR("Port flex counter groups were not set successfully: %s", e.what());
     }
 
+    if (gNativeCounterRates)
+    {
+        /* Rates, FLR and watermarks are computed by CounterRateOrch instead */
+        queueWmSha.clear();
+        pgWmSha.clear();
+        portRateSha.clear();
+        portFlrSha.clear();
+    }
+
     // Build portStatPlugins string, only adding non-empty plugin SHAs
     std::string portStatPlugins;
     if (!portRateSha.empty())
@@ -838,7 +949,11 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         isPortStatSupported(SAI_PORT_STAT_TX_TRIM_PACKETS) && \
         !isPortStatSupported(SAI_PORT_STAT_DROPPED_TRIM_PACKETS))
     {
-        portStatPlugins += "," + nvdaPortTrimSha;
+        if (!portStatPlugins.empty())
+        {
+            portStatPlugins += ",";
+        }
+        portStatPlugins += nvdaPortTrimSha;
     }
 
     setFlexCounterGroupParameter(QUEUE_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP,
@@ -863,11 +978,34 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
                                  PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS,
                                  STATS_MODE_READ);
 
+    /* Load port capabilities learned on a previous run */
+    if (!gPortCapabilityCacheFile.empty())
+    {
+        const auto *platform = std::getenv("platform");
+        string hwsku;
+
+        DBConnector cfgDb("CONFIG_DB", 0);
+        Table deviceMetadataTable(&cfgDb, CFG_DEVICE_METADATA_TABLE_NAME);
+        deviceMetadataTable.hget("localhost", "hwsku", hwsku);
+
+        auto swVersion = getPortCapabilitySwVersion();
+        if (swVersion.empty())
+        {
+            SWSS_LOG_WARN("Unknown software version, port capability cache %s is not used", gPortCapabilityCacheFile.c_str());
+        }
+        else
+        {
+            m_portCapCache.init(gPortCapabilityCacheFile, platform != nullptr ? platform : "", hwsku, swVersion);
+        }
+    }
+
     /* Get CPU port */
     this->initializeCpuPort();
 
     /* Get ports */
+    auto start = std::chrono::steady_clock::now();
     this->initializePorts();
+    addInitPhaseTime("port_discovery", start);
 
     /* Get the flood control types and check if combined mode is supported */
     vector<int32_t> supported_flood_control_types(max_flood_control_types, 0);
@@ -1166,15 +1304,33 @@ void PortsOrch::initializePorts()
     }
 
     // Get port hardware lane info
-    for (const auto &portId : portList)
-    {
-        std::vector<sai_uint32_t> laneList(Port::max_lanes, 0);
+    const auto portCount = static_cast<uint32_t>(portList.size());
+    std::vector<std::vector<sai_uint32_t>> laneLists(portCount, std::vector<sai_uint32_t>(Port::max_lanes, 0));
 
+    PortBulker bulker(portCount);
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
         attr.id = SAI_PORT_ATTR_HW_LANE_LIST;
-        attr.value.u32list.count = static_cast<sai_uint32_t>(laneList.size());
-        attr.value.u32list.list = laneList.data();
+        attr.value.u32list.count = static_cast<sai_uint32_t>(laneLists[idx].size());
+        attr.value.u32list.list = laneLists[idx].data();
+        bulker.add(portList[idx], attr);
+    }
+
+    bulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        const auto &portId = portList[idx];
+
+        attr = bulker.attrList[idx];
+        status = bulker.statuses[idx];
+        if (status == SAI_STATUS_NOT_EXECUTED)
+        {
+            // Bulk get is not available, query the port on its own
+            status = sai_port_api->get_port_attribute(portId, 1, &attr);
+        }
 
-        status = sai_port_api->get_port_attribute(portId, 1, &attr);
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to get hardware lane list pid:%" PRIx64, portId);
@@ -1764,6 +1920,16 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
     return false;
 }
 
+void PortsOrch::getPortLaneCounts(map<sai_object_id_t, uint32_t> &laneCounts) const
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &it : m_portListLaneMap)
+    {
+        laneCounts[it.second] = static_cast<uint32_t>(it.first.size());
+    }
+}
+
 void PortsOrch::increasePortRefCount(const string &alias)
 {
     assert (m_port_ref_count.find(alias) != m_port_ref_count.end());
@@ -3062,9 +3228,7 @@ void PortsOrch::getPortSupportedSpeeds(const std::string& alias, sai_object_id_t
 {
     sai_attribute_t attr;
     sai_status_t status;
-    const auto size_guess = 25; // Guess the size which could be enough
-
-    PortSupportedSpeeds speeds(size_guess);
+    PortSupportedSpeeds speeds(PORT_SUPPORTED_SPEED_LIST_DEFAULT_SIZE);
 
     // two attempts to get our value, first with the guess, other with the returned value
     for (int attempt = 0; attempt < 2; ++attempt)
@@ -3090,26 +3254,7 @@ void PortsOrch::getPortSupportedSpeeds(const std::string& alias, sai_object_id_t
     }
     else
     {
-        if (status == SAI_STATUS_BUFFER_OVERFLOW)
-        {
-            // something went wrong in SAI implementation
-            SWSS_LOG_ERROR("Failed to get supported speed list for port %s id=%" PRIx64 ". Not enough container size",
-                           alias.c_str(), port_id);
-        }
-        else if (SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-                 SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status) ||
-                 status == SAI_STATUS_NOT_IMPLEMENTED)
-        {
-            // unable to validate speed if attribute is not supported on platform
-            // assuming input value is correct
-            SWSS_LOG_WARN("Unable to validate speed for port %s id=%" PRIx64 ". Not supported by platform",
-                          alias.c_str(), port_id);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Failed to get a list of supported speeds for port %s id=%" PRIx64 ". Error=%d",
-                           alias.c_str(), port_id, status);
-        }
+        logPortSupportedSpeedsError(alias, port_id, status);
 
         supported_speeds.clear(); // return empty
     }
@@ -3124,6 +3269,87 @@ void PortsOrch::initPortSupportedSpeeds(const std::string& alias, sai_object_id_
     }
     PortSupportedSpeeds supported_speeds;
     getPortSupportedSpeeds(alias, port_id, supported_speeds);
+    setPortSupportedSpeeds(alias, port_id, supported_speeds);
+}
+
+void PortsOrch::initPortSupportedSpeedsBulk(const std::vector<Port*>& ports)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER(__FUNCTION__);
+
+    const auto portLaneSets = getPortLaneSets(m_portListLaneMap);
+    std::vector<Port*> queryPorts;
+
+    for (auto *port : ports)
+    {
+        // If port supported speeds map already contains the information, save the SAI call
+        if (m_portSupportedSpeeds.count(port->m_port_id) > 0)
+        {
+            continue;
+        }
+
+        PortSupportedSpeeds supported_speeds;
+        const auto &cit = portLaneSets.find(port->m_port_id);
+        if ((cit != portLaneSets.cend()) && m_portCapCache.getSupportedSpeeds(cit->second, supported_speeds))
+        {
+            setPortSupportedSpeeds(port->m_alias, port->m_port_id, supported_speeds);
+            continue;
+        }
+
+        queryPorts.push_back(port);
+    }
+
+    const auto portCount = static_cast<uint32_t>(queryPorts.size());
+    std::vector<PortSupportedSpeeds> speedLists(portCount, PortSupportedSpeeds(PORT_SUPPORTED_SPEED_LIST_DEFAULT_SIZE));
+
+    PortBulker bulker(portCount);
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_SUPPORTED_SPEED;
+        attr.value.u32list.count = static_cast<uint32_t>(speedLists[idx].size());
+        attr.value.u32list.list = speedLists[idx].data();
+        bulker.add(queryPorts[idx]->m_port_id, attr);
+    }
+
+    bulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        const auto *port = queryPorts[idx];
+        const auto status = bulker.statuses[idx];
+        const auto &attr = bulker.attrList[idx];
+        PortSupportedSpeeds supported_speeds;
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            speedLists[idx].resize(attr.value.u32list.count);
+            supported_speeds.swap(speedLists[idx]);
+        }
+        else if ((status == SAI_STATUS_BUFFER_OVERFLOW) || (status == SAI_STATUS_NOT_EXECUTED))
+        {
+            // Either the list did not fit or bulk get is not available, query the port on its own
+            getPortSupportedSpeeds(port->m_alias, port->m_port_id, supported_speeds);
+        }
+        else
+        {
+            logPortSupportedSpeedsError(port->m_alias, port->m_port_id, status);
+        }
+
+        const auto &cit = portLaneSets.find(port->m_port_id);
+        if ((cit != portLaneSets.cend()) && !supported_speeds.empty())
+        {
+            m_portCapCache.setSupportedSpeeds(cit->second, supported_speeds);
+        }
+
+        setPortSupportedSpeeds(port->m_alias, port->m_port_id, supported_speeds);
+    }
+}
+
+void PortsOrch::setPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, const PortSupportedSpeeds &supported_speeds)
+{
     m_portSupportedSpeeds[port_id] = supported_speeds;
     vector<FieldValueTuple> v;
     std::string supported_speeds_str = swss::join(',', supported_speeds.begin(), supported_speeds.end());
@@ -3200,22 +3426,7 @@ sai_status_t PortsOrch::getPortSupportedFecModes(PortSupportedFecModes &supporte
     }
     else
     {
-        if (SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-            SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status) ||
-            (status == SAI_STATUS_NOT_SUPPORTED) ||
-            (status == SAI_STATUS_NOT_IMPLEMENTED))
-        {
-            // unable to validate FEC mode if attribute is not supported on platform
-            SWSS_LOG_NOTICE(
-                "Unable to validate FEC mode for port id=%" PRIx64 " due to unsupported by platform", port_id
-            );
-        }
-        else
-        {
-            SWSS_LOG_ERROR(
-                "Failed to get a list of supported FEC modes for port id=%" PRIx64 ". Error=%d", port_id, status
-            );
-        }
+        logPortSupportedFecModesError(port_id, status);
     }
 
     return status;
@@ -3231,10 +3442,98 @@ void PortsOrch::initPortSupportedFecModes(const std::string& alias, sai_object_i
         return;
     }
 
+    PortSupportedFecModes supported_fec_modes;
+    auto status = getPortSupportedFecModes(supported_fec_modes, port_id);
+    setPortSupportedFecModes(alias, port_id, status, supported_fec_modes);
+}
+
+void PortsOrch::initPortSupportedFecModesBulk(const std::vector<Port*>& ports)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER(__FUNCTION__);
+
+    const auto portLaneSets = getPortLaneSets(m_portListLaneMap);
+    std::vector<Port*> queryPorts;
+
+    for (auto *port : ports)
+    {
+        // If port supported FEC modes map already contains the information, save the SAI call
+        if (m_portSupportedFecModes.count(port->m_port_id) > 0)
+        {
+            continue;
+        }
+
+        PortSupportedFecModes supported_fec_modes;
+        const auto &cit = portLaneSets.find(port->m_port_id);
+        if ((cit != portLaneSets.cend()) && m_portCapCache.getSupportedFecModes(cit->second, supported_fec_modes))
+        {
+            setPortSupportedFecModes(port->m_alias, port->m_port_id, SAI_STATUS_SUCCESS, supported_fec_modes);
+            continue;
+        }
+
+        queryPorts.push_back(port);
+    }
+
+    const auto portCount = static_cast<uint32_t>(queryPorts.size());
+    std::vector<std::vector<sai_int32_t>> fecModeLists(portCount, std::vector<sai_int32_t>(Port::max_fec_modes));
+
+    PortBulker bulker(portCount);
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_SUPPORTED_FEC_MODE;
+        attr.value.s32list.count = static_cast<uint32_t>(fecModeLists[idx].size());
+        attr.value.s32list.list = fecModeLists[idx].data();
+        bulker.add(queryPorts[idx]->m_port_id, attr);
+    }
+
+    bulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
+    {
+        const auto *port = queryPorts[idx];
+        auto status = bulker.statuses[idx];
+        const auto &attr = bulker.attrList[idx];
+        PortSupportedFecModes supported_fec_modes;
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            for (std::uint32_t i = 0; i < attr.value.s32list.count; i++)
+            {
+                supported_fec_modes.insert(static_cast<sai_port_fec_mode_t>(attr.value.s32list.list[i]));
+            }
+        }
+        else if (status == SAI_STATUS_NOT_EXECUTED)
+        {
+            // Bulk get is not available, query the port on its own
+            status = getPortSupportedFecModes(supported_fec_modes, port->m_port_id);
+        }
+        else
+        {
+            logPortSupportedFecModesError(port->m_port_id, status);
+        }
+
+        const auto &cit = portLaneSets.find(port->m_port_id);
+        if ((cit != portLaneSets.cend()) && (status == SAI_STATUS_SUCCESS))
+        {
+            m_portCapCache.setSupportedFecModes(cit->second, supported_fec_modes);
+        }
+
+        setPortSupportedFecModes(port->m_alias, port->m_port_id, status, supported_fec_modes);
+    }
+}
+
+void PortsOrch::setPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id, sai_status_t status, const PortSupportedFecModes &supported_fecmodes)
+{
+    SWSS_LOG_ENTER();
+
     auto &obj = m_portSupportedFecModes[port_id];
     auto &supported_fec_modes = obj.data;
 
-    auto status = getPortSupportedFecModes(supported_fec_modes, port_id);
+    supported_fec_modes = supported_fecmodes;
+
     if (status != SAI_STATUS_SUCCESS)
     {
         // Do not expose "supported_fecs" in case fetching FEC modes is not supported by the vendor
@@ -3994,25 +4293,32 @@ bool PortsOrch::initPortsBulk(std::vector<Port>& ports)
 
     SWSS_LOG_TIMER(__FUNCTION__);
 
+    auto start = std::chrono::steady_clock::now();
+
     if (!initializePorts(ports))
     {
         status = false;
     }
 
+    addInitPhaseTime("port_objects", start);
+
+    std::vector<Port*> registeredPorts;
+
     for (auto& p: ports)
     {
         const auto& alias = p.m_alias;
 
         registerPort(p);
-
-        if (!m_isWarmRestoreStage)
-        {
-            postPortInit(m_portList[alias]);
-        }
+        registeredPorts.push_back(&m_portList[alias]);
 
         SWSS_LOG_NOTICE("Initialized port %s", alias.c_str());
     }
 
+    if (!m_isWarmRestoreStage)
+    {
+        postPortInitBulk(registeredPorts);
+    }
+
     return status;
 }
 
@@ -4425,6 +4731,11 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 addSystemPorts();
                 m_initDone = true;
                 SWSS_LOG_INFO("Got PortInitDone notification from portsyncd");
+
+                if (!m_isWarmRestoreStage)
+                {
+                    publishInitPhaseTimes();
+                }
             }
 
             it = taskMap.erase(it);
@@ -4546,10 +4857,12 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 if (!portsToAddList.empty())
                 {
                     std::vector<Port> addedPorts;
+                    auto start = std::chrono::steady_clock::now();
                     if (!addPortBulk(portsToAddList, addedPorts))
                     {
                         SWSS_LOG_THROW("PortsOrch initialization failure");
                     }
+                    addInitPhaseTime("port_create", start);
 
                     initPortsBulk(addedPorts);
                 }
@@ -6204,34 +6517,111 @@ void PortsOrch::onWarmBootEnd()
     refreshPortStatus();
 
     // Do post boot port initialization
+    std::vector<Port*> ports;
+
     for (auto& it: m_portList)
     {
         Port& port = it.second;
 
         if (port.m_type == Port::PHY)
         {
-            postPortInit(it.second);
+            ports.push_back(&port);
         }
     }
+
+    postPortInitBulk(ports);
+
+    publishInitPhaseTimes();
 }
 
 void PortsOrch::postPortInit(Port& p)
+{
+    std::vector<Port*> ports = {&p};
+    postPortInitBulk(ports);
+}
+
+void PortsOrch::postPortInitBulk(std::vector<Port*>& ports)
 {
     SWSS_LOG_ENTER();
 
+    SWSS_LOG_TIMER(__FUNCTION__);
+
+    auto start = std::chrono::steady_clock::now();
+
     if (gMySwitchType != "dpu")
     {
-        initializePortBufferMaximumParameters(p);
+        initializePortBufferMaximumParametersBulk(ports);
+    }
+
+    for (auto *p : ports)
+    {
+        // We have to test the size of m_queue_ids here since it isn't initialized on some platforms (like DPU)
+        if (p->m_host_tx_queue_configured && p->m_queue_ids.size() > p->m_host_tx_queue)
+        {
+            createPortBufferQueueCounters(*p, to_string(p->m_host_tx_queue), false);
+        }
+    }
+
+    addInitPhaseTime("buffer_parameters", start);
+
+    start = std::chrono::steady_clock::now();
+    initPortSupportedSpeedsBulk(ports);
+    addInitPhaseTime("supported_speeds", start);
+
+    start = std::chrono::steady_clock::now();
+    initPortSupportedFecModesBulk(ports);
+    addInitPhaseTime("supported_fec_modes", start);
+
+    // Ports created after init (e.g. by DPB) are saved right away
+    if (m_initPhaseTimesPublished)
+    {
+        m_portCapCache.flush();
     }
+}
 
-    // We have to test the size of m_queue_ids here since it isn't initialized on some platforms (like DPU)
-    if (p.m_host_tx_queue_configured && p.m_queue_ids.size() > p.m_host_tx_queue)
+void PortsOrch::addInitPhaseTime(const std::string &phase, const std::chrono::steady_clock::time_point &start)
+{
+    if (m_initPhaseTimesPublished)
     {
-        createPortBufferQueueCounters(p, to_string(p.m_host_tx_queue), false);
+        return;
     }
 
-    initPortSupportedSpeeds(p.m_alias, p.m_port_id);
-    initPortSupportedFecModes(p.m_alias, p.m_port_id);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    m_initPhaseTimes[phase] += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+    );
+}
+
+void PortsOrch::publishInitPhaseTimes()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_initPhaseTimesPublished)
+    {
+        return;
+    }
+
+    m_initPhaseTimesPublished = true;
+
+    std::vector<FieldValueTuple> fvVector;
+    std::vector<std::string> phaseList;
+    std::uint64_t total = 0;
+
+    for (const auto &cit : m_initPhaseTimes)
+    {
+        fvVector.emplace_back(cit.first + "_usec", to_string(cit.second));
+        phaseList.push_back(cit.first + "=" + to_string(cit.second));
+        total += cit.second;
+    }
+    fvVector.emplace_back("total_usec", to_string(total));
+
+    SWSS_LOG_NOTICE("Port initialization took %" PRIu64 " usec: %s", total,
+                    swss::join(",", phaseList.cbegin(), phaseList.cend()).c_str());
+
+    Table initTimingTable(m_state_db.get(), STATE_PORT_INIT_TIMING_TABLE_NAME);
+    initTimingTable.set("PortsOrch", fvVector);
+
+    m_portCapCache.flush();
 }
 
 void PortsOrch::doTask()
@@ -6795,28 +7185,53 @@ void PortsOrch::initializeSchedulerGroupsBulk(std::vector<Port>& ports)
     }
 }
 
-void PortsOrch::initializePortBufferMaximumParameters(const Port &port)
+void PortsOrch::initializePortBufferMaximumParametersBulk(const std::vector<Port*>& ports)
 {
-    sai_attribute_t attr;
-    vector<FieldValueTuple> fvVector;
+    SWSS_LOG_ENTER();
 
-    attr.id = SAI_PORT_ATTR_QOS_MAXIMUM_HEADROOM_SIZE;
+    SWSS_LOG_TIMER(__FUNCTION__);
 
-    sai_status_t status = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (status != SAI_STATUS_SUCCESS)
+    const auto portCount = static_cast<uint32_t>(ports.size());
+
+    PortBulker bulker(portCount);
+
+    for (const auto *port : ports)
     {
-        SWSS_LOG_NOTICE("Unable to get the maximum headroom for port %s rv:%d, ignored", port.m_alias.c_str(), status);
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_QOS_MAXIMUM_HEADROOM_SIZE;
+        bulker.add(port->m_port_id, attr);
     }
-    else
+
+    bulker.executeGet();
+
+    for (size_t idx = 0; idx < portCount; idx++)
     {
-        auto maximum_headroom = attr.value.u32;
-        fvVector.emplace_back("max_headroom_size", to_string(maximum_headroom));
-    }
+        const auto *port = ports[idx];
+        auto status = bulker.statuses[idx];
+        auto attr = bulker.attrList[idx];
+        vector<FieldValueTuple> fvVector;
 
-    fvVector.emplace_back("max_priority_groups", to_string(port.m_priority_group_ids.size()));
-    fvVector.emplace_back("max_queues", to_string(port.m_queue_ids.size()));
+        if (status == SAI_STATUS_NOT_EXECUTED)
+        {
+            // Bulk get is not available, query the port on its own
+            status = sai_port_api->get_port_attribute(port->m_port_id, 1, &attr);
+        }
 
-    m_stateBufferMaximumValueTable->set(port.m_alias, fvVector);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_NOTICE("Unable to get the maximum headroom for port %s rv:%d, ignored", port->m_alias.c_str(), status);
+        }
+        else
+        {
+            auto maximum_headroom = attr.value.u32;
+            fvVector.emplace_back("max_headroom_size", to_string(maximum_headroom));
+        }
+
+        fvVector.emplace_back("max_priority_groups", to_string(port->m_priority_group_ids.size()));
+        fvVector.emplace_back("max_queues", to_string(port->m_queue_ids.size()));
+
+        m_stateBufferMaximumValueTable->set(port->m_alias, fvVector);
+    }
 }
 
 bool PortsOrch::addHostIntfs(Port &port, string alias, sai_object_id_t &host_intfs_id, bool isUp)
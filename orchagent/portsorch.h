@@ -18,6 +18,7 @@
 #include "events.h"
 
 #include "port/port_capabilities.h"
+#include "port/port_capability_cache.h"
 #include "port/porthlpr.h"
 #include "port/portschema.h"
 
@@ -37,6 +38,7 @@
 #define PG_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS    "60000"
 #define PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS         "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
+#define STATE_PORT_INIT_TIMING_TABLE_NAME "PORT_INIT_TIMING_TABLE"
 #define WRED_QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP "WRED_ECN_QUEUE_STAT_COUNTER"
 #define WRED_PORT_STAT_COUNTER_FLEX_COUNTER_GROUP "WRED_ECN_PORT_STAT_COUNTER"
 
@@ -151,6 +153,7 @@ public:
     bool setBridgePortLearningFDB(Port &port, sai_bridge_port_fdb_learning_mode_t mode);
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
+    void getPortLaneCounts(map<sai_object_id_t, uint32_t> &laneCounts) const;
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
@@ -269,6 +272,9 @@ public:
     bool setPortPtIntfId(const Port& port, sai_uint16_t intf_id);
     bool setPortPtTimestampTemplate(const Port& port, sai_port_path_tracing_timestamp_type_t ts_type);
 
+    /* Cached after the first SAI query of a queue */
+    bool getQueueTypeAndIndex(sai_object_id_t queue_id, sai_queue_type_t &type, uint8_t &index);
+
 private:
     unique_ptr<CounterNameMapUpdater> m_counterNameMapUpdater;
     unique_ptr<Table> m_counterSysPortTable;
@@ -409,7 +415,7 @@ private:
     void initializePortHostTxReadyBulk(std::vector<Port>& ports);
     void initializePortMtuBulk(std::vector<Port>& ports);
 
-    void initializePortBufferMaximumParameters(const Port &port);
+    void initializePortBufferMaximumParametersBulk(const std::vector<Port*>& ports);
     void initializeVoqs(Port &port);
 
     bool addHostIntfs(Port &port, string alias, sai_object_id_t &host_intfs_id, bool isUp);
@@ -439,6 +445,7 @@ private:
     void initPortCapLinkTraining(Port &port);
 
     void postPortInit(Port &p);
+    void postPortInitBulk(std::vector<Port*>& ports);
 
     bool setPortAdminStatus(Port &port, bool up);
     bool getPortAdminStatus(sai_object_id_t id, bool& up);
@@ -463,10 +470,14 @@ private:
     bool isSpeedSupported(const std::string& alias, sai_object_id_t port_id, sai_uint32_t speed);
     void getPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, PortSupportedSpeeds &supported_speeds);
     void initPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id);
+    void initPortSupportedSpeedsBulk(const std::vector<Port*>& ports);
+    void setPortSupportedSpeeds(const std::string& alias, sai_object_id_t port_id, const PortSupportedSpeeds &supported_speeds);
     // Get supported FEC modes on system side
     bool isFecModeSupported(const Port &port, sai_port_fec_mode_t fec_mode);
     sai_status_t getPortSupportedFecModes(PortSupportedFecModes &supported_fecmodes, sai_object_id_t port_id);
     void initPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id);
+    void initPortSupportedFecModesBulk(const std::vector<Port*>& ports);
+    void setPortSupportedFecModes(const std::string& alias, sai_object_id_t port_id, sai_status_t status, const PortSupportedFecModes &supported_fecmodes);
     task_process_status setPortSpeed(Port &port, sai_uint32_t speed);
     bool getPortSpeed(sai_object_id_t id, sai_uint32_t &speed);
     bool setGearboxPortsAttr(const Port &port, sai_port_attr_t id, void *value, bool override_fec=true);
@@ -476,8 +487,6 @@ private:
     bool getPortAdvSpeeds(const Port& port, bool remote, string& adv_speeds);
     task_process_status setPortAdvSpeeds(Port &port, std::set<sai_uint32_t> &speed_list);
 
-    bool getQueueTypeAndIndex(sai_object_id_t queue_id, sai_queue_type_t &type, uint8_t &index);
-
     bool m_isQueueMapGenerated = false;
     void generateQueueMapPerPort(const Port& port, FlexCounterQueueStates& queuesState, bool voq);
     bool m_isQueueFlexCountersAdded = false;
@@ -616,5 +625,14 @@ private:
     // Port OA helper
     PortHelper m_portHlpr;
     bool m_isWarmRestoreStage = false;
+
+    // Port discovery results persisted across restarts
+    PortCapabilityCache m_portCapCache;
+
+    // Startup phase timings in microseconds, published once port init is done
+    std::map<std::string, std::uint64_t> m_initPhaseTimes;
+    bool m_initPhaseTimesPublished = false;
+    void addInitPhaseTime(const std::string &phase, const std::chrono::steady_clock::time_point &start);
+    void publishInitPhaseTimes();
 };
 #endif /* SWSS_PORTSORCH_H */
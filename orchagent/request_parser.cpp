@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <exception>
+#include <mutex>
+#include <algorithm>
 
 #include "sai.h"
 #include "macaddress.h"
@@ -15,6 +17,83 @@
 using namespace std;
 using namespace swss;
 
+RequestParsePlan::RequestParsePlan(const request_description_t& request_description)
+{
+    for (const auto& item: request_description.attr_item_types)
+    {
+        names_.push_back(item.first);
+        types_.push_back(item.second);
+    }
+
+    for (const auto& attr: request_description.mandatory_attr_items)
+    {
+        auto it = std::find(names_.begin(), names_.end(), attr);
+        if (it == names_.end())
+        {
+            // Can never be satisfied, keep it to report on every SET request
+            unknown_mandatory_attrs_.push_back(attr);
+            continue;
+        }
+        mandatory_slots_.push_back(static_cast<size_t>(it - names_.begin()));
+    }
+
+    if (names_.empty())
+    {
+        return;
+    }
+
+    // Look for a seed which spreads all the names into distinct buckets,
+    // growing the table when no seed is found for the current size
+    size_t size = 1;
+    while (size < names_.size() * 2)
+    {
+        size <<= 1;
+    }
+
+    while (true)
+    {
+        mask_ = static_cast<uint32_t>(size - 1);
+        for (seed_ = 0; seed_ < 1024; seed_++)
+        {
+            buckets_.assign(size, -1);
+
+            bool collision = false;
+            for (size_t slot = 0; slot < names_.size(); slot++)
+            {
+                auto& bucket = buckets_[hash(names_[slot], seed_) & mask_];
+                if (bucket >= 0)
+                {
+                    collision = true;
+                    break;
+                }
+                bucket = static_cast<int>(slot);
+            }
+
+            if (!collision)
+            {
+                return;
+            }
+        }
+        size <<= 1;
+    }
+}
+
+shared_ptr<const RequestParsePlan> RequestParsePlan::get(const request_description_t& request_description)
+{
+    static mutex plans_mutex;
+    static unordered_map<const request_description_t *, shared_ptr<const RequestParsePlan>> plans;
+
+    lock_guard<mutex> lock(plans_mutex);
+
+    auto& plan = plans[&request_description];
+    if (!plan)
+    {
+        plan = make_shared<const RequestParsePlan>(request_description);
+    }
+
+    return plan;
+}
+
 
 void Request::parse(const KeyOpFieldsValuesTuple& request)
 {
@@ -34,14 +113,9 @@ void Request::clear()
 {
     operation_.clear();
     full_key_.clear();
-    attr_names_.clear();
-    key_item_strings_.clear();
-    key_item_mac_addresses_.clear();
-    attr_item_strings_.clear();
-    attr_item_bools_.clear();
-    attr_item_mac_addresses_.clear();
-    attr_item_packet_actions_.clear();
-    attr_item_string_list_.clear();
+    // Values stay in their slots and are overwritten by the next request
+    attr_present_.assign(attr_present_.size(), false);
+    attr_names_valid_ = false;
 
     is_parsed_ = false;
 }
@@ -60,16 +134,17 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
     full_key_ = kfvKey(request);
 
     // split the key by separator
-    std::vector<std::string> key_items;
+    auto& key_items = key_items_;
+    key_items.clear();
     size_t key_item_start = 0;
     size_t key_item_end = full_key_.find(key_separator_);
     while (key_item_end != std::string::npos)
     {
-        key_items.push_back(full_key_.substr(key_item_start, key_item_end - key_item_start));
+        key_items.emplace_back(full_key_, key_item_start, key_item_end - key_item_start);
         key_item_start = key_item_end + 1;
         key_item_end = full_key_.find(key_separator_, key_item_start);
     }
-    key_items.push_back(full_key_.substr(key_item_start, full_key_.length()));
+    key_items.emplace_back(full_key_, key_item_start, std::string::npos);
 
     /*
      * Attempt to parse an IPv6/MAC address only if the following conditions are met:
@@ -143,23 +218,25 @@ void Request::parseKey(const KeyOpFieldsValuesTuple& request)
 
 void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
 {
-    const auto not_found = std::end(request_description_.attr_item_types);
+    size_t number_of_attrs = 0;
 
-    for (auto i = kfvFieldsValues(request).begin();
-         i != kfvFieldsValues(request).end(); i++)
+    for (const auto& fv: kfvFieldsValues(request))
     {
-        if (fvField(*i) == "empty" || fvField(*i) == "NULL")
+        const auto& name = fvField(fv);
+        const auto& value = fvValue(fv);
+
+        if (name == "empty" || name == "NULL")
         {
             // if name of the attribute is 'empty' or 'NULL', just skip it.
             // it's used when we don't have any attributes, but we have to provide one for redis
             continue;
         }
-        const auto item = request_description_.attr_item_types.find(fvField(*i));
-        if (item == not_found)
+        const int slot = plan_->find(name);
+        if (slot < 0)
         {
             if (!relaxed_attr_parsing_)
             {
-                throw std::invalid_argument(std::string("Unknown attribute name: ") + fvField(*i));
+                throw std::invalid_argument(std::string("Unknown attribute name: ") + name);
             }
             else
             {
@@ -167,68 +244,79 @@ void Request::parseAttrs(const KeyOpFieldsValuesTuple& request)
             }
         }
 
-        attr_names_.insert(fvField(*i));
-        switch(item->second)
+        if (!attr_present_[slot])
+        {
+            attr_present_[slot] = true;
+            number_of_attrs++;
+        }
+
+        auto& item = attr_values_[slot];
+        switch(plan_->getType(slot))
         {
             case REQ_T_STRING:
-                attr_item_strings_[fvField(*i)] = fvValue(*i);
+                item.str = value;
                 break;
             case REQ_T_BOOL:
-                attr_item_bools_[fvField(*i)] = parseBool(fvValue(*i));
+                item.boolean = parseBool(value);
                 break;
             case REQ_T_MAC_ADDRESS:
-                attr_item_mac_addresses_[fvField(*i)] = parseMacAddress(fvValue(*i));
+                item.mac = parseMacAddress(value);
                 break;
             case REQ_T_PACKET_ACTION:
-                attr_item_packet_actions_[fvField(*i)] = parsePacketAction(fvValue(*i));
+                item.packet_action = parsePacketAction(value);
                 break;
             case REQ_T_VLAN:
-                attr_item_vlan_[fvField(*i)] = parseVlan(fvValue(*i));
+                item.vlan = parseVlan(value);
                 break;
             case REQ_T_IP:
-                attr_item_ip_[fvField(*i)] = parseIpAddress(fvValue(*i));
+                item.ip = parseIpAddress(value);
                 break;
             case REQ_T_IP_PREFIX:
-                attr_item_ip_prefix_[fvField(*i)] = parseIpPrefix(fvValue(*i));
+                item.ip_prefix = parseIpPrefix(value);
                 break;
             case REQ_T_UINT:
-                attr_item_uint_[fvField(*i)] = parseUint(fvValue(*i));
+                item.uint = parseUint(value);
                 break;
             case REQ_T_SET:
-                attr_item_set_[fvField(*i)] = parseSet(fvValue(*i));
+                item.set = parseSet(value);
                 break;
             case REQ_T_MAC_ADDRESS_LIST:
-                attr_item_mac_addresses_list_[fvField(*i)] = parseMacAddressList(fvValue(*i));
+                item.mac_list = parseMacAddressList(value);
                 break;
             case REQ_T_IP_LIST:
-                attr_item_ip_list_[fvField(*i)] = parseIpAddressList(fvValue(*i));
+                item.ip_list = parseIpAddressList(value);
                 break;
             case REQ_T_UINT_LIST:
-                attr_item_uint_list_[fvField(*i)] = parseUintList(fvValue(*i));
+                item.uint_list = parseUintList(value);
                 break;
             case REQ_T_BOOL_LIST:
-                attr_item_bool_list_[fvField(*i)] = parseBoolList(fvValue(*i));
+                item.bool_list = parseBoolList(value);
                 break;
             case REQ_T_STRING_LIST:
-                attr_item_string_list_[fvField(*i)] = parseStringList(fvValue(*i));
+                item.string_list = parseStringList(value);
                 break;
             default:
-                throw std::logic_error(std::string("Not implemented attribute type parser for attribute:") + fvField(*i));
+                throw std::logic_error(std::string("Not implemented attribute type parser for attribute:") + name);
         }
     }
 
-    if (operation_ == DEL_COMMAND && attr_names_.size() > 0)
+    if (operation_ == DEL_COMMAND && number_of_attrs > 0)
     {
         throw std::invalid_argument("Delete operation request contains attributes");
     }
 
     if (operation_ == SET_COMMAND)
     {
-        for (const auto& attr: request_description_.mandatory_attr_items)
+        if (!plan_->getUnknownMandatoryAttrs().empty())
+        {
+            throw std::invalid_argument(std::string("Mandatory attribute '") + plan_->getUnknownMandatoryAttrs().front() + std::string("' not found"));
+        }
+
+        for (auto slot: plan_->getMandatorySlots())
         {
-            if (attr_names_.find(attr) == std::end(attr_names_))
+            if (!attr_present_[slot])
             {
-                throw std::invalid_argument(std::string("Mandatory attribute '") + attr + std::string("' not found"));
+                throw std::invalid_argument(std::string("Mandatory attribute '") + plan_->getName(slot) + std::string("' not found"));
             }
         }
     }
@@ -358,7 +446,7 @@ uint16_t Request::parseVlan(const std::string& str)
 
 sai_packet_action_t Request::parsePacketAction(const std::string& str)
 {
-    std::unordered_map<std::string, sai_packet_action_t> m = {
+    static const std::unordered_map<std::string, sai_packet_action_t> m = {
         {"drop", SAI_PACKET_ACTION_DROP},
         {"forward", SAI_PACKET_ACTION_FORWARD},
         {"copy", SAI_PACKET_ACTION_COPY},
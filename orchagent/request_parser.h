@@ -6,6 +6,8 @@
 #include <sstream>
 #include <set>
 #include <vector>
+#include <memory>
+#include <stdexcept>
 
 typedef enum _request_types_t
 {
@@ -33,6 +35,81 @@ typedef struct _request_description
     std::vector<std::string> mandatory_attr_items;
 } request_description_t;
 
+// Attribute layout of a request type resolved once from its description.
+// Field names are looked up through a collision free hash table, and every
+// attribute gets a fixed slot in the flat value storage of the Request.
+class RequestParsePlan
+{
+public:
+    explicit RequestParsePlan(const request_description_t& request_description);
+
+    // Shared plan of the request description, built on the first use
+    static std::shared_ptr<const RequestParsePlan> get(const request_description_t& request_description);
+
+    // Slot of the attribute or -1 if the attribute isn't described
+    int find(const std::string& attr_name) const
+    {
+        if (buckets_.empty())
+        {
+            return -1;
+        }
+
+        int slot = buckets_[hash(attr_name, seed_) & mask_];
+        if (slot < 0 || names_[slot] != attr_name)
+        {
+            return -1;
+        }
+
+        return slot;
+    }
+
+    size_t size() const
+    {
+        return names_.size();
+    }
+
+    const std::string& getName(size_t slot) const
+    {
+        return names_[slot];
+    }
+
+    request_types_t getType(size_t slot) const
+    {
+        return types_[slot];
+    }
+
+    const std::vector<size_t>& getMandatorySlots() const
+    {
+        return mandatory_slots_;
+    }
+
+    const std::vector<std::string>& getUnknownMandatoryAttrs() const
+    {
+        return unknown_mandatory_attrs_;
+    }
+
+private:
+    static uint32_t hash(const std::string& str, uint32_t seed)
+    {
+        // FNV-1a
+        uint32_t h = 2166136261u ^ seed;
+        for (unsigned char c: str)
+        {
+            h ^= c;
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    std::vector<std::string> names_;
+    std::vector<request_types_t> types_;
+    std::vector<size_t> mandatory_slots_;
+    std::vector<std::string> unknown_mandatory_attrs_;
+    std::vector<int> buckets_;
+    uint32_t seed_ = 0;
+    uint32_t mask_ = 0;
+};
+
 class Request
 {
 public:
@@ -54,91 +131,103 @@ public:
     const std::string& getKeyString(int position) const
     {
         assert(is_parsed_);
-        return key_item_strings_.at(position);
+        return key_item_strings_[getKeyItemIndex(position, REQ_T_STRING)];
     }
 
     const swss::MacAddress& getKeyMacAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_mac_addresses_.at(position);
+        return key_item_mac_addresses_[getKeyItemIndex(position, REQ_T_MAC_ADDRESS)];
     }
 
     const swss::IpAddress& getKeyIpAddress(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_addresses_.at(position);
+        return key_item_ip_addresses_[getKeyItemIndex(position, REQ_T_IP)];
     }
 
     const swss::IpPrefix& getKeyIpPrefix(int position) const
     {
         assert(is_parsed_);
-        return key_item_ip_prefix_.at(position);
+        return key_item_ip_prefix_[getKeyItemIndex(position, REQ_T_IP_PREFIX)];
     }
 
     const uint64_t& getKeyUint(int position) const
     {
         assert(is_parsed_);
-        return key_item_uint_.at(position);
+        return key_item_uint_[getKeyItemIndex(position, REQ_T_UINT)];
     }
 
     const std::unordered_set<std::string>& getAttrFieldNames() const
     {
         assert(is_parsed_);
+        if (!attr_names_valid_)
+        {
+            attr_names_.clear();
+            for (size_t slot = 0; slot < attr_present_.size(); slot++)
+            {
+                if (attr_present_[slot])
+                {
+                    attr_names_.insert(plan_->getName(slot));
+                }
+            }
+            attr_names_valid_ = true;
+        }
         return attr_names_;
     }
 
     const std::string& getAttrString(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_strings_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_STRING).str;
     }
 
     bool getAttrBool(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_bools_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_BOOL).boolean;
     }
 
     const swss::MacAddress& getAttrMacAddress(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_mac_addresses_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_MAC_ADDRESS).mac;
     }
 
     sai_packet_action_t getAttrPacketAction(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_packet_actions_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_PACKET_ACTION).packet_action;
     }
 
     uint16_t getAttrVlan(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_vlan_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_VLAN).vlan;
     }
 
     swss::IpAddress getAttrIP(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_IP).ip;
     }
 
     swss::IpPrefix getAttrIpPrefix(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_prefix_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_IP_PREFIX).ip_prefix;
     }
 
     const uint64_t& getAttrUint(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_uint_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_UINT).uint;
     }
 
     const std::set<std::string>& getAttrSet(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_set_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_SET).set;
     }
 
     void setTableName(std::string& table_name)
@@ -155,31 +244,31 @@ public:
     const std::vector<swss::IpAddress>& getAttrIPList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_ip_list_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_IP_LIST).ip_list;
     }
 
     const std::vector<swss::MacAddress>& getAttrMacAddressList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_mac_addresses_list_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_MAC_ADDRESS_LIST).mac_list;
     }
 
     const std::vector<uint64_t>& getAttrUintList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_uint_list_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_UINT_LIST).uint_list;
     }
 
     const std::vector<bool> getAttrBoolList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_bool_list_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_BOOL_LIST).bool_list;
     }
 
     const std::vector<std::string>& getAttrStringList(const std::string& attr_name) const
     {
         assert(is_parsed_);
-        return attr_item_string_list_.at(attr_name);
+        return getAttrValue(attr_name, REQ_T_STRING_LIST).string_list;
     }
 
 protected:
@@ -188,7 +277,15 @@ protected:
           key_separator_(key_separator),
           is_parsed_(false),
           relaxed_attr_parsing_(relaxed_attr_parsing),
-          number_of_key_items_(request_description.key_item_types.size())
+          number_of_key_items_(request_description.key_item_types.size()),
+          plan_(RequestParsePlan::get(request_description)),
+          key_item_strings_(number_of_key_items_),
+          key_item_mac_addresses_(number_of_key_items_),
+          key_item_ip_addresses_(number_of_key_items_),
+          key_item_ip_prefix_(number_of_key_items_),
+          key_item_uint_(number_of_key_items_),
+          attr_present_(plan_->size(), false),
+          attr_values_(plan_->size())
     {
     }
 
@@ -219,30 +316,62 @@ private:
     // Enable if only interested in only a subset of attributes
     bool relaxed_attr_parsing_;
 
+    struct AttrValue
+    {
+        std::string str;
+        bool boolean = false;
+        swss::MacAddress mac;
+        sai_packet_action_t packet_action = SAI_PACKET_ACTION_DROP;
+        uint16_t vlan = 0;
+        swss::IpAddress ip;
+        swss::IpPrefix ip_prefix;
+        uint64_t uint = 0;
+        std::set<std::string> set;
+        std::vector<swss::IpAddress> ip_list;
+        std::vector<swss::MacAddress> mac_list;
+        std::vector<uint64_t> uint_list;
+        std::vector<bool> bool_list;
+        std::vector<std::string> string_list;
+    };
+
+    size_t getKeyItemIndex(int position, request_types_t type) const
+    {
+        if (position < 0 || static_cast<size_t>(position) >= number_of_key_items_
+            || request_description_.key_item_types[position] != type)
+        {
+            throw std::out_of_range(std::string("Key item is not present in the request: ") + std::to_string(position));
+        }
+        return static_cast<size_t>(position);
+    }
+
+    const AttrValue& getAttrValue(const std::string& attr_name, request_types_t type) const
+    {
+        int slot = plan_->find(attr_name);
+        if (slot < 0 || !attr_present_[slot] || plan_->getType(slot) != type)
+        {
+            throw std::out_of_range(std::string("Attribute is not present in the request: ") + attr_name);
+        }
+        return attr_values_[slot];
+    }
+
+    std::shared_ptr<const RequestParsePlan> plan_;
+
     std::string table_name_;
     std::string operation_;
     std::string full_key_;
-    std::unordered_map<int, std::string> key_item_strings_;
-    std::unordered_map<int, swss::MacAddress> key_item_mac_addresses_;
-    std::unordered_map<int, swss::IpAddress> key_item_ip_addresses_;
-    std::unordered_map<int, swss::IpPrefix> key_item_ip_prefix_;
-    std::unordered_map<int, uint64_t> key_item_uint_;
-    std::unordered_set<std::string> attr_names_;
-    // FIXME: Make one union with all the values, except string
-    std::unordered_map<std::string, std::string> attr_item_strings_;
-    std::unordered_map<std::string, bool> attr_item_bools_;
-    std::unordered_map<std::string, std::vector<bool>> attr_item_bool_list_;
-    std::unordered_map<std::string, swss::MacAddress> attr_item_mac_addresses_;
-    std::unordered_map<std::string, sai_packet_action_t> attr_item_packet_actions_;
-    std::unordered_map<std::string, uint16_t> attr_item_vlan_;
-    std::unordered_map<std::string, swss::IpAddress> attr_item_ip_;
-    std::unordered_map<std::string, swss::IpPrefix> attr_item_ip_prefix_;
-    std::unordered_map<std::string, uint64_t> attr_item_uint_;
-    std::unordered_map<std::string, std::set<std::string>> attr_item_set_;
-    std::unordered_map<std::string, std::vector<swss::IpAddress>> attr_item_ip_list_;
-    std::unordered_map<std::string, std::vector<swss::MacAddress>> attr_item_mac_addresses_list_;
-    std::unordered_map<std::string, std::vector<uint64_t>> attr_item_uint_list_;
-    std::unordered_map<std::string, std::vector<std::string>> attr_item_string_list_;
+    // Reused between requests to avoid reallocating the key items
+    std::vector<std::string> key_items_;
+    std::vector<std::string> key_item_strings_;
+    std::vector<swss::MacAddress> key_item_mac_addresses_;
+    std::vector<swss::IpAddress> key_item_ip_addresses_;
+    std::vector<swss::IpPrefix> key_item_ip_prefix_;
+    std::vector<uint64_t> key_item_uint_;
+    // Attribute values are stored by the slot of the parse plan
+    std::vector<bool> attr_present_;
+    std::vector<AttrValue> attr_values_;
+    // Built on demand from attr_present_
+    mutable std::unordered_set<std::string> attr_names_;
+    mutable bool attr_names_valid_ = false;
 };
 
 #endif // __REQUEST_PARSER_H
@@ -13,6 +13,8 @@
 #include "swssnet.h"
 #include "crmorch.h"
 #include "directory.h"
+#include "route_nexthop_codec.h"
+#include "route_latency.h"
 
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
@@ -37,6 +39,18 @@ extern string gMySwitchType;
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
 
+/*
+ * Routes to management, docker and loopback interfaces are not programmed.
+ * TODO: for route to loopback interface, the proper way is to create loopback
+ * interface and then create route pointing to it, so that we can traps packets
+ * to CPU
+ */
+static bool isExceptionIntf(const string &alias)
+{
+    return alias == "eth0" || alias == "docker0" ||
+           alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX);
+}
+
 RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames, SwitchOrch *switchOrch, NeighOrch *neighOrch, IntfsOrch *intfsOrch, VRFOrch *vrfOrch, FgNhgOrch *fgNhgOrch, Srv6Orch *srv6Orch, swss::ZmqServer *zmqServer) :
         gRouteBulker(sai_route_api, gMaxBulkSize),
         gLabelRouteBulker(sai_mpls_api, gMaxBulkSize),
@@ -125,6 +139,7 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     m_stateDb = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateDefaultRouteTb = unique_ptr<swss::Table>(new Table(m_stateDb.get(), STATE_ROUTE_TABLE_NAME));
+    m_routeLatency = unique_ptr<RouteLatencyRecorder>(new RouteLatencyRecorder(m_stateDb.get()));
 
     IpPrefix default_ip_prefix("0.0.0.0/0");
     updateDefRouteState("0.0.0.0/0");
@@ -602,6 +617,53 @@ bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t
     return true;
 }
 
+void RouteOrch::onShmRouteReload(ConsumerBase& consumer, const unordered_set<string>& keys)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Routes programmed, or still pending from records older than the
+     * reload, that are not in APPL_DB anymore are removed
+     */
+    vector<string> stale;
+    for (const auto& table : m_syncdRoutes)
+    {
+        string vrf;
+
+        if (table.first != gVirtualRouterId)
+        {
+            vrf = m_vrfOrch->getVRFname(table.first) + ":";
+        }
+
+        for (const auto& route : table.second)
+        {
+            string key = vrf + route.first.to_string();
+            /* Host routes may be written without the prefix length */
+            if (keys.count(key) ||
+                (route.first.isFullMask() && keys.count(vrf + route.first.getIp().to_string())))
+            {
+                continue;
+            }
+            stale.push_back(key);
+        }
+    }
+
+    for (const auto& it : consumer.m_toSync)
+    {
+        if (kfvOp(it.second) == SET_COMMAND && !keys.count(it.first))
+        {
+            stale.push_back(it.first);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Removing %zu routes not in APPL_DB after the route ring reload", stale.size());
+
+    for (const auto& key : stale)
+    {
+        consumer.addToSync(KeyOpFieldsValuesTuple(key, DEL_COMMAND, vector<FieldValueTuple>()));
+    }
+}
+
 void RouteOrch::doTask(ConsumerBase& consumer)
 {
     SWSS_LOG_ENTER();
@@ -631,6 +693,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 >,
                 RouteBulkContext
         >                                       toBulk;
+        bool latency_sampled = false;
 
         // Add or remove routes with a route bulker
         while (it != consumer.m_toSync.end())
@@ -726,6 +789,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             {
                 string ips;
                 string aliases;
+                string packed_nhs;
                 string mpls_nhs;
                 string vni_labels;
                 string remote_macs;
@@ -751,6 +815,9 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                     if (fvField(i) == "ifname" && fvValue(i) != "")
                         aliases = fvValue(i);
 
+                    if (fvField(i) == ROUTE_PACKED_NEXTHOP_FIELD && fvValue(i) != "")
+                        packed_nhs = fvValue(i);
+
                     if (fvField(i) == "mpls_nh" && fvValue(i) != "")
                         mpls_nhs = fvValue(i);
 
@@ -790,6 +857,13 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                     if (fvField(i) == "fallback_to_default_route")
                         fallback_to_default_route = fvValue(i) == "true";
 
+                    if (fvField(i) == ROUTE_LATENCY_TS_FIELD && fvValue(i) != "")
+                    {
+                        ctx.fpm_ts = strtoull(fvValue(i).c_str(), nullptr, 10);
+                        ctx.orch_ts = RouteLatencyRecorder::now();
+                        latency_sampled = true;
+                    }
+
                     if (fvField(i) == "vpn_sid" && fvValue(i) != "") {
                         srv6_vpn_sids = fvValue(i);
                         srv6_nh = true;
@@ -807,7 +881,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                  * A route should not fill both nexthop_group and ips /
                  * aliases.
                  */
-                if (!nhg_index.empty() && (!ips.empty() || !aliases.empty()))
+                if (!nhg_index.empty() && (!ips.empty() || !aliases.empty() || !packed_nhs.empty()))
                 {
                     SWSS_LOG_ERROR("Route %s has both nexthop_group and ips/aliases", key.c_str());
                     it = consumer.m_toSync.erase(it);
@@ -835,8 +909,86 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                 bool l3Vni = true;
                 uint32_t vni = 0;
 
+                /*
+                 * Next hops packed by fpmsyncd on the ZMQ channel are decoded
+                 * straight into the next hop keys.
+                 */
+                if (nhg_index.empty() && !packed_nhs.empty())
+                {
+                    vector<PackedRouteNextHop> packed_nhv;
+                    if (!unpackRouteNextHops(packed_nhs, ip_prefix.isV4(), packed_nhv, overlay_nh) || packed_nhv.empty())
+                    {
+                        SWSS_LOG_ERROR("Skip route %s, it has an invalid %s field", key.c_str(), ROUTE_PACKED_NEXTHOP_FIELD);
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+
+                    if (overlay_nh)
+                    {
+                        for (const auto &packed_nh : packed_nhv)
+                        {
+                            if (!m_vrfOrch->isL3VniVlan(packed_nh.vni))
+                            {
+                                SWSS_LOG_WARN("Route %s is received on non L3 VNI %u", key.c_str(), packed_nh.vni);
+                                l3Vni = false;
+                                break;
+                            }
+                        }
+
+                        if (!l3Vni)
+                        {
+                            it++;
+                            continue;
+                        }
+                    }
+
+                    excp_intfs_flag = any_of(packed_nhv.begin(), packed_nhv.end(),
+                                             [](const PackedRouteNextHop &packed_nh) { return isExceptionIntf(packed_nh.ifname); });
+                    if (excp_intfs_flag)
+                    {
+                        if (removeRoute(ctx))
+                            it = consumer.m_toSync.erase(it);
+                        else
+                            it++;
+
+                        /* Publish route state to advertise routes to Loopback interface */
+                        publishRouteState(ctx);
+                        continue;
+                    }
+
+                    vector<NextHopKey> nhv;
+                    nhv.reserve(packed_nhv.size());
+                    alsv.reserve(packed_nhv.size());
+                    for (const auto &packed_nh : packed_nhv)
+                    {
+                        const auto &ip = packed_nh.ip_address;
+                        string alias = packed_nh.ifname;
+                        alsv.push_back(packed_nh.ifname);
+
+                        if (overlay_nh)
+                        {
+                            nhv.emplace_back(ip, "vni" + alias, packed_nh.router_mac, packed_nh.vni, overlay_nh);
+                            continue;
+                        }
+
+                        /* Same alias resolution as NextHopKey does for ip@alias */
+                        if (alias.empty() || (alias == "tun0" && !ip.isZero()))
+                        {
+                            alias = gIntfsOrch->getRouterIntfsAlias(ip);
+                        }
+                        else if (!alias.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+                        {
+                            alias = gIntfsOrch->getRouterIntfsAlias(ip, alias);
+                        }
+
+                        nhv.emplace_back(ip, alias);
+                        nhv.back().weight = packed_nh.weight;
+                    }
+
+                    nhg = blackhole ? NextHopGroupKey() : NextHopGroupKey(nhv, overlay_nh);
+                }
                 /* Check if the next hop group is owned by the NhgOrch. */
-                if (nhg_index.empty())
+                else if (nhg_index.empty())
                 {
                     ipv = tokenize(ips, ',');
                     alsv = tokenize(aliases, ',');
@@ -894,20 +1046,7 @@ void RouteOrch::doTask(ConsumerBase& consumer)
                         }
                     }
 
-                    for (auto alias : alsv)
-                    {
-                        /* skip route to management, docker, loopback
-                        * TODO: for route to loopback interface, the proper
-                        * way is to create loopback interface and then create
-                        * route pointing to it, so that we can traps packets to
-                        * CPU */
-                        if (alias == "eth0" || alias == "docker0" ||
-                            alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
-                        {
-                            excp_intfs_flag = true;
-                            break;
-                        }
-                    }
+                    excp_intfs_flag = any_of(alsv.begin(), alsv.end(), isExceptionIntf);
 
                     // TODO: cannot trust m_portsOrch->getPortIdByAlias because sometimes alias is empty
                     if (excp_intfs_flag)
@@ -1114,7 +1253,9 @@ void RouteOrch::doTask(ConsumerBase& consumer)
         }
 
         // Flush the route bulker, so routes will be written to syncd and ASIC
+        uint64_t bulk_ts = latency_sampled ? RouteLatencyRecorder::now() : 0;
         gRouteBulker.flush();
+        uint64_t sai_ts = latency_sampled ? RouteLatencyRecorder::now() : 0;
 
         // Go through the bulker results
         auto it_prev = consumer.m_toSync.begin();
@@ -1163,6 +1304,11 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             route_entry.vr_id = vrf_id;
             route_entry.switch_id = gSwitchId;
             copy(route_entry.destination, ip_prefix);
+
+            if (ctx.fpm_ts && op == SET_COMMAND && object_statuses.front() == SAI_STATUS_SUCCESS)
+            {
+                recordRouteLatency(ctx, bulk_ts, sai_ts);
+            }
             
             if (op == SET_COMMAND)
             {
@@ -1224,6 +1370,9 @@ void RouteOrch::doTask(ConsumerBase& consumer)
             }
         }
 
+        // Export the latency histograms, rate limited, also picks up samples held back earlier
+        m_routeLatency->flush();
+
         /* Remove next hop group if the reference count decreases to zero */
         for (auto& it_nhg : m_bulkNhgReducedRefCnt)
         {
@@ -3179,6 +3328,47 @@ void RouteOrch::publishRouteState(const RouteBulkContext& ctx, const ReturnCode&
     m_publisher.publish(APP_ROUTE_TABLE_NAME, ctx.key, fvs, status, replace);
 }
 
+bool RouteOrch::bake()
+{
+    SWSS_LOG_ENTER();
+
+    bool result = Orch::bake();
+
+    // Latency stamps read back from APPL_DB were taken before the restart
+    for (auto &it : m_consumerMap)
+    {
+        auto consumer = dynamic_cast<ConsumerBase *>(it.second.get());
+        if (consumer == nullptr || consumer->getTableName() != APP_ROUTE_TABLE_NAME)
+        {
+            continue;
+        }
+
+        for (auto &entry : consumer->m_toSync)
+        {
+            auto &fvs = kfvFieldsValues(entry.second);
+            fvs.erase(remove_if(fvs.begin(), fvs.end(), [](const FieldValueTuple &fv) {
+                return fvField(fv) == ROUTE_LATENCY_TS_FIELD;
+            }), fvs.end());
+        }
+    }
+
+    return result;
+}
+
+void RouteOrch::recordRouteLatency(const RouteBulkContext& ctx, uint64_t bulk_ts, uint64_t sai_ts)
+{
+    /* Skip timestamps replayed from APPL_DB, e.g. after a restart */
+    if (ctx.orch_ts < ctx.fpm_ts || ctx.orch_ts - ctx.fpm_ts > ROUTE_LATENCY_MAX_AGE_US)
+    {
+        return;
+    }
+
+    m_routeLatency->record("fpm_to_orch", ctx.fpm_ts, ctx.orch_ts);
+    m_routeLatency->record("orch_to_bulk", ctx.orch_ts, bulk_ts);
+    m_routeLatency->record("sai_bulk", bulk_ts, sai_ts);
+    m_routeLatency->record("fpm_to_sai", ctx.fpm_ts, sai_ts);
+}
+
 inline bool RouteOrch::isVipRoute(const IpPrefix &ipPrefix, const NextHopGroupKey &nextHops)
 {
     bool res = true;
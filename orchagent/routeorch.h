@@ -18,6 +18,7 @@
 #include <map>
 #include "zmqorch.h"
 #include "zmqserver.h"
+#include "route_latency.h"
 #include <unordered_map>
 
 /* Maximum next hop group number */
@@ -154,9 +155,12 @@ struct RouteBulkContext
 
     Constraint                          retry_cst;
 
+    uint64_t                            fpm_ts;    // Sampled fpmsyncd receive time
+    uint64_t                            orch_ts;   // Time the sampled route was picked up
+
     RouteBulkContext(const std::string& key, bool is_set)
         : key(key), excp_intfs_flag(false), using_temp_nhg(false), is_set(is_set),
-          fallback_to_default_route(false), retry_cst(DUMMY_CONSTRAINT)
+          fallback_to_default_route(false), retry_cst(DUMMY_CONSTRAINT), fpm_ts(0), orch_ts(0)
     {
     }
 
@@ -177,6 +181,8 @@ struct RouteBulkContext
         protocol.clear();
         fallback_to_default_route = false;
         retry_cst = DUMMY_CONSTRAINT;
+        fpm_ts = 0;
+        orch_ts = 0;
     }
 };
 
@@ -228,6 +234,7 @@ public:
     bool isRefCounterZero(const NextHopGroupKey&) const;
 
     void flushRouteBulker() { gRouteBulker.flush(); }
+    bool bake() override;
     int getNextHopGroupRefCount(const NextHopGroupKey& key) { return m_syncdNextHopGroups[key].ref_count; }
     std::set<std::pair<NextHopGroupKey, sai_object_id_t>> &getBulkNhgReducedRefCnt() { return m_bulkNhgReducedRefCnt; }
 
@@ -287,6 +294,7 @@ private:
     std::set<NextHopKey> v6_active_default_route_nhops;
     shared_ptr<DBConnector> m_stateDb;
     unique_ptr<swss::Table> m_stateDefaultRouteTb;
+    unique_ptr<RouteLatencyRecorder> m_routeLatency;
 
     RouteTables m_syncdRoutes;
     LabelRouteTables m_syncdLabelRoutes;
@@ -318,10 +326,12 @@ private:
 
     void doTask(ConsumerBase& consumer);
     void doLabelTask(ConsumerBase& consumer);
+    void onShmRouteReload(ConsumerBase& consumer, const std::unordered_set<std::string>& keys) override;
 
     const NhgBase &getNhg(const std::string& nhg_index);
 
     void publishRouteState(const RouteBulkContext& ctx, const ReturnCode& status = ReturnCode(SAI_STATUS_SUCCESS));
+    void recordRouteLatency(const RouteBulkContext& ctx, uint64_t bulk_ts, uint64_t sai_ts);
 
     bool isVipRoute(const IpPrefix &ipPrefix, const NextHopGroupKey &nextHops);
     void createVipRouteSubnetDecapTerm(const IpPrefix &ipPrefix);
@@ -11,6 +11,8 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <map>
+#include <algorithm>
 #include "portsorch.h"
 #include "vrforch.h"
 
@@ -49,6 +51,7 @@ struct SaiOffloadHandlerTraits<sai_bfd_api_t>
     using get_session_stats_ext_fn = sai_get_bfd_session_stats_ext_fn;
     using clear_session_stats_fn = sai_clear_bfd_session_stats_fn;
     using notif_t = sai_bfd_session_state_notification_t;
+    static constexpr sai_object_type_t object_type = SAI_OBJECT_TYPE_BFD_SESSION;
 };
 
 template<>
@@ -63,6 +66,7 @@ struct SaiOffloadHandlerTraits<sai_icmp_echo_api_t>
     using get_session_stats_ext_fn = sai_get_icmp_echo_session_stats_ext_fn;
     using clear_session_stats_fn = sai_clear_icmp_echo_session_stats_fn;
     using notif_t = sai_icmp_echo_session_state_notification_t;
+    static constexpr sai_object_type_t object_type = SAI_OBJECT_TYPE_ICMP_ECHO_SESSION;
 };
 
 /**
@@ -85,6 +89,267 @@ const std::unordered_map<SaiOffloadHandlerStatus, std::string> SaiOffloadStatusS
     {SaiOffloadHandlerStatus::FAILED_INVALID_ENTRY, "FAILED_INVALID_ENTRY"}
 };
 
+// STATE_DB table with the state notification batch stats of each offload session type
+#define STATE_OFFLOAD_SESSION_NOTIFICATION_TABLE_NAME "OFFLOAD_SESSION_NOTIFICATION"
+
+/**
+ *@struct SaiOffloadSessionStateBatch
+ *
+ *@brief States of each session in a batch of state change notifications,
+ *       in the order they were notified
+ */
+template <typename S>
+struct SaiOffloadSessionStateBatch
+{
+    /**
+     *@method add
+     *
+     *@brief Add a session state from a notification, a state repeating
+     *       the previous one of the session is dropped
+     */
+    void add(sai_object_id_t id, S state)
+    {
+        auto& session_states = states[id];
+        if (session_states.empty() || session_states.back() != state)
+        {
+            session_states.push_back(state);
+        }
+    }
+
+    /**
+     *@method transitions
+     *
+     *@brief States the session went through from its current state
+     *
+     *@param current(in)         state of the session before the batch
+     *       session_states(in)  states of the session in the batch
+     *
+     *@return states that differ from the one before them, the last one
+     *        is the state of the session after the batch
+     */
+    static std::vector<S> transitions(S current, const std::vector<S>& session_states)
+    {
+        std::vector<S> result;
+        for (auto state : session_states)
+        {
+            if (state != current)
+            {
+                result.push_back(state);
+                current = state;
+            }
+        }
+        return result;
+    }
+
+    std::map<sai_object_id_t, std::vector<S>> states;
+    size_t notifications = 0;
+};
+
+/**
+ *@method publish_notification_batch
+ *
+ *@brief Write the stats of a batch of session state notifications
+ *
+ *@param table(in)               STATE_OFFLOAD_SESSION_NOTIFICATION_TABLE_NAME table
+ *       key(in)                 session type
+ *       notifications(in)       notifications in the batch
+ *       changes(in)             sessions whose state was written for the batch
+ *       coalesced(in)           transitions not written, a session that went
+ *                               UP->DOWN->UP in the batch has its final UP
+ *                               written and the DOWN counted here
+ *       process_us(in)          time from draining the batch to having its
+ *                               STATE_DB writes queued, the notification
+ *                               carries no time it was raised at
+ *       max_process_us(in/out)  highest process_us seen so far
+ */
+inline void publish_notification_batch(swss::Table& table, const std::string& key, size_t notifications,
+        size_t changes, uint64_t coalesced, uint64_t process_us, uint64_t& max_process_us)
+{
+    max_process_us = std::max(max_process_us, process_us);
+
+    std::vector<swss::FieldValueTuple> fvs = {
+        {"notifications", std::to_string(notifications)},
+        {"state_changes", std::to_string(changes)},
+        {"coalesced_transitions", std::to_string(coalesced)},
+        {"batch_process_us", std::to_string(process_us)},
+        {"max_batch_process_us", std::to_string(max_process_us)}
+    };
+    table.set(key, fvs);
+}
+
+/**
+ *@class SaiOffloadSessionBulker
+ *
+ *@brief Collects offload session creates and removes and programs them
+ *       with the generic SAI bulk object API, falling back to one call
+ *       per session when the object type has no bulk support
+ */
+template <typename T>
+class SaiOffloadSessionBulker {
+public:
+    using Tapis = SaiOffloadHandlerTraits<T>;
+
+    using bulk_create_fn = sai_status_t (*)(sai_object_id_t, sai_object_type_t, uint32_t, const uint32_t *,
+            const sai_attribute_t **, sai_bulk_op_error_mode_t, sai_object_id_t *, sai_status_t *);
+    using bulk_remove_fn = sai_status_t (*)(sai_object_type_t, uint32_t, const sai_object_id_t *,
+            sai_bulk_op_error_mode_t, sai_status_t *);
+
+    // max_bulk_size 0 sends all queued sessions in one call
+    SaiOffloadSessionBulker(typename Tapis::create_session_fn create_fn,
+                            typename Tapis::remove_session_fn remove_fn,
+                            size_t max_bulk_size,
+                            bulk_create_fn bulk_create = sai_bulk_object_create,
+                            bulk_remove_fn bulk_remove = sai_bulk_object_remove) :
+        m_create_fn(create_fn),
+        m_remove_fn(remove_fn),
+        m_bulk_create_fn(bulk_create),
+        m_bulk_remove_fn(bulk_remove),
+        m_max_bulk_size(max_bulk_size ? max_bulk_size : SIZE_MAX)
+    {
+    }
+
+    /**
+     *@method create_entry
+     *
+     *@brief Queue a session create, the attributes must stay valid until flush
+     *
+     *@param object_id(out)     session id, set by flush
+     *       object_status(out) create status, set by flush
+     *       attrs(in)          session attributes
+     */
+    void create_entry(sai_object_id_t *object_id, sai_status_t *object_status, const std::vector<sai_attribute_t> *attrs)
+    {
+        *object_id = SAI_NULL_OBJECT_ID;
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+        m_creating.push_back({object_id, object_status, attrs});
+    }
+
+    /**
+     *@method remove_entry
+     *
+     *@brief Queue a session remove
+     *
+     *@param object_status(out) remove status, set by flush
+     *       object_id(in)      session id to remove
+     */
+    void remove_entry(sai_status_t *object_status, sai_object_id_t object_id)
+    {
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+        m_removing.push_back({object_id, object_status});
+    }
+
+    /**
+     *@method flush
+     *
+     *@brief Remove and then create the queued sessions
+     */
+    void flush()
+    {
+        for (size_t first = 0; first < m_removing.size(); first += m_max_bulk_size)
+        {
+            flush_removing(first, std::min(m_removing.size(), first + m_max_bulk_size));
+        }
+
+        for (size_t first = 0; first < m_creating.size(); first += m_max_bulk_size)
+        {
+            flush_creating(first, std::min(m_creating.size(), first + m_max_bulk_size));
+        }
+
+        m_removing.clear();
+        m_creating.clear();
+    }
+
+    size_t creating_entries_count() const { return m_creating.size(); }
+    size_t removing_entries_count() const { return m_removing.size(); }
+
+private:
+    struct CreatingEntry {
+        sai_object_id_t *object_id;
+        sai_status_t *object_status;
+        const std::vector<sai_attribute_t> *attrs;
+    };
+
+    struct RemovingEntry {
+        sai_object_id_t object_id;
+        sai_status_t *object_status;
+    };
+
+    static bool bulk_not_supported(sai_status_t status)
+    {
+        return status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    void flush_creating(size_t first, size_t last)
+    {
+        uint32_t count = static_cast<uint32_t>(last - first);
+        std::vector<uint32_t> attr_counts;
+        std::vector<const sai_attribute_t *> attr_lists;
+        std::vector<sai_object_id_t> object_ids(count, SAI_NULL_OBJECT_ID);
+        std::vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+        for (size_t i = first; i < last; i++)
+        {
+            attr_counts.push_back(static_cast<uint32_t>(m_creating[i].attrs->size()));
+            attr_lists.push_back(m_creating[i].attrs->data());
+        }
+
+        sai_status_t status = m_bulk_create_fn(gSwitchId, Tapis::object_type, count,
+                attr_counts.data(), attr_lists.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                object_ids.data(), statuses.data());
+
+        for (size_t i = first; i < last; i++)
+        {
+            auto& entry = m_creating[i];
+            if (bulk_not_supported(status))
+            {
+                *entry.object_status = m_create_fn(entry.object_id, gSwitchId,
+                        static_cast<uint32_t>(entry.attrs->size()), entry.attrs->data());
+            }
+            else
+            {
+                *entry.object_id = object_ids[i - first];
+                *entry.object_status = statuses[i - first];
+            }
+        }
+    }
+
+    void flush_removing(size_t first, size_t last)
+    {
+        uint32_t count = static_cast<uint32_t>(last - first);
+        std::vector<sai_object_id_t> object_ids;
+        std::vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+        for (size_t i = first; i < last; i++)
+        {
+            object_ids.push_back(m_removing[i].object_id);
+        }
+
+        sai_status_t status = m_bulk_remove_fn(Tapis::object_type, count, object_ids.data(),
+                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+
+        for (size_t i = first; i < last; i++)
+        {
+            auto& entry = m_removing[i];
+            if (bulk_not_supported(status))
+            {
+                *entry.object_status = m_remove_fn(entry.object_id);
+            }
+            else
+            {
+                *entry.object_status = statuses[i - first];
+            }
+        }
+    }
+
+    typename Tapis::create_session_fn m_create_fn;
+    typename Tapis::remove_session_fn m_remove_fn;
+    bulk_create_fn m_bulk_create_fn;
+    bulk_remove_fn m_bulk_remove_fn;
+    size_t m_max_bulk_size;
+    std::vector<CreatingEntry> m_creating;
+    std::vector<RemovingEntry> m_removing;
+};
+
 /**
  *@struct SaiOffloadSessionHandler
  *
@@ -122,6 +387,31 @@ struct SaiOffloadSessionHandler {
      */
     SaiOffloadHandlerStatus create(const fv_vector_t& fv_data);
 
+    /**
+     *@method queue_create
+     *
+     *@brief Validate the session parameters and queue the session on a bulker,
+     *       complete_create gives the result once the bulker is flushed
+     *
+     *@param bulker(in)   bulker the session create is queued on
+     *       fv_data(in)  session parameters as Field Value tuples
+     *
+     *@return SUCCESS_VALID_ENTRY session parameters valid and session queued
+     *        FAILED_INVALID_ENTRY session parameters are invalid
+     *        FAILED_VALID_ENTRY session can't be created for valid key
+     *        RETRY_VALID_ENTRY retry session creation for valid key
+     */
+    SaiOffloadHandlerStatus queue_create(SaiOffloadSessionBulker<T>& bulker, const fv_vector_t& fv_data);
+
+    /**
+     *@method complete_create
+     *
+     *@brief Result of a session create queued by queue_create
+     *
+     *@return same as create
+     */
+    SaiOffloadHandlerStatus complete_create();
+
     /**
      *@method handle_hwlookup
      *
@@ -147,6 +437,26 @@ struct SaiOffloadSessionHandler {
      */
     SaiOffloadHandlerStatus remove(sai_object_id_t id);
 
+    /**
+     *@method queue_remove
+     *
+     *@brief Queue the session remove on a bulker, complete_remove gives the
+     *       result once the bulker is flushed
+     *
+     *@param bulker(in)  bulker the session remove is queued on
+     *       id(in)      sai session object id to delete
+     */
+    void queue_remove(SaiOffloadSessionBulker<T>& bulker, sai_object_id_t id);
+
+    /**
+     *@method complete_remove
+     *
+     *@brief Result of a session remove queued by queue_remove
+     *
+     *@return same as remove
+     */
+    SaiOffloadHandlerStatus complete_remove();
+
     /**
      *@method update
      *
@@ -215,9 +525,29 @@ struct SaiOffloadSessionHandler {
         return m_session_id;
     }
 
+    /**
+     *@method get_key
+     *
+     *@brief Returns the session key
+     *
+     *@return reference to string of session key
+     */
+    inline const std::string& get_key() {
+        return m_key;
+    }
+
 protected:
     SaiOffloadSessionHandler() = default;
 
+    /**
+     *@method prepare_create
+     *
+     *@brief Fill the session attributes for create from the session parameters
+     */
+    SaiOffloadHandlerStatus prepare_create(const fv_vector_t& fv_data);
+    SaiOffloadHandlerStatus handle_create_status(sai_status_t status);
+    SaiOffloadHandlerStatus handle_remove_status(sai_status_t status);
+
     typename Tapis::create_session_fn           sai_create_session;
     typename Tapis::remove_session_fn           sai_remove_session;
     typename Tapis::set_session_attribute_fn    sai_set_session_attrib;
@@ -241,6 +571,8 @@ protected:
     sai_attr_id_val_map_t m_attr_val_map;
     // attribute vector used for session creation
     std::vector<sai_attribute_t> m_attrs;
+    // status of the create or remove queued on a bulker
+    sai_status_t m_bulk_status;
 };
 
 template <class SaiOrchHandlerClass, typename T>
@@ -251,9 +583,8 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::init(t
 }
 
 template <class SaiOrchHandlerClass, typename T>
-SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create(const fv_vector_t& fv_data)
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::prepare_create(const fv_vector_t& fv_data)
 {
-    constexpr auto atype = static_cast<sai_api_t>(SaiOrchHandlerClass::SAI_API_TYPE::API_TYPE);
     constexpr auto& name = static_cast<SaiOrchHandlerClass *>(this)->m_name;
     auto& handler_map = static_cast<SaiOrchHandlerClass *>(this)->m_handler_map;
 
@@ -303,9 +634,50 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create
         m_attrs.emplace_back(attr);
     }
 
+    return SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY;
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::create(const fv_vector_t& fv_data)
+{
+    auto prepare_status = prepare_create(fv_data);
+    if (prepare_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
+    {
+        return prepare_status;
+    }
+
     m_session_id = SAI_NULL_OBJECT_ID;
     sai_status_t status = sai_create_session(&m_session_id, gSwitchId, (uint32_t)m_attrs.size(), m_attrs.data());
 
+    return handle_create_status(status);
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::queue_create(SaiOffloadSessionBulker<T>& bulker, const fv_vector_t& fv_data)
+{
+    auto prepare_status = prepare_create(fv_data);
+    if (prepare_status != SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY)
+    {
+        return prepare_status;
+    }
+
+    bulker.create_entry(&m_session_id, &m_bulk_status, &m_attrs);
+
+    return SaiOffloadHandlerStatus::SUCCESS_VALID_ENTRY;
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::complete_create()
+{
+    return handle_create_status(m_bulk_status);
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::handle_create_status(sai_status_t status)
+{
+    constexpr auto atype = static_cast<sai_api_t>(SaiOrchHandlerClass::SAI_API_TYPE::API_TYPE);
+    constexpr auto& name = static_cast<SaiOrchHandlerClass *>(this)->m_name;
+
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("%s, SAI create offload session failed %s, rv:%d", name.c_str(), m_key.c_str(), status);
@@ -414,11 +786,31 @@ SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::handle
 
 template <class SaiOrchHandlerClass, typename T>
 SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::remove(sai_object_id_t id)
+{
+    sai_status_t status = sai_remove_session(id);
+
+    return handle_remove_status(status);
+}
+
+template <class SaiOrchHandlerClass, typename T>
+void SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::queue_remove(SaiOffloadSessionBulker<T>& bulker, sai_object_id_t id)
+{
+    m_session_id = id;
+    bulker.remove_entry(&m_bulk_status, id);
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::complete_remove()
+{
+    return handle_remove_status(m_bulk_status);
+}
+
+template <class SaiOrchHandlerClass, typename T>
+SaiOffloadHandlerStatus SaiOffloadSessionHandler<SaiOrchHandlerClass, T>::handle_remove_status(sai_status_t status)
 {
     constexpr auto& name = static_cast<SaiOrchHandlerClass *>(this)->m_name;
     constexpr auto atype = static_cast<sai_api_t>(SaiOrchHandlerClass::SAI_API_TYPE::API_TYPE);
 
-    sai_status_t status = sai_remove_session(id);
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("%s, Failed to remove offload session %s, rv:%d", name.c_str(),
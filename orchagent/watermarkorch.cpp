@@ -4,6 +4,7 @@
 #include "notifier.h"
 #include "converter.h"
 #include "bufferorch.h"
+#include "counterrateorch.h"
 #include <inttypes.h>
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
@@ -18,6 +19,7 @@
 
 extern PortsOrch *gPortsOrch;
 extern BufferOrch *gBufferOrch;
+extern CounterRateOrch *gCounterRateOrch;
 
 
 WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
@@ -137,6 +139,10 @@ void WatermarkOrch::handleFcConfigUpdate(const std::string &key, const std::vect
         {
             m_telemetryTimer->start();
         }
+        if (gCounterRateOrch)
+        {
+            gCounterRateOrch->setWatermarkStatus(m_wmStatus);
+        }
     SWSS_LOG_DEBUG("Status of WMs: %u", m_wmStatus);
     }
 }
@@ -331,6 +337,10 @@ void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_objec
     for (sai_object_id_t id: obj_ids)
     {
         table->set(sai_serialize_object_id(id), vfvt);
+        if (gCounterRateOrch)
+        {
+            gCounterRateOrch->clearWatermark(table->getTableName(), sai_serialize_object_id(id), wm_name);
+        }
     }
 }
 
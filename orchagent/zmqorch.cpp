@@ -1,4 +1,5 @@
 #include "zmqorch.h"
+#include "warm_restart.h"
 
 using namespace swss;
 using namespace std;
@@ -11,8 +12,8 @@ void ZmqConsumer::execute()
 
     auto table = static_cast<swss::ZmqConsumerStateTable*>(getSelectable());
 
-    std::deque<KeyOpFieldsValuesTuple> entries;
-    table->pops(entries);
+    auto entries = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+    table->pops(*entries);
     addToSync(entries);
 
     drain();
@@ -20,10 +21,35 @@ void ZmqConsumer::execute()
 
 void ZmqConsumer::drain()
 {
-    if (!m_toSync.empty())
-        (static_cast<ZmqOrch*>(m_orch))->doTask(*this);
+    drainPending([this]() { (static_cast<ZmqOrch*>(m_orch))->doTask(*this); });
 }
 
+void ShmRouteConsumer::execute()
+{
+    SWSS_LOG_ENTER();
+
+    auto table = static_cast<swss::ShmRouteConsumerStateTable*>(getSelectable());
+
+    auto entries = std::make_shared<std::deque<KeyOpFieldsValuesTuple>>();
+    table->pops(*entries);
+    if (table->reloaded())
+    {
+        std::unordered_set<std::string> keys;
+        for (const auto &entry : *entries)
+        {
+            keys.insert(kfvKey(entry));
+        }
+        (static_cast<ZmqOrch*>(m_orch))->onShmRouteReload(*this, keys);
+    }
+    addToSync(entries);
+
+    drain();
+}
+
+void ShmRouteConsumer::drain()
+{
+    drainPending([this]() { (static_cast<ZmqOrch*>(m_orch))->doTask(*this); });
+}
 
 ZmqOrch::ZmqOrch(DBConnector *db, const vector<string> &tableNames, ZmqServer *zmqServer)
 : Orch()
@@ -64,6 +90,16 @@ void ZmqOrch::addConsumer(DBConnector *db, string tableName, int pri, ZmqServer
     }
 }
 
+void ZmqOrch::addShmRouteConsumer(DBConnector *db, const string &tableName, int pri, shared_ptr<ShmRouteRing> ring)
+{
+    SWSS_LOG_NOTICE("ShmRouteConsumer initialize for: %s", tableName.c_str());
+
+    // fpmsyncd may have written routes to the ring before it was reset, load them from APPL_DB.
+    // On warm start bake() already loads the table through the Redis consumer.
+    bool reload = !WarmStart::isWarmStart();
+    addExecutor(new ShmRouteConsumer(new ShmRouteConsumerStateTable(db, tableName, ring, gBatchSize, pri, reload), this, tableName + "_SHM"));
+}
+
 void ZmqOrch::doTask(Consumer &consumer)
 {
     // When ZMQ disabled, forward data from Consumer
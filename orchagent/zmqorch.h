@@ -2,8 +2,10 @@
 
 #include <vector>
 #include <string>
+#include <unordered_set>
 #include <orch.h>
 #include "zmqserver.h"
+#include "shm_route_ring.h"
 
 class ZmqConsumer : public ConsumerBase {
 public:
@@ -22,6 +24,22 @@ public:
     void drain() override;
 };
 
+class ShmRouteConsumer : public ConsumerBase {
+public:
+    ShmRouteConsumer(swss::ShmRouteConsumerStateTable *select, Orch *orch, const std::string &name)
+        : ConsumerBase(select, orch, name)
+    {
+    }
+
+    swss::TableBase *getConsumerTable() const override
+    {
+        return static_cast<swss::ShmRouteConsumerStateTable *>(getSelectable());
+    }
+
+    void execute() override;
+    void drain() override;
+};
+
 class ZmqOrch : public Orch
 {
 public:
@@ -31,6 +49,13 @@ public:
     virtual void doTask(ConsumerBase &consumer) { };
     void doTask(Consumer &consumer) override;
 
+    // Also takes the table from the shared memory route ring, next to its Redis or ZMQ consumer
+    void addShmRouteConsumer(swss::DBConnector *db, const std::string &tableName, int pri, std::shared_ptr<swss::ShmRouteRing> ring);
+
+    // Called when the shared memory route consumer reloaded the table from APPL_DB, keys holds
+    // every route it returned along with it, other routes were removed while ring records were dropped
+    virtual void onShmRouteReload(ConsumerBase &consumer, const std::unordered_set<std::string> &keys) { }
+
 private:
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri, swss::ZmqServer *zmqServer);
 };
\ No newline at end of file
@@ -29,6 +29,7 @@ extern sai_route_api_t *sai_next_hop_api;
 extern sai_mpls_api_t *sai_mpls_api;
 extern sai_next_hop_group_api_t* sai_next_hop_group_api;
 extern string gMySwitchType;
+extern uint32_t gAclRangeExpansionLimit;
 
 using namespace saimeta;
 
@@ -2364,4 +2365,256 @@ namespace aclorch_test
         orch->doAclRuleTask(ruleKofvt);
         ASSERT_NE(orch->getAclRule(aclTableName, aclRuleName), nullptr);
     }
+
+    TEST(AclRangeTest, ToPrefixes)
+    {
+        struct
+        {
+            uint32_t min;
+            uint32_t max;
+            size_t count;
+        } ranges[] = {
+            { 0, 65535, 1 },
+            { 80, 80, 1 },
+            { 1024, 2047, 1 },
+            { 1000, 2000, 8 },
+            { 1, 65534, 30 },
+        };
+
+        for (const auto& range: ranges)
+        {
+            auto prefixes = AclRange::toPrefixes(range.min, range.max);
+            ASSERT_EQ(prefixes.size(), range.count);
+
+            // every port in the range is matched by exactly one prefix, ports outside by none
+            for (uint32_t port = 0; port <= 0xFFFF; port++)
+            {
+                size_t matched = 0;
+                for (const auto& prefix: prefixes)
+                {
+                    matched += ((port & prefix.mask) == prefix.value);
+                }
+                ASSERT_EQ(matched, (port >= range.min && port <= range.max) ? 1u : 0u);
+            }
+        }
+
+        ASSERT_TRUE(AclRange::toPrefixes(100, 99).empty());
+    }
+
+    TEST_F(AclOrchTest, AclRule_RangeExpansion)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto tableOid = orch->getTableById(tableId);
+        ASSERT_NE(tableOid, SAI_NULL_OBJECT_ID);
+
+        gAclRangeExpansionLimit = 16;
+
+        // aligned range is a single prefix, no range checker is needed
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|prefix_rule",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "1024-2047" }
+                }
+            },
+            {
+                tableId + "|checker_rule",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_DST_PORT_RANGE, "1000-2000" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto prefixRule = orch->getAclRule(tableId, "prefix_rule");
+        ASSERT_NE(prefixRule, nullptr);
+        ASSERT_NE(prefixRule->m_ruleOid, SAI_NULL_OBJECT_ID);
+        ASSERT_TRUE(prefixRule->m_ranges.empty());
+        ASSERT_TRUE(prefixRule->m_expandedRuleOids.empty());
+
+        // range checkers are still available, so multi-prefix range keeps using one
+        auto checkerRule = orch->getAclRule(tableId, "checker_rule");
+        ASSERT_NE(checkerRule, nullptr);
+        ASSERT_EQ(checkerRule->m_ranges.size(), 1u);
+        ASSERT_TRUE(checkerRule->m_expandedRuleOids.empty());
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|prefix_rule", DEL_COMMAND, {} },
+            { tableId + "|checker_rule", DEL_COMMAND, {} }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        ASSERT_EQ(orch->getAclRule(tableId, "prefix_rule"), nullptr);
+        ASSERT_EQ(orch->getAclRule(tableId, "checker_rule"), nullptr);
+        gAclRangeExpansionLimit = 0;
+    }
+    TEST_F(AclOrchTest, AclRule_RangeReleasedOnCreateFailure)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({{
+            tableId + "|range_rule",
+            SET_COMMAND,
+            {
+                { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                { MATCH_L4_SRC_PORT_RANGE, "1000-2000" },
+                { MATCH_L4_DST_PORT_RANGE, "3000-4000" }
+            }
+        }});
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto rule = orch->getAclRule(tableId, "range_rule");
+        ASSERT_NE(rule, nullptr);
+        ASSERT_EQ(rule->m_ranges.size(), 2u);
+        ASSERT_TRUE(rule->remove());
+        ASSERT_TRUE(rule->m_ranges.empty());
+        ASSERT_TRUE(AclRange::m_ranges.empty());
+
+        // The failed create releases its range checkers and forgets them
+        auto origAclApi = sai_acl_api;
+        sai_acl_api_t failAclApi = *origAclApi;
+        failAclApi.create_acl_entry = [](sai_object_id_t *, sai_object_id_t, uint32_t, const sai_attribute_t *) -> sai_status_t {
+            return SAI_STATUS_INSUFFICIENT_RESOURCES;
+        };
+        sai_acl_api = &failAclApi;
+        ASSERT_FALSE(rule->create());
+        sai_acl_api = origAclApi;
+
+        ASSERT_TRUE(rule->m_ranges.empty());
+        ASSERT_TRUE(AclRange::m_ranges.empty());
+        ASSERT_TRUE(rule->removeRanges());
+
+        ASSERT_TRUE(rule->create());
+        ASSERT_EQ(rule->m_ranges.size(), 2u);
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({{ tableId + "|range_rule", DEL_COMMAND, {} }});
+        orch->doAclRuleTask(kvfAclRule);
+
+        ASSERT_EQ(orch->getAclRule(tableId, "range_rule"), nullptr);
+        ASSERT_TRUE(AclRange::m_ranges.empty());
+    }
+
+    static sai_acl_api_t *gOrigAclApi;
+    static sai_object_id_t gFailingEntryOid;
+
+    static sai_status_t failingSetAclEntryAttribute(sai_object_id_t oid, const sai_attribute_t *attr)
+    {
+        if (oid == gFailingEntryOid)
+        {
+            return SAI_STATUS_FAILURE;
+        }
+        return gOrigAclApi->set_acl_entry_attribute(oid, attr);
+    }
+
+    TEST_F(AclOrchTest, AclRule_ExpandedEntriesRollback)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT, "1000" }
+                }
+            },
+            {
+                tableId + "|rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT, "1001" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        auto rule = orch->getAclRule(tableId, "rule_1");
+        auto other = orch->getAclRule(tableId, "rule_2");
+        ASSERT_NE(rule, nullptr);
+        ASSERT_NE(other, nullptr);
+
+        // Stand in for an expanded rule made of two entries, the second one rejects the update
+        rule->m_expandedRuleOids.push_back(other->m_ruleOid);
+        gOrigAclApi = sai_acl_api;
+        gFailingEntryOid = other->m_ruleOid;
+        sai_acl_api_t failAclApi = *sai_acl_api;
+        failAclApi.set_acl_entry_attribute = failingSetAclEntryAttribute;
+        sai_acl_api = &failAclApi;
+
+        sai_attribute_t attr;
+        attr.id = SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION;
+        attr.value.aclaction.enable = true;
+        attr.value.aclaction.parameter.s32 = SAI_PACKET_ACTION_FORWARD;
+        ASSERT_NE(rule->setEntryAttribute(attr), SAI_STATUS_SUCCESS);
+
+        sai_acl_api = gOrigAclApi;
+        rule->m_expandedRuleOids.clear();
+
+        // The first entry is back to the value the rest of the rule still has
+        attr.value.aclaction.parameter.s32 = SAI_PACKET_ACTION_FORWARD;
+        ASSERT_EQ(sai_acl_api->get_acl_entry_attribute(rule->m_ruleOid, 1, &attr), SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.aclaction.parameter.s32, SAI_PACKET_ACTION_DROP);
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            { tableId + "|rule_1", DEL_COMMAND, {} },
+            { tableId + "|rule_2", DEL_COMMAND, {} }
+        });
+        orch->doAclRuleTask(kvfAclRule);
+    }
 } // namespace nsAclOrchTest
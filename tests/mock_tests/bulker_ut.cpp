@@ -289,6 +289,41 @@ namespace bulker_test
         gNextHopBulker.flush();
     }
 
+    TEST_F(BulkerTest, ObjectBulkCreateStatus)
+    {
+        // Create bulker
+        ObjectBulker<sai_next_hop_api_t> gNextHopBulker(sai_next_hop_api, 0x0, 1000);
+        vector<sai_object_id_t> next_hop_ids = {0x101, SAI_NULL_OBJECT_ID};
+        std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_INSUFFICIENT_RESOURCES};
+        sai_object_id_t next_hop_id_0;
+        sai_object_id_t next_hop_id_1;
+        sai_status_t next_hop_status_0;
+        sai_status_t next_hop_status_1;
+
+        sai_attribute_t next_hop_attr;
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+        // Entries created with a status are told about their own result
+        ASSERT_EQ(gNextHopBulker.create_entry(&next_hop_id_0, &next_hop_status_0, 1, &next_hop_attr), SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(gNextHopBulker.create_entry(&next_hop_id_1, &next_hop_status_1, 1, &next_hop_attr), SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(next_hop_status_0, SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(next_hop_status_1, SAI_STATUS_NOT_EXECUTED);
+
+        EXPECT_CALL(*mock_sai_next_hop_api, create_next_hops)
+            .WillOnce(DoAll(
+                SetArrayArgument<5>(next_hop_ids.begin(), next_hop_ids.end()),
+                SetArrayArgument<6>(exp_status.begin(), exp_status.end()),
+                Return(SAI_STATUS_FAILURE)));
+        gNextHopBulker.flush();
+
+        ASSERT_EQ(next_hop_id_0, 0x101);
+        ASSERT_EQ(next_hop_status_0, SAI_STATUS_SUCCESS);
+        ASSERT_EQ(next_hop_id_1, SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(next_hop_status_1, SAI_STATUS_INSUFFICIENT_RESOURCES);
+        ASSERT_EQ(gNextHopBulker.creating_entries_count(), 0u);
+    }
+
     TEST_F(BulkerTest, BulkerPendingRemovalOrSet_OnlyRemoval)
     {
         // Create bulker
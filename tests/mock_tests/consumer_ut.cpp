@@ -3,8 +3,10 @@
 #include "mock_table.h"
 
 #include <sstream>
+#include <string.h>
 
 extern PortsOrch *gPortsOrch;
+extern std::deque<redisReply *> mockReplies;
 
 namespace consumer_test
 {
@@ -29,6 +31,28 @@ namespace consumer_test
         long m_notification_count;
     };
 
+    // Leaves every entry for retry, like routes waiting for their next hops
+    class RetryOrch : public Orch
+    {
+    public:
+        RetryOrch(swss::DBConnector *db, string tableName)
+            :Orch(db, tableName)
+        {
+        }
+
+        void doTask(Consumer& consumer)
+        {
+            vector<string> keys;
+            for (const auto &it : consumer.m_toSync)
+            {
+                keys.push_back(it.first);
+            }
+            m_passes.push_back(keys);
+        }
+
+        vector<vector<string>> m_passes;
+    };
+
     struct ConsumerTest : public ::testing::Test
     {
         shared_ptr<swss::DBConnector> m_app_db;
@@ -69,6 +93,49 @@ namespace consumer_test
             ::testing_db::reset();
         }
 
+        static redisReply *stringReply(const string &str)
+        {
+            auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+            reply->type = REDIS_REPLY_STRING;
+            reply->len = str.size();
+            reply->str = strdup(str.c_str());
+            return reply;
+        }
+
+        static redisReply *arrayReply(const vector<redisReply *> &elements)
+        {
+            auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+            reply->type = REDIS_REPLY_ARRAY;
+            reply->elements = elements.size();
+            reply->element = (redisReply **)calloc(sizeof(redisReply *), elements.size() + 1);
+            for (size_t i = 0; i < elements.size(); i++)
+            {
+                reply->element[i] = elements[i];
+            }
+            return reply;
+        }
+
+        static redisReply *scanReply(const string &cursor, const vector<string> &keys)
+        {
+            vector<redisReply *> replies;
+            for (const auto &key : keys)
+            {
+                replies.push_back(stringReply(key));
+            }
+            return arrayReply({ stringReply(cursor), arrayReply(replies) });
+        }
+
+        static redisReply *hashReply(const vector<FieldValueTuple> &fvs)
+        {
+            vector<redisReply *> replies;
+            for (const auto &fv : fvs)
+            {
+                replies.push_back(stringReply(fvField(fv)));
+                replies.push_back(stringReply(fvValue(fv)));
+            }
+            return arrayReply(replies);
+        }
+
         void validate_syncmap(SyncMap &sync, uint16_t exp_sz, std::string exp_key, KeyOpFieldsValuesTuple exp_kofv)
         {
             // verify the content in syncMap
@@ -342,6 +409,46 @@ namespace consumer_test
 
     }
 
+    TEST_F(ConsumerTest, ConsumerAddToSync_Moved_Del_Set_Setnew1)
+    {
+        // Test case, same as Del_Set_Setnew1 but the entries are moved out of a shared deque
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                DEL_COMMAND,
+                { { } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        auto entryc = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1b },
+                    { f3, v3a } } });
+
+        auto entries = make_shared<deque<KeyOpFieldsValuesTuple>>();
+        entries->push_back(entrya);
+        entries->push_back(entryb);
+        entries->push_back(entryc);
+        ASSERT_EQ(consumer->addToSync(entries), 3);
+
+        // expect DEL then SET with new values and new fields
+        exp_kofv = entrya;
+        validate_syncmap(consumer->m_toSync, 2, key, exp_kofv);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a },
+                    { f1, v1b },
+                    { f3, v3a } } });
+
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
     TEST_F(ConsumerTest, ConsumerPops_notification_count)
     {
         int consumer_pops_batch_size = 10;
@@ -368,4 +475,116 @@ namespace consumer_test
         test_consumer.execute();
         ASSERT_EQ(test_orch.m_notification_count, consumer_pops_batch_size*2);
     }
+
+    TEST_F(ConsumerTest, ConsumerDrainQuota)
+    {
+        TestOrch test_orch(m_config_db.get(), "CFG_TEST_TABLE");
+        Consumer test_consumer(
+                new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &test_orch, "CFG_TEST_TABLE");
+        test_consumer.setDrainQuota(2);
+
+        for (int i = 0; i < 5; i++)
+        {
+            test_consumer.addToSync(KeyOpFieldsValuesTuple({ "key" + to_string(i), SET_COMMAND, { { f1, v1a } } }));
+        }
+
+        // each pass hands the orch at most the quota, the rest stays pending
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_notification_count, 2);
+        ASSERT_EQ(test_consumer.m_toSync.size(), 3);
+        ASSERT_EQ(test_consumer.getQueueDepth(), 3);
+        ASSERT_TRUE(Executor::hasThrottled());
+
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_notification_count, 4);
+        ASSERT_EQ(test_consumer.getQueueDepth(), 1);
+
+        test_consumer.drain();
+        ASSERT_EQ(test_orch.m_notification_count, 5);
+        ASSERT_EQ(test_consumer.getQueueDepth(), 0);
+        ASSERT_EQ(test_consumer.getWaitTimeMs(), 0);
+        ASSERT_FALSE(Executor::hasThrottled());
+    }
+
+    TEST_F(ConsumerTest, ConsumerDrainQuota_RoundRobin)
+    {
+        RetryOrch retry_orch(m_config_db.get(), "CFG_TEST_TABLE");
+        Consumer test_consumer(
+                new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &retry_orch, "CFG_TEST_TABLE");
+        test_consumer.setDrainQuota(2);
+
+        // a DEL and SET of one key are never split across passes
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "b", DEL_COMMAND, { } }));
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f1, v1a } } }));
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f1, v1a } } }));
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "d", SET_COMMAND, { { f1, v1a } } }));
+
+        test_consumer.drain();
+        test_consumer.drain();
+        test_consumer.drain();
+
+        vector<vector<string>> expected = {
+            { "a", "b", "b" },
+            { "c", "d" },
+            { "a", "b", "b" }
+        };
+        ASSERT_EQ(retry_orch.m_passes, expected);
+
+        // nothing was consumed, so the backlog is not worth spinning on
+        ASSERT_EQ(test_consumer.getQueueDepth(), 5);
+        ASSERT_FALSE(Executor::hasThrottled());
+
+        // a new SET still merges with the pending SET of its key
+        test_consumer.addToSync(KeyOpFieldsValuesTuple({ "d", SET_COMMAND, { { f2, v2a } } }));
+        auto range = test_consumer.m_toSync.equal_range("d");
+        ASSERT_EQ(std::distance(range.first, range.second), 1);
+        ASSERT_EQ(kfvFieldsValues(range.first->second).size(), 2);
+    }
+
+    TEST_F(ConsumerTest, ConsumerRefillPipelined)
+    {
+        // The HGETALLs of a batch come back ahead of the next SCAN
+        mockReplies = {
+            scanReply("7", { "STATE_TEST_TABLE|a", "STATE_TEST_TABLE|b" }),
+            hashReply({ { f1, v1a } }),
+            hashReply({ { f1, v1b }, { f2, v2a } }),
+            scanReply("0", { "STATE_TEST_TABLE|c" }),
+            hashReply({ { f3, v3a } })
+        };
+
+        ASSERT_EQ(consumer->refillToSync(m_state_db.get(), "STATE_TEST_TABLE"), 3);
+        ASSERT_TRUE(mockReplies.empty());
+
+        validate_syncmap(consumer->m_toSync, 3, "b",
+            KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f1, v1b }, { f2, v2a } } }));
+        validate_syncmap(consumer->m_toSync, 2, "a",
+            KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        validate_syncmap(consumer->m_toSync, 1, "c",
+            KeyOpFieldsValuesTuple({ "c", SET_COMMAND, { { f3, v3a } } }));
+    }
+
+    TEST_F(ConsumerTest, ConsumerRefillFallsBackOnBadScan)
+    {
+        Table table(m_state_db.get(), "STATE_TEST_TABLE");
+        table.set("a", { { f1, v1a } });
+        table.set("b", { { f2, v2a } });
+
+        // A malformed HGETALL reply fails the scan once its batch is drained
+        mockReplies = {
+            scanReply("7", { "STATE_TEST_TABLE|a", "STATE_TEST_TABLE|b" }),
+            hashReply({ { f1, v1a } }),
+            stringReply("unexpected"),
+            scanReply("0", { })
+        };
+
+        // The table is then read key by key on a connection of its own
+        ASSERT_EQ(consumer->refillToSync(m_state_db.get(), "STATE_TEST_TABLE"), 2);
+        ASSERT_TRUE(mockReplies.empty());
+
+        validate_syncmap(consumer->m_toSync, 2, "a",
+            KeyOpFieldsValuesTuple({ "a", SET_COMMAND, { { f1, v1a } } }));
+        validate_syncmap(consumer->m_toSync, 1, "b",
+            KeyOpFieldsValuesTuple({ "b", SET_COMMAND, { { f2, v2a } } }));
+    }
 }
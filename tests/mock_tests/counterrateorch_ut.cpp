@@ -0,0 +1,201 @@
+#include "gtest/gtest.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "schema.h"
+#include "counter_rate_engine.h"
+
+namespace counterrateorch_test
+{
+    using namespace std;
+
+    static const string PORT_OID = "oid:0x1000000000001";
+    static const string QUEUE_OID = "oid:0x15000000000001";
+
+    // Field values of the updates written to one table and key
+    map<string, string> findUpdate(const vector<CounterRateUpdate> &updates, const string &table, const string &key)
+    {
+        map<string, string> values;
+        for (const auto &update : updates)
+        {
+            if (update.table == table && update.key == key)
+            {
+                values.insert(update.values.begin(), update.values.end());
+            }
+        }
+        return values;
+    }
+
+    void setPortCounters(CounterRateEngine &engine, uint64_t pkts, uint64_t octets, uint64_t corrected_bits)
+    {
+        CounterColumnStore &store = engine.store(CounterRateGroup::PORT);
+        size_t row;
+        ASSERT_TRUE(store.findRow(PORT_OID, row));
+
+        const auto &names = store.counterNames();
+        for (size_t column = 0; column < names.size(); column++)
+        {
+            const string &name = names[column];
+            if (name == "SAI_PORT_STAT_IF_IN_UCAST_PKTS" || name == "SAI_PORT_STAT_IF_OUT_UCAST_PKTS")
+            {
+                store.setCounter(column, row, pkts);
+            }
+            else if (name == "SAI_PORT_STAT_IF_IN_OCTETS" || name == "SAI_PORT_STAT_IF_OUT_OCTETS")
+            {
+                store.setCounter(column, row, octets);
+            }
+            else if (name == "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS")
+            {
+                store.setCounter(column, row, corrected_bits);
+            }
+            else if (name == "SAI_PORT_STAT_IF_IN_FEC_CODEWORD_ERRORS_S3")
+            {
+                store.setCounter(column, row, corrected_bits ? 1 : 0);
+            }
+            else
+            {
+                store.setCounter(column, row, 0);
+            }
+        }
+    }
+
+    TEST(CounterRateEngine, PortRatesMatchLuaPlugin)
+    {
+        CounterRateEngine engine;
+        engine.addObject(CounterRateGroup::PORT, PORT_OID);
+        engine.setPortSpeed(PORT_OID, 100000, 4);
+
+        vector<CounterRateUpdate> updates;
+
+        // First poll only records the counters
+        setPortCounters(engine, 0, 0, 0);
+        engine.computePortRates(true, 0.5, 1000, updates);
+        ASSERT_TRUE(findUpdate(updates, RATES_TABLE, PORT_OID).empty());
+
+        // Second poll stores the unsmoothed rates
+        setPortCounters(engine, 1000, 100000, 0);
+        engine.computePortRates(true, 0.5, 1000, updates);
+        auto rates = findUpdate(updates, RATES_TABLE, PORT_OID);
+        ASSERT_EQ(rates["RX_BPS"], "100000");
+        ASSERT_EQ(rates["RX_PPS"], "1000");
+        ASSERT_EQ(rates["TX_PPS"], "1000");
+        ASSERT_EQ(rates["FEC_PRE_BER"], "0");
+        ASSERT_EQ(rates["FEC_MAX_T"], "-1");
+
+        // Following polls are smoothed with alpha
+        updates.clear();
+        setPortCounters(engine, 4000, 400000, 103125000);
+        engine.computePortRates(true, 0.5, 1000, updates);
+        rates = findUpdate(updates, RATES_TABLE, PORT_OID);
+        ASSERT_EQ(rates["RX_BPS"], "200000");
+        ASSERT_EQ(rates["TX_PPS"], "2000");
+
+        // 4 lanes of 25G use 25.78125e+9 serdes
+        ASSERT_EQ(rates["FEC_PRE_BER"], "0.001");
+        ASSERT_EQ(rates["FEC_PRE_BER_MAX"], "0.001");
+        ASSERT_EQ(rates["FEC_MAX_T"], "3");
+
+        // Without alpha only BER is computed, and the max is kept
+        updates.clear();
+        setPortCounters(engine, 4000, 400000, 103125000);
+        engine.computePortRates(false, 0, 1000, updates);
+        rates = findUpdate(updates, RATES_TABLE, PORT_OID);
+        ASSERT_EQ(rates.count("RX_BPS"), 0);
+        ASSERT_EQ(rates["FEC_PRE_BER"], "0");
+        ASSERT_EQ(rates.count("FEC_PRE_BER_MAX"), 0);
+    }
+
+    TEST(CounterRateEngine, WatermarksOnlyWriteChanges)
+    {
+        CounterRateEngine engine;
+        engine.addObject(CounterRateGroup::QUEUE_WATERMARK, QUEUE_OID);
+        engine.seedWatermark(CounterRateGroup::QUEUE_WATERMARK, PERSISTENT_WATERMARKS_TABLE, QUEUE_OID,
+                "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", 5000);
+
+        CounterColumnStore &store = engine.store(CounterRateGroup::QUEUE_WATERMARK);
+        size_t row;
+        ASSERT_TRUE(store.findRow(QUEUE_OID, row));
+
+        vector<CounterRateUpdate> updates;
+        store.setCounter(0, row, 1000);
+        engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+        ASSERT_EQ(findUpdate(updates, PERIODIC_WATERMARKS_TABLE, QUEUE_OID)["SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"], "1000");
+        ASSERT_EQ(findUpdate(updates, USER_WATERMARKS_TABLE, QUEUE_OID)["SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"], "1000");
+        // The seeded persistent watermark is higher and already in the DB
+        ASSERT_TRUE(findUpdate(updates, PERSISTENT_WATERMARKS_TABLE, QUEUE_OID).empty());
+
+        // A lower sample changes nothing
+        updates.clear();
+        store.setCounter(0, row, 500);
+        engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+        ASSERT_TRUE(updates.empty());
+
+        // After a clear the periodic watermark starts over
+        engine.clearWatermark(PERIODIC_WATERMARKS_TABLE, QUEUE_OID, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES");
+        engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+        ASSERT_EQ(updates.size(), 1);
+        ASSERT_EQ(findUpdate(updates, PERIODIC_WATERMARKS_TABLE, QUEUE_OID)["SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"], "500");
+    }
+
+    TEST(CounterRateEngine, OnlyNewPollsAreTaken)
+    {
+        CounterRateEngine engine;
+        engine.addObject(CounterRateGroup::QUEUE_WATERMARK, QUEUE_OID);
+
+        CounterColumnStore &store = engine.store(CounterRateGroup::QUEUE_WATERMARK);
+        size_t row;
+        ASSERT_TRUE(store.findRow(QUEUE_OID, row));
+
+        vector<CounterRateUpdate> updates;
+        store.setCounter(0, row, 1000);
+        ASSERT_TRUE(engine.takeNewPoll(CounterRateGroup::QUEUE_WATERMARK));
+        engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+        ASSERT_EQ(findUpdate(updates, USER_WATERMARKS_TABLE, QUEUE_OID)["SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"], "1000");
+
+        // The same poll read again after a clear is not taken, the cleared watermark stays at 0
+        engine.clearWatermark(USER_WATERMARKS_TABLE, QUEUE_OID, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES");
+        store.clearCounter(0, row);
+        store.setCounter(0, row, 1000);
+        ASSERT_FALSE(engine.takeNewPoll(CounterRateGroup::QUEUE_WATERMARK));
+
+        // The next poll is
+        updates.clear();
+        store.setCounter(0, row, 200);
+        ASSERT_TRUE(engine.takeNewPoll(CounterRateGroup::QUEUE_WATERMARK));
+        engine.computeWatermarks(CounterRateGroup::QUEUE_WATERMARK, updates);
+        ASSERT_EQ(findUpdate(updates, USER_WATERMARKS_TABLE, QUEUE_OID)["SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"], "200");
+
+        // Groups are tracked separately, and a counter going missing is a change too
+        engine.addObject(CounterRateGroup::PORT, PORT_OID);
+        ASSERT_TRUE(engine.takeNewPoll(CounterRateGroup::PORT));
+        ASSERT_FALSE(engine.takeNewPoll(CounterRateGroup::PORT));
+        store.clearCounter(0, row);
+        ASSERT_TRUE(engine.takeNewPoll(CounterRateGroup::QUEUE_WATERMARK));
+    }
+
+    TEST(CounterRateEngine, RemoveObjectKeepsOtherRows)
+    {
+        CounterRateEngine engine;
+        CounterColumnStore &store = engine.store(CounterRateGroup::RIF);
+
+        for (const auto &key : { "oid:0x1", "oid:0x2", "oid:0x3" })
+        {
+            engine.addObject(CounterRateGroup::RIF, key);
+            size_t row;
+            ASSERT_TRUE(store.findRow(key, row));
+            store.setCounter(0, row, row + 1);
+        }
+
+        engine.removeObject(CounterRateGroup::RIF, "oid:0x1");
+        ASSERT_EQ(store.rows(), 2);
+
+        size_t row;
+        ASSERT_FALSE(store.findRow("oid:0x1", row));
+        ASSERT_TRUE(store.findRow("oid:0x3", row));
+        ASSERT_EQ(store.counter(0, row), 3);
+        ASSERT_TRUE(store.findRow("oid:0x2", row));
+        ASSERT_EQ(store.counter(0, row), 2);
+    }
+}
@@ -0,0 +1,342 @@
+#define private public
+#include "directory.h"
+#undef private
+#define protected public
+#include "orch.h"
+#undef protected
+#define private public
+#include "dashaclorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_sai_api.h"
+#include "mock_dash_orch_test.h"
+#include "dash_api/acl_group.pb.h"
+#include "dash_api/acl_rule.pb.h"
+#include "dash_api/prefix_tag.pb.h"
+#include "dash_api/types.pb.h"
+#include "gtest/gtest.h"
+
+extern sai_dash_acl_api_t* sai_dash_acl_api;
+
+EXTERN_MOCK_FNS
+
+namespace dashaclorch_test
+{
+    DEFINE_SAI_GENERIC_APIS_MOCK(dash_acl, dash_acl_group, dash_acl_rule)
+    using namespace mock_orch_test;
+    using ::testing::_;
+    using ::testing::DoDefault;
+    using ::testing::Pointee;
+    using ::testing::Return;
+
+    class DashAclOrchTest : public MockDashOrchTest
+    {
+    protected:
+        std::unique_ptr<DashAclOrch> m_dash_acl_orch;
+        sai_object_id_t m_next_oid = 0x1000;
+
+        std::string group1 = "GROUP_1";
+        std::string tag1 = "TAG_1";
+
+        void ApplySaiMock() override
+        {
+            INIT_SAI_API_MOCK(dash_acl);
+            MockSaiApis();
+        }
+
+        void PostSetUp() override
+        {
+            ON_CALL(*mock_sai_dash_acl_api, create_dash_acl_group)
+                .WillByDefault([this](sai_object_id_t *oid, sai_object_id_t, uint32_t, const sai_attribute_t *) -> sai_status_t {
+                    *oid = m_next_oid++;
+                    return SAI_STATUS_SUCCESS;
+                });
+            ON_CALL(*mock_sai_dash_acl_api, remove_dash_acl_group)
+                .WillByDefault(Return(SAI_STATUS_SUCCESS));
+            ON_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules)
+                .WillByDefault([this](sai_object_id_t, uint32_t count, const uint32_t *, const sai_attribute_t **,
+                                      sai_bulk_op_error_mode_t, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t {
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        oids[i] = m_next_oid++;
+                        statuses[i] = SAI_STATUS_SUCCESS;
+                    }
+                    return SAI_STATUS_SUCCESS;
+                });
+            ON_CALL(*mock_sai_dash_acl_api, remove_dash_acl_rules)
+                .WillByDefault([](uint32_t count, const sai_object_id_t *, sai_bulk_op_error_mode_t, sai_status_t *statuses) -> sai_status_t {
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        statuses[i] = SAI_STATUS_SUCCESS;
+                    }
+                    return SAI_STATUS_SUCCESS;
+                });
+
+            std::vector<std::string> dash_acl_tables = {
+                APP_DASH_ACL_IN_TABLE_NAME,
+                APP_DASH_ACL_OUT_TABLE_NAME,
+                APP_DASH_ACL_GROUP_TABLE_NAME,
+                APP_DASH_ACL_RULE_TABLE_NAME,
+                APP_DASH_PREFIX_TAG_TABLE_NAME
+            };
+            m_dash_acl_orch = std::make_unique<DashAclOrch>(m_app_db.get(), dash_acl_tables, m_DashOrch, m_dpu_app_state_db.get(), nullptr);
+        }
+
+        void PreTearDown() override
+        {
+            m_dash_acl_orch.reset();
+            RestoreSaiApis();
+            DEINIT_SAI_API_MOCK(dash_acl);
+        }
+
+        std::unique_ptr<Consumer> MakeConsumer(const std::string &table_name)
+        {
+            return std::make_unique<Consumer>(
+                new swss::ConsumerStateTable(m_app_db.get(), table_name),
+                m_dash_acl_orch.get(), table_name);
+        }
+
+        void AddTask(Consumer &consumer, const std::string &key, const google::protobuf::Message &message)
+        {
+            consumer.addToSync(
+                swss::KeyOpFieldsValuesTuple(key, SET_COMMAND, { { "pb", message.SerializeAsString() } }));
+        }
+
+        void SetAclTable(const std::string &table_name, const std::string &key, const google::protobuf::Message &message)
+        {
+            auto consumer = MakeConsumer(table_name);
+            AddTask(*consumer, key, message);
+            m_dash_acl_orch->doTask(*consumer);
+            EXPECT_TRUE(consumer->m_toSync.empty()) << "Task " << table_name << ":" << key << " wasn't done";
+        }
+
+        dash::tag::PrefixTag BuildTag(const std::vector<std::string> &prefixes)
+        {
+            dash::tag::PrefixTag tag;
+            tag.set_ip_version(dash::types::IP_VERSION_IPV4);
+            for (const auto &prefix : prefixes)
+            {
+                swss::IpPrefix ip_prefix(prefix);
+                auto *pb_prefix = tag.add_prefix_list();
+                pb_prefix->mutable_ip()->set_ipv4(ip_prefix.getIp().getV4Addr());
+                pb_prefix->mutable_mask()->set_ipv4(ip_prefix.getMask().getV4Addr());
+            }
+            return tag;
+        }
+
+        dash::acl_group::AclGroup BuildGroup()
+        {
+            dash::acl_group::AclGroup group;
+            group.set_ip_version(dash::types::IP_VERSION_IPV4);
+            return group;
+        }
+
+        dash::acl_rule::AclRule BuildRule(uint32_t priority, const std::string &src_tag = "")
+        {
+            dash::acl_rule::AclRule rule;
+            rule.set_priority(priority);
+            rule.set_action(dash::acl_rule::ACTION_PERMIT);
+            rule.set_terminating(true);
+            if (!src_tag.empty())
+            {
+                rule.add_src_tag(src_tag);
+            }
+            return rule;
+        }
+
+        DashAclGroup& GetGroup(const std::string &group_id)
+        {
+            return m_dash_acl_orch->m_group_mgr.m_groups_table.at(group_id);
+        }
+
+        std::unordered_set<sai_object_id_t>& GetTagRules(const std::string &tag_id, const std::string &group_id)
+        {
+            return m_dash_acl_orch->m_group_mgr.m_tag_rules[tag_id][group_id];
+        }
+
+        // RULE_1 uses TAG_1 as its source, RULE_2 doesn't use any tag
+        void CreateTaggedRules()
+        {
+            SetAclTable(APP_DASH_PREFIX_TAG_TABLE_NAME, tag1, BuildTag({ "10.0.0.0/8" }));
+            SetAclTable(APP_DASH_ACL_GROUP_TABLE_NAME, group1, BuildGroup());
+
+            auto consumer = MakeConsumer(APP_DASH_ACL_RULE_TABLE_NAME);
+            AddTask(*consumer, group1 + ":RULE_1", BuildRule(1, tag1));
+            AddTask(*consumer, group1 + ":RULE_2", BuildRule(2));
+            m_dash_acl_orch->doTask(*consumer);
+            ASSERT_TRUE(consumer->m_toSync.empty());
+        }
+
+        sai_object_id_t GetRuleOid(const std::string &group_id, const std::string &rule_id)
+        {
+            for (const auto &it : GetGroup(group_id).m_dash_acl_rule_table)
+            {
+                if (it.second.m_rule_id == rule_id)
+                {
+                    return it.first;
+                }
+            }
+            return SAI_NULL_OBJECT_ID;
+        }
+    };
+
+    TEST_F(DashAclOrchTest, RulesCreatedInOneBulk)
+    {
+        SetAclTable(APP_DASH_ACL_GROUP_TABLE_NAME, group1, BuildGroup());
+
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 3, _, _, _, _, _)).Times(1);
+
+        auto consumer = MakeConsumer(APP_DASH_ACL_RULE_TABLE_NAME);
+        AddTask(*consumer, group1 + ":RULE_1", BuildRule(1));
+        AddTask(*consumer, group1 + ":RULE_2", BuildRule(2));
+        AddTask(*consumer, group1 + ":RULE_3", BuildRule(3));
+        m_dash_acl_orch->doTask(*consumer);
+
+        EXPECT_TRUE(consumer->m_toSync.empty());
+        EXPECT_EQ(GetGroup(group1).m_rule_count, 3);
+        EXPECT_EQ(GetGroup(group1).m_dash_acl_rule_table.size(), 3u);
+    }
+
+    TEST_F(DashAclOrchTest, FailedBulkCreateIsRetried)
+    {
+        SetAclTable(APP_DASH_ACL_GROUP_TABLE_NAME, group1, BuildGroup());
+
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 2, _, _, _, _, _))
+            .WillOnce([this](sai_object_id_t, uint32_t, const uint32_t *, const sai_attribute_t **,
+                             sai_bulk_op_error_mode_t, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t {
+                oids[0] = m_next_oid++;
+                statuses[0] = SAI_STATUS_SUCCESS;
+                oids[1] = SAI_NULL_OBJECT_ID;
+                statuses[1] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+                return SAI_STATUS_FAILURE;
+            });
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 1, _, _, _, _, _)).Times(1);
+
+        auto consumer = MakeConsumer(APP_DASH_ACL_RULE_TABLE_NAME);
+        AddTask(*consumer, group1 + ":RULE_1", BuildRule(1));
+        AddTask(*consumer, group1 + ":RULE_2", BuildRule(2));
+        m_dash_acl_orch->doTask(*consumer);
+
+        // Only the rule that failed is kept for the next pass
+        ASSERT_EQ(consumer->m_toSync.size(), 1u);
+        EXPECT_EQ(consumer->m_toSync.begin()->first, group1 + ":RULE_2");
+        EXPECT_EQ(GetGroup(group1).m_rule_count, 1);
+
+        m_dash_acl_orch->doTask(*consumer);
+
+        EXPECT_TRUE(consumer->m_toSync.empty());
+        EXPECT_EQ(GetGroup(group1).m_rule_count, 2);
+        EXPECT_NE(GetRuleOid(group1, "RULE_2"), SAI_NULL_OBJECT_ID);
+    }
+
+    TEST_F(DashAclOrchTest, TagIndexHoldsOnlyTaggedRules)
+    {
+        CreateTaggedRules();
+
+        auto &tag_rules = GetTagRules(tag1, group1);
+        ASSERT_EQ(tag_rules.size(), 1u);
+        EXPECT_EQ(*tag_rules.begin(), GetRuleOid(group1, "RULE_1"));
+        EXPECT_EQ(GetGroup(group1).m_tags.count(tag1), 1u);
+    }
+
+    TEST_F(DashAclOrchTest, RefreshTagRebuildsOnlyTaggedRules)
+    {
+        CreateTaggedRules();
+
+        auto old_tagged = GetRuleOid(group1, "RULE_1");
+        auto untagged = GetRuleOid(group1, "RULE_2");
+
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_group).Times(0);
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 1, _, _, _, _, _)).Times(1);
+        EXPECT_CALL(*mock_sai_dash_acl_api, remove_dash_acl_rules(1, Pointee(old_tagged), _, _)).Times(1);
+
+        SetAclTable(APP_DASH_PREFIX_TAG_TABLE_NAME, tag1, BuildTag({ "10.0.0.0/8", "20.0.0.0/8" }));
+
+        auto new_tagged = GetRuleOid(group1, "RULE_1");
+        EXPECT_NE(new_tagged, old_tagged);
+        EXPECT_EQ(GetRuleOid(group1, "RULE_2"), untagged);
+        EXPECT_EQ(GetGroup(group1).m_rule_count, 2);
+
+        auto &tag_rules = GetTagRules(tag1, group1);
+        ASSERT_EQ(tag_rules.size(), 1u);
+        EXPECT_EQ(*tag_rules.begin(), new_tagged);
+    }
+
+    TEST_F(DashAclOrchTest, RefreshTagKeepsRuleOnFailedCreate)
+    {
+        CreateTaggedRules();
+
+        auto old_tagged = GetRuleOid(group1, "RULE_1");
+
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 1, _, _, _, _, _))
+            .Times(2)
+            .WillOnce([](sai_object_id_t, uint32_t, const uint32_t *, const sai_attribute_t **,
+                         sai_bulk_op_error_mode_t, sai_object_id_t *oids, sai_status_t *statuses) -> sai_status_t {
+                oids[0] = SAI_NULL_OBJECT_ID;
+                statuses[0] = SAI_STATUS_INSUFFICIENT_RESOURCES;
+                return SAI_STATUS_FAILURE;
+            })
+            .WillOnce(DoDefault());
+        EXPECT_CALL(*mock_sai_dash_acl_api, remove_dash_acl_rules(1, Pointee(old_tagged), _, _)).Times(1);
+
+        auto consumer = MakeConsumer(APP_DASH_PREFIX_TAG_TABLE_NAME);
+        AddTask(*consumer, tag1, BuildTag({ "10.0.0.0/8", "20.0.0.0/8" }));
+        m_dash_acl_orch->doTask(*consumer);
+
+        // The rule and the tag are left as they were, the update is retried
+        ASSERT_EQ(consumer->m_toSync.size(), 1u);
+        EXPECT_EQ(GetRuleOid(group1, "RULE_1"), old_tagged);
+        EXPECT_EQ(GetGroup(group1).m_rule_count, 2);
+        EXPECT_EQ(m_dash_acl_orch->m_tag_mgr.getPrefixes(tag1).size(), 1u);
+
+        auto &tag_rules = GetTagRules(tag1, group1);
+        ASSERT_EQ(tag_rules.size(), 1u);
+        EXPECT_EQ(*tag_rules.begin(), old_tagged);
+
+        m_dash_acl_orch->doTask(*consumer);
+
+        EXPECT_TRUE(consumer->m_toSync.empty());
+        EXPECT_EQ(m_dash_acl_orch->m_tag_mgr.getPrefixes(tag1).size(), 2u);
+        auto new_tagged = GetRuleOid(group1, "RULE_1");
+        EXPECT_NE(new_tagged, old_tagged);
+
+        auto &new_tag_rules = GetTagRules(tag1, group1);
+        ASSERT_EQ(new_tag_rules.size(), 1u);
+        EXPECT_EQ(*new_tag_rules.begin(), new_tagged);
+    }
+
+    TEST_F(DashAclOrchTest, RefreshTagRebuildsBoundGroup)
+    {
+        CreateTaggedRules();
+
+        auto &group = GetGroup(group1);
+        auto old_group_oid = group.m_dash_acl_group_id;
+        auto old_tagged = GetRuleOid(group1, "RULE_1");
+        auto old_untagged = GetRuleOid(group1, "RULE_2");
+
+        // Bound to an ENI that is gone, so there is nothing to move over
+        group.m_in_tables["ENI_MISSING"].insert(DashAclStage::STAGE1);
+
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_group).Times(1);
+        EXPECT_CALL(*mock_sai_dash_acl_api, create_dash_acl_rules(_, 2, _, _, _, _, _)).Times(1);
+        EXPECT_CALL(*mock_sai_dash_acl_api, remove_dash_acl_rules(2, _, _, _)).Times(1);
+        EXPECT_CALL(*mock_sai_dash_acl_api, remove_dash_acl_group(old_group_oid)).Times(1);
+
+        SetAclTable(APP_DASH_PREFIX_TAG_TABLE_NAME, tag1, BuildTag({ "10.0.0.0/8", "20.0.0.0/8" }));
+
+        EXPECT_NE(group.m_dash_acl_group_id, old_group_oid);
+        EXPECT_EQ(group.m_rule_count, 2);
+        EXPECT_EQ(group.m_dash_acl_rule_table.size(), 2u);
+
+        auto new_tagged = GetRuleOid(group1, "RULE_1");
+        EXPECT_NE(new_tagged, old_tagged);
+        EXPECT_NE(GetRuleOid(group1, "RULE_2"), old_untagged);
+
+        auto &tag_rules = GetTagRules(tag1, group1);
+        ASSERT_EQ(tag_rules.size(), 1u);
+        EXPECT_EQ(*tag_rules.begin(), new_tagged);
+
+        group.m_in_tables.clear();
+    }
+}
@@ -347,6 +347,72 @@ namespace dashenifwdorch_ut
               });
        }
 
+       /*
+              Neighbor update only refires the ENI's waiting on it
+       */
+       TEST_F(DashEniFwdOrchTest, LocalNeighbor_PendingEnisOnly)
+       {
+              auto nh_ip = swss::IpAddress(local_pav4);
+              NextHopKey nh = {nh_ip, alias_dpu};
+              EXPECT_CALL(*ctx, getRouterIntfsAlias(nh_ip, _)).WillOnce(Return(alias_dpu));
+
+              /* initLocalEndpoints, then 2 rules of the first ENI, 2 of the second and 2 on the update */
+              EXPECT_CALL(*ctx, isNeighborResolved(nh))
+                     .WillOnce(Return(false))
+                     .WillOnce(Return(true)).WillOnce(Return(true))
+                     .WillOnce(Return(false)).WillOnce(Return(false))
+                     .WillOnce(Return(true)).WillOnce(Return(true));
+              EXPECT_CALL(*ctx, resolveNeighbor(nh)).Times(3);
+
+              eniOrch->initLocalEndpoints();
+
+              doDashEniFwdTableTask(applDb.get(),
+                     deque<KeyOpFieldsValuesTuple>(
+                            {
+                                   {
+                                       vnet_name + ":" + test_mac,
+                                       SET_COMMAND,
+                                       {
+                                          { DashEniFwd::VDPU_IDS, "vdpu0,vdpu1" },
+                                          { DashEniFwd::PRIMARY, "vdpu0" },
+                                       }
+                                   }
+                            }
+                     )
+              );
+              EXPECT_TRUE(eniOrch->nh_eni_map_.empty());
+
+              doDashEniFwdTableTask(applDb.get(),
+                     deque<KeyOpFieldsValuesTuple>(
+                            {
+                                   {
+                                       vnet_name + ":" + test_mac2,
+                                       SET_COMMAND,
+                                       {
+                                          { DashEniFwd::VDPU_IDS, "vdpu0,vdpu1" },
+                                          { DashEniFwd::PRIMARY, "vdpu0" },
+                                       }
+                                   }
+                            }
+                     )
+              );
+              ASSERT_EQ(eniOrch->nh_eni_map_.size(), 1);
+              EXPECT_EQ(eniOrch->nh_eni_map_[nh_ip], std::set<MacAddress>({ MacAddress(test_mac2) }));
+              checkRuleUninstalled("ENI:" + vnet_name + "_" + test_mac2_key);
+
+              NeighborEntry temp_entry = nh;
+              NeighborUpdate update = { temp_entry, MacAddress(), true };
+              eniOrch->update(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+              EXPECT_TRUE(eniOrch->nh_eni_map_.empty());
+              checkKFV(aclRuleTable.get(), "ENI:" + vnet_name + "_" + test_mac2_key, {
+                            { ACTION_REDIRECT_ACTION, local_pav4 }
+              });
+              checkKFV(aclRuleTable.get(), "ENI:" + vnet_name + "_" + test_mac2_key + "_TERM", {
+                            { ACTION_REDIRECT_ACTION, local_pav4 }, { MATCH_TUNNEL_TERM, "true"}
+              });
+       }
+
        /* 
               Remote Endpoint
        */
@@ -52,9 +52,33 @@ namespace dashhaorch_ut
     class DashHaOrchTestable : public DashHaOrch
     {
     public:
+        using DashHaOrch::m_bulk_set_fn;
         void doTask(swss::NotificationConsumer &consumer) { DashHaOrch::doTask(consumer); }
     };
 
+    // Bulk sets fall back to the mocked per object sets unless a test lets them succeed
+    uint32_t bulk_set_calls;
+    uint32_t bulk_set_objects;
+    sai_status_t bulk_set_status;
+    sai_status_t bulk_set_object_status;
+
+    sai_status_t fake_bulk_set(sai_object_type_t object_type, uint32_t object_count, const sai_object_id_t *object_id,
+            const sai_attribute_t *attr_list, sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulk_set_calls++;
+        if (bulk_set_status != SAI_STATUS_SUCCESS)
+        {
+            return bulk_set_status;
+        }
+
+        bulk_set_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = bulk_set_object_status;
+        }
+        return bulk_set_object_status;
+    }
+
     class DashHaOrchTest : public MockOrchTest
     {
     protected:
@@ -69,6 +93,11 @@ namespace dashhaorch_ut
                 APP_DASH_HA_SCOPE_TABLE_NAME
             };
             m_dashHaOrch = new DashHaOrch(m_dpu_app_db.get(), dash_ha_tables, m_DashOrch, m_mockBfdOrch.get(), m_dpu_app_state_db.get(), nullptr);
+            bulk_set_calls = 0;
+            bulk_set_objects = 0;
+            bulk_set_status = SAI_STATUS_NOT_IMPLEMENTED;
+            bulk_set_object_status = SAI_STATUS_SUCCESS;
+            static_cast<DashHaOrchTestable *>(m_dashHaOrch)->m_bulk_set_fn = fake_bulk_set;
             gDirectory.set(m_dashHaOrch);
             ut_orch_list.push_back((Orch **)&m_dashHaOrch);
         }
@@ -946,6 +975,80 @@ namespace dashhaorch_ut
         RemoveHaSet();
     }
 
+    TEST_F(DashHaOrchTest, HaScopeBulkSet)
+    {
+        ::testing_db::reset();
+        CreateHaSet();
+        CreateHaScope();
+
+        DBConnector dpu_state_db("DPU_STATE_DB", 0, true);
+        Table ha_scope_state_table(&dpu_state_db, STATE_DASH_HA_SCOPE_STATE_TABLE_NAME);
+        std::string value;
+
+        HaScopeEvent(SAI_HA_SCOPE_EVENT_STATE_CHANGED,
+                    SAI_DASH_HA_ROLE_SWITCHING_TO_ACTIVE, SAI_DASH_HA_STATE_PENDING_ACTIVE_ACTIVATION);
+
+        // A failed role set stops the HA Scope before its activate role request
+        bulk_set_status = SAI_STATUS_SUCCESS;
+        bulk_set_object_status = SAI_STATUS_INSUFFICIENT_RESOURCES;
+        bulk_set_calls = 0;
+        EXPECT_CALL(*mock_sai_dash_ha_api, set_ha_scope_attribute)
+        .Times(0);
+
+        SetHaScopeActivateRoleRequest();
+        EXPECT_EQ(bulk_set_calls, 1u);
+        EXPECT_FALSE(ha_scope_state_table.hget("HA_SET_1", "switchover_activated_time", value));
+
+        // One bulk per attribute, the role and then the activate role request
+        bulk_set_object_status = SAI_STATUS_SUCCESS;
+        bulk_set_calls = 0;
+        bulk_set_objects = 0;
+
+        SetHaScopeActivateRoleRequest();
+        EXPECT_EQ(bulk_set_calls, 2u);
+        EXPECT_EQ(bulk_set_objects, 2u);
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_programmed_time", value));
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "activate_role_pending", value));
+        EXPECT_EQ(value, "false");
+
+        RemoveHaScope();
+        RemoveHaSet();
+    }
+
+    TEST_F(DashHaOrchTest, SwitchoverPhaseTimes)
+    {
+        ::testing_db::reset();
+        CreateHaSet();
+        CreateHaScope();
+
+        DBConnector dpu_state_db("DPU_STATE_DB", 0, true);
+        Table ha_scope_state_table(&dpu_state_db, STATE_DASH_HA_SCOPE_STATE_TABLE_NAME);
+        std::string value;
+
+        SetHaScopeHaRole("switching_to_active");
+        EXPECT_NE(m_dashHaOrch->getHaScopeEntries().find("HA_SET_1")->second.switchover_requested_ms, 0);
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_requested_time", value));
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_programmed_time", value));
+        EXPECT_FALSE(ha_scope_state_table.hget("HA_SET_1", "switchover_completed_time", value));
+
+        // Intermediate states do not end the switchover
+        HaScopeEvent(SAI_HA_SCOPE_EVENT_STATE_CHANGED,
+                    SAI_DASH_HA_ROLE_SWITCHING_TO_ACTIVE, SAI_DASH_HA_STATE_PENDING_ACTIVE_ACTIVATION);
+        EXPECT_FALSE(ha_scope_state_table.hget("HA_SET_1", "switchover_completed_time", value));
+
+        SetHaScopeActivateRoleRequest();
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_activated_time", value));
+
+        HaScopeEvent(SAI_HA_SCOPE_EVENT_STATE_CHANGED,
+                    SAI_DASH_HA_ROLE_ACTIVE, SAI_DASH_HA_STATE_ACTIVE);
+        EXPECT_EQ(m_dashHaOrch->getHaScopeEntries().find("HA_SET_1")->second.switchover_requested_ms, 0);
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_completed_time", value));
+        EXPECT_TRUE(ha_scope_state_table.hget("HA_SET_1", "switchover_duration_ms", value));
+
+        RemoveHaScope();
+        RemoveHaSet();
+    }
+
     TEST_F(DashHaOrchTest, HaScopeFlowReconcileRequest)
     {
         CreateHaSet();
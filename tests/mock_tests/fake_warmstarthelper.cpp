@@ -65,6 +65,10 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
     g_mockRefreshMap[key] = kfv;
 }
 
+void WarmStartHelper::ignoreField(const std::string &field)
+{
+}
+
 void WarmStartHelper::reconcile()
 {
 }
@@ -81,6 +85,12 @@ bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &left,
     return false;
 }
 
+bool WarmStartHelper::compareFilteredFV(const std::vector<FieldValueTuple> &left,
+                                        const std::vector<FieldValueTuple> &right)
+{
+    return false;
+}
+
 bool WarmStartHelper::compareOneFV(const std::string &v1, const std::string &v2)
 {
     return false;
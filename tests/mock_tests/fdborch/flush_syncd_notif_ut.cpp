@@ -21,6 +21,35 @@ Test Fixture
 namespace fdb_syncd_flush_test
 {
 
+    struct BatchFdbObserver : public Observer
+    {
+        size_t updates = 0;
+        vector<size_t> batches;
+        MacAddress lastMac;
+        bool lastAdd = false;
+        string lastPortAlias;
+
+        void update(SubjectType type, void *cntx) override
+        {
+            updates++;
+        }
+
+        bool isBatchObserver(SubjectType type) const override
+        {
+            return type == SUBJECT_TYPE_FDB_CHANGE;
+        }
+
+        void updateBatch(SubjectType type, const vector<void *> &cntxs) override
+        {
+            batches.push_back(cntxs.size());
+            auto last = static_cast<FdbBatchUpdate *>(cntxs.back());
+            lastMac = last->entry.mac;
+            lastAdd = last->add;
+            lastPortAlias = last->port_alias;
+        }
+    };
+
+
     sai_fdb_api_t ut_sai_fdb_api;
     sai_fdb_api_t *pold_sai_fdb_api;
 
@@ -507,6 +536,80 @@ namespace fdb_syncd_flush_test
         ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "type", entry_type), false);
     }
 
+    /* Test STATE_DB writes coalesced within a notification batch */
+    TEST_F(FdbOrchTest, BatchedStateWrites)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+
+        vector<uint8_t> mac_addr = {124, 254, 144, 18, 34, 236};
+        auto bridge_port_id = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+        auto vlan_oid = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+        string port;
+
+        /* Writes in a batch are held back until it is flushed */
+        m_fdborch->beginFdbStateBatch();
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr, bridge_port_id, vlan_oid);
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), false);
+        m_fdborch->flushFdbStateBatch();
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), true);
+        ASSERT_EQ(port, "Ethernet0");
+
+        /* Aged and learned again in one batch leaves the entry in place */
+        m_fdborch->beginFdbStateBatch();
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_AGED, mac_addr, bridge_port_id, vlan_oid);
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr, bridge_port_id, vlan_oid);
+        ASSERT_EQ(m_fdborch->m_fdbStateWrites.size(), 1);
+        m_fdborch->flushFdbStateBatch();
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), true);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+
+        /* The final delete of a batch is written */
+        m_fdborch->beginFdbStateBatch();
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_AGED, mac_addr, bridge_port_id, vlan_oid);
+        m_fdborch->flushFdbStateBatch();
+        ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), false);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 0);
+    }
+
+    /* Test FDB changes of a batch delivered to a batch observer in one call */
+    TEST_F(FdbOrchTest, BatchedObserverUpdates)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+
+        BatchFdbObserver observer;
+        m_fdborch->attach(&observer);
+
+        vector<uint8_t> mac_addr = {124, 254, 144, 18, 34, 236};
+        auto bridge_port_id = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+        auto vlan_oid = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+
+        /* Outside a batch changes are delivered one by one */
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr, bridge_port_id, vlan_oid);
+        ASSERT_EQ(observer.updates, 1);
+        ASSERT_TRUE(observer.batches.empty());
+
+        m_fdborch->beginNotifyBatch();
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_AGED, mac_addr, bridge_port_id, vlan_oid);
+        mac_addr[5] = 237;
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr, bridge_port_id, vlan_oid);
+        ASSERT_TRUE(observer.batches.empty());
+        m_fdborch->endNotifyBatch();
+
+        ASSERT_EQ(observer.updates, 1);
+        ASSERT_EQ(observer.batches, vector<size_t>({ 2 }));
+        ASSERT_EQ(observer.lastMac, MacAddress("7c:fe:90:12:22:ed"));
+        ASSERT_TRUE(observer.lastAdd);
+        ASSERT_EQ(observer.lastPortAlias, ETH0);
+
+        m_fdborch->detach(&observer);
+    }
+
     /* Test Consolidated Flush with origin VXLAN */
     TEST_F(FdbOrchTest, ConsolidatedFlushAllVxLAN)
     {
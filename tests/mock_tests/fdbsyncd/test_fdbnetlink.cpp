@@ -0,0 +1,126 @@
+#include <string.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+
+#include <map>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "fdbnetlink.h"
+
+using namespace std;
+using namespace swss;
+
+namespace fdbnetlink_test
+{
+    /* Attributes of the single request in buf, by type */
+    map<unsigned short, vector<uint8_t>> parseRequest(const vector<uint8_t> &buf)
+    {
+        map<unsigned short, vector<uint8_t>> attrs;
+
+        auto hdr = reinterpret_cast<const struct nlmsghdr *>(buf.data());
+        EXPECT_EQ(hdr->nlmsg_len, buf.size());
+
+        auto ndm = reinterpret_cast<const struct ndmsg *>(NLMSG_DATA(hdr));
+        int len = static_cast<int>(hdr->nlmsg_len - NLMSG_LENGTH(sizeof(*ndm)));
+        for (auto rta = reinterpret_cast<const struct rtattr *>(reinterpret_cast<const uint8_t *>(ndm) + NLMSG_ALIGN(sizeof(*ndm)));
+             RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+        {
+            auto data = reinterpret_cast<const uint8_t *>(RTA_DATA(rta));
+            attrs[rta->rta_type] = vector<uint8_t>(data, data + RTA_PAYLOAD(rta));
+        }
+
+        return attrs;
+    }
+
+    FdbKernelEntry remoteEntry(const string &dst)
+    {
+        return { FDB_KERNEL_OP_REPLACE, "00:11:22:33:44:55", "lo", 100, false, FDB_KERNEL_STATE_STATIC, dst };
+    }
+
+    TEST(FdbNetlink, EncodeIpv4Dst)
+    {
+        vector<uint8_t> buf;
+        ASSERT_TRUE(FdbNetlink::encode(remoteEntry("10.0.0.1"), 7, buf));
+
+        auto hdr = reinterpret_cast<const struct nlmsghdr *>(buf.data());
+        ASSERT_EQ(hdr->nlmsg_type, RTM_NEWNEIGH);
+        ASSERT_EQ(hdr->nlmsg_seq, 7u);
+
+        auto ndm = reinterpret_cast<const struct ndmsg *>(NLMSG_DATA(hdr));
+        ASSERT_EQ(ndm->ndm_family, AF_BRIDGE);
+        ASSERT_EQ(ndm->ndm_ifindex, static_cast<int>(if_nametoindex("lo")));
+        ASSERT_EQ(ndm->ndm_flags, NTF_SELF);
+        ASSERT_EQ(ndm->ndm_state, NUD_NOARP);
+
+        auto attrs = parseRequest(buf);
+        ASSERT_EQ(attrs[NDA_LLADDR], vector<uint8_t>({ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 }));
+        ASSERT_EQ(attrs[NDA_VLAN].size(), sizeof(uint16_t));
+
+        struct in_addr dst;
+        inet_pton(AF_INET, "10.0.0.1", &dst);
+        ASSERT_EQ(attrs[NDA_DST].size(), sizeof(dst));
+        ASSERT_EQ(memcmp(attrs[NDA_DST].data(), &dst, sizeof(dst)), 0);
+    }
+
+    TEST(FdbNetlink, EncodeIpv6Dst)
+    {
+        vector<uint8_t> buf;
+        ASSERT_TRUE(FdbNetlink::encode(remoteEntry("2001:db8::1"), 1, buf));
+
+        struct in6_addr dst;
+        inet_pton(AF_INET6, "2001:db8::1", &dst);
+
+        auto attrs = parseRequest(buf);
+        ASSERT_EQ(attrs[NDA_DST].size(), sizeof(dst));
+        ASSERT_EQ(memcmp(attrs[NDA_DST].data(), &dst, sizeof(dst)), 0);
+    }
+
+    TEST(FdbNetlink, EncodeRejectsBadRequests)
+    {
+        vector<uint8_t> buf;
+        ASSERT_FALSE(FdbNetlink::encode(remoteEntry("10.0.0.256"), 1, buf));
+        ASSERT_FALSE(FdbNetlink::encode(remoteEntry("vtep1"), 1, buf));
+
+        auto entry = remoteEntry("");
+        entry.mac = "00:11:22:33:44";
+        ASSERT_FALSE(FdbNetlink::encode(entry, 1, buf));
+        ASSERT_TRUE(buf.empty());
+
+        /* No dst, a local MAC learned on the bridge port */
+        entry = remoteEntry("");
+        entry.master = true;
+        entry.state = FDB_KERNEL_STATE_DYNAMIC;
+        ASSERT_TRUE(FdbNetlink::encode(entry, 1, buf));
+
+        auto ndm = reinterpret_cast<const struct ndmsg *>(NLMSG_DATA(reinterpret_cast<const struct nlmsghdr *>(buf.data())));
+        ASSERT_EQ(ndm->ndm_flags, NTF_MASTER | NTF_EXT_LEARNED);
+        ASSERT_EQ(parseRequest(buf).count(NDA_DST), 0u);
+    }
+
+    TEST(FdbNetlink, FlushReturnsFailedEntries)
+    {
+        FdbNetlink kernelFdb;
+        ASSERT_TRUE(kernelFdb.flush().empty());
+
+        /* Requests that can not be encoded never reach the kernel */
+        auto entry = remoteEntry("10.0.0.256");
+        entry.retries = 2;
+        kernelFdb.add(entry);
+        kernelFdb.add(remoteEntry("vtep1"));
+
+        auto failed = kernelFdb.flush();
+        ASSERT_EQ(failed.size(), 2u);
+        ASSERT_EQ(failed[0].dst, "10.0.0.256");
+        ASSERT_EQ(failed[0].retries, 2);
+        ASSERT_EQ(failed[1].dst, "vtep1");
+
+        ASSERT_EQ(kernelFdb.pending(), 0u);
+        ASSERT_EQ(kernelFdb.getProgrammedCount(), 0u);
+        ASSERT_EQ(kernelFdb.getFailedCount(), 2u);
+        ASSERT_EQ(kernelFdb.getRate(), 0);
+    }
+}
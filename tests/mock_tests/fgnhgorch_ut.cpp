@@ -0,0 +1,210 @@
+#include "mock_orch_test.h"
+#include "mock_table.h"
+
+#include <chrono>
+#include <iostream>
+
+extern size_t gMaxBulkSize;
+
+namespace fgnhgorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    static const uint32_t BUCKET_SIZE = 4096;
+    static const uint32_t NHS_PER_BANK = 8;
+    static const uint32_t NUM_BANKS = 2;
+
+    uint32_t bulk_set_calls;
+    uint32_t bulk_set_objects;
+    sai_next_hop_group_api_t ut_sai_next_hop_group_api;
+    sai_next_hop_group_api_t *pold_sai_next_hop_group_api;
+
+    sai_status_t _ut_set_next_hop_group_members_attribute(
+            _In_ uint32_t object_count,
+            _In_ const sai_object_id_t *object_id,
+            _In_ const sai_attribute_t *attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_set_calls++;
+        bulk_set_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class FgNhgOrchTest : public MockOrchTest
+    {
+    protected:
+        FgNhgEntry m_fgNhgEntry;
+        FGNextHopGroupEntry m_routeEntry;
+        map<NextHopKey, sai_object_id_t> m_nhOids;
+        IpPrefix m_prefix = IpPrefix("10.0.0.0/24");
+        size_t m_oldMaxBulkSize;
+
+        void ApplyInitialConfigs() override
+        {
+            pold_sai_next_hop_group_api = sai_next_hop_group_api;
+            ut_sai_next_hop_group_api = *sai_next_hop_group_api;
+            ut_sai_next_hop_group_api.set_next_hop_group_members_attribute = _ut_set_next_hop_group_members_attribute;
+            sai_next_hop_group_api = &ut_sai_next_hop_group_api;
+            bulk_set_calls = 0;
+            bulk_set_objects = 0;
+            m_oldMaxBulkSize = gMaxBulkSize;
+
+            m_fgNhgEntry.fg_nhg_name = "fgnhg_v4";
+            m_fgNhgEntry.configured_bucket_size = BUCKET_SIZE;
+            m_fgNhgEntry.real_bucket_size = BUCKET_SIZE;
+            m_fgNhgEntry.match_mode = FGMatchMode::NEXTHOP_BASED;
+
+            for (uint32_t i = 0; i < NHS_PER_BANK * NUM_BANKS; i++)
+            {
+                IpAddress ip("10.1.0." + to_string(i + 1));
+                m_fgNhgEntry.next_hops[ip] = { i / NHS_PER_BANK, "", false };
+                m_nhOids[NextHopKey(ip, "Ethernet0")] = 0x4000 + i;
+            }
+            gFgNhgOrch->calculateBankHashBucketStartIndices(&m_fgNhgEntry);
+
+            // Spread the next-hops of each bank over its buckets the same way sprayBankNhgMembers does
+            m_routeEntry.next_hop_group_id = 0x5000;
+            m_routeEntry.points_to_rif = false;
+            m_routeEntry.nhopgroup_members.resize(BUCKET_SIZE);
+            m_routeEntry.syncd_fgnhg_map.resize(NUM_BANKS);
+            for (uint32_t bank = 0; bank < NUM_BANKS; bank++)
+            {
+                vector<NextHopKey> bank_nhs = bankNextHops(bank);
+                m_routeEntry.inactive_to_active_map[bank] = bank;
+                for (uint32_t idx = m_fgNhgEntry.hash_bucket_indices[bank].start_index;
+                        idx <= m_fgNhgEntry.hash_bucket_indices[bank].end_index; idx++)
+                {
+                    const NextHopKey &nh = bank_nhs[idx % bank_nhs.size()];
+                    m_routeEntry.syncd_fgnhg_map[bank][nh].push_back(idx);
+                    m_routeEntry.active_nexthops.insert(nh);
+                    m_routeEntry.nhopgroup_members[idx] = 0x6000 + idx;
+                }
+            }
+        }
+
+        void PreTearDown() override
+        {
+            sai_next_hop_group_api = pold_sai_next_hop_group_api;
+            gMaxBulkSize = m_oldMaxBulkSize;
+        }
+
+        vector<NextHopKey> bankNextHops(uint32_t bank)
+        {
+            vector<NextHopKey> nhs;
+            for (const auto &nh : m_nhOids)
+            {
+                if (m_fgNhgEntry.next_hops[nh.first.ip_address].bank == bank)
+                {
+                    nhs.push_back(nh.first);
+                }
+            }
+            return nhs;
+        }
+
+        // Bank member changes for a single next-hop going down (is_add false) or coming back
+        vector<BankMemberChanges> memberChange(const NextHopKey &nexthop, bool is_add)
+        {
+            vector<BankMemberChanges> changes(NUM_BANKS);
+            for (const auto &nh : m_routeEntry.active_nexthops)
+            {
+                if (nh == nexthop)
+                {
+                    continue;
+                }
+                changes[m_fgNhgEntry.next_hops[nh.ip_address].bank].active_nhs.push_back(nh);
+            }
+
+            auto &bank_change = changes[m_fgNhgEntry.next_hops[nexthop.ip_address].bank];
+            if (is_add)
+            {
+                bank_change.nhs_to_add.push_back(nexthop);
+            }
+            else
+            {
+                bank_change.nhs_to_del.push_back(nexthop);
+            }
+            return changes;
+        }
+
+        void checkBankBalanced(uint32_t bank)
+        {
+            const auto &bank_map = m_routeEntry.syncd_fgnhg_map[bank];
+            uint32_t num_buckets = 1 + m_fgNhgEntry.hash_bucket_indices[bank].end_index -
+                m_fgNhgEntry.hash_bucket_indices[bank].start_index;
+            size_t total = 0;
+            for (const auto &nh : bank_map)
+            {
+                ASSERT_GE(nh.second.size(), num_buckets / bank_map.size());
+                ASSERT_LE(nh.second.size(), num_buckets / bank_map.size() + 1);
+                total += nh.second.size();
+            }
+            ASSERT_EQ(total, num_buckets);
+        }
+    };
+
+    TEST_F(FgNhgOrchTest, MemberFlapProgramsBucketsInBulk)
+    {
+        NextHopKey flapped = bankNextHops(0)[0];
+        size_t moved = m_routeEntry.syncd_fgnhg_map[0][flapped].size();
+
+        auto changes = memberChange(flapped, false);
+        ASSERT_TRUE(gFgNhgOrch->computeAndSetHashBucketChanges(&m_routeEntry, &m_fgNhgEntry,
+                    changes, m_nhOids, m_prefix));
+
+        ASSERT_EQ(bulk_set_calls, 1);
+        ASSERT_EQ(bulk_set_objects, moved);
+        ASSERT_TRUE(gFgNhgOrch->m_pendingBucketWrites.empty());
+        ASSERT_EQ(m_routeEntry.syncd_fgnhg_map[0].count(flapped), 0);
+        checkBankBalanced(0);
+
+        vector<FieldValueTuple> fvs;
+        Table stateRouteTable(m_state_db.get(), STATE_FG_ROUTE_TABLE_NAME);
+        ASSERT_TRUE(stateRouteTable.get(m_prefix.to_string(), fvs));
+        ASSERT_EQ(fvs.size(), moved);
+
+        // A smaller bulk size splits the same reassignment into several calls
+        gMaxBulkSize = 64;
+        bulk_set_calls = 0;
+        bulk_set_objects = 0;
+        changes = memberChange(flapped, true);
+        ASSERT_TRUE(gFgNhgOrch->computeAndSetHashBucketChanges(&m_routeEntry, &m_fgNhgEntry,
+                    changes, m_nhOids, m_prefix));
+        ASSERT_EQ(bulk_set_objects, m_routeEntry.syncd_fgnhg_map[0][flapped].size());
+        ASSERT_EQ(bulk_set_calls, (bulk_set_objects + 63) / 64);
+        checkBankBalanced(0);
+    }
+
+    TEST_F(FgNhgOrchTest, BucketReassignmentBenchmark)
+    {
+        const int iterations = 200;
+        vector<NextHopKey> nhs = bankNextHops(1);
+        size_t queued = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            const NextHopKey &flapped = nhs[i % nhs.size()];
+            for (bool is_add : { false, true })
+            {
+                auto changes = memberChange(flapped, is_add);
+                ASSERT_TRUE(gFgNhgOrch->setActiveBankHashBucketChanges(&m_routeEntry, &m_fgNhgEntry,
+                            1, changes[1], m_nhOids, m_prefix));
+                queued += gFgNhgOrch->m_pendingBucketWrites.size();
+                gFgNhgOrch->m_pendingBucketWrites.clear();
+            }
+        }
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        checkBankBalanced(1);
+        ASSERT_EQ(bulk_set_calls, 0);
+        cout << "FG NHG bucket reassignment (" << BUCKET_SIZE << " buckets, " << NHS_PER_BANK
+             << " next-hops per bank): " << (double)elapsed / (iterations * 2) << " us per member change, "
+             << queued / (iterations * 2) << " buckets moved on average" << endl;
+    }
+}
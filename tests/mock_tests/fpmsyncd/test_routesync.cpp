@@ -7,6 +7,7 @@
 #include "fpmsyncd/routesync.h"
 #include "fpmsyncd/fpmlink.h"
 #undef private
+#include "lib/route_nexthop_codec.h"
 
 #include <arpa/inet.h>
 #include <linux/rtnetlink.h>
@@ -1045,6 +1046,126 @@ TEST_F(FpmSyncdResponseTest, TestGetNextHopWt)
     EXPECT_EQ(m_mockRouteSync.getNextHopWt(test_route.get()), "1,1");
 }
 
+// Checks that next hops packed from netlink match the packed string fields
+TEST_F(FpmSyncdResponseTest, TestGetPackedNextHops)
+{
+    EXPECT_CALL(m_mockRouteSync, getIfName(_, _, _)).WillRepeatedly(Return(false));
+
+    auto test_route = create_route("10.1.2.0");
+    rtnl_nexthop* nh1 = create_nexthop(test_gateway);
+    rtnl_nexthop* nh2 = create_nexthop(test_gateway_);
+    rtnl_route_nh_set_weight(nh2, 3);
+    rtnl_route_add_nexthop(test_route.get(), nh1);
+    rtnl_route_add_nexthop(test_route.get(), nh2);
+
+    string packed, intf_list;
+    ASSERT_TRUE(m_mockRouteSync.getPackedNextHops(test_route.get(), packed, intf_list));
+    EXPECT_TRUE(intf_list.empty());
+
+    string gw_list, mpls_list;
+    m_mockRouteSync.getNextHopList(test_route.get(), gw_list, mpls_list, intf_list);
+    vector<FieldValueTuple> fvs = {{"protocol", "static"}, {"nexthop", gw_list}, {"ifname", intf_list},
+                                   {"weight", m_mockRouteSync.getNextHopWt(test_route.get())}};
+    ASSERT_TRUE(packRouteNextHops(fvs));
+    EXPECT_EQ(fvValue(fvs.back()), packed);
+
+    // A next hop without a gateway gets the zero address of the route family
+    auto direct_route = create_route("10.1.3.0");
+    rtnl_nexthop* nh3 = rtnl_route_nh_alloc();
+    rtnl_route_nh_set_ifindex(nh3, 10);
+    rtnl_route_add_nexthop(direct_route.get(), nh3);
+
+    packed.clear();
+    intf_list.clear();
+    ASSERT_TRUE(m_mockRouteSync.getPackedNextHops(direct_route.get(), packed, intf_list));
+    EXPECT_EQ(intf_list, "unknown");
+
+    fvs = {{"protocol", "static"}, {"nexthop", "0.0.0.0"}, {"ifname", "unknown"}, {"weight", "1"}};
+    ASSERT_TRUE(packRouteNextHops(fvs));
+    EXPECT_EQ(fvValue(fvs.back()), packed);
+}
+
+TEST_F(FpmSyncdResponseTest, TestRouteLatencySampling)
+{
+    shared_ptr<swss::DBConnector> state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+    m_routeSync.m_latencySampling = 2;
+    m_routeSync.m_stateDb = state_db;
+    m_routeSync.m_routeLatency = make_unique<RouteLatencyRecorder>(state_db.get());
+
+    auto hasTimestamp = [this](const string& key) {
+        Table route_table(m_db.get(), APP_ROUTE_TABLE_NAME);
+        vector<FieldValueTuple> fvs;
+        EXPECT_TRUE(route_table.get(key, fvs));
+        return any_of(fvs.begin(), fvs.end(), [](const FieldValueTuple& fv) { return fvField(fv) == ROUTE_LATENCY_TS_FIELD; });
+    };
+
+    // Only the second of two route updates is sampled
+    RouteTableFieldValueTupleWrapper first{"10.1.1.0/24", "static"};
+    first.blackhole = "true";
+    m_routeSync.setRouteWithWarmRestart(first, *m_routeSync.m_routeTable);
+    RouteTableFieldValueTupleWrapper second{"10.1.2.0/24", "static"};
+    second.blackhole = "true";
+    m_routeSync.setRouteWithWarmRestart(second, *m_routeSync.m_routeTable);
+
+    EXPECT_FALSE(hasTimestamp("10.1.1.0/24"));
+    EXPECT_TRUE(hasTimestamp("10.1.2.0/24"));
+    ASSERT_EQ(m_routeSync.m_pendingLatency.size(), 1);
+    ASSERT_EQ(m_routeSync.m_pendingLatency.count("10.1.2.0/24"), 1);
+
+    // The offload reply of the sampled route closes the measurement
+    EXPECT_CALL(m_mockFpm, send(_)).Times(2).WillRepeatedly(Return(true));
+    m_routeSync.onRouteResponse("10.1.1.0/24", {{"err_str", "SWSS_RC_SUCCESS"}, {"protocol", "static"}});
+    m_routeSync.onRouteResponse("10.1.2.0/24", {{"err_str", "SWSS_RC_SUCCESS"}, {"protocol", "static"}});
+    EXPECT_TRUE(m_routeSync.m_pendingLatency.empty());
+
+    Table latency_table(state_db.get(), STATE_ROUTE_LATENCY_TABLE_NAME);
+    string count;
+    ASSERT_TRUE(latency_table.hget("fpm_to_offload", "count", count));
+    EXPECT_EQ(count, "1");
+}
+
+TEST_F(FpmSyncdResponseTest, TestRouteLatencyPendingExpiry)
+{
+    shared_ptr<swss::DBConnector> state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+    m_routeSync.m_latencySampling = 1;
+    m_routeSync.m_stateDb = state_db;
+    m_routeSync.m_routeLatency = make_unique<RouteLatencyRecorder>(state_db.get());
+
+    // A full map of samples whose response never came back
+    auto stale = RouteLatencyRecorder::now() - 2 * ROUTE_LATENCY_PENDING_TIMEOUT_US;
+    for (uint32_t i = 0; i < ROUTE_LATENCY_MAX_PENDING; i++)
+    {
+        m_routeSync.m_pendingLatency["stale" + to_string(i)] = stale;
+    }
+
+    RouteTableFieldValueTupleWrapper route{"10.1.3.0/24", "static"};
+    route.blackhole = "true";
+    m_routeSync.setRouteWithWarmRestart(route, *m_routeSync.m_routeTable);
+
+    ASSERT_EQ(m_routeSync.m_pendingLatency.size(), 1);
+    ASSERT_EQ(m_routeSync.m_pendingLatency.count("10.1.3.0/24"), 1);
+
+    // The latest update of the route keeps the newest stamp
+    m_routeSync.m_pendingLatency["10.1.3.0/24"] = stale;
+    m_routeSync.setRouteWithWarmRestart(route, *m_routeSync.m_routeTable);
+    EXPECT_GT(m_routeSync.m_pendingLatency["10.1.3.0/24"], stale);
+
+    // An unsampled update drops the pending sample of the route
+    m_routeSync.m_latencySampling = 2;
+    m_routeSync.m_latencyCounter = 0;
+    m_routeSync.setRouteWithWarmRestart(route, *m_routeSync.m_routeTable);
+    EXPECT_TRUE(m_routeSync.m_pendingLatency.empty());
+
+    // Samples older than the timeout are not recorded
+    m_routeSync.m_pendingLatency["10.1.3.0/24"] = stale;
+    EXPECT_CALL(m_mockFpm, send(_)).WillOnce(Return(true));
+    m_routeSync.onRouteResponse("10.1.3.0/24", {{"err_str", "SWSS_RC_SUCCESS"}, {"protocol", "static"}});
+
+    Table latency_table(state_db.get(), STATE_ROUTE_LATENCY_TABLE_NAME);
+    string count;
+    EXPECT_FALSE(latency_table.hget("fpm_to_offload", "count", count));
+}
+
 class WarmRestartRouteSyncTest : public ::testing::Test
 {
 public:
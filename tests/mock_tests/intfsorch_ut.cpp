@@ -1,10 +1,13 @@
 #define private public // make Directory::m_values available to clean it.
 #include "directory.h"
+#include "crmorch.h"
 #undef private
 #include "gtest/gtest.h"
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <vector>
 
@@ -36,6 +39,53 @@ namespace intfsorch_test
         return SAI_STATUS_SUCCESS;
     }
 
+    uint32_t bulk_route_calls = 0;
+    uint32_t bulk_create_routes = 0;
+    uint32_t bulk_remove_routes = 0;
+    uint32_t single_route_calls = 0;
+    sai_route_api_t *pold_sai_route_api;
+    sai_route_api_t ut_sai_route_api;
+
+    sai_status_t _ut_create_route_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_route_entry_t *route_entry,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_route_calls++;
+        bulk_create_routes += object_count;
+        return pold_sai_route_api->create_route_entries(object_count, route_entry, attr_count, attr_list, mode, object_statuses);
+    }
+
+    sai_status_t _ut_remove_route_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_route_entry_t *route_entry,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_route_calls++;
+        bulk_remove_routes += object_count;
+        return pold_sai_route_api->remove_route_entries(object_count, route_entry, mode, object_statuses);
+    }
+
+    sai_status_t _ut_create_route_entry(
+            _In_ const sai_route_entry_t *route_entry,
+            _In_ uint32_t attr_count,
+            _In_ const sai_attribute_t *attr_list)
+    {
+        single_route_calls++;
+        return pold_sai_route_api->create_route_entry(route_entry, attr_count, attr_list);
+    }
+
+    sai_status_t _ut_remove_route_entry(
+            _In_ const sai_route_entry_t *route_entry)
+    {
+        single_route_calls++;
+        return pold_sai_route_api->remove_route_entry(route_entry);
+    }
+
     struct IntfsOrchTest : public ::testing::Test
     {
         shared_ptr<swss::DBConnector> m_app_db;
@@ -62,6 +112,15 @@ namespace intfsorch_test
             sai_router_intfs_api->create_router_interface = _ut_create_router_interface;
             sai_router_intfs_api->remove_router_interface = _ut_remove_router_interface;
 
+            pold_sai_route_api = sai_route_api;
+            ut_sai_route_api = *sai_route_api;
+            sai_route_api = &ut_sai_route_api;
+
+            sai_route_api->create_route_entries = _ut_create_route_entries;
+            sai_route_api->remove_route_entries = _ut_remove_route_entries;
+            sai_route_api->create_route_entry = _ut_create_route_entry;
+            sai_route_api->remove_route_entry = _ut_remove_route_entry;
+
             m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
             m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
             m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
@@ -292,6 +351,7 @@ namespace intfsorch_test
             gFlowCounterRouteOrch = nullptr;
 
             sai_router_intfs_api = pold_sai_rif_api;
+            sai_route_api = pold_sai_route_api;
             ut_helper::uninitSaiApi();
         }
     };
@@ -394,4 +454,60 @@ namespace intfsorch_test
         m_syncdIntfses = gIntfsOrch->getSyncdIntfses();
         ASSERT_EQ(m_syncdIntfses["Loopback3"].vrf_id, gVirtualRouterId);    
     }
-}
\ No newline at end of file
+
+    TEST_F(IntfsOrchTest, Ip2MeRoutesBulkBenchmark)
+    {
+        const uint32_t loopbacks = 1024;
+
+        // Cold boot: every loopback and its IPv4 and IPv6 address arrive in one pass
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        for (uint32_t i = 0; i < loopbacks; i++)
+        {
+            string alias = "Loopback" + to_string(i);
+            entries.push_back({alias, "SET", {}});
+            entries.push_back({alias + ":10." + to_string(i / 256) + "." + to_string(i % 256) + ".1/32", "SET",
+                               {{"scope", "global"}, {"family", "IPv4"}}});
+            entries.push_back({alias + ":fc00::" + to_string(i) + "/128", "SET",
+                               {{"scope", "global"}, {"family", "IPv6"}}});
+        }
+        auto consumer = dynamic_cast<Consumer *>(gIntfsOrch->getExecutor(APP_INTF_TABLE_NAME));
+        consumer->addToSync(entries);
+
+        auto v4_used = gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV4_ROUTE).countersMap["STATS"].usedCounter;
+        auto v6_used = gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV6_ROUTE).countersMap["STATS"].usedCounter;
+
+        bulk_route_calls = bulk_create_routes = bulk_remove_routes = single_route_calls = 0;
+        auto start = chrono::steady_clock::now();
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        ASSERT_EQ(consumer->m_toSync.size(), 0);
+        ASSERT_EQ(single_route_calls, 0);
+        ASSERT_EQ(bulk_create_routes, 2 * loopbacks);
+        ASSERT_EQ(bulk_route_calls, (2 * loopbacks + gMaxBulkSize - 1) / gMaxBulkSize);
+        ASSERT_EQ(gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV4_ROUTE).countersMap["STATS"].usedCounter, v4_used + loopbacks);
+        ASSERT_EQ(gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV6_ROUTE).countersMap["STATS"].usedCounter, v6_used + loopbacks);
+        cout << "IP2me routes (" << 2 * loopbacks << " addresses): " << (double)elapsed / (2 * loopbacks)
+             << " us per address, " << bulk_route_calls << " bulk calls" << endl;
+
+        // An address removed and added back in the same pass keeps its route
+        entries.clear();
+        entries.push_back({"Loopback0:10.0.0.1/32", "DEL", {}});
+        consumer->addToSync(entries);
+        entries.clear();
+        entries.push_back({"Loopback0:10.0.0.1/32", "SET", {{"scope", "global"}, {"family", "IPv4"}}});
+        consumer->addToSync(entries);
+        entries.clear();
+        entries.push_back({"Loopback1:fc00::1/128", "DEL", {}});
+        consumer->addToSync(entries);
+
+        bulk_route_calls = bulk_create_routes = bulk_remove_routes = single_route_calls = 0;
+        static_cast<Orch *>(gIntfsOrch)->doTask();
+        ASSERT_EQ(single_route_calls, 0);
+        ASSERT_EQ(bulk_remove_routes, 2);
+        ASSERT_EQ(bulk_create_routes, 1);
+        ASSERT_EQ(gIntfsOrch->getSyncdIntfses().at("Loopback0").ip_addresses.size(), 2);
+        ASSERT_EQ(gIntfsOrch->getSyncdIntfses().at("Loopback1").ip_addresses.size(), 1);
+        ASSERT_EQ(gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV6_ROUTE).countersMap["STATS"].usedCounter, v6_used + loopbacks - 1);
+    }
+}
@@ -53,5 +53,59 @@ namespace mirrororch_test
         auto ret = gMirrorOrch->setUnsetPortMirror(dummyPort, /*ingress*/ false, /*set*/ true, /*sessionId*/ SAI_NULL_OBJECT_ID);
         ASSERT_FALSE(ret);
     }
-}
 
+    TEST_F(MirrorOrchTest, SessionIndexFollowsNeighbor)
+    {
+        ASSERT_NE(gMirrorOrch, nullptr);
+
+        const string name = "index_session";
+        const IpAddress dstIp("10.0.0.1");
+        const IpAddress nexthopIp("10.1.0.1");
+        const sai_object_id_t vlanOid = 0x2600000000001;
+        const MacAddress mac("00:01:02:03:04:05");
+
+        MirrorEntry session("");
+        session.dstIp = dstIp;
+        session.src_port = "PortChannel1,Ethernet0";
+        session.neighborInfo.portId = SAI_NULL_OBJECT_ID;
+        gMirrorOrch->m_syncdMirrors.emplace(name, session);
+        gMirrorOrch->indexSession(name, session);
+
+        ASSERT_EQ(gMirrorOrch->m_dstIpSessions[dstIp].count(name), 1);
+        ASSERT_EQ(gMirrorOrch->m_srcPortSessions["PortChannel1"].count(name), 1);
+        ASSERT_EQ(gMirrorOrch->m_srcPortSessions["Ethernet0"].count(name), 1);
+        ASSERT_EQ(gMirrorOrch->m_neighborPortSessions.count("Vlan1000"), 0);
+
+        // The session resolves to a neighbor on a VLAN through a next hop
+        auto& entry = gMirrorOrch->m_syncdMirrors.at(name);
+        entry.nexthopInfo.nexthop = NextHopKey(nexthopIp, string("Vlan1000"));
+        entry.neighborInfo.port.m_type = Port::VLAN;
+        entry.neighborInfo.port.m_alias = "Vlan1000";
+        entry.neighborInfo.port.m_vlan_info.vlan_oid = vlanOid;
+        entry.neighborInfo.mac = mac;
+        gMirrorOrch->indexSession(name, entry);
+
+        ASSERT_EQ(gMirrorOrch->m_nexthopIpSessions[nexthopIp].count(name), 1);
+        ASSERT_EQ(gMirrorOrch->m_neighborPortSessions["Vlan1000"].count(name), 1);
+        ASSERT_EQ(gMirrorOrch->m_fdbSessions[make_pair(vlanOid, mac)].count(name), 1);
+
+        // An FDB update for another MAC in the VLAN does not reach the session
+        FdbUpdate update;
+        update.entry.bv_id = vlanOid;
+        update.entry.mac = MacAddress("00:01:02:03:04:06");
+        update.port.m_port_id = 0x1000000000001;
+        update.add = true;
+        gMirrorOrch->updateFdb(update);
+        ASSERT_EQ(entry.neighborInfo.portId, SAI_NULL_OBJECT_ID);
+
+        gMirrorOrch->unindexSession(name);
+        gMirrorOrch->m_syncdMirrors.erase(name);
+
+        ASSERT_EQ(gMirrorOrch->m_dstIpSessions.count(dstIp), 0);
+        ASSERT_EQ(gMirrorOrch->m_nexthopIpSessions.count(nexthopIp), 0);
+        ASSERT_EQ(gMirrorOrch->m_neighborPortSessions.count("Vlan1000"), 0);
+        ASSERT_EQ(gMirrorOrch->m_srcPortSessions.count("PortChannel1"), 0);
+        ASSERT_EQ(gMirrorOrch->m_fdbSessions.count(make_pair(vlanOid, mac)), 0);
+        ASSERT_EQ(gMirrorOrch->m_sessionKeys.count(name), 0);
+    }
+}
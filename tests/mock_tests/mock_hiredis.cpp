@@ -1,13 +1,21 @@
 #include <stdlib.h>
 #include <hiredis/hiredis.h>
 #include <iostream>
+#include <deque>
 
 // Add a global redisReply for user to mock
 redisReply *mockReply = nullptr;
+// Replies handed out in order before mockReply, to script a pipeline
+std::deque<redisReply *> mockReplies;
 
 int redisGetReply(redisContext *c, void **reply)
 {
-    if (mockReply == nullptr)
+    if (!mockReplies.empty())
+    {
+        *reply = mockReplies.front();
+        mockReplies.pop_front();
+    }
+    else if (mockReply == nullptr)
     {
         *reply = calloc(sizeof(redisReply), 1);
         ((redisReply *)*reply)->type = 3;
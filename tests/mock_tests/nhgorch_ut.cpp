@@ -0,0 +1,226 @@
+#include "mock_orch_test.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace nhgorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    uint32_t bulk_create_objects;
+    uint32_t bulk_remove_objects;
+    uint32_t bulk_set_objects;
+    uint32_t bulk_calls;
+    uint32_t single_set_calls;
+    sai_object_id_t next_oid;
+    sai_next_hop_group_api_t ut_sai_next_hop_group_api;
+    sai_next_hop_group_api_t *pold_sai_next_hop_group_api;
+
+    sai_status_t _ut_create_next_hop_group(
+            _Out_ sai_object_id_t *next_hop_group_id,
+            _In_ sai_object_id_t switch_id,
+            _In_ uint32_t attr_count,
+            _In_ const sai_attribute_t *attr_list)
+    {
+        *next_hop_group_id = next_oid++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_remove_next_hop_group(
+            _In_ sai_object_id_t next_hop_group_id)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_create_next_hop_group_members(
+            _In_ sai_object_id_t switch_id,
+            _In_ uint32_t object_count,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_object_id_t *object_id,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_calls++;
+        bulk_create_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_id[i] = next_oid++;
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_remove_next_hop_group_members(
+            _In_ uint32_t object_count,
+            _In_ const sai_object_id_t *object_id,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_calls++;
+        bulk_remove_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_set_next_hop_group_members_attribute(
+            _In_ uint32_t object_count,
+            _In_ const sai_object_id_t *object_id,
+            _In_ const sai_attribute_t *attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        bulk_calls++;
+        bulk_set_objects += object_count;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_set_next_hop_group_member_attribute(
+            _In_ sai_object_id_t next_hop_group_member_id,
+            _In_ const sai_attribute_t *attr)
+    {
+        single_set_calls++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class NhgOrchTest : public MockOrchTest
+    {
+    protected:
+        static const uint32_t MAX_NEXT_HOPS = 513;
+
+        void ApplyInitialConfigs() override
+        {
+            pold_sai_next_hop_group_api = sai_next_hop_group_api;
+            ut_sai_next_hop_group_api = *sai_next_hop_group_api;
+            ut_sai_next_hop_group_api.create_next_hop_group = _ut_create_next_hop_group;
+            ut_sai_next_hop_group_api.remove_next_hop_group = _ut_remove_next_hop_group;
+            ut_sai_next_hop_group_api.create_next_hop_group_members = _ut_create_next_hop_group_members;
+            ut_sai_next_hop_group_api.remove_next_hop_group_members = _ut_remove_next_hop_group_members;
+            ut_sai_next_hop_group_api.set_next_hop_group_members_attribute = _ut_set_next_hop_group_members_attribute;
+            ut_sai_next_hop_group_api.set_next_hop_group_member_attribute = _ut_set_next_hop_group_member_attribute;
+            sai_next_hop_group_api = &ut_sai_next_hop_group_api;
+            next_oid = 0x8000;
+            resetCounters();
+
+            // Next hops known to NeighOrch, the group members only need their SAI IDs
+            for (uint32_t i = 0; i < MAX_NEXT_HOPS; i++)
+            {
+                gNeighOrch->m_syncdNextHops[nextHop(i)] = { 0x4000 + i, 0, 0 };
+            }
+        }
+
+        void PreTearDown() override
+        {
+            sai_next_hop_group_api = pold_sai_next_hop_group_api;
+        }
+
+        void resetCounters()
+        {
+            bulk_create_objects = 0;
+            bulk_remove_objects = 0;
+            bulk_set_objects = 0;
+            bulk_calls = 0;
+            single_set_calls = 0;
+        }
+
+        NextHopKey nextHop(uint32_t i)
+        {
+            return NextHopKey("10.1." + to_string(i / 256) + "." + to_string(i % 256) + "@Ethernet0");
+        }
+
+        // Key of next hops [first, first + size), all of the given weight but the one at weighted
+        NextHopGroupKey groupKey(uint32_t first, uint32_t size, uint32_t weight = 1,
+                                 uint32_t weighted = UINT32_MAX, uint32_t other_weight = 1)
+        {
+            string nhs;
+            string weights;
+            for (uint32_t i = first; i < first + size; i++)
+            {
+                nhs += (nhs.empty() ? "" : ",") + nextHop(i).to_string();
+                weights += (weights.empty() ? "" : ",") + to_string(i == weighted ? other_weight : weight);
+            }
+            return NextHopGroupKey(nhs, weights);
+        }
+    };
+
+    TEST_F(NhgOrchTest, UpdateSubmitsOnlyChangedMembers)
+    {
+        NextHopGroup nhg(groupKey(0, 64), false);
+        ASSERT_TRUE(nhg.sync());
+        ASSERT_EQ(bulk_create_objects, 64);
+
+        // A weight change is a single bulk set, the members are kept
+        resetCounters();
+        ASSERT_TRUE(nhg.update(groupKey(0, 64, 1, 10, 5)));
+        ASSERT_EQ(bulk_calls, 1);
+        ASSERT_EQ(bulk_set_objects, 1);
+        ASSERT_EQ(bulk_create_objects, 0);
+        ASSERT_EQ(bulk_remove_objects, 0);
+        ASSERT_EQ(single_set_calls, 0);
+        ASSERT_EQ(nhg.m_members.at(nextHop(10)).getWeight(), 5);
+
+        // Replacing one next hop touches only that member
+        resetCounters();
+        ASSERT_TRUE(nhg.update(groupKey(1, 64, 1, 10, 5)));
+        ASSERT_EQ(bulk_create_objects, 1);
+        ASSERT_EQ(bulk_remove_objects, 1);
+        ASSERT_EQ(bulk_set_objects, 0);
+        ASSERT_EQ(nhg.m_members.size(), 64);
+        ASSERT_EQ(nhg.m_members.count(nextHop(0)), 0);
+        ASSERT_TRUE(nhg.m_members.at(nextHop(64)).isSynced());
+        ASSERT_EQ(gNeighOrch->m_syncdNextHops[nextHop(0)].ref_count, 0);
+        ASSERT_EQ(gNeighOrch->m_syncdNextHops[nextHop(64)].ref_count, 1);
+
+        // Members skipped earlier are synced on the next update
+        gNeighOrch->m_syncdNextHops[nextHop(65)].nh_flags |= NHFLAGS_IFDOWN;
+        resetCounters();
+        ASSERT_TRUE(nhg.update(groupKey(1, 65)));
+        ASSERT_EQ(bulk_create_objects, 0);
+        ASSERT_EQ(bulk_set_objects, 1);
+        ASSERT_FALSE(nhg.m_members.at(nextHop(65)).isSynced());
+
+        gNeighOrch->m_syncdNextHops[nextHop(65)].nh_flags &= ~NHFLAGS_IFDOWN;
+        resetCounters();
+        ASSERT_TRUE(nhg.update(groupKey(1, 65)));
+        ASSERT_EQ(bulk_create_objects, 1);
+        ASSERT_EQ(bulk_remove_objects, 0);
+        ASSERT_TRUE(nhg.m_members.at(nextHop(65)).isSynced());
+    }
+
+    TEST_F(NhgOrchTest, UpdateBenchmark)
+    {
+        const uint32_t iterations = 200;
+
+        for (uint32_t size : { 64u, 512u })
+        {
+            NextHopGroup nhg(groupKey(0, size), false);
+            ASSERT_TRUE(nhg.sync());
+
+            // Each update moves the group one next hop along and reweights one member
+            resetCounters();
+            auto start = chrono::steady_clock::now();
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                uint32_t first = (i + 1) % 2;
+                ASSERT_TRUE(nhg.update(groupKey(first, size, 1, first + size / 2, 1 + i % 3)));
+            }
+            auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+            ASSERT_EQ(bulk_create_objects, iterations);
+            ASSERT_EQ(bulk_remove_objects, iterations);
+            ASSERT_EQ(single_set_calls, 0);
+            ASSERT_EQ(nhg.m_members.size(), size);
+            cout << "NHG update (" << size << " members): " << (double)elapsed / iterations
+                 << " us per update, " << (double)(bulk_create_objects + bulk_remove_objects + bulk_set_objects) / iterations
+                 << " members programmed on average" << endl;
+        }
+    }
+}
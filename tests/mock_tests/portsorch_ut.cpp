@@ -99,6 +99,26 @@ namespace portsorch_test
         return status;
     }
 
+    sai_status_t _ut_stub_sai_get_ports_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_sai_get_port_attribute(object_id[i], attr_count[i], attr_list[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
     uint32_t _sai_set_pfc_mode_count;
     uint32_t _sai_set_admin_state_up_count;
     uint32_t _sai_set_admin_state_down_count;
@@ -274,6 +294,7 @@ namespace portsorch_test
         ut_sai_port_api = *sai_port_api;
         pold_sai_port_api = sai_port_api;
         ut_sai_port_api.get_port_attribute = _ut_stub_sai_get_port_attribute;
+        ut_sai_port_api.get_ports_attribute = _ut_stub_sai_get_ports_attribute;
         ut_sai_port_api.set_port_attribute = _ut_stub_sai_set_port_attribute;
         sai_port_api = &ut_sai_port_api;
     }
@@ -2698,6 +2719,80 @@ namespace portsorch_test
         _unhook_sai_port_api();
     }
 
+    /*
+     * Test case: Supported FEC modes are taken from the port capability cache when present
+     * and newly discovered ports are saved to it once port init is done
+     **/
+    TEST_F(PortsOrchTest, PortCapabilityCacheSupportedFecModes)
+    {
+        _hook_sai_port_api();
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        const string cachePath = "/tmp/port_capability_cache_ut.json";
+
+        not_support_fetching_fec = false;
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        ASSERT_GE(gPortsOrch->m_portListLaneMap.size(), 2);
+        const auto cachedLanes = gPortsOrch->m_portListLaneMap.cbegin()->first;
+        const auto queriedLanes = std::next(gPortsOrch->m_portListLaneMap.cbegin())->first;
+
+        // Cache a FEC mode list that differs from what SAI reports
+        {
+            PortCapabilityCache cache;
+            cache.init(cachePath, "ut_platform", "ut_hwsku", "ut_version");
+            cache.setSupportedFecModes(cachedLanes, { SAI_PORT_FEC_MODE_NONE });
+            ASSERT_TRUE(cache.flush());
+        }
+        gPortsOrch->m_portCapCache.init(cachePath, "ut_platform", "ut_hwsku", "ut_version");
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        PortSupportedFecModes expected = { SAI_PORT_FEC_MODE_NONE };
+        ASSERT_EQ(gPortsOrch->m_portSupportedFecModes[gPortsOrch->m_portListLaneMap[cachedLanes]].data, expected);
+
+        expected = PortSupportedFecModes(mock_port_fec_modes.begin(), mock_port_fec_modes.end());
+        ASSERT_EQ(gPortsOrch->m_portSupportedFecModes[gPortsOrch->m_portListLaneMap[queriedLanes]].data, expected);
+
+        // Port init is done, so timings are published and every port is in the cache
+        string value;
+        Table timingTable = Table(m_state_db.get(), STATE_PORT_INIT_TIMING_TABLE_NAME);
+        ASSERT_TRUE(timingTable.hget("PortsOrch", "total_usec", value));
+
+        PortCapabilityCache cache;
+        PortSupportedFecModes cached;
+        cache.init(cachePath, "ut_platform", "ut_hwsku", "ut_version");
+        ASSERT_TRUE(cache.getSupportedFecModes(queriedLanes, cached));
+        ASSERT_EQ(cached, expected);
+        ASSERT_EQ(cache.entries.size(), ports.size());
+
+        // A cache built for another HWSKU is ignored
+        cache.init(cachePath, "ut_platform", "other_hwsku", "ut_version");
+        ASSERT_FALSE(cache.getSupportedFecModes(cachedLanes, cached));
+
+        // So is one built by another SAI or SONiC version
+        cache.init(cachePath, "ut_platform", "ut_hwsku", "other_version");
+        ASSERT_FALSE(cache.getSupportedFecModes(cachedLanes, cached));
+
+        gPortsOrch->m_portCapCache.init("", "", "", "");
+        std::remove(cachePath.c_str());
+        _unhook_sai_port_api();
+    }
+
     /*
      * Test case: Fetching SAI_PORT_ATTR_OPER_PORT_FEC_MODE
      **/
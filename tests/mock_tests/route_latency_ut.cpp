@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "ut_helper.h"
+#include "mock_table.h"
+#include "route_latency.h"
+
+namespace route_latency_test
+{
+    using namespace std;
+    using namespace swss;
+
+    TEST(RouteLatencyTest, HistogramBuckets)
+    {
+        // Exact below the sub bucket count, then 4 linear buckets per power of two
+        ASSERT_EQ(LatencyHistogram::bucketIndex(0), 0);
+        ASSERT_EQ(LatencyHistogram::bucketIndex(3), 3);
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(3), 4);
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(4)), 5);
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(1000)), 1024);
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(1024)), 1280);
+        ASSERT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+        ASSERT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::BUCKETS - 1), UINT64_MAX);
+
+        for (uint64_t us = 1; us < (1ULL << 40); us = us * 3 + 1)
+        {
+            auto index = LatencyHistogram::bucketIndex(us);
+            ASSERT_LT(us, LatencyHistogram::bucketUpperBound(index));
+            ASSERT_GE(us, LatencyHistogram::bucketUpperBound(index - 1));
+        }
+    }
+
+    TEST(RouteLatencyTest, HistogramPercentiles)
+    {
+        LatencyHistogram histogram;
+        ASSERT_EQ(histogram.percentile(99), 0);
+
+        for (uint64_t us = 1; us <= 100; us++)
+        {
+            histogram.record(us * 100);
+        }
+
+        ASSERT_EQ(histogram.count(), 100);
+        ASSERT_EQ(histogram.max(), 10000);
+        auto p50 = histogram.percentile(50);
+        ASSERT_GT(p50, 5000);
+        ASSERT_LE(p50, 5000 * 5 / 4);
+        ASSERT_EQ(histogram.percentile(100), 10001);
+    }
+
+    TEST(RouteLatencyTest, RecorderExport)
+    {
+        ::testing_db::reset();
+        DBConnector state_db("STATE_DB", 0);
+        RouteLatencyRecorder recorder(&state_db);
+        Table table(&state_db, STATE_ROUTE_LATENCY_TABLE_NAME);
+        string value;
+
+        recorder.record("fpm_to_sai", 100, 50);
+        recorder.flush();
+        ASSERT_EQ(recorder.getHistogram("fpm_to_sai"), nullptr);
+        ASSERT_FALSE(table.hget("fpm_to_sai", "count", value));
+
+        recorder.record("fpm_to_sai", 100, 300);
+        recorder.flush();
+        ASSERT_TRUE(table.hget("fpm_to_sai", "count", value));
+        ASSERT_EQ(value, "1");
+        ASSERT_TRUE(table.hget("fpm_to_sai", "lt_224", value));
+        ASSERT_EQ(value, "1");
+
+        // Held back by the export interval until forced
+        recorder.record("fpm_to_sai", 100, 400);
+        recorder.flush();
+        ASSERT_TRUE(table.hget("fpm_to_sai", "count", value));
+        ASSERT_EQ(value, "1");
+        recorder.flush(true);
+        ASSERT_TRUE(table.hget("fpm_to_sai", "count", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_TRUE(table.hget("fpm_to_sai", "max_us", value));
+        ASSERT_EQ(value, "300");
+    }
+}
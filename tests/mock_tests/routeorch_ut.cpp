@@ -10,6 +10,11 @@
 #include "mock_response_publisher.h"
 #include "mock_sai_api.h"
 #include "bulker.h"
+#include "route_nexthop_codec.h"
+#include "route_latency.h"
+
+#include <chrono>
+#include <iostream>
 
 extern string gMySwitchType;
 
@@ -1026,4 +1031,180 @@ namespace routeorch_test
         ASSERT_EQ(gRouteOrch->gRouteBulker.setting_entries_count(), 0);
         ASSERT_EQ(gRouteOrch->gRouteBulker.removing_entries_count(), 0);
     }
+
+    TEST_F(RouteOrchTest, RouteOrchPackedNextHops)
+    {
+        std::vector<FieldValueTuple> fvs{{"protocol", "bgp"}, {"nexthop", "10.0.0.2,10.0.0.3"},
+                                         {"ifname", "Ethernet0,Ethernet0"}, {"weight", "1,3"}};
+        std::vector<FieldValueTuple> packed = fvs;
+        ASSERT_TRUE(packRouteNextHops(packed));
+        ASSERT_EQ(packed.size(), 2);
+        ASSERT_EQ(fvField(packed[1]), ROUTE_PACKED_NEXTHOP_FIELD);
+
+        // The ZMQ producer also writes the field to APPL_DB, so it stays base64 text
+        const auto &packed_value = fvValue(packed[1]);
+        ASSERT_TRUE(std::all_of(packed_value.begin(), packed_value.end(),
+                                [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '+' || c == '/' || c == '='; }));
+        ASSERT_EQ(packed_value.size() % 4, 0);
+
+        // MPLS next hops keep the string form
+        std::vector<FieldValueTuple> mpls{{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"}, {"mpls_nh", "push10"}};
+        ASSERT_FALSE(packRouteNextHops(mpls));
+        ASSERT_EQ(mpls.size(), 3);
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"2.1.1.0/24", "SET", fvs});
+        entries.push_back({"2.1.2.0/24", "SET", packed});
+        entries.push_back({"2.1.3.0/24", "SET", {{ROUTE_PACKED_NEXTHOP_FIELD, "garbage"}}});
+
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // The packed route resolves to the same next hop group as the string one
+        const auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        const auto &string_nhg = routes.at(IpPrefix("2.1.1.0/24")).nhg_key;
+        const auto &packed_nhg = routes.at(IpPrefix("2.1.2.0/24")).nhg_key;
+        ASSERT_EQ(string_nhg.getSize(), 2);
+        ASSERT_EQ(packed_nhg, string_nhg);
+        ASSERT_EQ(packed_nhg.getNextHops().rbegin()->weight, 3);
+        ASSERT_EQ(routes.count(IpPrefix("2.1.3.0/24")), 0);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchLatencyHistogram)
+    {
+        auto now = RouteLatencyRecorder::now();
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"2.2.1.0/24", "SET", {{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"},
+                                                 {ROUTE_LATENCY_TS_FIELD, std::to_string(now - 500)}}});
+        // Replayed from APPL_DB long after fpmsyncd stamped it
+        entries.push_back({"2.2.2.0/24", "SET", {{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"},
+                                                 {ROUTE_LATENCY_TS_FIELD, "1"}}});
+        entries.push_back({"2.2.3.0/24", "SET", {{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"}}});
+
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        const auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        ASSERT_EQ(routes.count(IpPrefix("2.2.1.0/24")), 1);
+        ASSERT_EQ(routes.count(IpPrefix("2.2.2.0/24")), 1);
+
+        Table latency_table(m_state_db.get(), STATE_ROUTE_LATENCY_TABLE_NAME);
+        for (const auto &stage : {"fpm_to_orch", "orch_to_bulk", "sai_bulk", "fpm_to_sai"})
+        {
+            std::string count;
+            ASSERT_TRUE(latency_table.hget(stage, "count", count)) << stage;
+            ASSERT_EQ(count, "1") << stage;
+        }
+
+        std::string max_us;
+        ASSERT_TRUE(latency_table.hget("fpm_to_sai", "max_us", max_us));
+        ASSERT_GE(std::stoull(max_us), 500);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchLatencyStampNotPersisted)
+    {
+        Table app_route_table(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        std::vector<FieldValueTuple> fvs{{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"},
+                                         {ROUTE_LATENCY_TS_FIELD, std::to_string(RouteLatencyRecorder::now())}};
+        app_route_table.set("2.2.4.0/24", fvs);
+
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+
+        // Routes read back by bake() do not replay the stamp
+        gRouteOrch->bake();
+        auto it = consumer->m_toSync.find("2.2.4.0/24");
+        ASSERT_NE(it, consumer->m_toSync.end());
+        for (const auto &fv : kfvFieldsValues(it->second))
+        {
+            ASSERT_NE(fvField(fv), ROUTE_LATENCY_TS_FIELD);
+        }
+        consumer->m_toSync.clear();
+
+        // The stamped route is still programmed and its APPL_DB entry is left as is
+        consumer->addToSync(std::deque<KeyOpFieldsValuesTuple>{{"2.2.4.0/24", "SET", fvs}});
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        std::string nexthop;
+        ASSERT_TRUE(app_route_table.hget("2.2.4.0/24", "nexthop", nexthop));
+        ASSERT_EQ(gRouteOrch->getSyncdRoutes().at(gVirtualRouterId).count(IpPrefix("2.2.4.0/24")), 1);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchShmRouteReloadRemovesStaleRoutes)
+    {
+        std::vector<FieldValueTuple> fvs{{"nexthop", "10.0.0.2"}, {"ifname", "Ethernet0"}};
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(std::deque<KeyOpFieldsValuesTuple>{{"2.3.1.0/24", "SET", fvs},
+                                                               {"2.3.2.0/24", "SET", fvs},
+                                                               {"2.3.3.1/32", "SET", fvs}});
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        const auto &routes = gRouteOrch->getSyncdRoutes().at(gVirtualRouterId);
+        ASSERT_EQ(routes.count(IpPrefix("2.3.2.0/24")), 1);
+
+        // A SET from a record older than the reload is still pending
+        consumer->addToSync(std::deque<KeyOpFieldsValuesTuple>{{"2.3.4.0/24", "SET", fvs}});
+
+        // The reloaded table has the host route without its prefix length
+        static_cast<ZmqOrch *>(gRouteOrch)->onShmRouteReload(*consumer, {"2.3.1.0/24", "2.3.3.1"});
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(routes.count(IpPrefix("2.3.1.0/24")), 1);
+        ASSERT_EQ(routes.count(IpPrefix("2.3.3.1/32")), 1);
+        ASSERT_EQ(routes.count(IpPrefix("2.3.2.0/24")), 0);
+        ASSERT_EQ(routes.count(IpPrefix("2.3.4.0/24")), 0);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchPackedNextHopsDecodeBenchmark)
+    {
+        const int routes = 100000;
+        const std::string nexthops = "10.0.0.2,10.0.0.3,10.0.0.4,10.0.0.5";
+        const std::string ifnames = "Ethernet0,Ethernet4,Ethernet8,Ethernet12";
+        const std::string weights = "1,2,3,4";
+
+        std::vector<FieldValueTuple> packed{{"nexthop", nexthops}, {"ifname", ifnames}, {"weight", weights}};
+        ASSERT_TRUE(packRouteNextHops(packed));
+        const std::string &packed_nhs = fvValue(packed[0]);
+
+        // What RouteOrch does with the string fields
+        NextHopGroupKey string_nhg;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < routes; i++)
+        {
+            auto ipv = tokenize(nexthops, ',');
+            auto alsv = tokenize(ifnames, ',');
+            std::string nhg_str;
+            for (size_t j = 0; j < ipv.size(); j++)
+            {
+                if (j) nhg_str += NHG_DELIMITER;
+                nhg_str += ipv[j] + NH_DELIMITER + alsv[j];
+            }
+            string_nhg = NextHopGroupKey(nhg_str, weights);
+        }
+        auto string_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        NextHopGroupKey packed_nhg;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < routes; i++)
+        {
+            std::vector<PackedRouteNextHop> packed_nhv;
+            bool overlay = false;
+            ASSERT_TRUE(unpackRouteNextHops(packed_nhs, true, packed_nhv, overlay));
+            std::vector<NextHopKey> nhv;
+            nhv.reserve(packed_nhv.size());
+            for (const auto &packed_nh : packed_nhv)
+            {
+                nhv.emplace_back(packed_nh.ip_address, packed_nh.ifname);
+                nhv.back().weight = packed_nh.weight;
+            }
+            packed_nhg = NextHopGroupKey(nhv, overlay);
+        }
+        auto packed_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ASSERT_EQ(packed_nhg, string_nhg);
+        std::cout << "String next hops: " << (double)string_us * 1000 / routes << " ns/route, "
+                  << "packed next hops: " << (double)packed_us * 1000 / routes << " ns/route, "
+                  << packed_nhs.size() << " bytes vs " << nexthops.size() + ifnames.size() + weights.size() << " bytes" << std::endl;
+    }
 }
@@ -0,0 +1,237 @@
+#include "ut_helper.h"
+#include "saioffloadsession.h"
+
+namespace saioffloadsession_test
+{
+    using namespace std;
+
+    using IcmpBulker = SaiOffloadSessionBulker<sai_icmp_echo_api_t>;
+    using BfdBatch = SaiOffloadSessionStateBatch<sai_bfd_session_state_t>;
+
+    // What the fake SAI calls were asked to do and what they answer
+    vector<uint32_t> bulk_create_counts;
+    vector<uint32_t> bulk_remove_counts;
+    vector<sai_status_t> bulk_statuses;
+    sai_status_t bulk_status;
+    uint32_t single_creates;
+    uint32_t single_removes;
+    sai_object_id_t next_oid;
+
+    sai_status_t fake_bulk_create(sai_object_id_t, sai_object_type_t object_type, uint32_t object_count,
+            const uint32_t *, const sai_attribute_t **, sai_bulk_op_error_mode_t,
+            sai_object_id_t *object_id, sai_status_t *object_statuses)
+    {
+        EXPECT_EQ(object_type, SAI_OBJECT_TYPE_ICMP_ECHO_SESSION);
+        bulk_create_counts.push_back(object_count);
+        if (bulk_status == SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            return bulk_status;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = i < bulk_statuses.size() ? bulk_statuses[i] : SAI_STATUS_SUCCESS;
+            object_id[i] = object_statuses[i] == SAI_STATUS_SUCCESS ? next_oid++ : SAI_NULL_OBJECT_ID;
+        }
+        return bulk_status;
+    }
+
+    sai_status_t fake_bulk_remove(sai_object_type_t, uint32_t object_count, const sai_object_id_t *,
+            sai_bulk_op_error_mode_t, sai_status_t *object_statuses)
+    {
+        bulk_remove_counts.push_back(object_count);
+        if (bulk_status == SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            return bulk_status;
+        }
+
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = i < bulk_statuses.size() ? bulk_statuses[i] : SAI_STATUS_SUCCESS;
+        }
+        return bulk_status;
+    }
+
+    sai_status_t fake_create(sai_object_id_t *id, sai_object_id_t, uint32_t, const sai_attribute_t *)
+    {
+        single_creates++;
+        *id = next_oid++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t fake_remove(sai_object_id_t)
+    {
+        single_removes++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct SaiOffloadSessionTest : public ::testing::Test
+    {
+        vector<sai_attribute_t> attrs;
+
+        void SetUp() override
+        {
+            bulk_create_counts.clear();
+            bulk_remove_counts.clear();
+            bulk_statuses.clear();
+            bulk_status = SAI_STATUS_SUCCESS;
+            single_creates = 0;
+            single_removes = 0;
+            next_oid = 0x100;
+
+            sai_attribute_t attr;
+            attr.id = SAI_ICMP_ECHO_SESSION_ATTR_HW_LOOKUP_VALID;
+            attr.value.booldata = true;
+            attrs.push_back(attr);
+        }
+
+        IcmpBulker makeBulker(size_t max_bulk_size)
+        {
+            return IcmpBulker(fake_create, fake_remove, max_bulk_size, fake_bulk_create, fake_bulk_remove);
+        }
+    };
+
+    TEST_F(SaiOffloadSessionTest, BulkCreateAndRemove)
+    {
+        auto bulker = makeBulker(0);
+
+        sai_object_id_t ids[3];
+        sai_status_t statuses[3];
+        for (int i = 0; i < 3; i++)
+        {
+            bulker.create_entry(&ids[i], &statuses[i], &attrs);
+        }
+        ASSERT_EQ(bulker.creating_entries_count(), 3u);
+        bulker.flush();
+
+        ASSERT_EQ(bulk_create_counts, vector<uint32_t>({ 3 }));
+        ASSERT_EQ(single_creates, 0u);
+        ASSERT_EQ(bulker.creating_entries_count(), 0u);
+        for (int i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(statuses[i], SAI_STATUS_SUCCESS);
+            ASSERT_EQ(ids[i], static_cast<sai_object_id_t>(0x100 + i));
+        }
+
+        sai_status_t remove_statuses[3];
+        for (int i = 0; i < 3; i++)
+        {
+            bulker.remove_entry(&remove_statuses[i], ids[i]);
+        }
+        bulker.flush();
+
+        ASSERT_EQ(bulk_remove_counts, vector<uint32_t>({ 3 }));
+        ASSERT_EQ(single_removes, 0u);
+        for (int i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(remove_statuses[i], SAI_STATUS_SUCCESS);
+        }
+    }
+
+    TEST_F(SaiOffloadSessionTest, BulkCreatePartialFailure)
+    {
+        auto bulker = makeBulker(0);
+        bulk_statuses = { SAI_STATUS_SUCCESS, SAI_STATUS_INSUFFICIENT_RESOURCES, SAI_STATUS_SUCCESS };
+        bulk_status = SAI_STATUS_FAILURE;
+
+        sai_object_id_t ids[3];
+        sai_status_t statuses[3];
+        for (int i = 0; i < 3; i++)
+        {
+            bulker.create_entry(&ids[i], &statuses[i], &attrs);
+        }
+        bulker.flush();
+
+        // Each session gets its own result, the failed one isn't retried on its own
+        ASSERT_EQ(single_creates, 0u);
+        ASSERT_EQ(statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_NE(ids[0], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(statuses[1], SAI_STATUS_INSUFFICIENT_RESOURCES);
+        ASSERT_EQ(ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(statuses[2], SAI_STATUS_SUCCESS);
+        ASSERT_NE(ids[2], SAI_NULL_OBJECT_ID);
+    }
+
+    TEST_F(SaiOffloadSessionTest, BulkSplitByMaxSize)
+    {
+        auto bulker = makeBulker(2);
+
+        sai_object_id_t ids[5];
+        sai_status_t statuses[5];
+        for (int i = 0; i < 5; i++)
+        {
+            bulker.create_entry(&ids[i], &statuses[i], &attrs);
+        }
+        bulker.flush();
+
+        ASSERT_EQ(bulk_create_counts, vector<uint32_t>({ 2, 2, 1 }));
+        for (int i = 0; i < 5; i++)
+        {
+            ASSERT_EQ(statuses[i], SAI_STATUS_SUCCESS);
+        }
+    }
+
+    TEST_F(SaiOffloadSessionTest, FallbackWithoutBulkSupport)
+    {
+        auto bulker = makeBulker(0);
+        bulk_status = SAI_STATUS_NOT_IMPLEMENTED;
+
+        sai_object_id_t ids[2];
+        sai_status_t statuses[2];
+        for (int i = 0; i < 2; i++)
+        {
+            bulker.create_entry(&ids[i], &statuses[i], &attrs);
+        }
+        bulker.flush();
+
+        ASSERT_EQ(single_creates, 2u);
+        for (int i = 0; i < 2; i++)
+        {
+            ASSERT_EQ(statuses[i], SAI_STATUS_SUCCESS);
+            ASSERT_NE(ids[i], SAI_NULL_OBJECT_ID);
+        }
+
+        sai_status_t remove_statuses[2];
+        for (int i = 0; i < 2; i++)
+        {
+            bulker.remove_entry(&remove_statuses[i], ids[i]);
+        }
+        bulker.flush();
+
+        ASSERT_EQ(single_removes, 2u);
+        ASSERT_EQ(remove_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(remove_statuses[1], SAI_STATUS_SUCCESS);
+    }
+
+    TEST_F(SaiOffloadSessionTest, StateBatchCoalescesRepeatedStates)
+    {
+        BfdBatch batch;
+        batch.add(0x1, SAI_BFD_SESSION_STATE_DOWN);
+        batch.add(0x1, SAI_BFD_SESSION_STATE_DOWN);
+        batch.add(0x2, SAI_BFD_SESSION_STATE_UP);
+        batch.add(0x1, SAI_BFD_SESSION_STATE_UP);
+
+        ASSERT_EQ(batch.states.size(), 2u);
+        ASSERT_EQ(batch.states[0x1], vector<sai_bfd_session_state_t>({ SAI_BFD_SESSION_STATE_DOWN, SAI_BFD_SESSION_STATE_UP }));
+        ASSERT_EQ(batch.states[0x2], vector<sai_bfd_session_state_t>({ SAI_BFD_SESSION_STATE_UP }));
+    }
+
+    TEST_F(SaiOffloadSessionTest, StateBatchKeepsFlaps)
+    {
+        BfdBatch batch;
+        batch.add(0x1, SAI_BFD_SESSION_STATE_DOWN);
+        batch.add(0x1, SAI_BFD_SESSION_STATE_UP);
+
+        // A session that was UP went DOWN and back UP, both transitions are kept
+        auto transitions = BfdBatch::transitions(SAI_BFD_SESSION_STATE_UP, batch.states[0x1]);
+        ASSERT_EQ(transitions, vector<sai_bfd_session_state_t>({ SAI_BFD_SESSION_STATE_DOWN, SAI_BFD_SESSION_STATE_UP }));
+
+        // A session that was already DOWN only came UP
+        transitions = BfdBatch::transitions(SAI_BFD_SESSION_STATE_DOWN, batch.states[0x1]);
+        ASSERT_EQ(transitions, vector<sai_bfd_session_state_t>({ SAI_BFD_SESSION_STATE_UP }));
+
+        // Nothing changed for a session notified with its current state
+        transitions = BfdBatch::transitions(SAI_BFD_SESSION_STATE_UP, { SAI_BFD_SESSION_STATE_UP });
+        ASSERT_TRUE(transitions.empty());
+    }
+}
@@ -0,0 +1,381 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+
+#include "schema.h"
+#include "ut_helper.h"
+#include "orch_zmq_config.h"
+#include "mock_table.h"
+
+#define private public
+#include "shm_route_ring.h"
+#undef private
+
+#define protected public
+#include "orch.h"
+#include "zmqorch.h"
+#undef protected
+
+namespace shm_route_ring_test
+{
+    using namespace std;
+    using namespace swss;
+
+    const string ringName = "/swss_route_ring_ut";
+
+    class RouteCollectorOrch : public ZmqOrch
+    {
+    public:
+        RouteCollectorOrch(DBConnector *db, const vector<table_name_with_pri_t> &tables) :
+            ZmqOrch(db, tables, nullptr)
+        {
+        }
+
+        void doTask(ConsumerBase &consumer) override
+        {
+            tableName = consumer.getTableName();
+            for (auto &it : consumer.m_toSync)
+            {
+                routes.push_back(it.second);
+            }
+            consumer.m_toSync.clear();
+        }
+
+        void onShmRouteReload(ConsumerBase &consumer, const unordered_set<string> &keys) override
+        {
+            reloadedKeys = keys;
+        }
+
+        string tableName;
+        vector<KeyOpFieldsValuesTuple> routes;
+        unordered_set<string> reloadedKeys;
+    };
+
+    class RouteCounter : public ZmqMessageHandler
+    {
+    public:
+        void handleReceivedData(const std::vector<std::shared_ptr<KeyOpFieldsValuesTuple>>& kcos) override
+        {
+            received += kcos.size();
+        }
+
+        atomic<size_t> received{0};
+    };
+
+    class ShmRouteRingTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_pipeline = make_shared<RedisPipeline>(m_app_db.get());
+            m_consumerRing = ShmRouteRing::create(ringName, 1 << 20);
+            m_producerRing = ShmRouteRing::attach(ringName);
+            ASSERT_NE(m_producerRing, nullptr);
+        }
+
+        void TearDown() override
+        {
+            m_producerRing.reset();
+            m_consumerRing.reset();
+            shm_unlink(ringName.c_str());
+            unlink(("/dev/shm" + ringName + ".fifo").c_str());
+        }
+
+        string routeKey(uint32_t i)
+        {
+            return "10." + to_string(i / 65536) + "." + to_string((i / 256) % 256) + "." + to_string(i % 256) + "/32";
+        }
+
+        vector<FieldValueTuple> routeFields(uint32_t i)
+        {
+            return { { "nexthop", "10.0.0." + to_string(i % 4) + ",10.0.1." + to_string(i % 4) },
+                     { "ifname", "Ethernet0,Ethernet4" },
+                     { "protocol", "bgp" } };
+        }
+
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<RedisPipeline> m_pipeline;
+        shared_ptr<ShmRouteRing> m_consumerRing;
+        shared_ptr<ShmRouteRing> m_producerRing;
+    };
+
+    TEST_F(ShmRouteRingTest, RoutesReachRouteOrchTable)
+    {
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, m_producerRing);
+
+        vector<FieldValueTuple> fields = { { "nexthop", "10.0.0.1,10.0.0.2" }, { "ifname", "Ethernet0,Ethernet4" } };
+        vector<string> keys = { "10.1.0.0/24", "10.1.0.1", "Vrf-red:10.2.0.0/16", "fc00::/64",
+                                "Vrf-red:fc00::1", "0.0.0.0/0", "not-a-prefix" };
+        for (const auto &key : keys)
+        {
+            producer.set(key, fields);
+        }
+        producer.set({ KeyOpFieldsValuesTuple{ "Vrf-red:10.2.0.0/16", DEL_COMMAND, {} },
+                       KeyOpFieldsValuesTuple{ "10.3.0.0/24", SET_COMMAND, { { "blackhole", "true" } } } });
+        producer.del(vector<string>{ "not-a-prefix" });
+
+        // APPL_DB keeps the routes for visibility only
+        Table appl(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(appl.get("Vrf-red:fc00::1", values));
+        ASSERT_EQ(values, fields);
+        ASSERT_FALSE(appl.get("Vrf-red:10.2.0.0/16", values));
+
+        const int routeorch_pri = 5;
+        RouteCollectorOrch orch(m_app_db.get(), { { APP_ROUTE_TABLE_NAME, routeorch_pri } });
+        orch.addShmRouteConsumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, routeorch_pri, m_consumerRing);
+        auto executor = orch.getExecutor(string(APP_ROUTE_TABLE_NAME) + "_SHM");
+        ASSERT_NE(executor, nullptr);
+        ASSERT_EQ(executor->getPri(), routeorch_pri);
+        ASSERT_TRUE(executor->hasCachedData());
+
+        executor->readData();
+        while (executor->hasCachedData())
+        {
+            executor->execute();
+        }
+        ASSERT_EQ(orch.tableName, APP_ROUTE_TABLE_NAME);
+
+        // Pending entries are keyed, the later DEL replaces the SET of the same route
+        map<string, KeyOpFieldsValuesTuple> routes;
+        for (const auto &route : orch.routes)
+        {
+            routes[kfvKey(route)] = route;
+        }
+        ASSERT_EQ(routes.size(), keys.size() + 1);
+        for (const auto &key : keys)
+        {
+            ASSERT_EQ(routes.count(key), 1);
+        }
+        ASSERT_EQ(kfvOp(routes["Vrf-red:10.2.0.0/16"]), DEL_COMMAND);
+        ASSERT_EQ(kfvOp(routes["not-a-prefix"]), DEL_COMMAND);
+        ASSERT_EQ(kfvFieldsValues(routes["fc00::/64"]), fields);
+        ASSERT_EQ(kfvFieldsValues(routes["10.3.0.0/24"]), (vector<FieldValueTuple>{ { "blackhole", "true" } }));
+
+        // The table was loaded on the sync record, RouteOrch gets its keys to find removed routes
+        for (const auto &key : { "10.1.0.1", "Vrf-red:fc00::1", "10.3.0.0/24" })
+        {
+            ASSERT_EQ(orch.reloadedKeys.count(key), 1);
+        }
+    }
+
+    TEST_F(ShmRouteRingTest, ConsumerResetStartsNewGeneration)
+    {
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, m_producerRing);
+        producer.set("Vrf-red:10.0.0.0/24", routeFields(0));
+
+        // A restarted consumer drops the ring and the ids interned into it
+        m_consumerRing = ShmRouteRing::create(ringName, 1 << 20);
+        ShmRouteConsumerStateTable consumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, m_consumerRing, 128);
+        ASSERT_FALSE(consumer.hasCachedData());
+
+        producer.set("Vrf-red:10.0.0.0/24", routeFields(0));
+        deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+        ASSERT_EQ(entries.size(), 1);
+        ASSERT_EQ(kfvKey(entries[0]), "Vrf-red:10.0.0.0/24");
+        ASSERT_EQ(kfvFieldsValues(entries[0]), routeFields(0));
+    }
+
+    TEST_F(ShmRouteRingTest, CorruptRecordReloadsFromApplDb)
+    {
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, m_producerRing);
+        ShmRouteConsumerStateTable consumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, m_consumerRing, 128);
+        producer.set("10.0.0.0/24", routeFields(0));
+
+        // The first record claims more bytes than the ring holds
+        uint32_t bogus = 1 << 16;
+        m_producerRing->write(0, &bogus, sizeof(bogus));
+        auto generation = m_consumerRing->generation();
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+        ASSERT_TRUE(entries.empty());
+        ASSERT_EQ(m_consumerRing->generation(), generation + 1);
+
+        // APPL_DB is loaded once the producer has flushed it and sent the sync record
+        ASSERT_FALSE(consumer.hasCachedData());
+
+        // The dropped route comes back from APPL_DB, the next one also through the ring
+        producer.set("10.0.1.0/24", routeFields(1));
+        consumer.pops(entries);
+        ASSERT_TRUE(consumer.reloaded());
+        ASSERT_EQ(entries.size(), 3);
+        ASSERT_EQ(kfvKey(entries[2]), "10.0.1.0/24");
+        ASSERT_EQ(kfvFieldsValues(entries[2]), routeFields(1));
+
+        map<string, vector<FieldValueTuple>> reloaded;
+        for (size_t i = 0; i < 2; i++)
+        {
+            ASSERT_EQ(kfvOp(entries[i]), SET_COMMAND);
+            reloaded[kfvKey(entries[i])] = kfvFieldsValues(entries[i]);
+        }
+        ASSERT_EQ(reloaded["10.0.0.0/24"], routeFields(0));
+        ASSERT_EQ(reloaded["10.0.1.0/24"], routeFields(1));
+        ASSERT_FALSE(consumer.hasCachedData());
+    }
+
+    TEST_F(ShmRouteRingTest, IdleProducerStartsNewGeneration)
+    {
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, m_producerRing);
+        ShmRouteConsumerStateTable consumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, m_consumerRing, 128);
+        producer.set("10.0.0.0/24", routeFields(0));
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+        ASSERT_EQ(entries.size(), 1);
+        ASSERT_FALSE(consumer.reloaded());
+
+        // The consumer waits for the producer, which notices the reset without writing a route
+        m_consumerRing->reset();
+        consumer.pops(entries);
+        ASSERT_TRUE(entries.empty());
+        ASSERT_FALSE(consumer.hasCachedData());
+
+        producer.poll();
+        ASSERT_TRUE(consumer.hasCachedData());
+        consumer.pops(entries);
+        ASSERT_TRUE(consumer.reloaded());
+        ASSERT_EQ(entries.size(), 1);
+        ASSERT_EQ(kfvKey(entries[0]), "10.0.0.0/24");
+        ASSERT_EQ(kfvFieldsValues(entries[0]), routeFields(0));
+    }
+
+    TEST_F(ShmRouteRingTest, FullRingFallsBackToRedis)
+    {
+        const string smallRingName = "/swss_route_ring_ut_small";
+        auto consumerRing = ShmRouteRing::create(smallRingName, 4096);
+        auto producerRing = ShmRouteRing::attach(smallRingName);
+        ASSERT_NE(producerRing, nullptr);
+        producerRing->setPushTimeout(1);
+
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, producerRing);
+        ShmRouteConsumerStateTable consumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, consumerRing, 1 << 16);
+
+        // Nothing pops, the ring fills up and the remaining routes are written to Redis
+        const uint32_t routes = 1000;
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            producer.set(routeKey(i), routeFields(i));
+        }
+
+        // The SET of the route is still in the ring, it must not come after this DEL
+        producer.del(routeKey(0));
+
+        Table appl(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(appl.get(routeKey(routes - 1), values));
+        ASSERT_FALSE(appl.get(routeKey(0), values));
+
+        // The producer asked for a reset, the records left in the ring are dropped
+        auto generation = consumerRing->generation();
+        deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+        ASSERT_TRUE(entries.empty());
+        ASSERT_EQ(consumerRing->generation(), generation + 1);
+        ASSERT_FALSE(consumer.hasCachedData());
+
+        // Back on the ring, the whole table is loaded without the deleted route
+        producer.set(routeKey(routes), routeFields(routes));
+        consumer.pops(entries);
+        ASSERT_TRUE(consumer.reloaded());
+        ASSERT_EQ(entries.size(), routes + 1);
+        ASSERT_EQ(kfvKey(entries.back()), routeKey(routes));
+        for (const auto &entry : entries)
+        {
+            ASSERT_EQ(kfvOp(entry), SET_COMMAND);
+            ASSERT_NE(kfvKey(entry), routeKey(0));
+        }
+
+        producerRing.reset();
+        consumerRing.reset();
+        shm_unlink(smallRingName.c_str());
+        unlink(("/dev/shm" + smallRingName + ".fifo").c_str());
+    }
+
+    TEST_F(ShmRouteRingTest, TransportBenchmark)
+    {
+        const uint32_t routes = 20000;
+        const uint32_t samples = 1000;
+
+        // Shared memory ring, the consumer pops while the producer writes
+        ShmRouteProducerStateTable producer(m_pipeline.get(), APP_ROUTE_TABLE_NAME, m_producerRing);
+        ShmRouteConsumerStateTable consumer(m_app_db.get(), APP_ROUTE_TABLE_NAME, m_consumerRing, 1024);
+        deque<KeyOpFieldsValuesTuple> entries;
+        size_t received = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            producer.set(routeKey(i), routeFields(i));
+            if (i % 256 == 255)
+            {
+                consumer.pops(entries);
+                received += entries.size();
+            }
+        }
+        while (consumer.hasCachedData())
+        {
+            consumer.pops(entries);
+            received += entries.size();
+        }
+        auto ring_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        ASSERT_EQ(received, routes);
+
+        start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < samples; i++)
+        {
+            producer.set(routeKey(i), routeFields(i));
+            consumer.pops(entries);
+            ASSERT_EQ(entries.size(), 1);
+        }
+        auto ring_latency_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        // ZMQ channel, one message per route as ZmqProducerStateTable sends them
+        RouteCounter counter;
+        auto zmq_server = create_zmq_server("tcp://127.0.0.1");
+        auto zmq_client = create_zmq_client("tcp://127.0.0.1");
+        zmq_server->registerMessageHandler("APPL_DB", APP_ROUTE_TABLE_NAME, &counter);
+        zmq_server->bind();
+
+        auto waitFor = [&counter](size_t count) {
+            auto deadline = chrono::steady_clock::now() + chrono::seconds(30);
+            while (counter.received < count && chrono::steady_clock::now() < deadline)
+            {
+                this_thread::yield();
+            }
+            return counter.received >= count;
+        };
+
+        start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            vector<KeyOpFieldsValuesTuple> kcos = { KeyOpFieldsValuesTuple{ routeKey(i), SET_COMMAND, routeFields(i) } };
+            zmq_client->sendMsg("APPL_DB", APP_ROUTE_TABLE_NAME, kcos);
+        }
+        ASSERT_TRUE(waitFor(routes));
+        auto zmq_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < samples; i++)
+        {
+            vector<KeyOpFieldsValuesTuple> kcos = { KeyOpFieldsValuesTuple{ routeKey(i), SET_COMMAND, routeFields(i) } };
+            zmq_client->sendMsg("APPL_DB", APP_ROUTE_TABLE_NAME, kcos);
+            ASSERT_TRUE(waitFor(routes + i + 1));
+        }
+        auto zmq_latency_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        cout << "Route ring: " << (double)routes * 1000000 / (double)max<int64_t>(ring_us, 1) << " routes/s, "
+             << (double)ring_latency_us / samples << " us latency" << endl;
+        cout << "ZMQ: " << (double)routes * 1000000 / (double)max<int64_t>(zmq_us, 1) << " routes/s, "
+             << (double)zmq_latency_us / samples << " us latency" << endl;
+    }
+}
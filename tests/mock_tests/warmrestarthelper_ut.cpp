@@ -1,4 +1,6 @@
+#define private public // test compareAllFV directly
 #include "warmRestartHelper.h"
+#undef private
 #include "warm_restart.h"
 #include "mock_table.h"
 #include "ut_helper.h"
@@ -103,4 +105,18 @@ namespace wrhelper_test
         m_routeTable->hget("1.2.0.0/24", "protocol", val);
         ASSERT_EQ(val, "kernel");
     }
+
+    TEST_F(WRHelperTest, testIgnoredFieldCompare)
+    {
+        std::vector<FieldValueTuple> restored{{"nexthop", "2.3.0.0"}, {"fpm_ts_us", "1"}};
+        std::vector<FieldValueTuple> refreshed{{"nexthop", "2.3.0.0"}};
+
+        /* Old-life entry still carries the stamp of its last update */
+        ASSERT_TRUE(wrHelper->compareAllFV(restored, refreshed));
+
+        wrHelper->ignoreField("fpm_ts_us");
+        ASSERT_FALSE(wrHelper->compareAllFV(restored, refreshed));
+        ASSERT_FALSE(wrHelper->compareAllFV(refreshed, {{"nexthop", "2.3.0.0"}, {"fpm_ts_us", "2"}}));
+        ASSERT_TRUE(wrHelper->compareAllFV(restored, {{"nexthop", "2.4.0.0"}}));
+    }
 }
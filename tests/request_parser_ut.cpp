@@ -3,6 +3,8 @@
 #include <unordered_set>
 #include <string>
 #include <vector>
+#include <chrono>
+#include <iostream>
 
 #include "macaddress.h"
 #include "orch.h"
@@ -2024,3 +2026,99 @@ TEST(request_parser, string_list_clear_test)
         FAIL() << "Got unexpected exception";
     }
 }
+
+TEST(request_parser, parse_plan_lookup)
+{
+    request_description_t description = {
+        { REQ_T_STRING },
+        { },
+        { }
+    };
+
+    for (int i = 0; i < 200; i++)
+    {
+        description.attr_item_types["attr_" + std::to_string(i)] = REQ_T_UINT;
+    }
+
+    RequestParsePlan plan(description);
+    ASSERT_EQ(plan.size(), 200u);
+
+    for (int i = 0; i < 200; i++)
+    {
+        auto name = "attr_" + std::to_string(i);
+        auto slot = plan.find(name);
+        ASSERT_GE(slot, 0);
+        EXPECT_EQ(plan.getName(slot), name);
+        EXPECT_EQ(plan.getType(slot), REQ_T_UINT);
+    }
+
+    EXPECT_EQ(plan.find("attr_200"), -1);
+    EXPECT_EQ(plan.find(""), -1);
+
+    // Requests of the same type share one plan
+    EXPECT_EQ(RequestParsePlan::get(request_description1), RequestParsePlan::get(request_description1));
+}
+
+TEST(request_parser, wrong_attr_type_access)
+{
+    KeyOpFieldsValuesTuple t {"key1", "SET",
+                                 {
+                                     { "v4", "true" },
+                                     { "src_mac", "02:03:04:05:06:07" },
+                                 }
+                             };
+
+    TestRequest1 request;
+    EXPECT_NO_THROW(request.parse(t));
+
+    EXPECT_THROW(request.getAttrMacAddress("v4"), std::out_of_range);
+    EXPECT_THROW(request.getAttrBool("v6"), std::out_of_range);
+
+    EXPECT_EQ(request.getKeyString(0), "key1");
+    EXPECT_THROW(request.getKeyMacAddress(0), std::out_of_range);
+    EXPECT_THROW(request.getKeyUint(0), std::out_of_range);
+    EXPECT_THROW(request.getKeyString(1), std::out_of_range);
+
+    // Attributes of the previous request are not visible after clear
+    request.clear();
+    KeyOpFieldsValuesTuple t2 {"key2", "SET", { { "v6", "false" } } };
+    EXPECT_NO_THROW(request.parse(t2));
+    EXPECT_THROW(request.getAttrBool("v4"), std::out_of_range);
+    EXPECT_FALSE(request.getAttrBool("v6"));
+    EXPECT_EQ(request.getAttrFieldNames(), (std::unordered_set<std::string>{ "v6" }));
+}
+
+TEST(request_parser, parse_benchmark)
+{
+    const int iterations = 100000;
+
+    KeyOpFieldsValuesTuple t {"key1|02:03:04:05:06:07|key2", "SET",
+                                 {
+                                     { "v4", "true" },
+                                     { "v6", "false" },
+                                     { "src_mac", "02:03:04:05:06:07" },
+                                     { "ttl_action", "copy" },
+                                     { "ip_opt_action", "drop" },
+                                     { "l3_mc_action", "log" },
+                                     { "just_string", "123" },
+                                     { "vlan", "Vlan100" },
+                                 }
+                             };
+
+    TestRequest2 request;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        request.parse(t);
+        request.clear();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Request parse: " << elapsed.count() / iterations << " ns per request" << std::endl;
+
+    request.parse(t);
+    EXPECT_EQ(request.getAttrVlan("vlan"), 100);
+    EXPECT_EQ(request.getAttrString("just_string"), "123");
+    EXPECT_EQ(request.getAttrFieldNames().size(), 8u);
+}
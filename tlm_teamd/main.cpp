@@ -105,6 +105,7 @@ int main()
             {
                 update_interfaces(sst_lag, teamdctl_mgr);
                 values_store.update(teamdctl_mgr.get_dumps(false));
+                values_store.update_latencies(teamdctl_mgr.get_latencies());
             }
             else if (res == swss::Select::ERROR)
             {
@@ -118,6 +119,7 @@ int main()
                 // occurs, it triggers get_dumps incorrectly for resource which was in process of 
                 // getting deleted. The fix here is to retry and check if this is a real failure.
                 values_store.update(teamdctl_mgr.get_dumps(true));
+                values_store.update_latencies(teamdctl_mgr.get_latencies());
             }
             else
             {
@@ -1,5 +1,8 @@
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include <logger.h>
 
@@ -30,6 +33,8 @@ void teamdctl_log_function(struct teamdctl *tdc, int priority,
 ///
 TeamdCtlMgr::~TeamdCtlMgr()
 {
+    stop_dump_workers();
+
     for (const auto & p: m_handlers)
     {
         const auto & lag_name = p.first;
@@ -172,89 +177,233 @@ void TeamdCtlMgr::process_add_queue()
 }
 
 ///
-/// Get json dump from teamd for LAG interface with name lag_name
+/// Request json dump from teamd. Doesn't touch the manager state,
+/// so it can be called for different LAGs from several threads
+/// @param tdc teamdctl handler of the LAG
+/// @param raw result of the request and its latency
+///
+void TeamdCtlMgr::query_dump(struct teamdctl * tdc, RawDump & raw)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    char * dump;
+    raw.err = teamdctl_state_get_raw_direct(tdc, &dump);
+    if (raw.err == 0)
+    {
+        raw.dump.assign(dump);
+    }
+
+    raw.latency_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+///
+/// Handle result of the dump request for LAG interface with name lag_name
 /// @param lag_name a name for LAG interface
+/// @param raw result of the dump request
 /// @param to_retry is the flag used to do retry or not.
-/// @return a pair. First element of the pair is true, if the method is successful
+/// @return a pair. First element of the pair is true, if the request was successful
 ///         false otherwise. If the first element is true, the second element has a dump
 ///         otherwise the second element is an empty string
 ///
-TeamdCtlDump TeamdCtlMgr::get_dump(const std::string & lag_name, bool to_retry)
+TeamdCtlDump TeamdCtlMgr::process_dump(const std::string & lag_name, RawDump & raw, bool to_retry)
 {
     TeamdCtlDump res = { false, "" };
-    if (has_key(lag_name))
+
+    m_latencies[lag_name] = raw.latency_us;
+
+    if (raw.err == 0)
     {
-        auto tdc = m_handlers[lag_name];
-        char * dump;
-        int r = teamdctl_state_get_raw_direct(tdc, &dump);
-        if (r == 0)
-        {
-            res = { true, std::string(dump) };
+        res = { true, std::move(raw.dump) };
 
-            // If this lag interface errored last time, remove the entry
-            if (m_lags_err_retry.find(lag_name) != m_lags_err_retry.end())
-            {
-                SWSS_LOG_NOTICE("The LAG '%s' had errored in get_dump earlier, removing it", lag_name.c_str());
-                m_lags_err_retry.erase(lag_name);
-            }
+        // If this lag interface errored last time, remove the entry
+        if (m_lags_err_retry.find(lag_name) != m_lags_err_retry.end())
+        {
+            SWSS_LOG_NOTICE("The LAG '%s' had errored in get_dump earlier, removing it", lag_name.c_str());
+            m_lags_err_retry.erase(lag_name);
         }
-        else
+    }
+    else
+    {
+        // In case of failure and retry flag is set, check if it fails for MAX_RETRY times.
+        if (to_retry)
         {
-            // In case of failure and retry flag is set, check if it fails for MAX_RETRY times.
-            if (to_retry)
+            if (m_lags_err_retry.find(lag_name) != m_lags_err_retry.end())
             {
-                if (m_lags_err_retry.find(lag_name) != m_lags_err_retry.end())
+                if (m_lags_err_retry[lag_name] == MAX_RETRY)
                 {
-                    if (m_lags_err_retry[lag_name] == MAX_RETRY)
-                    {
-                        SWSS_LOG_ERROR("Can't get dump for LAG '%s'. Skipping", lag_name.c_str());
-                        m_lags_err_retry.erase(lag_name);
-                    }
-                    else
-                        m_lags_err_retry[lag_name]++;
+                    SWSS_LOG_ERROR("Can't get dump for LAG '%s'. Skipping", lag_name.c_str());
+                    m_lags_err_retry.erase(lag_name);
                 }
                 else
-                {
-
-                    // This time a different lag interface errored out.
-		    m_lags_err_retry[lag_name] = 1;
-                }
+                    m_lags_err_retry[lag_name]++;
             }
             else
             {
-                // No need to retry if the flag is not set.
-                SWSS_LOG_ERROR("Can't get dump for LAG '%s'. Skipping", lag_name.c_str());
+
+                // This time a different lag interface errored out.
+                m_lags_err_retry[lag_name] = 1;
             }
         }
+        else
+        {
+            // No need to retry if the flag is not set.
+            SWSS_LOG_ERROR("Can't get dump for LAG '%s'. Skipping", lag_name.c_str());
+        }
     }
-    else
+
+    return res;
+}
+
+///
+/// Get json dump from teamd for LAG interface with name lag_name
+/// @param lag_name a name for LAG interface
+/// @param to_retry is the flag used to do retry or not.
+/// @return a pair. First element of the pair is true, if the method is successful
+///         false otherwise. If the first element is true, the second element has a dump
+///         otherwise the second element is an empty string
+///
+TeamdCtlDump TeamdCtlMgr::get_dump(const std::string & lag_name, bool to_retry)
+{
+    if (!has_key(lag_name))
     {
         SWSS_LOG_ERROR("Can't update state. LAG not found. LAG='%s'", lag_name.c_str());
+        return { false, "" };
     }
 
-    return res;
+    RawDump raw;
+    query_dump(m_handlers[lag_name], raw);
+
+    return process_dump(lag_name, raw, to_retry);
+}
+
+///
+/// Start dump workers, so there are n_workers of them
+/// @param n_workers number of workers to have
+///
+void TeamdCtlMgr::start_dump_workers(size_t n_workers)
+{
+    while (m_dump_workers.size() < n_workers)
+    {
+        m_dump_workers.emplace_back(&TeamdCtlMgr::dump_worker, this);
+    }
+}
+
+///
+/// Stop and join the dump workers
+///
+void TeamdCtlMgr::stop_dump_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_dump_mutex);
+        m_dump_stop = true;
+    }
+    m_dump_cv.notify_all();
+
+    for (auto & worker: m_dump_workers)
+    {
+        worker.join();
+    }
+    m_dump_workers.clear();
+}
+
+///
+/// Dump worker loop. Waits for a poll and queries teamds until no job is left
+///
+void TeamdCtlMgr::dump_worker()
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(m_dump_mutex);
+
+    while (true)
+    {
+        m_dump_cv.wait(lock, [this, &generation] { return m_dump_stop || m_dump_generation != generation; });
+        if (m_dump_stop)
+        {
+            return;
+        }
+
+        generation = m_dump_generation;
+        size_t n_jobs = m_dump_jobs.size();
+        m_dump_active++;
+        lock.unlock();
+
+        run_dump_jobs(n_jobs);
+
+        lock.lock();
+        if (--m_dump_active == 0)
+        {
+            m_dump_done_cv.notify_all();
+        }
+    }
+}
+
+///
+/// Query teamds of the current poll until no job is left
+/// @param n_jobs number of jobs of the current poll
+///
+void TeamdCtlMgr::run_dump_jobs(size_t n_jobs)
+{
+    size_t idx;
+    while ((idx = m_dump_next++) < n_jobs)
+    {
+        query_dump(m_dump_jobs[idx], m_dump_raws[idx]);
+    }
 }
 
 ///
 /// Get dumps for all registered LAG interfaces
+/// The teamds are queried in parallel by the dump workers and the caller,
+/// results are processed in the caller thread
 /// @return vector of pairs. Each pair first value is a name of LAG, second value is a dump
 ///
 TeamdCtlDumps TeamdCtlMgr::get_dumps(bool to_retry)
 {
     TeamdCtlDumps res;
 
-    for (const auto & p: m_handlers)
+    std::vector<std::string> lag_names;
+    lag_names.reserve(m_handlers.size());
+
     {
-        const auto & lag_name = p.first;
-        const auto & result = get_dump(lag_name, to_retry);
-        const auto & status = result.first;
-        const auto & dump = result.second;
-        if (status)
+        std::unique_lock<std::mutex> lock(m_dump_mutex);
+        // A worker that woke up late may still be going through the jobs of the previous poll
+        m_dump_done_cv.wait(lock, [this] { return m_dump_active == 0; });
+
+        m_dump_jobs.clear();
+        for (const auto & p: m_handlers)
         {
-            res.push_back({ lag_name, dump });
+            lag_names.push_back(p.first);
+            m_dump_jobs.push_back(p.second);
+        }
+        m_dump_raws.assign(m_dump_jobs.size(), RawDump());
+        m_dump_next = 0;
+
+        if (m_dump_jobs.size() > 1)
+        {
+            start_dump_workers(std::min(m_dump_jobs.size(), max_dump_threads) - 1);
+            m_dump_generation++;
+        }
+    }
+    m_dump_cv.notify_all();
+
+    run_dump_jobs(m_dump_jobs.size());
+
+    {
+        std::unique_lock<std::mutex> lock(m_dump_mutex);
+        m_dump_done_cv.wait(lock, [this] { return m_dump_active == 0; });
+    }
+
+    // Drop latencies of the removed LAGs
+    m_latencies.clear();
+
+    for (size_t idx = 0; idx < lag_names.size(); idx++)
+    {
+        const auto & lag_name = lag_names[idx];
+        auto result = process_dump(lag_name, m_dump_raws[idx], to_retry);
+        if (result.first)
+        {
+            res.emplace_back(lag_name, std::move(result.second));
         }
     }
 
     return res;
 }
-
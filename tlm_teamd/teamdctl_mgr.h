@@ -3,12 +3,18 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include <teamdctl.h>
 
 using TeamdCtlDump = std::pair<bool, std::string>;
 using TeamdCtlDumpsEntry = std::pair<std::string, std::string>;
 using TeamdCtlDumps = std::vector<TeamdCtlDumpsEntry>;
+using TeamdCtlLatencies = std::unordered_map<std::string, uint64_t>;
 
 class TeamdCtlMgr
 {
@@ -21,14 +27,47 @@ public:
     // Retry logic added to prevent incorrect error reporting in dump API's
     TeamdCtlDump get_dump(const std::string & lag_name, bool to_retry);
     TeamdCtlDumps get_dumps(bool to_retry);
+    // Latency of the last dump request in microseconds for every polled LAG
+    const TeamdCtlLatencies & get_latencies() const { return m_latencies; }
 
 private:
+    struct RawDump
+    {
+        int err = 0;
+        std::string dump;
+        uint64_t latency_us = 0;
+    };
+
     bool has_key(const std::string & lag_name) const;
     bool try_add_lag(const std::string & lag_name);
+    static void query_dump(struct teamdctl * tdc, RawDump & raw);
+    void start_dump_workers(size_t n_workers);
+    void stop_dump_workers();
+    void dump_worker();
+    void run_dump_jobs(size_t n_jobs);
+    TeamdCtlDump process_dump(const std::string & lag_name, RawDump & raw, bool to_retry);
 
     std::unordered_map<std::string, struct teamdctl*> m_handlers;
     std::unordered_map<std::string, int> m_lags_to_add;
     std::unordered_map<std::string, int> m_lags_err_retry;
+    TeamdCtlLatencies m_latencies;
 
     const int max_attempts_to_add = 10;
+    // Every teamd is queried over its own socket, so the dumps are collected in parallel
+    const size_t max_dump_threads = 8;
+
+    // Workers started on the first poll and kept until exit. The caller queries teamds too
+    std::vector<std::thread> m_dump_workers;
+    std::mutex m_dump_mutex;
+    std::condition_variable m_dump_cv;
+    std::condition_variable m_dump_done_cv;
+    bool m_dump_stop = false;
+    // Incremented for every poll, wakes up the workers
+    uint64_t m_dump_generation = 0;
+    // Workers running jobs of the current poll
+    size_t m_dump_active = 0;
+    // Jobs of the current poll, only changed when no worker is active
+    std::vector<struct teamdctl*> m_dump_jobs;
+    std::vector<RawDump> m_dump_raws;
+    std::atomic<size_t> m_dump_next{0};
 };
@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include <jansson.h>
 
 #include <logger.h>
@@ -149,9 +151,11 @@ std::string ValuesStore::get_value(json_t * root, const std::string & path, Valu
 /// @param lag_name a name of the LAG
 /// @param root a pointer to the parsed json tree
 /// @param storage a reference to the temporary storage
+/// @return a list of the storage keys extracted for the LAG
 ///
-void ValuesStore::extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage)
+std::vector<std::string> ValuesStore::extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage)
 {
+    std::vector<std::string> keys;
 
     const std::string key = "LAG_TABLE|" + lag_name;
     Records lag_values;
@@ -163,6 +167,7 @@ void ValuesStore::extract_values(const std::string & lag_name, json_t * root, Ha
         lag_values.emplace(path, value);
     }
     storage.emplace(key, lag_values);
+    keys.push_back(key);
 
     const auto & ports = get_ports(root);
     for (const auto & port: ports)
@@ -178,9 +183,10 @@ void ValuesStore::extract_values(const std::string & lag_name, json_t * root, Ha
             member_values.emplace(path, value);
         }
         storage.emplace(key, member_values);
+        keys.push_back(key);
     }
 
-    return;
+    return keys;
 }
 
 ///
@@ -211,15 +217,40 @@ json_t * ValuesStore::load_json(const std::string & data)
 HashOfRecords ValuesStore::from_json(const std::vector<StringPair> & dumps)
 {
     HashOfRecords storage;
+    std::unordered_map<std::string, std::pair<std::string, std::vector<std::string>>> new_dumps;
     for (const auto & p: dumps)
     {
         const auto & lag_name = p.first;
         const auto & json_dump = p.second;
+
+        // The dump didn't change since the last update, reuse records from the main storage
+        const auto & cached = m_dumps.find(lag_name);
+        if (cached != m_dumps.end() && cached->second.first == json_dump)
+        {
+            for (const auto & key: cached->second.second)
+            {
+                storage.emplace(key, m_storage.at(key));
+            }
+            new_dumps.emplace(lag_name, std::move(cached->second));
+            continue;
+        }
+
         json_t * root = load_json(json_dump);
-        extract_values(lag_name, root, storage);
+        try
+        {
+            auto keys = extract_values(lag_name, root, storage);
+            new_dumps.emplace(lag_name, std::make_pair(json_dump, std::move(keys)));
+        }
+        catch (...)
+        {
+            json_decref(root);
+            throw;
+        }
         json_decref(root);
     }
 
+    m_dumps.swap(new_dumps);
+
     return storage;
 }
 
@@ -289,9 +320,24 @@ void ValuesStore::remove_keys_db(const std::vector<std::string> & keys)
         // to connect to teamdctl and if it fails we do not delete State Db entry.
         if (table_name == "LAG_TABLE")
             continue;
-        swss::Table table(m_db, table_name);
-        table.del(table_key);
+        get_table(table_name).del(table_key);
+    }
+}
+
+///
+/// Get a table writing to the db through the pipeline
+/// @param table_name a name of the table
+/// @return a reference to the table
+///
+swss::Table & ValuesStore::get_table(const std::string & table_name)
+{
+    auto & table = m_tables[table_name];
+    if (!table)
+    {
+        table = std::make_unique<swss::Table>(&m_pipeline, table_name, true);
     }
+
+    return *table;
 }
 
 ///
@@ -359,8 +405,7 @@ void ValuesStore::update_db(const HashOfRecords & storage, const std::vector<std
             fvp.emplace_back(row_pair);
         }
         const auto & table_pair = split_key(key);
-        swss::Table table(m_db, table_pair.first);
-        table.set(table_pair.second, fvp);
+        get_table(table_pair.first).set(table_pair.second, fvp);
     }
 }
 
@@ -378,6 +423,47 @@ void ValuesStore::update(const std::vector<StringPair> & dumps)
         remove_keys_storage(old_keys);
         const auto & keys_to_refresh = update_storage(storage);
         update_db(storage, keys_to_refresh);
+        m_pipeline.flush();
+    }
+    catch (const std::exception & e)
+    {
+        // Drop the cached dumps, so the next update re-parses and re-syncs everything
+        m_dumps.clear();
+        SWSS_LOG_WARN("Exception '%s' had been thrown in ValuesStore", e.what());
+    }
+}
+
+///
+/// Publish latency of the last teamd dump request for every LAG.
+/// Together with the update timestamp it shows how stale LAG state in the db is.
+/// @param latencies latency of the last dump request in microseconds per LAG
+///
+void ValuesStore::update_latencies(const std::unordered_map<std::string, uint64_t> & latencies)
+{
+    try
+    {
+        auto & table = get_table("LAG_TELEMETRY_TABLE");
+        const auto & timestamp = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+        for (const auto & p: m_latencies)
+        {
+            if (latencies.find(p.first) == latencies.end())
+            {
+                table.del(p.first);
+            }
+        }
+
+        for (const auto & p: latencies)
+        {
+            table.set(p.first, {
+                { "poll_latency_us", std::to_string(p.second) },
+                { "last_poll_timestamp", timestamp },
+            });
+        }
+
+        m_pipeline.flush();
+        m_latencies = latencies;
     }
     catch (const std::exception & e)
     {
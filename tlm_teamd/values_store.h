@@ -2,10 +2,14 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <unordered_map>
 
 #include <jansson.h>
 
 #include <dbconnector.h>
+#include <redispipeline.h>
+#include <table.h>
 
 using StringPair = std::pair<std::string, std::string>;
 using Records = std::unordered_map<std::string, std::string>;
@@ -14,8 +18,9 @@ using HashOfRecords = std::unordered_map<std::string, Records>;
 class ValuesStore
 {
 public:
-    ValuesStore(const swss::DBConnector * db) : m_db(db) {};
+    ValuesStore(const swss::DBConnector * db) : m_db(db), m_pipeline(db) {};
     void update(const std::vector<StringPair> & dumps);
+    void update_latencies(const std::unordered_map<std::string, uint64_t> & latencies);
 
 private:
     enum class json_type
@@ -40,10 +45,17 @@ private:
     StringPair split_key(const std::string & key);
     std::vector<std::string> update_storage(const HashOfRecords & storage);
     void update_db(const HashOfRecords & storage, const std::vector<std::string> & keys_to_refresh);
-    void extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage);
+    std::vector<std::string> extract_values(const std::string & lag_name, json_t * root, HashOfRecords & storage);
+    swss::Table & get_table(const std::string & table_name);
 
     HashOfRecords m_storage;  // our main storage
     const swss::DBConnector * m_db;
+    swss::RedisPipeline m_pipeline;  // all db writes of one update are sent in one batch
+    std::unordered_map<std::string, std::unique_ptr<swss::Table>> m_tables;
+    // Last json dump per LAG and the storage keys extracted from it.
+    // Unchanged dumps are not parsed again.
+    std::unordered_map<std::string, std::pair<std::string, std::vector<std::string>>> m_dumps;
+    std::unordered_map<std::string, uint64_t> m_latencies;
 
     const std::vector<std::pair<std::string, ValuesStore::json_type>> m_lag_paths = {
         { "setup.kernel_team_mode_name", ValuesStore::json_type::string  },
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <sstream>
+#include <iterator>
 
 #include "warmRestartHelper.h"
 
@@ -260,8 +261,15 @@ void WarmStartHelper::reconcile(void)
 }
 
 
+void WarmStartHelper::ignoreField(const std::string &field)
+{
+    m_ignoredFields.insert(field);
+}
+
+
 /*
- * Compare all field-value-tuples within two vectors.
+ * Compare all field-value-tuples within two vectors, leaving out the fields
+ * registered through ignoreField().
  *
  * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
  *          v2 {nexthop: 10.1.1.2, ifname: eth2, protocol: kernel, weight: 1}
@@ -273,6 +281,27 @@ void WarmStartHelper::reconcile(void)
  */
 bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
                                    const std::vector<FieldValueTuple> &v2)
+{
+    if (!m_ignoredFields.empty())
+    {
+        auto ignored = [this](const FieldValueTuple &fv)
+        {
+            return m_ignoredFields.count(fvField(fv)) != 0;
+        };
+
+        std::vector<FieldValueTuple> l, r;
+        std::remove_copy_if(v1.begin(), v1.end(), std::back_inserter(l), ignored);
+        std::remove_copy_if(v2.begin(), v2.end(), std::back_inserter(r), ignored);
+
+        return compareFilteredFV(l, r);
+    }
+
+    return compareFilteredFV(v1, v2);
+}
+
+
+bool WarmStartHelper::compareFilteredFV(const std::vector<FieldValueTuple> &v1,
+                                        const std::vector<FieldValueTuple> &v2)
 {
     /* Size mismatch implies a diff */
     if (v1.size() != v2.size())
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <algorithm>
 
@@ -54,6 +55,12 @@ class WarmStartHelper {
 
     void insertRefreshMap(const KeyOpFieldsValuesTuple &kfv);
 
+    /*
+     * Fields that carry no state (e.g. per-update stamps) and must not turn
+     * an otherwise identical entry into a diff during reconciliation.
+     */
+    void ignoreField(const std::string &field);
+
     void reconcile(void);
 
     const std::string printKFV(const std::string                  &key,
@@ -64,6 +71,9 @@ class WarmStartHelper {
     bool compareAllFV(const std::vector<FieldValueTuple> &left,
                       const std::vector<FieldValueTuple> &right);
 
+    bool compareFilteredFV(const std::vector<FieldValueTuple> &left,
+                           const std::vector<FieldValueTuple> &right);
+
     bool compareOneFV(const std::string &v1, const std::string &v2);
 
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
@@ -75,6 +85,7 @@ class WarmStartHelper {
     std::string               m_syncTableName;     // producer-table-name to sync/push state to
     std::string               m_dockName;          // sonic-docker requesting warmStart services
     std::string               m_appName;           // sonic-app requesting warmStart services
+    std::set<std::string>     m_ignoredFields;     // fields left out of the reconciliation diff
 };
 
 